@@ -0,0 +1,186 @@
+/*
+ * AsyncReadback.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_ASYNC_READBACK_H
+#define LLGL_ASYNC_READBACK_H
+
+
+#include "NonCopyable.h"
+#include "ForwardDecls.h"
+#include "TextureFlags.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Handle of a single readback that was recorded by an AsyncReadback object.
+\remarks A handle of zero is invalid. Handles are only valid until the readback has been read or discarded.
+The lower 32 bits identify the internal slot and the upper 32 bits its generation, which is incremented each time the slot is reused.
+This way, a stale handle is rejected even if its slot has been reused for another readback in the meantime.
+\see AsyncReadback::ReadTexture
+\see AsyncReadback::ReadBuffer
+*/
+using ReadbackHandle = std::uint64_t;
+
+/**
+\brief Helper class for non-blocking readbacks of texture and buffer data from GPU to CPU memory space.
+\remarks Each readback copies the source resource into a readback buffer (i.e. a buffer with CPUAccessFlags::Read and only the BindFlags::CopyDst binding flag)
+as part of a command buffer, and a fence is submitted after that command buffer. The CPU can then poll the readback in later frames,
+so the latency of the readback overlaps with the rendering of the next frames instead of stalling the CPU until the GPU has drained its queue.
+On the OpenGL backend, the copy is recorded into a pixel-pack buffer and synchronized with a sync object (i.e. \c glFenceSync).
+On the Vulkan backend, the copy is recorded directly into host visible memory, which is host cached if the device provides such a memory type.
+\code
+// Frame N: record and submit the readback
+auto readback = myAsyncReadback.ReadTexture(*myCmdBuffer, *myTexture, myTexRegion);
+myCmdQueue->Submit(*myCmdBuffer);
+myAsyncReadback.Submit();
+
+// Frame N+2: read the data once it is available
+if (myAsyncReadback.IsReady(readback))
+    myAsyncReadback.Read(readback, myImageData.data(), myImageData.size());
+\endcode
+\see RenderSystem::ReadTexture
+\see RenderSystem::MapBuffer
+*/
+class LLGL_EXPORT AsyncReadback : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Initializes the readback helper for the specified render system and command queue.
+        \remarks All readbacks must be recorded into command buffers that are submitted to the specified command queue.
+        */
+        AsyncReadback(RenderSystem& renderSystem, CommandQueue& commandQueue);
+
+        //! Releases all readback buffers and fences.
+        ~AsyncReadback();
+
+        /**
+        \brief Records a readback of the specified texture region into the specified command buffer.
+        \param[in] commandBuffer Specifies the command buffer that records the copy command and a resource barrier for the readback buffer.
+        This command buffer must be between its Begin and End calls, and outside of a render pass.
+        \param[in] srcTexture Specifies the source texture. This texture must have been created with the BindFlags::CopySrc binding flag.
+        \param[in] srcRegion Specifies the source texture region. The texels are tightly packed in the readback buffer.
+        \return Handle of the new readback, or zero if the texture region is empty.
+        \see Texture::GetMemoryFootprint(const Extent3D&, const TextureSubresource&) const
+        */
+        ReadbackHandle ReadTexture(CommandBuffer& commandBuffer, Texture& srcTexture, const TextureRegion& srcRegion);
+
+        /**
+        \brief Records a readback of the specified buffer range into the specified command buffer.
+        \param[in] commandBuffer Specifies the command buffer that records the copy command and a resource barrier for the readback buffer.
+        This command buffer must be between its Begin and End calls, and outside of a render pass.
+        \param[in] srcBuffer Specifies the source buffer. This buffer must have been created with the BindFlags::CopySrc binding flag.
+        \param[in] srcOffset Specifies the offset (in bytes) of the source buffer range.
+        \param[in] size Specifies the size (in bytes) of the source buffer range.
+        \return Handle of the new readback, or zero if the size is zero.
+        */
+        ReadbackHandle ReadBuffer(CommandBuffer& commandBuffer, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size);
+
+        /**
+        \brief Submits a fence for all readbacks that have been recorded since the last call to this function.
+        \remarks This must be called after the command buffers that recorded these readbacks have been submitted to the command queue.
+        */
+        void Submit();
+
+        /**
+        \brief Returns true if the data of the specified readback is available. This never blocks.
+        \remarks Returns false if the handle is invalid or the readback has not been submitted yet.
+        */
+        bool IsReady(ReadbackHandle handle);
+
+        /**
+        \brief Blocks the CPU execution until the data of the specified readback is available.
+        \param[in] handle Specifies the readback to wait for.
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds).
+        \return True if the data is available, or false if the handle is invalid, the readback has not been submitted yet, or the fence has a timeout.
+        \see CommandQueue::WaitFence
+        */
+        bool Wait(ReadbackHandle handle, std::uint64_t timeout = ~0ull);
+
+        /**
+        \brief Copies the data of the specified readback into the output buffer and releases the readback.
+        \param[in] handle Specifies the readback to read. This handle is invalid after this call.
+        \param[out] data Pointer to the output buffer. At most the number of bytes returned by GetDataSize are written to this buffer.
+        \param[in] dataSize Specifies the size (in bytes) of the output buffer.
+        \return True on success. Otherwise, the handle is invalid or the readback has not been submitted yet.
+        \remarks If the data is not yet available, this function blocks until the readback has been completed.
+        To avoid stalls, call this function only after IsReady returned true.
+        */
+        bool Read(ReadbackHandle handle, void* data, std::size_t dataSize);
+
+        /**
+        \brief Releases the specified readback without reading its data. This handle is invalid after this call.
+        \remarks The internal readback buffer is not reused until the fence of this readback has been signaled,
+        i.e. a readback that has been recorded but not yet submitted still requires a call to Submit.
+        */
+        void Discard(ReadbackHandle handle);
+
+        //! Returns the size (in bytes) of the data of the specified readback, or zero if the handle is invalid.
+        std::uint64_t GetDataSize(ReadbackHandle handle) const;
+
+    private:
+
+        enum class SlotState
+        {
+            Free,               // Slot can be used for a new readback.
+            Recorded,           // Copy command has been recorded, but the fence has not been submitted yet.
+            Submitted,          // Fence has been submitted.
+            Ready,              // Fence has been signaled.
+            DiscardedRecorded,  // Readback has been discarded before its fence was submitted.
+            Discarded,          // Readback has been discarded while its fence was still pending.
+        };
+
+        struct Slot
+        {
+            Buffer*         buffer      = nullptr;
+            Fence*          fence       = nullptr;
+            std::uint64_t   capacity    = 0;
+            std::uint64_t   dataSize    = 0;
+            std::uint32_t   generation  = 0;
+            SlotState       state       = SlotState::Free;
+        };
+
+    private:
+
+        // Returns true if the specified slot can be used for a new readback.
+        bool IsSlotAvailable(Slot& slot);
+
+        // Returns the index of a free slot whose buffer can hold the specified number of bytes.
+        std::uint32_t AcquireSlot(std::uint64_t dataSize);
+
+        // Returns the slot of the specified handle, or null if the handle is invalid.
+        Slot* GetSlot(ReadbackHandle handle);
+        const Slot* GetSlot(ReadbackHandle handle) const;
+
+        // Returns the handle for the specified slot index and the current generation of that slot.
+        ReadbackHandle MakeHandle(std::uint32_t slotIndex) const;
+
+    private:
+
+        RenderSystem&       renderSystem_;
+        CommandQueue&       commandQueue_;
+
+        std::vector<Slot>   slots_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -20,6 +20,30 @@ namespace LLGL
 {
 
 
+/**
+\brief Memory mapping flags for a Blob.
+\see Blob::CreateMapped
+*/
+struct BlobMappingFlags
+{
+    enum
+    {
+        /**
+        \brief Hint that the mapped file will be read sequentially from beginning to end.
+        \remarks This lets the operating system read ahead more aggressively and free the pages behind the read position sooner,
+        e.g. with \c MADV_SEQUENTIAL on POSIX or \c FILE_FLAG_SEQUENTIAL_SCAN on Win32.
+        */
+        Sequential  = (1 << 0),
+
+        /**
+        \brief Hint that the entire mapped file will be needed soon.
+        \remarks This lets the operating system start reading the file in the background before it is accessed,
+        e.g. with \c MADV_WILLNEED on POSIX. This is ignored on Win32.
+        */
+        WillNeed    = (1 << 1),
+    };
+};
+
 /**
 \brief CPU read-only buffer of arbitrary size.
 \see RenderSystem::CreatePipelineState
@@ -73,6 +97,26 @@ class LLGL_EXPORT Blob : public NonCopyable
         */
         static std::unique_ptr<Blob> CreateFromFile(const std::string& filename);
 
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory.
+        \param[in] filename Specifies the file that is to be mapped.
+        \param[in] flags Specifies optional access hints for the mapped memory. This can be a bitwise OR combination of the BlobMappingFlags entries. By default 0.
+        \return New instance of Blob that refers to the mapped file or null if the file could not be mapped.
+        \remarks In contrast to CreateFromFile, the file content is not copied. Instead, the pages of the file are loaded by the operating system when they are accessed the first time.
+        This makes the returned blob suitable for large files such as SPIR-V modules, pipeline caches, and pre-baked textures,
+        whose data can be passed directly to ShaderDescriptor::source (with ShaderSourceType::BinaryBuffer) and SrcImageDescriptor::data.
+        \remarks The file is mapped with read-only access and must not be truncated while it is mapped.
+        Empty files and platforms without memory mapped files fall back to CreateFromFile.
+        \see BlobMappingFlags
+        */
+        static std::unique_ptr<Blob> CreateMapped(const char* filename, long flags = 0);
+
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory.
+        \see CreateMapped(const char*, long)
+        */
+        static std::unique_ptr<Blob> CreateMapped(const std::string& filename, long flags = 0);
+
     public:
 
         //! Returns a constant pointer to the internal buffer.
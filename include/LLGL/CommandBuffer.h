@@ -68,6 +68,26 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void End() = 0;
 
+        /**
+        \brief Begins with the encoding of this command buffer only if this does not block the CPU execution.
+        \return True if the encoding has begun, or false if all native command buffers are still in use by the GPU.
+        In the latter case, the command buffer remains unchanged and the encoding must not continue.
+        \remarks This can be used to skip or defer the encoding of a frame instead of waiting for the GPU to catch up.
+        For rendering APIs without native command buffers (such as OpenGL and Direct3D 11), this is equivalent to calling Begin and always returns true.
+        \see Begin
+        \see CommandBufferDescriptor::numNativeBuffers
+        */
+        virtual bool TryBegin();
+
+        /**
+        \brief Returns the time (in nanoseconds) the CPU was blocked in the last call to Begin, waiting for the GPU to release the next native command buffer.
+        \remarks A large wait time means the CPU is ahead of the GPU by the maximum number of frames in flight.
+        This can be used to tune CommandBufferDescriptor::numNativeBuffers between throughput and input latency.
+        For rendering APIs without native command buffers, this is always zero.
+        \see CommandBufferDescriptor::numNativeBuffers
+        */
+        virtual std::uint64_t GetLastWaitTime() const;
+
         /**
         \brief Executes the specified deferred command buffer.
         \param[in] deferredCommandBuffer Specifies the deferred command buffer which is meant to be executed.
@@ -856,6 +876,28 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         */
         virtual void DispatchIndirect(Buffer& buffer, std::uint64_t offset) = 0;
 
+        /**
+        \brief Makes all previous writes to the specified resources visible to all subsequent commands of this command buffer.
+        \param[in] numBuffers Specifies the number of buffers in the \c buffers array.
+        \param[in] buffers Pointer to an array of buffers that have been written by a shader or a copy command. This may be null if \c numBuffers is zero.
+        \param[in] numTextures Specifies the number of textures in the \c textures array.
+        \param[in] textures Pointer to an array of textures that have been written by a shader or a copy command. This may be null if \c numTextures is zero.
+        \remarks This must be used whenever a resource is read after it has been written within the same command buffer with a different kind of access,
+        e.g. when a compute shader writes the arguments for DrawIndirect into a storage buffer, or when a shader reads a buffer after CopyBuffer has written into it.
+        The kind of synchronization is determined by the binding flags of each resource (see BufferDescriptor::bindFlags and TextureDescriptor::bindFlags).
+        Buffers with CPUAccessFlags::Read are also made visible to the host once the command buffer has completed, e.g. for RenderSystem::MapBuffer.
+        Kinds of access that the queue of this command buffer does not support (e.g. vertex input on a compute queue) are ignored.
+        \remarks This function must not be called inside a render pass, i.e. between BeginRenderPass and EndRenderPass.
+        Renderers do not interrupt an active render pass for this barrier.
+        \note Direct3D 11 and Metal synchronize these accesses implicitly, so this function has no effect with those renderers.
+        */
+        virtual void ResourceBarrier(
+            std::uint32_t           numBuffers,
+            Buffer* const *         buffers,
+            std::uint32_t           numTextures = 0,
+            Texture* const *        textures    = nullptr
+        );
+
         /* ----- Debugging ----- */
 
         /**
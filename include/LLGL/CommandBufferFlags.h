@@ -69,6 +69,19 @@ enum class PipelineBindPoint
     Compute,    //!< Compute pipeline binding point.
 };
 
+/**
+\brief Command queue type enumeration.
+\remarks Rendering APIs that only provide a single queue (such as OpenGL and Direct3D 11) return the graphics queue for all types.
+\see RenderSystem::GetCommandQueueOfType(const CommandQueueType)
+\see CommandBufferDescriptor::queueType
+*/
+enum class CommandQueueType
+{
+    Graphics,   //!< Command queue for graphics, compute, and copy commands. This is the default command queue.
+    Compute,    //!< Command queue for compute and copy commands that can run asynchronously to the graphics queue.
+    Transfer,   //!< Command queue for copy commands that can run asynchronously to the graphics and compute queues.
+};
+
 
 /* ----- Flags ----- */
 
@@ -256,9 +269,22 @@ struct CommandBufferDescriptor
     These native command buffers are then switched everytime encoding begins with the CommandBuffer::Begin function.
     The benefit of having multiple native command buffers is that it reduces the time the GPU is idle
     because it waits for a command buffer to be completed before it can be reused.
+    \remarks This is the maximum number of frames in flight for this command buffer: more native command buffers increase the throughput,
+    fewer native command buffers reduce the input latency, since the CPU cannot get ahead of the GPU by more frames.
     \see CommandBuffer::Begin
+    \see CommandBuffer::TryBegin
+    \see CommandBuffer::GetLastWaitTime
     */
     std::uint32_t   numNativeBuffers    = 2;
+
+    /**
+    \brief Specifies the type of command queue the command buffer will be submitted to. By default CommandQueueType::Graphics.
+    \remarks The command buffer must only be submitted to the command queue returned by RenderSystem::GetCommandQueueOfType for this type.
+    Command buffers for the compute queue must only record compute and copy commands,
+    and command buffers for the transfer queue must only record copy commands.
+    \see RenderSystem::GetCommandQueueOfType(const CommandQueueType)
+    */
+    CommandQueueType    queueType       = CommandQueueType::Graphics;
 };
 
 
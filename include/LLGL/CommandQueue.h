@@ -122,6 +122,48 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual void WaitIdle() = 0;
 
+        /* ----- Fence values ----- */
+
+        /**
+        \brief Submits a signal operation into the command queue that sets the specified fence to a 64-bit value.
+        \param[in] fence Specifies the fence to be signaled.
+        \param[in] value Specifies the new value of the fence. This must be greater than any value the fence has been signaled with before.
+For rendering APIs with fence values, Submit(Fence&) signals the fence with its previous value plus one, so both functions advance the same value.
+        \remarks The fence is set to the new value when all previously submitted command buffers of this queue have been completed.
+        This can be used to synchronize command queues of different types:
+        \code
+        // Run simulation on the compute queue and let the graphics queue wait for its results
+        myComputeQueue->Submit(*mySimulationCmdBuffer);
+        myComputeQueue->Signal(*myFence, ++myFenceValue);
+        myGraphicsQueue->Wait(*myFence, myFenceValue);
+        myGraphicsQueue->Submit(*myRenderCmdBuffer);
+        \endcode
+        \remarks For rendering APIs without fence values, this is equivalent to Submit(Fence&).
+        \see Wait
+        \see WaitFenceValue
+        */
+        virtual void Signal(Fence& fence, std::uint64_t value);
+
+        /**
+        \brief Lets all command buffers that are submitted after this call wait on the GPU until the specified fence has reached the specified value.
+        \remarks This does not block the CPU execution. The fence value must be signaled by a subsequent or previous call to Signal on any other command queue.
+        \remarks For rendering APIs with only a single queue, all submissions are already executed in order and this function has no effect.
+        For rendering APIs with multiple queues but without fence values, this function blocks the CPU execution until the fence has been signaled.
+        \see Signal
+        */
+        virtual void Wait(Fence& fence, std::uint64_t value);
+
+        /**
+        \brief Blocks the CPU execution until the specified fence has reached the specified value.
+        \param[in] fence Specifies the fence for which the CPU needs to wait.
+        \param[in] value Specifies the value the fence must have reached.
+        \param[in] timeout Specifies the waiting timeout (in nanoseconds). A timeout of zero can be used to poll the fence.
+        \return True on success, or false if the fence has a timeout or the device is lost.
+        \remarks For rendering APIs without fence values, this is equivalent to WaitFence(Fence&, std::uint64_t).
+        \see Signal
+        */
+        virtual bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout);
+
     protected:
 
         CommandQueue() = default;
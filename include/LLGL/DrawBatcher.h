@@ -0,0 +1,251 @@
+/*
+ * DrawBatcher.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_DRAW_BATCHER_H
+#define LLGL_DRAW_BATCHER_H
+
+
+#include "NonCopyable.h"
+#include "ForwardDecls.h"
+#include "BufferFlags.h"
+#include "IndirectArguments.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Draw packet structure for a single indexed draw command that is batched by a DrawBatcher.
+\see DrawBatcher::AddDraw
+*/
+struct DrawPacket
+{
+    //! Pipeline state to draw with. This must not be null.
+    PipelineState*  pipelineState       = nullptr;
+
+    //! Optional resource heap to draw with. By default null.
+    ResourceHeap*   resourceHeap        = nullptr;
+
+    //! Descriptor set of the resource heap. This is ignored if \c resourceHeap is null. By default 0.
+    std::uint32_t   descriptorSet       = 0;
+
+    //! Number of indices per instance. By default 0.
+    std::uint32_t   numIndices          = 0;
+
+    //! Number of instances. By default 1.
+    std::uint32_t   numInstances        = 1;
+
+    //! Zero-based offset of the first index from the index buffer. By default 0.
+    std::uint32_t   firstIndex          = 0;
+
+    //! Base vertex offset that is added to each index from the index buffer. By default 0.
+    std::int32_t    vertexOffset        = 0;
+
+    /**
+    \brief Zero-based index of the first instance data entry. By default 0.
+    \remarks This is used as \c firstInstance argument if the batcher has no instance buffer, i.e. DrawBatcherDescriptor::instanceDataSize is 0.
+    Otherwise, the first instance is determined by the location of the draw packet's instance data in the instance buffer.
+    */
+    std::uint32_t   instanceDataIndex   = 0;
+};
+
+/**
+\brief Draw batcher descriptor structure.
+\see DrawBatcher::DrawBatcher
+*/
+struct DrawBatcherDescriptor
+{
+    //! Number of threads that add draw packets concurrently. Each thread must use its own index in the range <code>[0, numThreads)</code>. By default 1.
+    std::uint32_t       numThreads          = 1;
+
+    //! Maximum number of draw packets per build. This determines the size of the indirect argument buffer. By default 0.
+    std::uint32_t       maxNumDraws         = 0;
+
+    /**
+    \brief Size (in bytes) of the per-instance data of each draw packet. By default 0.
+    \remarks If this is zero, no instance buffer is created and the draw packets do not provide any instance data.
+    */
+    std::uint32_t       instanceDataSize    = 0;
+
+    //! Maximum number of instances of all draw packets per build. This is ignored if \c instanceDataSize is zero. By default 0.
+    std::uint32_t       maxNumInstances     = 0;
+
+    /**
+    \brief Descriptor for the instance buffer.
+    \remarks The buffer size is determined by \c instanceDataSize and \c maxNumInstances.
+    If no binding flags are specified, BindFlags::VertexBuffer is used.
+    To read the instance data as vertex attributes, specify the attributes in \c vertexAttribs with an instance divisor of 1 and a stride of \c instanceDataSize.
+    \see BufferDescriptor::vertexAttribs
+    */
+    BufferDescriptor    instanceBufferDesc;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Helper class to batch thousands of indexed draw calls into the minimal number of multi-draw-indirect commands.
+\remarks Draw packets can be added by multiple threads concurrently. When all draw packets of a frame have been added,
+Build sorts them by their pipeline state and resource heap with a radix sort, writes the DrawIndexedIndirectArguments and instance data
+into GPU buffers, and merges all consecutive draw packets with the same states into a single batch. Execute then records one
+CommandBuffer::DrawIndexedIndirect command per batch. The vertex and index buffers are shared between all draw packets and must be bound before.
+\remarks The \c firstInstance argument of each draw command refers to the first entry of its instance data in the instance buffer,
+so the instance data can be read with per-instance vertex attributes (or \c gl_BaseInstance) regardless of the draw command's order.
+\code
+// Worker threads
+myDrawBatcher.AddDraw(threadIndex, myDrawPacket, &myInstanceData);
+
+// Render thread
+myDrawBatcher.Build();
+myCmdBuffer->SetVertexBufferArray(*myVertexBufferArray); // Mesh vertices and instance buffer
+myCmdBuffer->SetIndexBuffer(*myIndexBuffer);
+myDrawBatcher.Execute(*myCmdBuffer);
+myDrawBatcher.Reset();
+\endcode
+\see CommandBuffer::DrawIndexedIndirect(Buffer&, std::uint64_t, std::uint32_t, std::uint32_t)
+*/
+class LLGL_EXPORT DrawBatcher : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Creates the indirect argument buffer and the optional instance buffer.
+        \throws std::invalid_argument If \c numThreads or \c maxNumDraws is zero.
+        */
+        DrawBatcher(RenderSystem& renderSystem, const DrawBatcherDescriptor& desc);
+
+        //! Releases the GPU buffers.
+        ~DrawBatcher();
+
+        /**
+        \brief Adds the specified draw packet.
+        \param[in] threadIndex Specifies the index of the calling thread. Different threads must not use the same index concurrently.
+        \param[in] packet Specifies the draw packet.
+        \param[in] instanceData Optional pointer to the instance data of this draw packet.
+        If the batcher has an instance buffer, this must point to <code>packet.numInstances * instanceDataSize</code> bytes.
+        \throws std::out_of_range If \c threadIndex is out of range.
+        */
+        void AddDraw(std::uint32_t threadIndex, const DrawPacket& packet, const void* instanceData = nullptr);
+
+        /**
+        \brief Sorts all draw packets and writes their arguments and instance data into the GPU buffers.
+        \remarks This must not be called while other threads add draw packets.
+        \throws std::out_of_range If the number of draw packets or instances exceeds the capacity of the GPU buffers.
+        In that case, the GPU buffers and batches of the previous call remain unchanged.
+        */
+        void Build();
+
+        /**
+        \brief Records one multi-draw-indirect command per batch into the specified command buffer.
+        \remarks The pipeline state and resource heap are only set when they change between two batches.
+        */
+        void Execute(CommandBuffer& commandBuffer) const;
+
+        /**
+        \brief Records the same draw commands as Execute, but with one CommandBuffer::DrawIndexedInstanced command per draw packet.
+        \remarks This can be used to verify the batched draw path against the plain draw path.
+        */
+        void ExecuteDirect(CommandBuffer& commandBuffer) const;
+
+        //! Removes all draw packets and batches.
+        void Reset();
+
+        //! Returns the number of draw packets of the last build.
+        inline std::uint32_t GetNumDraws() const
+        {
+            return static_cast<std::uint32_t>(arguments_.size());
+        }
+
+        //! Returns the number of batches (i.e. multi-draw-indirect commands) of the last build.
+        inline std::uint32_t GetNumBatches() const
+        {
+            return static_cast<std::uint32_t>(batches_.size());
+        }
+
+        //! Returns the buffer with the DrawIndexedIndirectArguments of all draw packets.
+        inline Buffer* GetIndirectBuffer() const
+        {
+            return indirectBuffer_;
+        }
+
+        //! Returns the buffer with the instance data of all draw packets, or null if DrawBatcherDescriptor::instanceDataSize is zero.
+        inline Buffer* GetInstanceBuffer() const
+        {
+            return instanceBuffer_;
+        }
+
+    private:
+
+        struct PacketEntry
+        {
+            DrawPacket      packet;
+            std::uint32_t   threadIndex;
+            std::size_t     instanceDataOffset; // Offset into the thread's instance data, or ~0 if no instance data was provided
+        };
+
+        struct ThreadPackets
+        {
+            std::vector<PacketEntry>    entries;
+            std::vector<char>           instanceData;
+        };
+
+        struct Batch
+        {
+            PipelineState*  pipelineState;
+            ResourceHeap*   resourceHeap;
+            std::uint32_t   descriptorSet;
+            std::uint32_t   firstCommand;
+            std::uint32_t   numCommands;
+        };
+
+    private:
+
+        // Generates the sort key of each draw packet and returns the maximum key.
+        std::uint64_t GenerateSortKeys();
+
+        // Sorts the draw packet order by the sort keys with a radix sort.
+        void SortPackets(std::uint64_t maxKey);
+
+    private:
+
+        RenderSystem&                               renderSystem_;
+
+        Buffer*                                     indirectBuffer_     = nullptr;
+        Buffer*                                     instanceBuffer_     = nullptr;
+        std::uint32_t                               maxNumDraws_        = 0;
+        std::uint32_t                               maxNumInstances_    = 0;
+        std::uint32_t                               instanceDataSize_   = 0;
+
+        std::vector<ThreadPackets>                  threadPackets_;
+
+        std::vector<const PacketEntry*>             packets_;
+        std::vector<const PacketEntry*>             sortedPackets_;
+        std::vector<std::uint64_t>                  sortKeys_;
+        std::vector<std::uint64_t>                  sortedKeys_;
+
+        std::vector<DrawIndexedIndirectArguments>   arguments_;
+        std::vector<char>                           instanceData_;
+        std::vector<Batch>                          batches_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
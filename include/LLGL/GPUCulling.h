@@ -0,0 +1,320 @@
+/*
+ * GPUCulling.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GPU_CULLING_H
+#define LLGL_GPU_CULLING_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include "NonCopyable.h"
+#include "ForwardDecls.h"
+#include "BufferFlags.h"
+#include "RenderSystemFlags.h"
+#include "IndirectArguments.h"
+#include "Types.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\defgroup group_gpu_culling GPU-driven culling module with a compute shader and a CPU reference implementation.
+\addtogroup group_gpu_culling
+@{
+*/
+
+/* ----- Structures ----- */
+
+/**
+\brief Bounding volume of a single instance for GPU-driven culling.
+\remarks This structure is 32 bytes large and matches the \c std430 layout of the culling compute shader.
+\see GPUCulling::SetInstances
+*/
+struct GPUCullingInstance
+{
+    //! Center of the bounding sphere in world space.
+    float           center[3]   = { 0.0f, 0.0f, 0.0f };
+
+    //! Radius of the bounding sphere.
+    float           radius      = 0.0f;
+
+    //! Zero-based index into the list of meshes (see GPUCullingDescriptor::meshes) this instance is drawn with.
+    std::uint32_t   meshIndex   = 0;
+
+    //! Reserved for padding; must be zero.
+    std::uint32_t   reserved[3] = { 0, 0, 0 };
+};
+
+/**
+\brief Indexed geometry of a mesh that is drawn for all visible instances referencing it.
+\see GPUCullingDescriptor::meshes
+*/
+struct GPUCullingMesh
+{
+    //! Number of indices of this mesh.
+    std::uint32_t   numIndices      = 0;
+
+    //! Zero-based offset of the first index from the shared index buffer.
+    std::uint32_t   firstIndex      = 0;
+
+    //! Base vertex offset that is added to each index from the shared index buffer.
+    std::int32_t    vertexOffset    = 0;
+};
+
+/**
+\brief View parameters of a single culling pass.
+\remarks These parameters must be the same for the GPU culling pass and the CPU reference implementation to get the same results.
+\see GPUCulling::Dispatch
+\see CullInstancesCPU
+*/
+struct GPUCullingView
+{
+    //! View-projection matrix in column-major order, i.e. <code>clipPosition = viewProjection * float4(worldPosition, 1)</code>.
+    float           viewProjection[16]  = { 1.0f, 0.0f, 0.0f, 0.0f,
+                                            0.0f, 1.0f, 0.0f, 0.0f,
+                                            0.0f, 0.0f, 1.0f, 0.0f,
+                                            0.0f, 0.0f, 0.0f, 1.0f };
+
+    //! Clipping depth range of the projection matrix. This should be equal to RenderingCapabilities::clippingRange. By default ClippingRange::ZeroToOne.
+    ClippingRange   clippingRange       = ClippingRange::ZeroToOne;
+
+    //! Origin of the first texel of the hierarchical-Z pyramid. This should be equal to RenderingCapabilities::screenOrigin. By default ScreenOrigin::UpperLeft.
+    ScreenOrigin    hiZOrigin           = ScreenOrigin::UpperLeft;
+
+    //! Specifies whether to test the instances against the hierarchical-Z pyramid. This is ignored if no pyramid is specified. By default true.
+    bool            occlusionCulling    = true;
+};
+
+/**
+\brief Hierarchical-Z pyramid on the CPU, i.e. a MIP-map chain of a depth buffer where each texel holds the maximum depth of the texels it covers.
+\see BuildHiZPyramid
+\see CullInstancesCPU
+*/
+struct HiZPyramid
+{
+    //! Extent of each level. The first level has the extent of the depth buffer, the last one has an extent of 1x1.
+    std::vector<Extent2D>           extents;
+
+    //! Depth values of each level in row-major order.
+    std::vector<std::vector<float>> levels;
+};
+
+/**
+\brief GPU culling descriptor structure.
+\see GPUCulling::GPUCulling
+*/
+struct GPUCullingDescriptor
+{
+    /**
+    \brief List of all meshes. Each mesh results into one indirect draw command.
+    \remarks All meshes share the same vertex and index buffers.
+    */
+    std::vector<GPUCullingMesh> meshes;
+
+    //! Maximum number of instances. This determines the size of the instance buffers. By default 0.
+    std::uint32_t               maxNumInstances             = 0;
+
+    /**
+    \brief Optional hierarchical-Z pyramid texture for occlusion culling. By default null.
+    \remarks This must be a 2D texture with format Format::R32Float and a full MIP-map chain,
+    where each texel holds the maximum depth of the texels it covers in the previous MIP-map level (see BuildHiZPyramid).
+    Depth values are expected to be in the range [0, 1] with smaller values closer to the viewer.
+    */
+    Texture*                    hiZTexture                  = nullptr;
+
+    /**
+    \brief Optional compute shader that replaces the built-in GLSL compute shader. By default null.
+    \remarks This must be used for renderers that cannot compile GLSL code, e.g. with a SPIR-V module for Vulkan
+    that was compiled from the source returned by GPUCulling::GetShaderSource, such as with <code>glslangValidator -V -DENABLE_HIZ</code>.
+    The \c ENABLE_HIZ macro must be defined if and only if \c hiZTexture is specified.
+    This shader is not released by the GPUCulling instance.
+    */
+    Shader*                     computeShader               = nullptr;
+
+    /**
+    \brief Descriptor for the buffer of visible instance indices.
+    \remarks The buffer size is determined by \c maxNumInstances. The binding flag BindFlags::Storage is always added.
+    If no binding flags are specified, BindFlags::VertexBuffer is used.
+    Each entry is a 32-bit unsigned integer that refers to an index of the instances specified with GPUCulling::SetInstances.
+    To read these indices in the vertex shader, specify a vertex attribute with format Format::R32UInt and an instance divisor of 1.
+    \see BufferDescriptor::vertexAttribs
+    */
+    BufferDescriptor            visibleInstanceBufferDesc;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief GPU-driven frustum and occlusion culling pass.
+\remarks A compute shader tests the bounding sphere of each instance against the view frustum and the optional hierarchical-Z pyramid.
+For each mesh, the surviving instances are compacted into a contiguous range of the visible instance buffer,
+and the number of instances of the mesh's DrawIndexedIndirectArguments is incremented accordingly.
+The \c firstInstance argument of each draw command refers to the beginning of the mesh's range in the visible instance buffer.
+\code
+// Render thread
+myGPUCulling.Dispatch(*myCmdBuffer, myCullingView); // Must be outside of a render pass
+myCmdBuffer->BeginRenderPass(*myRenderTarget);
+{
+    myCmdBuffer->SetVertexBufferArray(*myVertexBufferArray); // Mesh vertices and visible instance buffer
+    myCmdBuffer->SetIndexBuffer(*myIndexBuffer);
+    myCmdBuffer->SetPipelineState(*myPipeline);
+    myGPUCulling.Draw(*myCmdBuffer);
+}
+myCmdBuffer->EndRenderPass();
+\endcode
+\see CullInstancesCPU
+*/
+class LLGL_EXPORT GPUCulling : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Creates the buffers and the compute pipeline of the culling pass.
+        \throws std::invalid_argument If \c meshes is empty or \c maxNumInstances is zero.
+        \throws std::runtime_error If the renderer does not support compute shaders or the built-in compute shader failed to compile.
+        */
+        GPUCulling(RenderSystem& renderSystem, const GPUCullingDescriptor& desc);
+
+        //! Releases all GPU resources.
+        ~GPUCulling();
+
+        /**
+        \brief Writes the specified instances into the instance buffer.
+        \remarks This also determines the range of each mesh within the visible instance buffer.
+        \throws std::out_of_range If \c numInstances exceeds GPUCullingDescriptor::maxNumInstances or an instance refers to an invalid mesh index.
+        */
+        void SetInstances(const GPUCullingInstance* instances, std::uint32_t numInstances);
+
+        /**
+        \brief Records the culling pass into the specified command buffer.
+        \remarks This resets the indirect arguments, updates the culling parameters, and dispatches the compute shader.
+        It must be recorded outside of a render pass.
+        \remarks Resource barriers are recorded between resetting the indirect arguments and the compute pass,
+        and after the compute pass, so the indirect arguments and visible instances can be used by the subsequent draw commands.
+        \see CommandBuffer::ResourceBarrier
+        */
+        void Dispatch(CommandBuffer& commandBuffer, const GPUCullingView& view);
+
+        //! Records one multi-draw-indirect command with one draw command per mesh into the specified command buffer.
+        void Draw(CommandBuffer& commandBuffer) const;
+
+        //! Returns the GLSL source of the built-in compute shader. Define \c ENABLE_HIZ to enable occlusion culling.
+        static const char* GetShaderSource();
+
+        //! Returns the buffer with the DrawIndexedIndirectArguments of all meshes. This buffer can also be used as source for copy commands.
+        inline Buffer* GetDrawArgsBuffer() const
+        {
+            return drawArgsBuffer_;
+        }
+
+        //! Returns the buffer with the indices of all visible instances.
+        inline Buffer* GetVisibleInstanceBuffer() const
+        {
+            return visibleInstanceBuffer_;
+        }
+
+        //! Returns the number of meshes, i.e. the number of indirect draw commands.
+        inline std::uint32_t GetNumMeshes() const
+        {
+            return static_cast<std::uint32_t>(meshes_.size());
+        }
+
+    private:
+
+        void CreateBuffers(const GPUCullingDescriptor& desc);
+        void CreateComputePipeline(const GPUCullingDescriptor& desc);
+
+    private:
+
+        RenderSystem&               renderSystem_;
+
+        std::vector<GPUCullingMesh> meshes_;
+        std::uint32_t               maxNumInstances_        = 0;
+        std::uint32_t               numInstances_           = 0;
+
+        Texture*                    hiZTexture_             = nullptr;
+        Extent2D                    hiZExtent_;
+        std::uint32_t               hiZNumLevels_           = 0;
+
+        Buffer*                     paramsBuffer_           = nullptr;
+        Buffer*                     instanceBuffer_         = nullptr;
+        Buffer*                     drawArgsBuffer_         = nullptr;
+        Buffer*                     drawArgsInitBuffer_     = nullptr;
+        Buffer*                     visibleInstanceBuffer_  = nullptr;
+        Sampler*                    hiZSampler_             = nullptr;
+
+        Shader*                     computeShader_          = nullptr;
+        bool                        ownsComputeShader_      = false;
+        ShaderProgram*              shaderProgram_          = nullptr;
+        PipelineLayout*             pipelineLayout_         = nullptr;
+        PipelineState*              pipelineState_          = nullptr;
+        ResourceHeap*               resourceHeap_           = nullptr;
+
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Builds a hierarchical-Z pyramid from the specified depth buffer.
+\param[in] depthData Pointer to <code>extent.width * extent.height</code> depth values in row-major order. This must not be null.
+\param[in] extent Specifies the extent of the depth buffer.
+\param[out] pyramid Specifies the output pyramid. Each texel of a level holds the maximum depth of all texels it covers in the previous level.
+\remarks The levels of the output pyramid can be uploaded into the MIP-maps of GPUCullingDescriptor::hiZTexture.
+*/
+LLGL_EXPORT void BuildHiZPyramid(const float* depthData, const Extent2D& extent, HiZPyramid& pyramid);
+
+/**
+\brief CPU reference implementation of the GPU culling pass.
+\param[in] view Specifies the view parameters. These should be the same as for GPUCulling::Dispatch.
+\param[in] meshes Specifies the list of meshes. This should be the same as GPUCullingDescriptor::meshes.
+\param[in] instances Pointer to the list of instances.
+\param[in] numInstances Specifies the number of instances.
+\param[in] hiZPyramid Optional pointer to the hierarchical-Z pyramid for occlusion culling.
+\param[out] drawArgs Specifies the output indirect arguments with one entry per mesh.
+\param[out] visibleInstances Specifies the output indices of all visible instances. This has the same layout as GPUCulling::GetVisibleInstanceBuffer,
+except that the GPU culling pass does not preserve the order of instances within the range of each mesh.
+\remarks This can be used as test oracle for the GPU culling pass, or as fallback if compute shaders are not supported.
+\throws std::out_of_range If an instance refers to an invalid mesh index.
+*/
+LLGL_EXPORT void CullInstancesCPU(
+    const GPUCullingView&                       view,
+    const std::vector<GPUCullingMesh>&          meshes,
+    const GPUCullingInstance*                   instances,
+    std::uint32_t                               numInstances,
+    const HiZPyramid*                           hiZPyramid,
+    std::vector<DrawIndexedIndirectArguments>&  drawArgs,
+    std::vector<std::uint32_t>&                 visibleInstances
+);
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#else
+
+#error LLGL was not compiled with LLGL_ENABLE_UTILITY option
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
@@ -19,10 +19,15 @@
 #include "ColorRGB.h"
 #include "ColorRGBA.h"
 #include "RenderSystem.h"
+#include "AsyncReadback.h"
+#include "DrawBatcher.h"
+#include "RenderGraph.h"
+#include "TextureContainer.h"
 #include "Log.h"
 #include "IndirectArguments.h"
 #include "ImageFlags.h"
 #include "VertexFormat.h"
+#include "VertexConversion.h"
 
 
 //DOXYGEN MAIN PAGE
@@ -13,6 +13,7 @@
 #include <functional>
 #include <string>
 #include <iostream>
+#include <initializer_list>
 
 
 namespace LLGL
@@ -78,6 +79,29 @@ using ReportCallback = std::function<void(ReportType type, const std::string& me
 */
 LLGL_EXPORT void PostReport(ReportType type, const std::string& message, const std::string& contextInfo = "");
 
+/**
+\brief Posts a report whose message is formatted only when the report is passed to the report callback.
+\param[in] type Specifies the type of the report message.
+\param[in] format Specifies the format string of the report message. Each occurrence of <code>"%s"</code> is replaced by the next argument,
+and <code>"%%"</code> is replaced by a single percent sign. This must point to a string with static storage duration (e.g. a string literal),
+since it is only read when the message is formatted.
+\param[in] args Specifies the arguments for the format string. Missing arguments are replaced by empty strings.
+\param[in] contextInfo Specifies a descriptive string about the context of the report. This may also be empty.
+\remarks While asynchronous reports are enabled, only the arguments are copied on the calling thread,
+and the message is formatted on the thread that drains the report queues.
+\code
+LLGL::Log::PostReportFormat(LLGL::Log::ReportType::Error, "failed to load extension: %s", { extensionName });
+\endcode
+\see PostReport
+\see EnableAsyncReports
+*/
+LLGL_EXPORT void PostReportFormat(
+    ReportType                          type,
+    const char*                         format,
+    std::initializer_list<const char*>  args,
+    const std::string&                  contextInfo = ""
+);
+
 /**
 \brief Sets the new report callback. No report callback is specified by default, in which case the reports are ignored.
 \param[in] callback Specifies the new report callback. This can also be null.
@@ -103,6 +127,36 @@ LLGL_EXPORT void SetReportCallbackStd(std::ostream& stream = std::cerr);
 */
 LLGL_EXPORT void SetReportLimit(std::size_t maxCount);
 
+/**
+\brief Enables asynchronous reports. By default disabled.
+\param[in] queueSize Specifies the maximum number of pending reports for each thread. By default 256.
+This only applies to threads that post their first asynchronous report after this call.
+\param[in] backgroundThread Specifies whether a background thread is spawned to drain the report queues periodically. By default true.
+If this is false, the pending reports are only passed to the report callback when FlushReports is called.
+\remarks While asynchronous reports are enabled, PostReport does not take any lock after the first report on each thread.
+Instead, each thread pushes its reports into its own report queue, and the report callback is invoked later from the background thread or FlushReports.
+When a thread exits, the remaining reports of its queue are passed to the report callback on that thread and the queue is released.
+If a report queue is full, further reports of that thread are dropped and a single warning with the number of dropped reports is posted on the next flush.
+Dropped reports are counted against the limit specified by SetReportLimit like any other report.
+\see DisableAsyncReports
+\see FlushReports
+*/
+LLGL_EXPORT void EnableAsyncReports(std::size_t queueSize = 256, bool backgroundThread = true);
+
+/**
+\brief Disables asynchronous reports, stops the background thread (if any), and flushes all pending reports.
+\see EnableAsyncReports
+*/
+LLGL_EXPORT void DisableAsyncReports();
+
+/**
+\brief Passes all pending reports of all threads to the report callback.
+\remarks This has no effect if asynchronous reports are disabled.
+The report callback is invoked without holding any internal lock, so it can post further reports or call this function itself.
+\see EnableAsyncReports
+*/
+LLGL_EXPORT void FlushReports();
+
 
 } // /namespace Log
 
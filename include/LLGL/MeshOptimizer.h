@@ -0,0 +1,268 @@
+/*
+ * MeshOptimizer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_MESH_OPTIMIZER_H
+#define LLGL_MESH_OPTIMIZER_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include "VertexFormat.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\defgroup group_mesh_optimizer Mesh optimization functions to reorder index and vertex buffers and to generate meshlets.
+\addtogroup group_mesh_optimizer
+@{
+*/
+
+/* ----- Structures ----- */
+
+/**
+\brief Source vertex buffer descriptor for the mesh optimization functions that need vertex positions.
+\remarks The vertex buffer must be interleaved, i.e. all attributes of \c format must refer to the same buffer with the stride returned by VertexFormat::GetStride.
+\see OptimizeOverdraw
+\see GenerateMeshlets
+*/
+struct SrcVertexDescriptor
+{
+    //! Pointer to the vertex format of the vertex buffer. This must not be null.
+    const VertexFormat* format          = nullptr;
+
+    //! Pointer to the vertex buffer data.
+    const void*         data            = nullptr;
+
+    //! Specifies the size (in bytes) of the vertex buffer. The number of vertices is <code>dataSize / format->GetStride()</code>.
+    std::size_t         dataSize        = 0;
+
+    /**
+    \brief Specifies the name of the position attribute. By default "position".
+    \remarks The attribute must have the format Format::RG32Float, Format::RGB32Float, or Format::RGBA32Float.
+    The Z coordinate of two-component positions is 0.
+    */
+    const char*         positionName    = "position";
+};
+
+/**
+\brief Post-transform vertex cache statistics of an index buffer.
+\see AnalyzeVertexCache
+*/
+struct VertexCacheStatistics
+{
+    //! Number of vertex shader invocations, i.e. the number of cache misses.
+    std::uint32_t   numTransformedVertices  = 0;
+
+    //! Average cache miss ratio (ACMR), i.e. the number of transformed vertices per triangle. This is in the range [0.5, 3], and lower is better.
+    float           acmr                    = 0.0f;
+
+    //! Average transform to vertex ratio (ATVR), i.e. the number of transformed vertices per vertex. The optimum is 1.
+    float           atvr                    = 0.0f;
+};
+
+/**
+\brief Vertex cache statistics before and after an index buffer has been reordered.
+\see OptimizeVertexCache
+\see OptimizeOverdraw
+*/
+struct MeshOptimizationReport
+{
+    //! Vertex cache statistics of the original index buffer.
+    VertexCacheStatistics before;
+
+    //! Vertex cache statistics of the reordered index buffer.
+    VertexCacheStatistics after;
+};
+
+/**
+\brief Range of vertices and triangles of a single meshlet.
+\see MeshletBuffer::meshlets
+*/
+struct Meshlet
+{
+    //! Zero-based offset of the first vertex of this meshlet into MeshletBuffer::vertices.
+    std::uint32_t   firstVertex     = 0;
+
+    //! Number of vertices of this meshlet.
+    std::uint32_t   numVertices     = 0;
+
+    //! Zero-based offset of the first triangle of this meshlet into MeshletBuffer::triangles. Each triangle takes three entries.
+    std::uint32_t   firstTriangle   = 0;
+
+    //! Number of triangles of this meshlet.
+    std::uint32_t   numTriangles    = 0;
+};
+
+/**
+\brief Bounding sphere and normal cone of a single meshlet for cluster culling.
+\remarks A meshlet can be culled as back facing if the following condition is true, where \c cameraPos is the camera position in the same space as the vertex positions:
+\code
+dot(center - cameraPos, coneAxis) >= coneCutoff * length(center - cameraPos) + radius
+\endcode
+\see MeshletBuffer::bounds
+*/
+struct MeshletBounds
+{
+    //! Center of the bounding sphere.
+    float   center[3]   = { 0.0f, 0.0f, 0.0f };
+
+    //! Radius of the bounding sphere.
+    float   radius      = 0.0f;
+
+    //! Normalized average normal of all triangles of the meshlet.
+    float   coneAxis[3] = { 0.0f, 0.0f, 1.0f };
+
+    //! Sine of the half-angle of the normal cone. This is 1 if the meshlet cannot be culled by its normal cone.
+    float   coneCutoff  = 1.0f;
+};
+
+/**
+\brief Meshlets that have been generated from an index buffer.
+\see GenerateMeshlets
+*/
+struct MeshletBuffer
+{
+    //! List of meshlets.
+    std::vector<Meshlet>        meshlets;
+
+    //! List of bounding volumes in the same order as \c meshlets.
+    std::vector<MeshletBounds>  bounds;
+
+    //! Indices into the original vertex buffer for all meshlets.
+    std::vector<std::uint32_t>  vertices;
+
+    //! Local vertex indices (relative to Meshlet::firstVertex) of all triangles. Each triangle takes three entries.
+    std::vector<std::uint8_t>   triangles;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Simulates a post-transform vertex cache with FIFO replacement for the specified triangle list.
+\param[in] indices Pointer to the 32-bit indices of the triangle list.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; remaining indices are ignored.
+\param[in] numVertices Specifies the number of vertices in the vertex buffer. Every index must be less than this value.
+\param[in] cacheSize Specifies the number of entries of the simulated vertex cache. By default 16.
+\throw std::invalid_argument If an index is out of range or \c cacheSize is zero.
+*/
+LLGL_EXPORT VertexCacheStatistics AnalyzeVertexCache(
+    const std::uint32_t*    indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize   = 16
+);
+
+/**
+\brief Reorders the triangles of the specified triangle list for post-transform vertex cache efficiency.
+\param[in,out] indices Pointer to the 32-bit indices of the triangle list that is reordered in place.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; remaining indices are not modified.
+\param[in] numVertices Specifies the number of vertices in the vertex buffer. Every index must be less than this value.
+\param[in] cacheSize Specifies the number of entries of the vertex cache to optimize for. By default 16.
+\return Vertex cache statistics before and after the triangles have been reordered, simulated with the same cache size.
+\remarks This uses the Tipsify algorithm by Sander et al., which runs in linear time.
+The vertices themselves are not reordered, which is what OptimizeVertexFetch is for.
+\throw std::invalid_argument If an index is out of range or \c cacheSize is zero.
+\see OptimizeOverdraw
+\see OptimizeVertexFetch
+*/
+LLGL_EXPORT MeshOptimizationReport OptimizeVertexCache(
+    std::uint32_t*          indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize   = 16
+);
+
+/**
+\brief Reorders clusters of triangles of the specified triangle list to approximately reduce overdraw.
+\param[in,out] indices Pointer to the 32-bit indices of the triangle list that is reordered in place.
+This should have been reordered by OptimizeVertexCache with the same cache size beforehand.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; remaining indices are not modified.
+\param[in] vertexDesc Specifies the vertex buffer with the vertex positions.
+\param[in] threshold Specifies how much the ACMR of a cluster may exceed the ACMR of the entire mesh. Higher values generate smaller clusters. By default 1.05.
+\param[in] cacheSize Specifies the number of entries of the vertex cache. By default 16.
+\return Vertex cache statistics before and after the clusters have been reordered.
+\remarks The index buffer is split into clusters at the vertex cache boundaries,
+and the clusters are sorted so that the ones facing away from the mesh center are drawn first, which are likely to occlude the others.
+This is the view-independent approximation by Sander et al. and retains the vertex cache efficiency within each cluster.
+\throw std::invalid_argument If an index is out of range, if \c cacheSize is zero, or if the position attribute is missing or has an unsupported format.
+\see OptimizeVertexCache
+*/
+LLGL_EXPORT MeshOptimizationReport OptimizeOverdraw(
+    std::uint32_t*              indices,
+    std::size_t                 numIndices,
+    const SrcVertexDescriptor&  vertexDesc,
+    float                       threshold   = 1.05f,
+    std::uint32_t               cacheSize   = 16
+);
+
+/**
+\brief Reorders the vertices of the specified vertex buffer in the order they are first referenced by the index buffer to improve vertex fetch locality.
+\param[in] vertexFormat Specifies the vertex format of the interleaved vertex buffer.
+\param[in,out] vertexData Pointer to the vertex buffer data that is reordered in place.
+\param[in] vertexDataSize Specifies the size (in bytes) of the vertex buffer.
+\param[in,out] indices Pointer to the 32-bit indices that are remapped in place to the reordered vertices.
+\param[in] numIndices Specifies the number of indices.
+\return Number of vertices that are referenced by the index buffer.
+Unreferenced vertices are moved behind this number of vertices, so the vertex buffer can be shrinked to this size.
+\remarks This should be called after the triangles have been reordered with OptimizeVertexCache and OptimizeOverdraw.
+\throw std::invalid_argument If an index is out of range or the stride of \c vertexFormat is zero.
+*/
+LLGL_EXPORT std::uint32_t OptimizeVertexFetch(
+    const VertexFormat&     vertexFormat,
+    void*                   vertexData,
+    std::size_t             vertexDataSize,
+    std::uint32_t*          indices,
+    std::size_t             numIndices
+);
+
+/**
+\brief Splits the specified triangle list into meshlets and generates their bounding volumes for cluster culling.
+\param[in] indices Pointer to the 32-bit indices of the triangle list.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3; remaining indices are ignored.
+\param[in] vertexDesc Specifies the vertex buffer with the vertex positions.
+\param[in] maxVertices Specifies the maximum number of vertices per meshlet. This must be in the range [3, 256]. By default 64.
+\param[in] maxTriangles Specifies the maximum number of triangles per meshlet. This must be greater than zero. By default 124.
+\remarks Triangles are assigned to meshlets in the order of the index buffer, so the index buffer should have been reordered by OptimizeVertexCache beforehand.
+\throw std::invalid_argument If an index is out of range, if the meshlet limits are out of range, or if the position attribute is missing or has an unsupported format.
+\see MeshletBounds
+*/
+LLGL_EXPORT MeshletBuffer GenerateMeshlets(
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    const SrcVertexDescriptor&  vertexDesc,
+    std::uint32_t               maxVertices     = 64,
+    std::uint32_t               maxTriangles    = 124
+);
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#else
+
+#error LLGL was not compiled with LLGL_ENABLE_UTILITY option
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
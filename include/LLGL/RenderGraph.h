@@ -0,0 +1,316 @@
+/*
+ * RenderGraph.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_RENDER_GRAPH_H
+#define LLGL_RENDER_GRAPH_H
+
+
+#include "NonCopyable.h"
+#include "ForwardDecls.h"
+#include "TextureFlags.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <iosfwd>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class RenderGraph;
+
+/* ----- Types ----- */
+
+/**
+\brief Handle of a virtual resource in a render graph. Zero is an invalid handle.
+\see RenderGraph::CreateTexture
+\see RenderGraph::ImportTexture
+*/
+using RenderGraphResource = std::uint32_t;
+
+/**
+\brief Callback function signature to record the commands of a render graph pass.
+\param[in] commandBuffer Specifies the command buffer the pass is recorded into.
+If the pass has any attachments, the render pass of these attachments has already begun.
+\param[in] renderGraph Specifies the render graph. Use RenderGraph::GetTexture to access the textures of the virtual resources.
+*/
+using RenderGraphPassCallback = std::function<void(CommandBuffer& commandBuffer, const RenderGraph& renderGraph)>;
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Usage state of a render graph resource.
+\see RenderGraphTransition
+*/
+enum class RenderGraphResourceState
+{
+    Undefined,              //!< Undefined state before the first usage in a frame.
+    ShaderResource,         //!< Resource is read by shaders.
+    ColorAttachment,        //!< Resource is written as color attachment.
+    DepthStencilAttachment, //!< Resource is written as depth-stencil attachment.
+    Storage,                //!< Resource is read and written as storage resource.
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Render graph pass descriptor structure.
+\remarks The order of passes is determined by their resource dependencies rather than the order they were added.
+A pass that reads a resource depends on the last pass that writes this resource and was added before it,
+or on the first pass that writes this resource and was added after it.
+\see RenderGraph::AddPass
+*/
+struct RenderGraphPassDescriptor
+{
+    //! Name of the pass for the schedule and debug groups.
+    std::string                         name;
+
+    //! Resources that are read by shaders in this pass.
+    std::vector<RenderGraphResource>    reads;
+
+    //! Resources that are written as color attachments in this pass, in the order of their attachment indices.
+    std::vector<RenderGraphResource>    colorAttachments;
+
+    //! Optional resource that is written as depth-stencil attachment in this pass. By default 0.
+    RenderGraphResource                 depthStencilAttachment  = 0;
+
+    //! Resources that are read and written as storage resources in this pass.
+    std::vector<RenderGraphResource>    storages;
+
+    /**
+    \brief Specifies whether this pass has side effects outside the render graph. By default false.
+    \remarks Passes without side effects are culled unless one of their outputs is used by another pass that is not culled.
+    Passes that write imported resources are never culled either. A pass that presents to a render context must have side effects.
+    */
+    bool                                hasSideEffects          = false;
+
+    //! Callback to record the commands of this pass. This is not called for culled passes.
+    RenderGraphPassCallback             execute;
+};
+
+/**
+\brief Resource state transition that is required before a pass.
+\remarks RenderGraph::Execute issues a resource barrier for the textures of all transitions from a previous state before the pass begins (see CommandBuffer::ResourceBarrier).
+Image layout transitions of attachments are still performed implicitly by render pass begin and end.
+The transitions are also listed by the schedule to examine the synchronization of a frame.
+\see RenderGraph::PrintSchedule
+*/
+struct RenderGraphTransition
+{
+    RenderGraphResource         resource    = 0;
+    RenderGraphResourceState    oldState    = RenderGraphResourceState::Undefined;
+    RenderGraphResourceState    newState    = RenderGraphResourceState::Undefined;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Frame graph that orders passes by their resource dependencies and aliases transient textures.
+\remarks Passes declare which virtual resources they read and write. Compile culls passes whose outputs are never used,
+sorts the remaining passes, determines the lifetime of each transient texture, and lets transient textures
+with the same descriptor and disjoint lifetimes share the same physical texture. Execute then records all passes
+in their scheduled order, issues the resource barriers of their transitions, and begins and ends the render pass of their attachments.
+\remarks The contents of a transient texture are undefined before its first write in a frame, since its memory might be shared with other transient textures.
+\remarks If the render graph is created without a render system, no GPU objects are created and the graph can only be compiled and printed (dry run).
+\code
+auto gBuffer = myRenderGraph.CreateTexture("GBuffer", myGBufferDesc);
+auto depth   = myRenderGraph.CreateTexture("Depth", myDepthDesc);
+auto hdr     = myRenderGraph.CreateTexture("HDR", myHDRDesc);
+
+LLGL::RenderGraphPassDescriptor geometryPass;
+{
+    geometryPass.name                   = "Geometry";
+    geometryPass.colorAttachments       = { gBuffer };
+    geometryPass.depthStencilAttachment = depth;
+    geometryPass.execute                = [&](LLGL::CommandBuffer& cmdBuffer, const LLGL::RenderGraph&) { ... };
+}
+myRenderGraph.AddPass(geometryPass);
+
+// Add lighting pass that reads "GBuffer" and writes "HDR", and final pass that reads "HDR" and presents ...
+
+myRenderGraph.Compile();
+myRenderGraph.PrintSchedule(std::cout);
+myRenderGraph.Execute(*myCmdBuffer);
+\endcode
+*/
+class LLGL_EXPORT RenderGraph : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Creates an empty render graph.
+        \param[in] renderSystem Optional pointer to the render system. If this is null, the render graph can only be used for dry runs.
+        */
+        RenderGraph(RenderSystem* renderSystem = nullptr);
+
+        //! Releases all physical textures and render targets.
+        ~RenderGraph();
+
+        /**
+        \brief Declares a transient texture that is created and aliased by the render graph.
+        \param[in] name Specifies the name of the resource for the schedule.
+        \param[in] textureDesc Specifies the descriptor of the physical texture.
+        The binding flags must include all usages of the passes, e.g. BindFlags::Sampled for reads and BindFlags::ColorAttachment for color attachments.
+        */
+        RenderGraphResource CreateTexture(const std::string& name, const TextureDescriptor& textureDesc);
+
+        /**
+        \brief Declares an external texture that is neither created nor aliased by the render graph.
+        \remarks Passes that write imported textures are never culled.
+        \remarks Render targets are cached by their attachments across compilations and resets,
+        so an imported texture must not be released while it is still attached to a pass of the last compilation.
+        */
+        RenderGraphResource ImportTexture(const std::string& name, Texture& texture);
+
+        /**
+        \brief Adds a new pass and returns its zero-based index.
+        \throws std::out_of_range If the descriptor refers to an invalid resource.
+        */
+        std::uint32_t AddPass(const RenderGraphPassDescriptor& passDesc);
+
+        /**
+        \brief Culls unused passes, sorts the remaining passes, computes resource lifetimes and transitions, and assigns the physical textures.
+        \remarks Physical textures of the previous compilation are reused if their descriptors match,
+        and render targets are reused if they have the same attachments.
+        \throws std::runtime_error If the passes have cyclic dependencies.
+        */
+        void Compile();
+
+        /**
+        \brief Records all scheduled passes into the specified command buffer.
+        \remarks Compile must have been called after the last pass was added.
+        \throws std::runtime_error If the render graph was created without a render system or has not been compiled.
+        */
+        void Execute(CommandBuffer& commandBuffer);
+
+        /**
+        \brief Removes all passes and resources, but keeps the physical textures and render targets to be reused by the next compilation.
+        \remarks This can be used to rebuild the render graph each frame.
+        */
+        void Reset();
+
+        /**
+        \brief Prints the schedule of the last compilation into the specified stream.
+        \remarks This includes the culled passes, the transitions before each pass, the lifetime and physical texture of each resource,
+        and the memory of transient textures with and without aliasing.
+        */
+        void PrintSchedule(std::ostream& stream) const;
+
+        /**
+        \brief Returns the physical texture of the specified resource, or null if the resource is invalid or has no physical texture.
+        \remarks Transient textures only have a physical texture after compilation and if they are used by a pass that is not culled.
+        */
+        Texture* GetTexture(RenderGraphResource resource) const;
+
+        //! Returns the indices of all passes in the order they are executed.
+        inline const std::vector<std::uint32_t>& GetSchedule() const
+        {
+            return schedule_;
+        }
+
+        //! Returns the size (in bytes) of all transient textures that are used by a pass that is not culled, as if they were not aliased.
+        inline std::uint64_t GetTransientMemory() const
+        {
+            return transientMemory_;
+        }
+
+        //! Returns the size (in bytes) of all physical textures that are created for transient textures.
+        inline std::uint64_t GetAliasedMemory() const
+        {
+            return aliasedMemory_;
+        }
+
+    private:
+
+        static const std::uint32_t invalidIndex = ~0u;
+
+        struct VirtualResource
+        {
+            std::string         name;
+            TextureDescriptor   textureDesc;
+            Texture*            importedTexture = nullptr;
+            std::uint32_t       physicalIndex   = invalidIndex;
+            std::uint32_t       firstUse        = invalidIndex;
+            std::uint32_t       lastUse         = invalidIndex;
+        };
+
+        struct Pass
+        {
+            RenderGraphPassDescriptor           desc;
+            bool                                culled          = false;
+            std::vector<std::uint32_t>          dependencies;   // Passes this pass depends on by its reads and writes
+            std::vector<std::uint32_t>          successors;     // Passes that must be executed after this pass
+            std::vector<RenderGraphTransition>  transitions;
+            RenderTarget*                       renderTarget    = nullptr; // Render target from the cache
+        };
+
+        struct PhysicalTexture
+        {
+            TextureDescriptor   textureDesc;
+            Texture*            texture     = nullptr;
+            std::uint32_t       lastUse     = invalidIndex;
+        };
+
+        struct CachedRenderTarget
+        {
+            std::vector<Texture*>   attachments;    // Color attachments followed by the optional depth-stencil attachment
+            RenderTarget*           renderTarget    = nullptr;
+            bool                    used            = false;
+        };
+
+    private:
+
+        void ValidateResource(RenderGraphResource resource) const;
+
+        void BuildDependencies();
+        void CullPasses();
+        void SortPasses();
+        void ComputeLifetimes();
+        void ComputeTransitions();
+        void AssignPhysicalTextures();
+        void CreateRenderTargets();
+
+        RenderTarget* CreateRenderTarget(const RenderGraphPassDescriptor& passDesc);
+
+        // Releases all cached render targets.
+        void ReleaseRenderTargets();
+
+        // Releases all cached render targets that refer to the specified texture.
+        void ReleaseRenderTargets(const Texture& texture);
+
+    private:
+
+        RenderSystem*                   renderSystem_       = nullptr;
+
+        std::vector<VirtualResource>    resources_;
+        std::vector<Pass>               passes_;
+        std::vector<std::uint32_t>      schedule_;
+        std::vector<PhysicalTexture>    physicalTextures_;
+        std::vector<PhysicalTexture>    texturePool_;       // Physical textures of the previous compilation
+        std::vector<CachedRenderTarget> renderTargetCache_;
+
+        std::uint64_t                   transientMemory_    = 0;
+        std::uint64_t                   aliasedMemory_      = 0;
+        bool                            compiled_           = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
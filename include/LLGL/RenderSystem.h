@@ -70,6 +70,10 @@ renderSystem->WriteBuffer(*buffer, modificationData, ...);
 // Release object
 renderSystem->Release(*buffer);
 \endcode
+\remarks With the Vulkan backend, the "Create..." and "Release" functions for resources (buffers, textures, samplers, shaders, pipeline states etc.)
+can be called from multiple threads concurrently, e.g. to stream resources from worker threads.
+This does not apply when the render system was loaded with a RenderingDebugger or RenderingProfiler.
+Other backends do not guarantee thread-safe resource creation.
 */
 class LLGL_EXPORT RenderSystem : public Interface
 {
@@ -199,6 +203,16 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Returns the single instance of the command queue.
         virtual CommandQueue* GetCommandQueue() = 0;
 
+        /**
+        \brief Returns the command queue of the specified type.
+        \remarks If the rendering API or the device does not provide a dedicated queue for the specified type,
+        this function returns the same command queue as GetCommandQueue().
+        Dedicated queues can run in parallel to the graphics queue. Use CommandQueue::Signal and CommandQueue::Wait to synchronize them.
+        \note Only supported with: Vulkan.
+        \see CommandBufferDescriptor::queueType
+        */
+        virtual CommandQueue* GetCommandQueueOfType(const CommandQueueType type);
+
         /* ----- Command buffers ----- */
 
         /**
@@ -265,7 +279,11 @@ class LLGL_EXPORT RenderSystem : public Interface
         \param[in] buffer Specifies the buffer which is to be mapped.
         \param[in] access Specifies the CPU buffer access requirement, i.e. if the CPU can read and/or write the mapped memory.
         \return Raw pointer to the mapped memory block. You should be aware of the storage buffer size, to not cause memory violations.
+        \remarks Readback buffers, i.e. buffers with CPUAccessFlags::Read and no other binding flags than BindFlags::CopySrc and BindFlags::CopyDst,
+        might be allocated in host visible memory. Mapping such a buffer does not synchronize with the GPU on all backends (e.g. Vulkan),
+        so the client must wait for a fence that was submitted after the commands which write into that buffer.
         \see UnmapBuffer
+        \see AsyncReadback
         */
         virtual void* MapBuffer(Buffer& buffer, const CPUAccess access) = 0;
 
@@ -334,6 +352,55 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) = 0;
 
+        /**
+        \brief Reserves staging memory for a streaming texture upload.
+        \param[in] size Specifies the size (in bytes) of the image data that is to be uploaded.
+        \return Reserved staging range. Its \c data member is null if streaming texture uploads are not supported or there is currently not enough free staging memory.
+        In the latter case, the staging memory of completed uploads is recycled by the next call to FlushTextureUploads. Alternatively, use WriteTexture instead.
+        \remarks This function does not issue any commands to the rendering API and can be called from any thread, e.g. from the worker threads of a texture streamer.
+        The caller writes the image data into the staging memory, including any CPU side conversion (e.g. with ConvertImageBuffer), and then commits the range with CommitTextureUpload.
+        Each reserved range \b must be committed, otherwise its staging memory is never recycled.
+        \code
+        // Worker thread: convert the image directly into the staging memory
+        auto myRange = myRenderSystem->ReserveTextureUpload(myDstImageDesc.dataSize);
+        if (myRange.data != nullptr)
+        {
+            myDstImageDesc.data = myRange.data;
+            LLGL::ConvertImageBuffer(mySrcImageDesc, myDstImageDesc);
+            myRenderSystem->CommitTextureUpload(myRange, *myTexture, myTexRegion, myDstImageDesc.format, myDstImageDesc.dataType);
+        }
+
+        // Rendering thread: issue all committed uploads
+        myRenderSystem->FlushTextureUploads();
+        \endcode
+        \note Only supported with: OpenGL (if RendererConfigurationOpenGL::streamingBufferSize is not zero).
+        \see CommitTextureUpload
+        \see FlushTextureUploads
+        */
+        virtual TextureUploadRange ReserveTextureUpload(std::uint64_t size);
+
+        /**
+        \brief Commits a streaming texture upload whose image data has been written into the specified staging range.
+        \param[in] range Specifies the staging range that was returned by ReserveTextureUpload. Its staging memory must no longer be written after this call.
+        \param[in] texture Specifies the destination texture. This texture must not be released before the upload has been issued by FlushTextureUploads.
+        \param[in] textureRegion Specifies the destination texture region. The field TextureRegion::numMipLevels \b must be 1.
+        \param[in] format Specifies the image format of the data in the staging range.
+        \param[in] dataType Specifies the data type of the data in the staging range.
+        \remarks This function does not issue any commands to the rendering API and can be called from any thread.
+        The upload itself is issued by the next call to FlushTextureUploads.
+        \see FlushTextureUploads
+        */
+        virtual void CommitTextureUpload(const TextureUploadRange& range, Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType);
+
+        /**
+        \brief Issues all texture uploads that have been committed since the last call, and recycles the staging memory of all uploads the GPU has completed.
+        \remarks This must be called on the thread that issues the commands to the rendering API, e.g. once per frame before the command buffers are submitted.
+        Each committed upload is issued as a single upload command from the staging memory (i.e. \c glTexSubImage* from a pixel-unpack buffer offset).
+        This function never waits for the GPU.
+        \see CommitTextureUpload
+        */
+        virtual void FlushTextureUploads();
+
         /* ----- Samplers ---- */
 
         /**
@@ -346,6 +413,13 @@ class LLGL_EXPORT RenderSystem : public Interface
         //! Releases the specified Sampler object. After this call, the specified object must no longer be used.
         virtual void Release(Sampler& sampler) = 0;
 
+        /**
+        \brief Returns the statistics of the sampler cache.
+        \remarks The statistics only include the samplers that have been created while RenderSystemConfiguration::samplerCache was enabled.
+        \see RenderSystemConfiguration::samplerCache
+        */
+        virtual SamplerCacheStatistics GetSamplerCacheStatistics() const;
+
         /* ----- Resource Heaps ----- */
 
         /**
@@ -201,7 +201,31 @@ struct RenderSystemConfiguration
     to convert the image data into the respective hardware texture format. OpenGL does this automatically.
     \see Constants::maxThreadCount
     */
-    std::size_t threadCount = Constants::maxThreadCount;
+    std::size_t threadCount     = Constants::maxThreadCount;
+
+    /**
+    \brief Specifies whether samplers with identical descriptors are shared. By default false.
+    \remarks If this is true, RenderSystem::CreateSampler returns the same Sampler object for all descriptors that are equal in every member
+    and only creates a new native sampler for a descriptor that is not in use yet. Each shared sampler is reference counted,
+    i.e. RenderSystem::Release must still be called once for each call to RenderSystem::CreateSampler and the native sampler is destroyed with the last release.
+    This keeps the number of native samplers low, which is limited by some drivers (see \c maxSamplerAllocationCount in Vulkan).
+    \remarks Shared samplers must not be modified, e.g. with GLSampler::SetDesc.
+    \see RenderSystem::GetSamplerCacheStatistics
+    */
+    bool        samplerCache    = false;
+};
+
+/**
+\brief Sampler cache statistics structure.
+\see RenderSystem::GetSamplerCacheStatistics
+*/
+struct SamplerCacheStatistics
+{
+    //! Number of samplers that have been requested with RenderSystem::CreateSampler and not released yet.
+    std::uint32_t numRequestedSamplers  = 0;
+
+    //! Number of native samplers that are shared by the requested samplers.
+    std::uint32_t numUniqueSamplers     = 0;
 };
 
 /**
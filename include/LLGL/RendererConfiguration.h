@@ -11,6 +11,7 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <cstdint>
 
 
@@ -18,6 +19,9 @@ namespace LLGL
 {
 
 
+class Blob;
+
+
 /* ----- Enumerations ----- */
 
 /**
@@ -40,6 +44,36 @@ enum class OpenGLContextProfile
 };
 
 
+/* ----- Interfaces ----- */
+
+/**
+\brief Interface for a user-supplied store of OpenGL program binaries.
+\remarks Implement this interface to keep the program binaries in a custom location, e.g. an archive or a shared network cache.
+\see RendererConfigurationOpenGL::programBinaryStore
+*/
+class OpenGLProgramBinaryStore
+{
+
+    public:
+
+        virtual ~OpenGLProgramBinaryStore() = default;
+
+        /**
+        \brief Returns the program binary that was previously stored with the specified key, or null if there is no such entry.
+        \param[in] key Specifies the unique key of the program binary. This is a string of hexadecimal digits and can be used as filename.
+        */
+        virtual std::unique_ptr<Blob> LoadProgramBinary(const std::string& key) = 0;
+
+        /**
+        \brief Stores the specified program binary with the specified key.
+        \param[in] key Specifies the unique key of the program binary. This is a string of hexadecimal digits and can be used as filename.
+        \param[in] binary Specifies the opaque program binary. Entries with the same key shall be overwritten.
+        */
+        virtual void StoreProgramBinary(const std::string& key, const Blob& binary) = 0;
+
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -107,21 +141,97 @@ struct RendererConfigurationVulkan
 struct RendererConfigurationOpenGL
 {
     //! Specifies the requested OpenGL context profile. By default OpenGLContextProfile::CoreProfile.
-    OpenGLContextProfile    contextProfile  = OpenGLContextProfile::CoreProfile;
+    OpenGLContextProfile        contextProfile      = OpenGLContextProfile::CoreProfile;
 
     /**
     \brief Specifies the requested OpenGL context major version. By default 0.
     \remarks If both \c majorVersion and \c minorVersion are 0, the highest OpenGL version that is available on the host system will be choosen.
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
-    int                     majorVersion    = 0;
+    int                         majorVersion        = 0;
 
     /**
     \brief Specifies the requested OpenGL context minor version. By default 0.
     \remarks If both \c majorVersion and \c minorVersion are 0, the highest OpenGL version that is available on the host system will be choosen.
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
-    int                     minorVersion    = 0;
+    int                         minorVersion        = 0;
+
+    /**
+    \brief Specifies an optional directory for the OpenGL program binary cache. By default empty.
+    \remarks If this is not empty, each linked shader program is stored in this directory (via \c glGetProgramBinary)
+    and loaded again on the next run (via \c glProgramBinary) instead of compiling and linking all of its shaders.
+    The entries are keyed by a hash of all attached shader sources, macros, vertex and fragment attribute bindings,
+    and the renderer and driver version. Hence, a program is recompiled transparently whenever any of these change.
+    The directory must already exist.
+    \remarks This is ignored if \c programBinaryStore is not null or if \c GL_ARB_get_program_binary is not supported.
+    \see programBinaryStore
+    */
+    std::string                 programBinaryCacheDir;
+
+    /**
+    \brief Optional user-supplied store for the OpenGL program binary cache. By default null.
+    \remarks If this is not null, this store is used instead of \c programBinaryCacheDir.
+    It must remain valid for the lifetime of the render system.
+    \see programBinaryCacheDir
+    */
+    OpenGLProgramBinaryStore*   programBinaryStore  = nullptr;
+
+    /**
+    \brief Specifies the size (in bytes) of the ring buffer for streaming texture uploads. By default 0.
+    \remarks If this is not zero, a persistently mapped pixel-unpack buffer is used as ring buffer for the staging memory of RenderSystem::ReserveTextureUpload.
+    Worker threads can write (and convert) image data directly into that memory, so the rendering thread only issues a single \c glTexSubImage* call from the buffer offset for each upload.
+    RenderSystem::WriteTexture also copies its image data into this ring buffer, so the driver does not copy the client memory synchronously.
+    Regions of this ring buffer are recycled with sync objects. Image data that is larger than the free space of this ring buffer is uploaded directly from client memory by RenderSystem::WriteTexture.
+    A common value for texture streaming is 16 MB, i.e. <code>(16 * 1024 * 1024)</code>.
+    \remarks This is ignored if \c GL_ARB_buffer_storage or \c GL_ARB_sync is not supported.
+    */
+    std::uint64_t               streamingBufferSize = 0;
+
+    /**
+    \brief Specifies whether resource heaps bind their textures as bindless texture handles. By default false.
+    \remarks If this is true, each resource heap makes the handles of its sampled textures resident (via \c glGetTextureSamplerHandleARB)
+    and stores them in a shader storage buffer, which is bound to the binding slot \c bindlessTextureSlot instead of binding each texture and sampler to a texture unit.
+    Each texture is combined with the sampler at the same binding slot. The handles of each descriptor set are stored as an array
+    of 64-bit handles that is indexed by the texture binding slots, i.e. a shader accesses the texture at binding slot \c N as follows:
+    \code
+    #extension GL_ARB_bindless_texture : enable
+    layout(std430, binding = 0) readonly buffer BindlessTextures { sampler2D textures[]; };
+    // ...
+    vec4 color = texture(textures[N], texCoord);
+    \endcode
+    \remarks This is ignored if \c GL_ARB_bindless_texture or \c GL_ARB_shader_storage_buffer_object is not supported.
+    \see bindlessTextureSlot
+    */
+    bool                        bindlessTextures    = false;
+
+    /**
+    \brief Specifies the binding slot of the shader storage buffer for bindless texture handles. By default 0.
+    \remarks This slot must not be used by any other storage buffer in the pipeline layout.
+    \see bindlessTextures
+    */
+    std::uint32_t               bindlessTextureSlot = 0;
+
+    /**
+    \brief Specifies whether all OpenGL commands are executed by a dedicated submission thread. By default false.
+    \remarks If this is true, the OpenGL context of the first render context is handed over to a dedicated thread after the render context has been created.
+    All functions of the render system, the command queue, and the render context are then encoded as tasks and executed by this thread in the order they were called,
+    so they can be called from any thread. Command buffers are always created as deferred command buffers (i.e. GLDeferredCommandBuffer),
+    which can be recorded on any thread. CommandQueue::Submit only enqueues the command buffer and returns immediately,
+    while functions that return a result (e.g. RenderSystem::CreateBuffer, CommandQueue::WaitFence, and CommandQueue::WaitIdle) block until the submission thread has executed them.
+    RenderContext::Present returns as soon as the previous frame has been presented.
+    \remarks Creating and releasing objects is not encoded as a deferred task: functions such as RenderSystem::CreateTexture and RenderSystem::Release
+    block the calling thread until the submission thread has executed all previously enqueued tasks, including pending command buffer submissions.
+    Hence, objects should be created up front rather than while command buffers are recorded and submitted each frame.
+    \remarks A command buffer must not be recorded again while a previous submission of that command buffer is still pending; CommandBuffer::Begin waits until all of them have been executed.
+    \remarks Only a single render context is supported in this mode.
+    Functions of individual objects that query the OpenGL state are only dispatched to the submission thread for shaders and shader programs
+    (e.g. Shader::HasErrors and ShaderProgram::FindUniformLocation), all others (e.g. Texture::GetDesc) must not be used in this mode.
+    \remarks AsyncReadback can be used in this mode, because it only calls functions of the render system and the command queue,
+    which are dispatched to the submission thread, and Texture::GetMemoryFootprint(const Extent3D&, const TextureSubresource&) const, which does not query the OpenGL state.
+    An AsyncReadback object itself must still be used by one thread at a time.
+    */
+    bool                        threadedSubmission  = false;
 };
 
 /**
@@ -12,6 +12,8 @@
 #include "Export.h"
 #include <map>
 #include <string>
+#include <atomic>
+#include <cstdint>
 
 
 namespace LLGL
@@ -36,6 +38,19 @@ enum class WarningType
     VaryingBehavior,    //!< Warning due to a varying behavior between the native APIs (e.g. \c SV_VertexID in HLSL behaves different to \c gl_VertexID in GLSL or \c gl_VertexIndex in SPIRV).
 };
 
+/**
+\brief Rendering debugger validation level enumeration.
+\remarks Cheap structural checks (such as matching CommandBuffer::Begin/ CommandBuffer::End and CommandBuffer::BeginRenderPass/ CommandBuffer::EndRenderPass pairs)
+are always performed, regardless of the validation level.
+\see RenderingDebugger::SetValidationLevel
+*/
+enum class ValidationLevel
+{
+    Full,       //!< All commands of all command buffer encodings are validated. This is the default value.
+    Sampled,    //!< All commands are validated only for a sample of command buffer encodings, e.g. for soak tests where the full validation is too slow.
+    Minimal,    //!< Only cheap structural checks are performed for command buffers.
+};
+
 
 /**
 \brief Rendering debugger interface.
@@ -46,8 +61,15 @@ class LLGL_EXPORT RenderingDebugger
 
     public:
 
+        RenderingDebugger() = default;
         virtual ~RenderingDebugger() = default;
 
+        //! Copies all messages and validation settings, including the current value of the validation sample counter.
+        RenderingDebugger(const RenderingDebugger& rhs);
+
+        //! Copies all messages and validation settings, including the current value of the validation sample counter.
+        RenderingDebugger& operator = (const RenderingDebugger& rhs);
+
         /**
         \brief Sets the new source function name.
         \param[in] source Pointer to a null terminated string that specifies the name. If this is null, the source is disabled.
@@ -76,6 +98,33 @@ class LLGL_EXPORT RenderingDebugger
         */
         void PostWarning(const WarningType type, const std::string& message);
 
+        /**
+        \brief Sets the validation level for command buffers.
+        \param[in] level Specifies the new validation level. By default ValidationLevel::Full.
+        \param[in] sampleInterval Specifies the interval N for the ValidationLevel::Sampled level, i.e. every N-th command buffer encoding is fully validated.
+        If this is zero, the value is clamped to 1. By default 1.
+        \param[in] randomSampling Specifies whether the command buffer encodings are sampled pseudo-randomly with a probability of 1/N instead of every N-th encoding.
+        This avoids that a frame-periodic error is always or never detected. By default false.
+        \remarks Validation is sampled per command buffer encoding (i.e. from CommandBuffer::Begin to CommandBuffer::End) rather than per command,
+        because the debug layer must track all bindings of an encoding to validate a draw or dispatch command.
+        Resource creation is always validated, since it is not part of the per-frame workload.
+        \see ValidationLevel
+        */
+        void SetValidationLevel(const ValidationLevel level, std::uint32_t sampleInterval = 1, bool randomSampling = false);
+
+        //! Returns the current validation level. By default ValidationLevel::Full.
+        inline ValidationLevel GetValidationLevel() const
+        {
+            return level_;
+        }
+
+        /**
+        \brief Returns true if the next command buffer encoding is to be fully validated according to the current validation level.
+        \remarks This is called by the debug layer once per command buffer encoding and can be called from multiple threads.
+        \see SetValidationLevel
+        */
+        bool SampleValidation();
+
     protected:
 
         /**
@@ -185,8 +234,13 @@ class LLGL_EXPORT RenderingDebugger
 
         std::map<std::string, Message>  errors_;
         std::map<std::string, Message>  warnings_;
-        const char*                     source_     = "";
-        const char*                     groupName_  = "";
+        const char*                     source_         = "";
+        const char*                     groupName_      = "";
+
+        ValidationLevel                 level_          = ValidationLevel::Full;
+        std::uint32_t                   sampleInterval_ = 1;
+        bool                            randomSampling_ = false;
+        std::atomic<std::uint32_t>      sampleCounter_  { 0 };
 
 };
 
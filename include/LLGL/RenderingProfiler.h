@@ -14,6 +14,9 @@
 #include "PipelineStateFlags.h"
 #include <cstdint>
 #include <algorithm>
+#include <vector>
+#include <memory>
+#include <iosfwd>
 
 
 namespace LLGL
@@ -26,11 +29,26 @@ namespace LLGL
 */
 struct ProfileTimeRecord
 {
-    //! Time record annotation, e.g. function name that was recorded from the CommandBuffer.
+    /**
+    \brief Time record annotation, e.g. function name that was recorded from the CommandBuffer.
+    \remarks Annotations of debug groups are owned by the command buffer that recorded them and remain valid until that command buffer is released.
+    The trace of the RenderingProfiler stores its own copies of these annotations.
+    */
     const char*     annotation  = "";
 
-    //! Elapsed time (in nanoseconds) to execute the respective command.
+    /**
+    \brief Elapsed time (in nanoseconds) to execute the respective command.
+    \remarks For records of debug groups (see CommandBuffer::PushDebugGroup), this includes the elapsed time of all nested records.
+    */
     std::uint64_t   elapsedTime = 0;
+
+    /**
+    \brief Start time (in nanoseconds) of the respective command on the profiler's timeline.
+    \remarks Since the timer queries only measure the elapsed time on the GPU, the records of a command buffer are laid out
+    consecutively, starting at the time the command buffer encoding ended. Idle time of the GPU is therefore not included.
+    \see RenderingProfiler::GetTimestamp
+    */
+    std::uint64_t   startTime   = 0;
 };
 
 /**
@@ -293,6 +311,21 @@ class LLGL_EXPORT RenderingProfiler
 
     public:
 
+        RenderingProfiler();
+        ~RenderingProfiler();
+
+        /**
+        \brief Copies the frame profile, the recording settings, and all recorded trace scopes.
+        \remarks This must not be called while other threads are recording trace scopes into the source profiler.
+        */
+        RenderingProfiler(const RenderingProfiler& rhs);
+
+        /**
+        \brief Copies the frame profile, the recording settings, and all recorded trace scopes.
+        \remarks This must not be called while other threads are recording trace scopes into either profiler.
+        */
+        RenderingProfiler& operator = (const RenderingProfiler& rhs);
+
         /**
         \brief Returns the current frame profile and resets the counters for the next frame.
         \param[out] outputProfile Optional pointer to an output profile to retrieve the current values. By default null.
@@ -306,6 +339,37 @@ class LLGL_EXPORT RenderingProfiler
         */
         void Accumulate(const FrameProfile& profile);
 
+        /**
+        \brief Records a CPU-side time scope for the trace of this profiler.
+        \param[in] annotation Pointer to a null terminated string that specifies the name of the scope.
+        Only the pointer is stored, so it must remain valid until the trace is written or cleared.
+        \param[in] startTime Specifies the start time (in nanoseconds) of the scope. This should be a value returned by GetTimestamp.
+        \param[in] elapsedTime Specifies the elapsed time (in nanoseconds) of the scope.
+        \remarks This function can be called on multiple threads. Each thread records into its own event buffer,
+        so only the first call on each thread is synchronized. This function has no effect if \c traceRecordingEnabled is false.
+        \see traceRecordingEnabled
+        \see WriteTrace
+        */
+        void RecordTraceScope(const char* annotation, std::uint64_t startTime, std::uint64_t elapsedTime);
+
+        /**
+        \brief Writes all recorded CPU and GPU time scopes in the Chrome trace event format (JSON) to the specified output stream.
+        \remarks The output can be loaded with \c chrome://tracing or the Perfetto UI (https://ui.perfetto.dev).
+        The GPU time scopes are written to a separate track named "GPU", and the CPU time scopes to one track per thread.
+        \remarks This must not be called while other threads are recording trace scopes.
+        \see RecordTraceScope
+        */
+        void WriteTrace(std::ostream& stream) const;
+
+        /**
+        \brief Clears all recorded trace scopes.
+        \remarks This must not be called while other threads are recording trace scopes.
+        */
+        void ClearTrace();
+
+        //! Returns the current time (in nanoseconds) of the monotonic clock that is used for the trace timeline.
+        static std::uint64_t GetTimestamp();
+
     public:
 
         //! Current frame profile with all counter values.
@@ -313,10 +377,27 @@ class LLGL_EXPORT RenderingProfiler
 
         /**
         \brief Specifis whether the command buffer time recording is enabled or disabled. By default disabled.
+        \remarks Time records are resolved without waiting for the GPU, i.e. they are accumulated into the frame profile
+        with a latency of usually two or three command buffer encodings. Each debug group (see CommandBuffer::PushDebugGroup)
+        is recorded as a scope that encloses the time records of all its nested commands.
         \see FrameProfile::timeRecords
         */
         bool            timeRecordingEnabled    = false;
 
+        /**
+        \brief Specifies whether trace recording is enabled or disabled. By default disabled.
+        \remarks If enabled, the debug layer records CPU-side time scopes for command buffer encoding, command buffer submission,
+        presentation, and resource creation. If \c timeRecordingEnabled is enabled, too, the GPU time records are added to the trace as well.
+        \see WriteTrace
+        */
+        bool            traceRecordingEnabled   = false;
+
+    private:
+
+        class TraceRecorder;
+
+        std::unique_ptr<TraceRecorder> traceRecorder_;
+
 };
 
 
@@ -14,6 +14,7 @@
 #include "FragmentAttribute.h"
 #include "Types.h"
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 
@@ -51,6 +52,20 @@ enum class ShaderSourceType
     BinaryFile,     //!< Refers to <code>sourceSize+1</code> bytes, describing the filename of the shader binary code (including null terminator).
 };
 
+/**
+\brief Data type enumeration of shader specialization constants.
+\remarks All specialization constants are 32-bit values.
+The boolean type is called "Boolean" instead of "Bool", because "Bool" is a reserved identifier for an Xlib macro on GNU/Linux.
+\see SpecializationConstant::type
+*/
+enum class SpecializationConstantType
+{
+    Boolean,    //!< Boolean type. The value is stored as 0 (false) or 1 (true) in SpecializationConstant::u32.
+    Int32,      //!< 32-bit signed integral type. The value is stored in SpecializationConstant::i32.
+    UInt32,     //!< 32-bit unsigned integral type. The value is stored in SpecializationConstant::u32.
+    Float32,    //!< 32-bit floating-point type. The value is stored in SpecializationConstant::f32.
+};
+
 
 /* ----- Flags ----- */
 
@@ -135,6 +150,67 @@ struct ShaderMacro
     const char* definition  = nullptr;
 };
 
+/**
+\brief Shader specialization constant structure.
+\remarks Specialization constants are declared in the shader with a constant ID, e.g. <code>layout(constant_id = 0) const bool ENABLE_FOG = false;</code> in GLSL.
+Their values are applied when the shader is specialized for a pipeline, so the driver can eliminate all code paths that depend on them
+and a single shader module can provide multiple shader permutations.
+\see ShaderDescriptor::specializationConstants
+\see ShaderReflection::specializationConstants
+*/
+struct SpecializationConstant
+{
+    SpecializationConstant() = default;
+    SpecializationConstant(const SpecializationConstant&) = default;
+    SpecializationConstant& operator = (const SpecializationConstant&) = default;
+
+    //! Constructor to initialize a boolean specialization constant.
+    inline SpecializationConstant(std::uint32_t constantID, bool value) :
+        constantID { constantID                          },
+        type       { SpecializationConstantType::Boolean }
+    {
+        u32 = (value ? 1u : 0u);
+    }
+
+    //! Constructor to initialize a 32-bit signed integral specialization constant.
+    inline SpecializationConstant(std::uint32_t constantID, std::int32_t value) :
+        constantID { constantID                          },
+        type       { SpecializationConstantType::Int32   }
+    {
+        i32 = value;
+    }
+
+    //! Constructor to initialize a 32-bit unsigned integral specialization constant.
+    inline SpecializationConstant(std::uint32_t constantID, std::uint32_t value) :
+        constantID { constantID                          },
+        type       { SpecializationConstantType::UInt32  }
+    {
+        u32 = value;
+    }
+
+    //! Constructor to initialize a 32-bit floating-point specialization constant.
+    inline SpecializationConstant(std::uint32_t constantID, float value) :
+        constantID { constantID                          },
+        type       { SpecializationConstantType::Float32 }
+    {
+        f32 = value;
+    }
+
+    //! Specifies the constant ID of the specialization constant, i.e. \c constant_id in GLSL or the \c SpecId decoration in SPIR-V. By default 0.
+    std::uint32_t               constantID  = 0;
+
+    //! Specifies the data type of the specialization constant. By default SpecializationConstantType::UInt32.
+    SpecializationConstantType  type        = SpecializationConstantType::UInt32;
+
+    //! Specifies the 32-bit value of the specialization constant. The member that is used depends on the \c type member.
+    union
+    {
+        std::uint32_t           u32         = 0;
+        std::int32_t            i32;
+        float                   f32;
+    };
+};
+
 /**
 \brief Vertex (or geometry) shader specific structure.
 \see ShaderDescriptor::vertex
@@ -224,7 +300,7 @@ struct ShaderDescriptor
     }
 
     //! Specifies the type of the shader, i.e. if it is either a vertex or fragment shader or the like. By default ShaderType::Undefined.
-    ShaderType                  type            = ShaderType::Undefined;
+    ShaderType                          type            = ShaderType::Undefined;
 
     /**
     \brief Pointer to the shader source. This is either a null terminated string or a raw byte buffer (depending on the \c sourceType member).
@@ -233,7 +309,7 @@ struct ShaderDescriptor
     \see sourceSize
     \see sourceType
     */
-    const char*                 source          = nullptr;
+    const char*                         source          = nullptr;
 
     /**
     \brief Specifies the size of the shader source (excluding the null terminator).
@@ -241,7 +317,7 @@ struct ShaderDescriptor
     For the binary buffer source type (i.e. ShaderSourceType::BinaryBuffer), this must not be zero!
     \see source
     */
-    std::size_t                 sourceSize      = 0;
+    std::size_t                         sourceSize      = 0;
 
     /**
     \brief Specifies the type of the shader source. By default ShaderSourceType::CodeFile.
@@ -251,13 +327,13 @@ struct ShaderDescriptor
     \see ShaderSourceType
     \see source
     */
-    ShaderSourceType            sourceType      = ShaderSourceType::CodeFile;
+    ShaderSourceType                    sourceType      = ShaderSourceType::CodeFile;
 
     /**
     \brief Shader entry point (shader main function). If this is null, the empty string is used. By default null.
     \note Only supported with: HLSL, SPIR-V, Metal.
     */
-    const char*                 entryPoint      = nullptr;
+    const char*                         entryPoint      = nullptr;
 
     /**
     \brief Shader target profile. If this is null, the empty string is used. By default null.
@@ -268,7 +344,7 @@ struct ShaderDescriptor
     \note Only supported with: HLSL, Metal.
     \see https://msdn.microsoft.com/en-us/library/windows/desktop/jj215820(v=vs.85).aspx
     */
-    const char*                 profile         = nullptr;
+    const char*                         profile         = nullptr;
 
     /**
     \brief Optional array of macro definitions. By default null.
@@ -286,7 +362,7 @@ struct ShaderDescriptor
     \endcode
     \note Only supported with: HLSL, Metal.
     */
-    const ShaderMacro*          defines         = nullptr;
+    const ShaderMacro*                  defines         = nullptr;
 
     /**
     \brief Optional compilation flags. By default 0.
@@ -294,20 +370,39 @@ struct ShaderDescriptor
     \note Only supported with: HLSL.
     \see ShaderCompileFlags
     */
-    long                        flags           = 0;
+    long                                flags           = 0;
+
+    /**
+    \brief Optional list of specialization constants. By default empty.
+    \remarks Specialization constants are applied when a shader module is specialized, i.e. when the shader is loaded in OpenGL and when a pipeline state is created in Vulkan.
+    Constants that are not declared in the shader module are ignored. Constants that are not listed here keep the default value they have been declared with.
+    If a constant ID is listed more than once, the last value is used.
+    \remarks Here is a brief example how to use:
+    \code
+    LLGL::ShaderDescriptor myShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Fragment, "MyUberShader.frag.spv");
+    myShaderDesc.specializationConstants = {
+        { 0, true },    // layout(constant_id = 0) const bool ENABLE_FOG
+        { 1, 4u   },    // layout(constant_id = 1) const uint NUM_LIGHTS
+        { 2, 0.5f },    // layout(constant_id = 2) const float ALPHA_THRESHOLD
+    };
+    \endcode
+    \note Only supported with: Vulkan, OpenGL (with SPIR-V shader binaries only).
+    \see ShaderReflection::specializationConstants
+    */
+    std::vector<SpecializationConstant> specializationConstants;
 
     //! Vertex (or geometry) shader specific attributes.
-    VertexShaderAttributes      vertex;
+    VertexShaderAttributes              vertex;
 
     //! Fragment shader specific attributes.
-    FragmentShaderAttributes    fragment;
+    FragmentShaderAttributes            fragment;
 
     /**
     \brief Compute shader specific attributes.
     \remarks This member is only used to specify the number of threads per threadgroup for the Metal backend.
     \note Only supported with: Metal.
     */
-    ComputeShaderAttributes     compute;
+    ComputeShaderAttributes             compute;
 };
 
 
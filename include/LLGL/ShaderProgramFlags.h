@@ -257,13 +257,20 @@ This is not a "descriptor", because it is only used as output from an interface
 struct ShaderReflection
 {
     //! List of all shader reflection resource views.
-    std::vector<ShaderResource> resources;
+    std::vector<ShaderResource>         resources;
 
     /**
     \brief List of all uniforms (a.k.a. shader constants).
     \note Only supported with: OpenGL, Vulkan.
     */
-    std::vector<ShaderUniform>  uniforms;
+    std::vector<ShaderUniform>          uniforms;
+
+    /**
+    \brief List of all specialization constants with the default values they have been declared with.
+    \note Only supported with: Vulkan.
+    \see ShaderDescriptor::specializationConstants
+    */
+    std::vector<SpecializationConstant> specializationConstants;
 
     /**
     \brief Reflection data that is specificly for the vertex shader.
@@ -275,13 +282,13 @@ struct ShaderReflection
     - \c semanticIndex
     - \c systemValue
     */
-    VertexShaderAttributes      vertex;
+    VertexShaderAttributes              vertex;
 
     //! Reflection data that is specificly for the fragment shader.
-    FragmentShaderAttributes    fragment;
+    FragmentShaderAttributes            fragment;
 
     //! Reflection data that is specificly for the compute shader.
-    ComputeShaderAttributes     compute;
+    ComputeShaderAttributes             compute;
 };
 
 
@@ -0,0 +1,160 @@
+/*
+ * TextureContainer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEXTURE_CONTAINER_H
+#define LLGL_TEXTURE_CONTAINER_H
+
+
+#include "NonCopyable.h"
+#include "ForwardDecls.h"
+#include "Blob.h"
+#include "TextureFlags.h"
+#include "ImageFlags.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Texture container file format enumeration.
+\see TextureContainer::GetContainerFormat
+*/
+enum class TextureContainerFormat
+{
+    DDS,    //!< DirectDraw Surface (DDS), including the DX10 header extension.
+    KTX2,   //!< Khronos Texture 2.0 (KTX2) without supercompression.
+};
+
+/**
+\brief Loader for texture container files with pre-baked texture data, i.e. DDS and KTX2 files.
+\remarks The container header is parsed into a TextureDescriptor, including block compressed formats, array layers, cube faces, 3D textures, and the entire MIP-map chain.
+The texture data is neither decoded nor copied. Instead, each subresource is a view into the blob the container was loaded from,
+which is a memory mapped file when the container is loaded with LoadFromFile (see Blob::CreateMapped).
+Hence, the file content is only paged in while the texture is uploaded level by level.
+\code
+auto myContainer = LLGL::TextureContainer::LoadFromFile("MyTexture.ktx2");
+auto myTexture = myContainer->CreateTexture(*myRenderer);
+\endcode
+\remarks Only formats that are supported by LLGL::Format can be loaded, e.g. BC6H and BC7 are not supported.
+The byte order of the file must match the host system, which is always little endian for DDS and KTX2 files.
+\see RenderSystem::WriteTexture
+*/
+class LLGL_EXPORT TextureContainer : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Parses the texture container stored in the specified blob and takes its ownership.
+        \param[in] blob Specifies the blob with the content of a DDS or KTX2 file. The container format is determined by the file identifier.
+        \throws std::invalid_argument If \c blob is null.
+        \throws std::runtime_error If the blob does not contain a valid DDS or KTX2 file, or if the file uses an unsupported format or supercompression.
+        */
+        explicit TextureContainer(std::unique_ptr<Blob>&& blob);
+
+        /**
+        \brief Loads the specified DDS or KTX2 file as memory mapped file.
+        \param[in] filename Specifies the file that is to be loaded.
+        \throws std::runtime_error If the file could not be opened or parsed.
+        \see Blob::CreateMapped
+        */
+        static std::unique_ptr<TextureContainer> LoadFromFile(const std::string& filename);
+
+        //! Returns the file format of this container.
+        inline TextureContainerFormat GetContainerFormat() const
+        {
+            return containerFormat_;
+        }
+
+        /**
+        \brief Returns the texture descriptor that was parsed from the container header.
+        \remarks The binding flags are BindFlags::Sampled and the miscellaneous flags are MiscFlags::NoInitialData,
+        since the texture data is written with WriteTexture. A KTX2 file without MIP-map levels (i.e. a level count of zero) is loaded with a single MIP-map level.
+        */
+        inline const TextureDescriptor& GetDesc() const
+        {
+            return textureDesc_;
+        }
+
+        /**
+        \brief Returns the image descriptor of the specified subresource, which refers directly to the data of the container.
+        \param[in] mipLevel Specifies the MIP-map level. This must be less than TextureDescriptor::mipLevels.
+        \param[in] arrayLayer Specifies the array layer. This must be less than TextureDescriptor::arrayLayers. For cube textures, each face is a separate array layer.
+        \throws std::out_of_range If \c mipLevel or \c arrayLayer is out of range.
+        */
+        SrcImageDescriptor GetSubresourceImage(std::uint32_t mipLevel, std::uint32_t arrayLayer = 0) const;
+
+        /**
+        \brief Returns the texture region that covers the specified subresource.
+        \throws std::out_of_range If \c mipLevel or \c arrayLayer is out of range.
+        */
+        TextureRegion GetSubresourceRegion(std::uint32_t mipLevel, std::uint32_t arrayLayer = 0) const;
+
+        /**
+        \brief Writes all subresources of this container into the specified texture.
+        \remarks The texture is written level by level with RenderSystem::WriteTexture.
+        All array layers of a MIP-map level are written with a single call if they are stored consecutively (as in KTX2 files), otherwise with one call per array layer (as in DDS files).
+        \remarks The texture must have been created with a descriptor that is compatible to GetDesc.
+        */
+        void WriteTexture(RenderSystem& renderSystem, Texture& texture) const;
+
+        /**
+        \brief Creates a new texture with the descriptor of this container and writes all subresources into it.
+        \see GetDesc
+        \see WriteTexture
+        */
+        Texture* CreateTexture(RenderSystem& renderSystem) const;
+
+    private:
+
+        struct SubresourceView
+        {
+            const void*     data;
+            std::size_t     size;
+        };
+
+    private:
+
+        void ParseDDS();
+        void ParseKTX2();
+
+        // Returns the size (in bytes) of a single array layer of the specified MIP-map level.
+        std::size_t GetLayerSize(std::uint32_t mipLevel) const;
+
+        // Validates the number of MIP-map levels and array layers of the texture descriptor and allocates the subresource views.
+        void AllocSubresources();
+
+        // Stores the view of the specified subresource after checking that it is within the blob.
+        void SetSubresource(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::size_t offset, std::size_t size);
+
+        const SubresourceView& GetSubresource(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
+
+    private:
+
+        std::unique_ptr<Blob>           blob_;
+        TextureContainerFormat          containerFormat_    = TextureContainerFormat::DDS;
+        TextureDescriptor               textureDesc_;
+        SrcImageDescriptor              imageDesc_;         // Image format and data type of all subresources
+        std::vector<SubresourceView>    subresources_;      // Subresource views in the order [mipLevel][arrayLayer]
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
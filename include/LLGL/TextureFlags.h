@@ -256,6 +256,28 @@ struct TextureRegion
     Extent3D            extent;
 };
 
+/**
+\brief Staging memory range for a streaming texture upload.
+\remarks A texture upload range is reserved with RenderSystem::ReserveTextureUpload, filled with image data by the caller (possibly on a worker thread),
+and committed with RenderSystem::CommitTextureUpload.
+\see RenderSystem::ReserveTextureUpload
+\see RenderSystem::CommitTextureUpload
+*/
+struct TextureUploadRange
+{
+    /**
+    \brief Pointer to the CPU accessible staging memory. This is null if no staging memory could be reserved.
+    \remarks The caller writes the image data (e.g. the output of ConvertImageBuffer) into this memory before the range is committed.
+    */
+    void*           data    = nullptr;
+
+    //! Size (in bytes) of the staging memory.
+    std::uint64_t   size    = 0;
+
+    //! Offset (in bytes) of the staging memory within the internal staging buffer. Only the render system that reserved this range interprets this value.
+    std::uint64_t   offset  = 0;
+};
+
 /**
 \brief Texture descriptor structure.
 \remarks Contains all information about type, format, and dimension to create a texture resource.
@@ -0,0 +1,145 @@
+/*
+ * VertexConversion.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VERTEX_CONVERSION_H
+#define LLGL_VERTEX_CONVERSION_H
+
+
+#include "Export.h"
+#include "VertexFormat.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Enumerations ----- */
+
+/**
+\brief Vertex attribute encoding enumeration.
+\see ConvertVertexBuffer
+*/
+enum class VertexAttributeEncoding
+{
+    /**
+    \brief Source components are converted directly into the destination format.
+    \remarks Values outside the range of a normalized destination format are clamped,
+    i.e. [0, 1] for unsigned normalized formats and [-1, 1] for signed normalized formats.
+    NaN components are stored as zero in normalized formats.
+    */
+    Direct,
+
+    /**
+    \brief Source components are remapped from the bounding box of all vertices into the range of the destination format.
+    \remarks This is the encoding of choice to store positions in normalized formats such as Format::RGBA16SNorm.
+    The scale and offset to decode the attribute (e.g. in the vertex shader) are returned in VertexAttributeQuantization.
+    */
+    Bounds,
+
+    /**
+    \brief Source components are interpreted as 3D direction vector and stored as octahedral encoded 2D vector.
+    \remarks This requires a destination format with two components, e.g. Format::RG16SNorm or Format::RG8SNorm.
+    The source vectors are normalized before they are encoded. The decoded vector is in the range [-1, 1] for both components.
+    */
+    Octahedral,
+};
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Decoding parameters and quantization error of a converted vertex attribute.
+\remarks An encoded component is decoded with <code>decoded = encoded * scale + offset</code>,
+where \c encoded is the value the vertex shader reads from the destination format.
+For VertexAttributeEncoding::Octahedral, the decoded 2D vector must then be unpacked into the 3D direction vector.
+\see VertexConversionReport::attributes
+*/
+struct VertexAttributeQuantization
+{
+    //! Scale factor for each component. By default 1.
+    float   scale[4]    = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    //! Offset for each component. By default 0.
+    float   offset[4]   = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    /**
+    \brief Largest absolute error of all decoded components compared to the source components.
+    \remarks For VertexAttributeEncoding::Octahedral, this is the error of the unpacked 3D direction vector compared to the normalized source vector.
+    */
+    float   maxError    = 0.0f;
+};
+
+/**
+\brief Result of a vertex buffer conversion.
+\see ConvertVertexBuffer
+*/
+struct VertexConversionReport
+{
+    //! Number of vertices that have been converted.
+    std::size_t                                 numVertices = 0;
+
+    //! Decoding parameters and quantization errors in the same order as the attributes of the destination vertex format.
+    std::vector<VertexAttributeQuantization>    attributes;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Converts an interleaved vertex buffer into another vertex format, e.g. to pack floating-point attributes into compact normalized formats.
+\param[in] srcFormat Specifies the vertex format of the source buffer. All attributes must have a 32-bit floating-point format, e.g. Format::RGB32Float.
+\param[in] srcData Pointer to the source vertex buffer.
+\param[in] srcDataSize Specifies the size (in bytes) of the source buffer. The number of vertices is <code>srcDataSize / srcFormat.GetStride()</code>.
+\param[in] dstFormat Specifies the vertex format of the destination buffer.
+Each attribute is read from the source attribute with the same name and semantic index.
+Supported destination formats are 32-bit and 16-bit floating-point formats, 8-bit and 16-bit normalized formats, and Format::RGB10A2UNorm.
+\param[out] dstData Pointer to the destination vertex buffer. Bytes that are not covered by any destination attribute are not modified.
+\param[in] dstDataSize Specifies the size (in bytes) of the destination buffer. This must be large enough to hold all vertices with the stride of \c dstFormat.
+\param[in] encodings Optional list of encodings in the same order as the attributes of \c dstFormat. If this is empty, all attributes use VertexAttributeEncoding::Direct.
+\return Decoding parameters and the quantization error for each destination attribute.
+\remarks Missing source components are filled with 0 for the X, Y, and Z components and with 1 for the W component.
+\remarks Here is an example that packs positions with their bounding box, normals with octahedral encoding, and texture-coordinates as half floats:
+\code
+LLGL::VertexFormat myPackedFormat;
+myPackedFormat.AppendAttribute({ "position", LLGL::Format::RGBA16SNorm });
+myPackedFormat.AppendAttribute({ "normal",   LLGL::Format::RG16SNorm   });
+myPackedFormat.AppendAttribute({ "texCoord", LLGL::Format::RG16Float   });
+auto myReport = LLGL::ConvertVertexBuffer(
+    myFloatFormat, myVertices.data(), myVertices.size() * sizeof(MyVertex),
+    myPackedFormat, myPackedVertices.data(), myPackedVertices.size(),
+    { LLGL::VertexAttributeEncoding::Bounds, LLGL::VertexAttributeEncoding::Octahedral, LLGL::VertexAttributeEncoding::Direct }
+);
+\endcode
+\throw std::invalid_argument If a source attribute has no 32-bit floating-point format,
+if a destination attribute has an unsupported format or no matching source attribute,
+if the number of encodings does not match the number of destination attributes,
+if an octahedral encoded attribute has no two-component destination format,
+or if the destination buffer is too small.
+\see VertexAttributeEncoding
+\see VertexAttributeQuantization
+*/
+LLGL_EXPORT VertexConversionReport ConvertVertexBuffer(
+    const VertexFormat&                         srcFormat,
+    const void*                                 srcData,
+    std::size_t                                 srcDataSize,
+    const VertexFormat&                         dstFormat,
+    void*                                       dstData,
+    std::size_t                                 dstDataSize,
+    const std::vector<VertexAttributeEncoding>& encodings = {}
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,9 +7,20 @@
 
 #include <LLGL/Blob.h>
 #include <LLGL/ImageFlags.h>
+#include <LLGL/Platform/Platform.h>
 #include <fstream>
 #include "Helper.h"
 
+#if defined LLGL_OS_WIN32
+#   include "../Platform/Win32/Win32LeanAndMean.h"
+#   include <Windows.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
 
 namespace LLGL
 {
@@ -151,6 +162,120 @@ using BlobStdVectorInt8 = BlobContainer<std::vector<std::int8_t>>;
 using BlobStdString     = BlobContainer<std::string>;
 
 
+/*
+ * BlobMapped class
+ */
+
+// Memory mapped file implementation of <Blob> interface.
+class BlobMapped final : public Blob
+{
+
+    public:
+
+        BlobMapped(const void* data, std::size_t size);
+        ~BlobMapped();
+
+    public:
+
+        const void* GetData() const override;
+        std::size_t GetSize() const override;
+
+    private:
+
+        const void* data_ = nullptr;
+        std::size_t size_ = 0;
+
+};
+
+BlobMapped::BlobMapped(const void* data, std::size_t size) :
+    data_ { data },
+    size_ { size }
+{
+}
+
+BlobMapped::~BlobMapped()
+{
+    #if defined LLGL_OS_WIN32
+    ::UnmapViewOfFile(data_);
+    #else
+    ::munmap(const_cast<void*>(data_), size_);
+    #endif
+}
+
+const void* BlobMapped::GetData() const
+{
+    return data_;
+}
+
+std::size_t BlobMapped::GetSize() const
+{
+    return size_;
+}
+
+// Maps the entire file into memory with read-only access and returns null on failure or if the file is empty.
+static const void* MapFileIntoMemory(const char* filename, long flags, std::size_t& size)
+{
+    const void* view = nullptr;
+
+    #if defined LLGL_OS_WIN32
+
+    /* Open file with optional sequential access hint */
+    DWORD fileFlags = FILE_ATTRIBUTE_NORMAL;
+    if ((flags & BlobMappingFlags::Sequential) != 0)
+        fileFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+
+    HANDLE file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, fileFlags, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (::GetFileSizeEx(file, &fileSize) != FALSE && fileSize.QuadPart > 0 && static_cast<ULONGLONG>(fileSize.QuadPart) <= SIZE_MAX)
+    {
+        /* Map view of entire file; the view keeps the file mapping object alive */
+        if (HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view != nullptr)
+                size = static_cast<std::size_t>(fileSize.QuadPart);
+            ::CloseHandle(mapping);
+        }
+    }
+
+    ::CloseHandle(file);
+
+    #else
+
+    int file = ::open(filename, O_RDONLY);
+    if (file == -1)
+        return nullptr;
+
+    struct stat fileStat;
+    if (::fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        /* Map entire file; the mapping keeps a reference to the file after it has been closed */
+        const auto fileSize = static_cast<std::size_t>(fileStat.st_size);
+        void* mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED)
+        {
+            /* Pass access hints to the page cache */
+            if ((flags & BlobMappingFlags::Sequential) != 0)
+                ::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+            if ((flags & BlobMappingFlags::WillNeed) != 0)
+                ::madvise(mapping, fileSize, MADV_WILLNEED);
+
+            view = mapping;
+            size = fileSize;
+        }
+    }
+
+    ::close(file);
+
+    #endif
+
+    return view;
+}
+
+
 /*
  * Blob class
  */
@@ -203,6 +328,24 @@ std::unique_ptr<Blob> Blob::CreateFromFile(const std::string& filename)
     return CreateFromFile(filename.c_str());
 }
 
+std::unique_ptr<Blob> Blob::CreateMapped(const char* filename, long flags)
+{
+    if (filename == nullptr || *filename == '\0')
+        return nullptr;
+
+    /* Map file into memory, or read empty and unmappable files into a buffer */
+    std::size_t size = 0;
+    if (auto data = MapFileIntoMemory(filename, flags, size))
+        return MakeUnique<BlobMapped>(data, size);
+    else
+        return CreateFromFile(filename);
+}
+
+std::unique_ptr<Blob> Blob::CreateMapped(const std::string& filename, long flags)
+{
+    return CreateMapped(filename.c_str(), flags);
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,63 @@
+/*
+ * HashUtils.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_HASH_UTILS_H
+#define LLGL_HASH_UTILS_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace LLGL
+{
+
+
+// Initial value for the FNV-1a hash functions.
+static const std::uint64_t g_hashSeed = 0xcbf29ce484222325ull;
+
+// Returns the 64-bit FNV-1a hash of the specified data, continued from the specified seed.
+inline std::uint64_t HashBytes(const void* data, std::size_t size, std::uint64_t seed = g_hashSeed)
+{
+    auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        seed ^= bytes[i];
+        seed *= 0x100000001b3ull;
+    }
+    return seed;
+}
+
+// Returns the 64-bit FNV-1a hash of the specified null-terminated string including its terminator, so consecutive strings cannot be confused.
+inline std::uint64_t HashString(const char* s, std::uint64_t seed = g_hashSeed)
+{
+    if (s != nullptr)
+    {
+        for (; *s != '\0'; ++s)
+            seed = HashBytes(s, 1, seed);
+    }
+    return HashBytes("", 1, seed);
+}
+
+// Returns the 64-bit FNV-1a hash of the specified value of trivial type.
+template <typename T>
+std::uint64_t HashValue(const T& value, std::uint64_t seed = g_hashSeed)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "HashValue<T>: T must be trivially copyable");
+    return HashBytes(&value, sizeof(value), seed);
+}
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,14 @@
  */
 
 #include <LLGL/Log.h>
+#include "Helper.h"
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <algorithm>
 
 
 namespace LLGL
@@ -16,23 +23,296 @@ namespace Log
 {
 
 
+/*
+Single-producer/single-consumer ring buffer of reports for one thread.
+Only the owning thread writes 'head', and only the thread that takes reports from the queue (guarded by 'queuesMutex') writes 'tail'.
+*/
+struct ReportQueue
+{
+    /*
+    Pending report. If 'format' is non-null, the message is formatted from 'format' and 'args' when the report is drained.
+    The strings of each slot are reused, so their capacity is only allocated once.
+    */
+    struct Report
+    {
+        ReportType                  type;
+        const char*                 format      = nullptr;
+        std::string                 message;
+        std::vector<std::string>    args;
+        std::size_t                 numArgs     = 0;
+        std::string                 contextInfo;
+    };
+
+    explicit ReportQueue(std::size_t capacity) :
+        reports { capacity }
+    {
+    }
+
+    std::vector<Report>         reports;
+    std::atomic<std::size_t>    head        { 0 };
+    std::atomic<std::size_t>    tail        { 0 };
+};
+
 struct LogState
 {
-    std::mutex      reportMutex;
-    ReportCallback  reportCallback  = nullptr;
-    std::ostream*   outputStream    = nullptr;
-    void*           userData        = nullptr;
-    std::size_t     limit           = 0;
-    std::size_t     counter         = 0;
+    ~LogState();
+
+    std::mutex                                  reportMutex;
+    ReportCallback                              reportCallback  = nullptr;
+    std::ostream*                               outputStream    = nullptr;
+    void*                                       userData        = nullptr;
+    std::atomic<std::size_t>                    limit           { 0 };
+    std::size_t                                 counter         = 0;
+
+    /* Asynchronous reports */
+    std::atomic<bool>                           asyncEnabled    { false };
+    std::atomic<std::size_t>                    asyncCounter    { 0 };
+    std::atomic<std::size_t>                    asyncDropped    { 0 };
+    std::size_t                                 queueSize       = 256;
+    std::mutex                                  queuesMutex;
+    std::vector<std::unique_ptr<ReportQueue>>   queues;
+    std::thread                                 drainThread;
+    std::atomic<bool>                           drainThreadQuit { false };
 };
 
 static LogState g_logState;
 
+// Owns the report queue of a thread and releases it when the thread exits.
+struct ThreadReportQueueOwner
+{
+    ~ThreadReportQueueOwner();
+
+    ReportQueue* queue = nullptr;
+};
+
+static thread_local ThreadReportQueueOwner g_threadReportQueue;
+
+
+/* ----- Internal functions ----- */
+
+static void StopDrainThread()
+{
+    if (g_logState.drainThread.joinable())
+    {
+        g_logState.drainThreadQuit = true;
+        g_logState.drainThread.join();
+        g_logState.drainThreadQuit = false;
+    }
+}
+
+LogState::~LogState()
+{
+    StopDrainThread();
+}
+
+// Appends the format string to the output string and replaces each "%s" by the next argument.
+static void FormatReport(std::string& s, const char* format, const std::string* args, std::size_t numArgs)
+{
+    std::size_t argIndex = 0;
+
+    for (; *format != '\0'; ++format)
+    {
+        if (format[0] == '%' && format[1] == 's')
+        {
+            if (argIndex < numArgs)
+                s += args[argIndex++];
+            ++format;
+        }
+        else if (format[0] == '%' && format[1] == '%')
+        {
+            s += '%';
+            ++format;
+        }
+        else
+            s += *format;
+    }
+}
+
+static void GetReportCallback(ReportCallback& callback, void*& userData)
+{
+    std::lock_guard<std::mutex> guard { g_logState.reportMutex };
+    callback = g_logState.reportCallback;
+    userData = g_logState.userData;
+}
+
+// Copies all pending reports of the specified queue into the output list and releases their slots. Must be called with a lock of 'queuesMutex'.
+static void TakeReports(ReportQueue& queue, std::vector<ReportQueue::Report>& reports)
+{
+    auto tail = queue.tail.load(std::memory_order_relaxed);
+    auto head = queue.head.load(std::memory_order_acquire);
+
+    for (; tail != head; ++tail)
+    {
+        /* Copy strings rather than swapping them, so the slots keep their capacity for the producer thread */
+        const auto& src = queue.reports[tail % queue.reports.size()];
+
+        reports.emplace_back();
+        auto& dst = reports.back();
+
+        dst.type        = src.type;
+        dst.format      = src.format;
+        dst.numArgs     = src.numArgs;
+        dst.contextInfo = src.contextInfo;
+
+        if (src.format != nullptr)
+            dst.args.assign(src.args.begin(), src.args.begin() + src.numArgs);
+        else
+            dst.message = src.message;
+    }
+
+    queue.tail.store(tail, std::memory_order_release);
+}
+
+// Passes the specified reports to the callback. Must be called without a lock of 'queuesMutex', since the callback may post or flush reports itself.
+static void PassReports(const std::vector<ReportQueue::Report>& reports, const ReportCallback& callback, void* userData)
+{
+    if (callback == nullptr)
+        return;
+
+    std::string message;
+
+    for (const auto& report : reports)
+    {
+        if (report.format != nullptr)
+        {
+            /* Format message on the consumer thread */
+            message.clear();
+            FormatReport(message, report.format, report.args.data(), report.numArgs);
+            callback(report.type, message, report.contextInfo, userData);
+        }
+        else
+            callback(report.type, report.message, report.contextInfo, userData);
+    }
+}
+
+ThreadReportQueueOwner::~ThreadReportQueueOwner()
+{
+    if (queue != nullptr)
+    {
+        std::vector<ReportQueue::Report> reports;
+
+        /* Take remaining reports of this thread, then unregister and release its queue */
+        {
+            std::lock_guard<std::mutex> guard { g_logState.queuesMutex };
+
+            TakeReports(*queue, reports);
+
+            auto it = std::find_if(
+                g_logState.queues.begin(),
+                g_logState.queues.end(),
+                [this](const std::unique_ptr<ReportQueue>& entry)
+                {
+                    return (entry.get() == queue);
+                }
+            );
+            if (it != g_logState.queues.end())
+                g_logState.queues.erase(it);
+
+            queue = nullptr;
+        }
+
+        /* Pass reports to the callback after the lock has been released */
+        ReportCallback  callback;
+        void*           userData    = nullptr;
+        GetReportCallback(callback, userData);
+        PassReports(reports, callback, userData);
+    }
+}
+
+static ReportQueue* GetThreadReportQueue()
+{
+    /* Fast path: thread has already registered its queue */
+    if (g_threadReportQueue.queue != nullptr)
+        return g_threadReportQueue.queue;
+
+    /* Slow path: register new report queue for the calling thread */
+    std::lock_guard<std::mutex> guard { g_logState.queuesMutex };
+
+    g_logState.queues.push_back(MakeUnique<ReportQueue>(g_logState.queueSize));
+    g_threadReportQueue.queue = g_logState.queues.back().get();
+
+    return g_threadReportQueue.queue;
+}
+
+// Reserves a slot in the report queue of the calling thread, lets 'fillReport' write into it, and publishes the report.
+template <typename TFunc>
+static void PostReportAsync(const TFunc& fillReport)
+{
+    /* Increase report counter and check if the report must be ignored */
+    const auto counter  = ++g_logState.asyncCounter;
+    const auto limit    = g_logState.limit.load(std::memory_order_relaxed);
+    if (limit > 0 && counter > limit)
+        return;
+
+    /* Push report into the queue of the calling thread */
+    auto queue  = GetThreadReportQueue();
+    auto head   = queue->head.load(std::memory_order_relaxed);
+    auto tail   = queue->tail.load(std::memory_order_acquire);
+
+    if (head - tail == queue->reports.size())
+    {
+        /* Drop report if the queue is full */
+        g_logState.asyncDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    fillReport(queue->reports[head % queue->reports.size()]);
+    queue->head.store(head + 1, std::memory_order_release);
+}
+
+// Passes all pending reports to the callback. The reports are taken with a lock of 'queuesMutex', but the callback is invoked without it.
+static void DrainReportQueues()
+{
+    std::vector<ReportQueue::Report> reports;
+
+    {
+        std::lock_guard<std::mutex> guard { g_logState.queuesMutex };
+        for (auto& queue : g_logState.queues)
+            TakeReports(*queue, reports);
+    }
+
+    ReportCallback  callback;
+    void*           userData    = nullptr;
+    GetReportCallback(callback, userData);
+
+    PassReports(reports, callback, userData);
+
+    /* Post a single warning about all dropped reports */
+    if (auto numDropped = g_logState.asyncDropped.exchange(0))
+    {
+        if (callback != nullptr)
+            callback(ReportType::Warning, std::to_string(numDropped) + " report(s) dropped due to full report queue", "", userData);
+    }
+}
+
+static void DrainThreadMain()
+{
+    while (!g_logState.drainThreadQuit)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        FlushReports();
+    }
+}
+
 
 /* ----- Functions ----- */
 
 LLGL_EXPORT void PostReport(ReportType type, const std::string& message, const std::string& contextInfo)
 {
+    if (g_logState.asyncEnabled.load(std::memory_order_acquire))
+    {
+        PostReportAsync(
+            [&](ReportQueue::Report& report)
+            {
+                report.type         = type;
+                report.format       = nullptr;
+                report.message      = message;
+                report.contextInfo  = contextInfo;
+            }
+        );
+        return;
+    }
+
     ReportCallback  callback;
     void*           userData    = nullptr;
     bool            ignore      = false;
@@ -56,6 +336,47 @@ LLGL_EXPORT void PostReport(ReportType type, const std::string& message, const s
         callback(type, message, contextInfo, userData);
 }
 
+LLGL_EXPORT void PostReportFormat(
+    ReportType                          type,
+    const char*                         format,
+    std::initializer_list<const char*>  args,
+    const std::string&                  contextInfo)
+{
+    if (g_logState.asyncEnabled.load(std::memory_order_acquire))
+    {
+        /* Only copy the arguments; the message is formatted when the report is drained */
+        PostReportAsync(
+            [&](ReportQueue::Report& report)
+            {
+                report.type     = type;
+                report.format   = format;
+                report.numArgs  = args.size();
+                if (report.args.size() < args.size())
+                    report.args.resize(args.size());
+
+                auto dst = report.args.begin();
+                for (auto arg : args)
+                    (dst++)->assign(arg != nullptr ? arg : "");
+
+                report.contextInfo = contextInfo;
+            }
+        );
+    }
+    else
+    {
+        /* Format message immediately */
+        std::vector<std::string> argStrings;
+        argStrings.reserve(args.size());
+        for (auto arg : args)
+            argStrings.push_back(arg != nullptr ? arg : "");
+
+        std::string message;
+        FormatReport(message, format, argStrings.data(), argStrings.size());
+
+        PostReport(type, message, contextInfo);
+    }
+}
+
 LLGL_EXPORT void SetReportCallback(const ReportCallback& callback, void* userData)
 {
     std::lock_guard<std::mutex> guard { g_logState.reportMutex };
@@ -82,6 +403,46 @@ LLGL_EXPORT void SetReportLimit(std::size_t maxCount)
     g_logState.limit = maxCount;
 }
 
+LLGL_EXPORT void EnableAsyncReports(std::size_t queueSize, bool backgroundThread)
+{
+    DisableAsyncReports();
+
+    /* Continue with the report counter of the synchronous reports */
+    {
+        std::lock_guard<std::mutex> guard { g_logState.reportMutex };
+        g_logState.asyncCounter = g_logState.counter;
+    }
+
+    /* Store size for new report queues */
+    {
+        std::lock_guard<std::mutex> guard { g_logState.queuesMutex };
+        g_logState.queueSize = std::max(queueSize, std::size_t(1));
+    }
+
+    g_logState.asyncEnabled = true;
+
+    if (backgroundThread)
+        g_logState.drainThread = std::thread(DrainThreadMain);
+}
+
+LLGL_EXPORT void DisableAsyncReports()
+{
+    if (g_logState.asyncEnabled.exchange(false))
+    {
+        StopDrainThread();
+        FlushReports();
+
+        /* Continue with the report counter of the asynchronous reports */
+        std::lock_guard<std::mutex> guard { g_logState.reportMutex };
+        g_logState.counter = g_logState.asyncCounter;
+    }
+}
+
+LLGL_EXPORT void FlushReports()
+{
+    DrainReportQueues();
+}
+
 
 } // /namespace Log
 
@@ -0,0 +1,259 @@
+/*
+ * AsyncReadback.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/AsyncReadback.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/CommandQueue.h>
+#include <LLGL/Texture.h>
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+AsyncReadback::AsyncReadback(RenderSystem& renderSystem, CommandQueue& commandQueue) :
+    renderSystem_ { renderSystem },
+    commandQueue_ { commandQueue }
+{
+}
+
+AsyncReadback::~AsyncReadback()
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.buffer != nullptr)
+            renderSystem_.Release(*slot.buffer);
+        if (slot.fence != nullptr)
+            renderSystem_.Release(*slot.fence);
+    }
+}
+
+ReadbackHandle AsyncReadback::ReadTexture(CommandBuffer& commandBuffer, Texture& srcTexture, const TextureRegion& srcRegion)
+{
+    /* Determine size of tightly packed texels */
+    const auto dataSize = srcTexture.GetMemoryFootprint(srcRegion.extent, srcRegion.subresource);
+    if (dataSize == 0)
+        return 0;
+
+    /* Record copy command into readback buffer, followed by a barrier that makes the copy visible to the host */
+    const auto slotIndex = AcquireSlot(dataSize);
+    auto& slot = slots_[slotIndex];
+    commandBuffer.CopyBufferFromTexture(*slot.buffer, 0, srcTexture, srcRegion);
+    commandBuffer.ResourceBarrier(1, &slot.buffer, 0, nullptr);
+    slot.state = SlotState::Recorded;
+
+    return MakeHandle(slotIndex);
+}
+
+ReadbackHandle AsyncReadback::ReadBuffer(CommandBuffer& commandBuffer, Buffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    if (size == 0)
+        return 0;
+
+    /* Record copy command into readback buffer, followed by a barrier that makes the copy visible to the host */
+    const auto slotIndex = AcquireSlot(size);
+    auto& slot = slots_[slotIndex];
+    commandBuffer.CopyBuffer(*slot.buffer, 0, srcBuffer, srcOffset, size);
+    commandBuffer.ResourceBarrier(1, &slot.buffer, 0, nullptr);
+    slot.state = SlotState::Recorded;
+
+    return MakeHandle(slotIndex);
+}
+
+void AsyncReadback::Submit()
+{
+    for (auto& slot : slots_)
+    {
+        if (slot.state == SlotState::Recorded)
+        {
+            commandQueue_.Submit(*slot.fence);
+            slot.state = SlotState::Submitted;
+        }
+        else if (slot.state == SlotState::DiscardedRecorded)
+        {
+            /* Copy command of a discarded readback is still pending in its command buffer -> keep slot until the fence has been signaled */
+            commandQueue_.Submit(*slot.fence);
+            slot.state = SlotState::Discarded;
+        }
+    }
+}
+
+bool AsyncReadback::IsReady(ReadbackHandle handle)
+{
+    return Wait(handle, 0);
+}
+
+bool AsyncReadback::Wait(ReadbackHandle handle, std::uint64_t timeout)
+{
+    if (auto slot = GetSlot(handle))
+    {
+        if (slot->state == SlotState::Submitted)
+        {
+            /* Only wait for the fence until it has been signaled once, since it might be submitted again for another readback later */
+            if (commandQueue_.WaitFence(*slot->fence, timeout))
+                slot->state = SlotState::Ready;
+        }
+        return (slot->state == SlotState::Ready);
+    }
+    return false;
+}
+
+bool AsyncReadback::Read(ReadbackHandle handle, void* data, std::size_t dataSize)
+{
+    if (!Wait(handle))
+        return false;
+
+    auto slot = GetSlot(handle);
+
+    /* Copy data from mapped readback buffer into output buffer */
+    if (auto mappedData = renderSystem_.MapBuffer(*slot->buffer, CPUAccess::ReadOnly))
+    {
+        ::memcpy(data, mappedData, static_cast<std::size_t>(std::min(slot->dataSize, static_cast<std::uint64_t>(dataSize))));
+        renderSystem_.UnmapBuffer(*slot->buffer);
+    }
+    else
+        return false;
+
+    slot->state = SlotState::Free;
+
+    return true;
+}
+
+void AsyncReadback::Discard(ReadbackHandle handle)
+{
+    if (auto slot = GetSlot(handle))
+    {
+        /*
+        Keep slot until its fence has been signaled, because a pending fence must not be submitted again,
+        and a recorded copy command still writes into the readback buffer once its command buffer is submitted.
+        */
+        switch (slot->state)
+        {
+            case SlotState::Recorded:
+                slot->state = SlotState::DiscardedRecorded;
+                break;
+            case SlotState::Submitted:
+                slot->state = SlotState::Discarded;
+                break;
+            default:
+                slot->state = SlotState::Free;
+                break;
+        }
+    }
+}
+
+std::uint64_t AsyncReadback::GetDataSize(ReadbackHandle handle) const
+{
+    if (auto slot = GetSlot(handle))
+        return slot->dataSize;
+    return 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool AsyncReadback::IsSlotAvailable(Slot& slot)
+{
+    if (slot.state == SlotState::Discarded && commandQueue_.WaitFence(*slot.fence, 0))
+        slot.state = SlotState::Free;
+    return (slot.state == SlotState::Free);
+}
+
+std::uint32_t AsyncReadback::AcquireSlot(std::uint64_t dataSize)
+{
+    /* Find free slot with the smallest buffer that is large enough, or otherwise any free slot */
+    std::size_t slotIndex = slots_.size();
+
+    for (std::size_t i = 0; i < slots_.size(); ++i)
+    {
+        auto& slot = slots_[i];
+        if (IsSlotAvailable(slot))
+        {
+            if (slotIndex == slots_.size())
+                slotIndex = i;
+            else if (slot.capacity >= dataSize && (slots_[slotIndex].capacity < dataSize || slot.capacity < slots_[slotIndex].capacity))
+                slotIndex = i;
+        }
+    }
+
+    /* Allocate new slot if there is no free slot */
+    if (slotIndex == slots_.size())
+    {
+        slots_.emplace_back();
+        slots_.back().fence = renderSystem_.CreateFence();
+    }
+
+    auto& slot = slots_[slotIndex];
+
+    /* Replace readback buffer if it is too small */
+    if (slot.capacity < dataSize)
+    {
+        if (slot.buffer != nullptr)
+            renderSystem_.Release(*slot.buffer);
+
+        BufferDescriptor bufferDesc;
+        {
+            bufferDesc.size             = dataSize;
+            bufferDesc.bindFlags        = BindFlags::CopyDst;
+            bufferDesc.cpuAccessFlags   = CPUAccessFlags::Read;
+        }
+        slot.buffer     = renderSystem_.CreateBuffer(bufferDesc);
+        slot.capacity   = dataSize;
+    }
+
+    slot.dataSize = dataSize;
+    slot.generation++;
+
+    return static_cast<std::uint32_t>(slotIndex);
+}
+
+AsyncReadback::Slot* AsyncReadback::GetSlot(ReadbackHandle handle)
+{
+    const auto slotIndex    = static_cast<std::uint32_t>(handle & 0xFFFFFFFFu);
+    const auto generation   = static_cast<std::uint32_t>(handle >> 32);
+
+    if (slotIndex > 0 && slotIndex <= slots_.size())
+    {
+        /* Free and discarded slots, and slots that have been reused since, are not accessible by their former handles */
+        auto& slot = slots_[slotIndex - 1];
+        if (slot.generation == generation && slot.state != SlotState::Free && slot.state != SlotState::DiscardedRecorded && slot.state != SlotState::Discarded)
+            return &slot;
+    }
+    return nullptr;
+}
+
+const AsyncReadback::Slot* AsyncReadback::GetSlot(ReadbackHandle handle) const
+{
+    const auto slotIndex    = static_cast<std::uint32_t>(handle & 0xFFFFFFFFu);
+    const auto generation   = static_cast<std::uint32_t>(handle >> 32);
+
+    if (slotIndex > 0 && slotIndex <= slots_.size())
+    {
+        /* Free and discarded slots, and slots that have been reused since, are not accessible by their former handles */
+        auto& slot = slots_[slotIndex - 1];
+        if (slot.generation == generation && slot.state != SlotState::Free && slot.state != SlotState::DiscardedRecorded && slot.state != SlotState::Discarded)
+            return &slot;
+    }
+    return nullptr;
+}
+
+ReadbackHandle AsyncReadback::MakeHandle(std::uint32_t slotIndex) const
+{
+    return ((static_cast<ReadbackHandle>(slots_[slotIndex].generation) << 32) | static_cast<ReadbackHandle>(slotIndex + 1));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -35,6 +35,16 @@ inline bool IsBufferViewEnabled(const BufferViewDescriptor& bufferViewDesc)
     );
 }
 
+// Returns true if the specified buffer is only used as destination of copy commands to read its data back to the CPU.
+inline bool IsReadbackBuffer(const BufferDescriptor& desc)
+{
+    return
+    (
+        (desc.cpuAccessFlags & CPUAccessFlags::Read) != 0 &&
+        (desc.bindFlags & ~(BindFlags::CopySrc | BindFlags::CopyDst)) == 0
+    );
+}
+
 
 } // /namespace LLGL
 
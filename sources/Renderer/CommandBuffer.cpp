@@ -0,0 +1,41 @@
+/*
+ * CommandBuffer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandBuffer.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Encoding ----- */
+
+bool CommandBuffer::TryBegin()
+{
+    /* Encoding never blocks without native command buffers */
+    Begin();
+    return true;
+}
+
+std::uint64_t CommandBuffer::GetLastWaitTime() const
+{
+    return 0;
+}
+
+/* ----- Compute ----- */
+
+void CommandBuffer::ResourceBarrier(std::uint32_t /*numBuffers*/, Buffer* const * /*buffers*/, std::uint32_t /*numTextures*/, Texture* const * /*textures*/)
+{
+    /* Resources are synchronized implicitly without native command buffers */
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
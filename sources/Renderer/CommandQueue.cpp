@@ -0,0 +1,37 @@
+/*
+ * CommandQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandQueue.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Fence values ----- */
+
+void CommandQueue::Signal(Fence& fence, std::uint64_t /*value*/)
+{
+    Submit(fence);
+}
+
+void CommandQueue::Wait(Fence& /*fence*/, std::uint64_t /*value*/)
+{
+    // dummy
+}
+
+bool CommandQueue::WaitFenceValue(Fence& fence, std::uint64_t /*value*/, std::uint64_t timeout)
+{
+    return WaitFence(fence, timeout);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -9,8 +9,12 @@
 #define LLGL_CONTAINER_TYPES_H
 
 
-#include <set>
 #include <memory>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -20,8 +24,334 @@ namespace LLGL
 template <typename T>
 using HWObjectInstance = std::unique_ptr<T>;
 
-template <typename T>
-using HWObjectContainer = std::set<HWObjectInstance<T>>;
+/*
+Container for the hardware objects of a render system.
+Objects are stored in a slot array with a free-list, so inserting and removing an object is O(1) and iteration runs over a contiguous array.
+The slot of each object is found by an open-addressing hash table that is keyed by the object address.
+If 'ThreadSafe' is true, all modifications are guarded by a spin lock, so objects can be created and released by several threads concurrently.
+*/
+template <typename T, bool ThreadSafe = false>
+class HWObjectContainer
+{
+
+    public:
+
+        // Forward iterator over all occupied slots.
+        class const_iterator
+        {
+
+            public:
+
+                const_iterator(const HWObjectInstance<T>* slot, const HWObjectInstance<T>* end) :
+                    slot_ { slot },
+                    end_  { end  }
+                {
+                    SkipEmptySlots();
+                }
+
+                const HWObjectInstance<T>& operator * () const
+                {
+                    return *slot_;
+                }
+
+                const HWObjectInstance<T>* operator -> () const
+                {
+                    return slot_;
+                }
+
+                const_iterator& operator ++ ()
+                {
+                    ++slot_;
+                    SkipEmptySlots();
+                    return *this;
+                }
+
+                bool operator == (const const_iterator& rhs) const
+                {
+                    return (slot_ == rhs.slot_);
+                }
+
+                bool operator != (const const_iterator& rhs) const
+                {
+                    return (slot_ != rhs.slot_);
+                }
+
+            private:
+
+                void SkipEmptySlots()
+                {
+                    while (slot_ != end_ && !(*slot_))
+                        ++slot_;
+                }
+
+            private:
+
+                const HWObjectInstance<T>* slot_;
+                const HWObjectInstance<T>* end_;
+
+        };
+
+    public:
+
+        HWObjectContainer() = default;
+
+        HWObjectContainer(const HWObjectContainer&) = delete;
+        HWObjectContainer& operator = (const HWObjectContainer&) = delete;
+
+        ~HWObjectContainer()
+        {
+            clear();
+        }
+
+        // Takes ownership of the specified object and returns its raw pointer.
+        T* insert(HWObjectInstance<T>&& object)
+        {
+            auto ref = object.get();
+            if (ref != nullptr)
+            {
+                LockGuard guard { lock_ };
+
+                /* Take a slot from the free-list or append a new one */
+                std::uint32_t slot = 0;
+                if (!freeSlots_.empty())
+                {
+                    slot = freeSlots_.back();
+                    freeSlots_.pop_back();
+                }
+                else
+                {
+                    slot = static_cast<std::uint32_t>(slots_.size());
+                    slots_.emplace_back();
+                }
+                slots_[slot] = std::move(object);
+
+                /* Map object address to its slot */
+                if ((size_.load() + 1) * 2 > table_.size())
+                    RehashTable(table_.empty() ? 16 : table_.size() * 2);
+                InsertIntoTable(ref, slot);
+                ++size_;
+            }
+            return ref;
+        }
+
+        // Destroys the specified object. Returns false if the object is not stored in this container.
+        bool erase(const T* object)
+        {
+            HWObjectInstance<T> removedObject;
+
+            {
+                LockGuard guard { lock_ };
+
+                const auto slot = RemoveFromTable(object);
+                if (slot == g_invalidSlot)
+                    return false;
+
+                removedObject = std::move(slots_[slot]);
+                freeSlots_.push_back(slot);
+                --size_;
+
+                /* Release all slots once the container is empty, so the free-list does not keep growing */
+                if (size_.load() == 0)
+                {
+                    slots_.clear();
+                    freeSlots_.clear();
+                }
+            }
+
+            /* Destroy object outside of the lock, since its destructor might release other objects */
+            removedObject.reset();
+            return true;
+        }
+
+        // Destroys all objects in the order they were inserted into their slots.
+        void clear()
+        {
+            std::vector<HWObjectInstance<T>> removedObjects;
+
+            {
+                LockGuard guard { lock_ };
+                removedObjects.swap(slots_);
+                freeSlots_.clear();
+                table_.clear();
+                size_.store(0);
+            }
+
+            removedObjects.clear();
+        }
+
+        // Returns true if the specified object is stored in this container.
+        bool contains(const T* object) const
+        {
+            LockGuard guard { lock_ };
+            return (FindInTable(object) != g_invalidSlot);
+        }
+
+        // Returns the number of objects in this container.
+        std::size_t size() const
+        {
+            return size_.load();
+        }
+
+        // Returns true if this container has no objects.
+        bool empty() const
+        {
+            return (size_.load() == 0);
+        }
+
+        // Returns the iterator to the first object. The container must not be modified while it is iterated.
+        const_iterator begin() const
+        {
+            return const_iterator { slots_.data(), slots_.data() + slots_.size() };
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator { slots_.data() + slots_.size(), slots_.data() + slots_.size() };
+        }
+
+    private:
+
+        static const std::uint32_t g_invalidSlot = ~0u;
+
+        struct TableEntry
+        {
+            const T*        key     = nullptr;
+            std::uint32_t   slot    = g_invalidSlot;
+        };
+
+        // Spin lock that is only used if the container is thread-safe; object creation is expected to dominate any contention.
+        class LockGuard
+        {
+
+            public:
+
+                LockGuard(std::atomic_flag& lock) :
+                    lock_ { lock }
+                {
+                    if (ThreadSafe)
+                    {
+                        while (lock_.test_and_set(std::memory_order_acquire))
+                            std::this_thread::yield();
+                    }
+                }
+
+                ~LockGuard()
+                {
+                    if (ThreadSafe)
+                        lock_.clear(std::memory_order_release);
+                }
+
+            private:
+
+                std::atomic_flag& lock_;
+
+        };
+
+    private:
+
+        // Returns the home position of the specified key (Fibonacci hashing of the object address).
+        std::size_t HashKey(const T* key) const
+        {
+            const auto addr = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+            return static_cast<std::size_t>((addr * 0x9E3779B97F4A7C15ull) >> 32) & (table_.size() - 1);
+        }
+
+        void InsertIntoTable(const T* key, std::uint32_t slot)
+        {
+            const auto mask = table_.size() - 1;
+            auto pos = HashKey(key);
+            while (table_[pos].key != nullptr)
+                pos = (pos + 1) & mask;
+            table_[pos].key     = key;
+            table_[pos].slot    = slot;
+        }
+
+        std::uint32_t FindInTable(const T* key) const
+        {
+            if (table_.empty() || key == nullptr)
+                return g_invalidSlot;
+
+            const auto mask = table_.size() - 1;
+            for (auto pos = HashKey(key); table_[pos].key != nullptr; pos = (pos + 1) & mask)
+            {
+                if (table_[pos].key == key)
+                    return table_[pos].slot;
+            }
+
+            return g_invalidSlot;
+        }
+
+        // Removes the specified key with backward-shift deletion, so linear probing does not need tombstones.
+        std::uint32_t RemoveFromTable(const T* key)
+        {
+            if (table_.empty() || key == nullptr)
+                return g_invalidSlot;
+
+            const auto mask = table_.size() - 1;
+
+            auto pos = HashKey(key);
+            while (table_[pos].key != key)
+            {
+                if (table_[pos].key == nullptr)
+                    return g_invalidSlot;
+                pos = (pos + 1) & mask;
+            }
+
+            const auto slot = table_[pos].slot;
+
+            for (auto next = (pos + 1) & mask; table_[next].key != nullptr; next = (next + 1) & mask)
+            {
+                /* Move entry into the gap if its home position is not within the range (pos, next] */
+                const auto home = HashKey(table_[next].key);
+                if (((next - home) & mask) >= ((next - pos) & mask))
+                {
+                    table_[pos] = table_[next];
+                    pos = next;
+                }
+            }
+
+            table_[pos] = TableEntry{};
+
+            return slot;
+        }
+
+        void RehashTable(std::size_t capacity)
+        {
+            std::vector<TableEntry> oldTable(capacity);
+            oldTable.swap(table_);
+            for (const auto& entry : oldTable)
+            {
+                if (entry.key != nullptr)
+                    InsertIntoTable(entry.key, entry.slot);
+            }
+        }
+
+    private:
+
+        std::vector<HWObjectInstance<T>>    slots_;
+        std::vector<std::uint32_t>          freeSlots_;
+        std::vector<TableEntry>             table_;     // Capacity is a power of two and at least twice the number of objects
+        std::atomic<std::size_t>            size_       { 0 };
+        mutable std::atomic_flag            lock_       = ATOMIC_FLAG_INIT;
+
+};
+
+// Takes ownership of the specified object and returns its raw pointer.
+template <typename BaseType, bool ThreadSafe, typename SubType>
+SubType* TakeOwnership(HWObjectContainer<BaseType, ThreadSafe>& objectSet, std::unique_ptr<SubType>&& object)
+{
+    auto ref = object.get();
+    objectSet.insert(std::unique_ptr<BaseType>(std::move(object)));
+    return ref;
+}
+
+// Destroys the specified object if it is stored in the container.
+template <typename T, bool ThreadSafe, typename TBase>
+void RemoveFromUniqueSet(HWObjectContainer<T, ThreadSafe>& cont, const TBase* entry)
+{
+    if (entry)
+        cont.erase(static_cast<const T*>(entry));
+}
 
 
 } // /namespace LLGL
@@ -24,6 +24,7 @@
 #include <LLGL/IndirectArguments.h>
 #include <LLGL/Strings.h>
 #include <algorithm>
+#include <vector>
 
 
 namespace LLGL
@@ -59,13 +60,14 @@ DbgCommandBuffer::DbgCommandBuffer(
     const CommandBufferDescriptor&  desc,
     const RenderingCapabilities&    caps)
 :
-    instance   { commandBufferInstance                                             },
-    desc       { desc                                                              },
-    debugger_  { debugger                                                          },
-    profiler_  { profiler                                                          },
-    features_  { caps.features                                                     },
-    limits_    { caps.limits                                                       },
-    timerMngr_ { renderSystemInstance, commandQueueInstance, commandBufferInstance }
+    instance           { commandBufferInstance                                             },
+    desc               { desc                                                              },
+    debugger_          { debugger                                                          },
+    profiler_          { profiler                                                          },
+    validationEnabled_ { debugger != nullptr                                               },
+    features_          { caps.features                                                     },
+    limits_            { caps.limits                                                       },
+    timerMngr_         { renderSystemInstance, commandQueueInstance, commandBufferInstance }
 {
 }
 
@@ -73,23 +75,7 @@ DbgCommandBuffer::DbgCommandBuffer(
 
 void DbgCommandBuffer::Begin()
 {
-    /* Reset previous states */
-    ResetFrameProfile();
-    ResetBindings();
-    ResetStates();
-
-    /* Enable performance profiler if it was scheduled */
-    perfProfilerEnabled_ = (profiler_ != nullptr && profiler_->timeRecordingEnabled);
-    if (perfProfilerEnabled_)
-        timerMngr_.Reset();
-
-    /* Begin with command recording  */
-    if (debugger_)
-        EnableRecording(true);
-
-    instance.Begin();
-
-    profile_.commandBufferEncodings++;
+    BeginEncoding(false);
 }
 
 void DbgCommandBuffer::End()
@@ -97,18 +83,36 @@ void DbgCommandBuffer::End()
     /* End with command recording */
     if (debugger_)
         EnableRecording(false);
-    instance.End();
 
-    /* Resolve timer query results for performance profiler */
+    /* Close all timer queries for performance profiler; results are resolved with a latency of several encodings */
     if (perfProfilerEnabled_)
-        timerMngr_.TakeRecords(profile_.timeRecords);
+        timerMngr_.EndFrame();
+
+    instance.End();
+
+    /* Record command buffer encoding as trace scope */
+    if (profiler_ != nullptr && profiler_->traceRecordingEnabled && encodingStartTime_ > 0)
+    {
+        profiler_->RecordTraceScope("Encode", encodingStartTime_, RenderingProfiler::GetTimestamp() - encodingStartTime_);
+        encodingStartTime_ = 0;
+    }
+}
+
+bool DbgCommandBuffer::TryBegin()
+{
+    return BeginEncoding(true);
+}
+
+std::uint64_t DbgCommandBuffer::GetLastWaitTime() const
+{
+    return instance.GetLastWaitTime();
 }
 
 void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, deferredCommandBuffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
 
@@ -140,7 +144,9 @@ void DbgCommandBuffer::UpdateBuffer(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBufferRange(dstBufferDbg, dstOffset, dataSize, "destination range");
+
+        if (validationEnabled_)
+            ValidateBufferRange(dstBufferDbg, dstOffset, dataSize, "destination range");
     }
 
     LLGL_DBG_COMMAND( "UpdateBuffer", instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize) );
@@ -162,10 +168,14 @@ void DbgCommandBuffer::CopyBuffer(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBufferRange(dstBufferDbg, dstOffset, size, "destination range");
-        ValidateBufferRange(srcBufferDbg, srcOffset, size, "source range");
-        ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
-        ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+
+        if (validationEnabled_)
+        {
+            ValidateBufferRange(dstBufferDbg, dstOffset, size, "destination range");
+            ValidateBufferRange(srcBufferDbg, srcOffset, size, "source range");
+            ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+            ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+        }
     }
 
     LLGL_DBG_COMMAND( "CopyBuffer", instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size) );
@@ -189,11 +199,15 @@ void DbgCommandBuffer::CopyBufferFromTexture(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
-        //ValidateBufferRange(dstBufferDbg, dstOffset, srcSize);
-        ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
-        //ValidateTextureRegion(srcTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
-        ValidateTextureBufferCopyStrides(srcTextureDbg, rowStride, layerStride, srcRegion.extent);
+
+        if (validationEnabled_)
+        {
+            ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+            //ValidateBufferRange(dstBufferDbg, dstOffset, srcSize);
+            ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
+            //ValidateTextureRegion(srcTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
+            ValidateTextureBufferCopyStrides(srcTextureDbg, rowStride, layerStride, srcRegion.extent);
+        }
     }
 
     LLGL_DBG_COMMAND( "CopyBufferFromTexture", instance.CopyBufferFromTexture(dstBufferDbg.instance, dstOffset, srcTextureDbg.instance, srcRegion, rowStride, layerStride) );
@@ -213,18 +227,22 @@ void DbgCommandBuffer::FillBuffer(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
 
-        if (fillSize == Constants::wholeSize)
-        {
-            if (dstOffset != 0)
-                LLGL_DBG_WARN(WarningType::ImproperArgument, "non-zero argument for 'dstOffset' is ignored because 'fillSize' is set to LLGL::wholeSize");
-        }
-        else
+        if (validationEnabled_)
         {
-            if (fillSize % 4 != 0)
-                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill size is not a multiple of 4");
-            ValidateBufferRange(dstBufferDbg, dstOffset, fillSize);
+            ValidateBindBufferFlags(dstBufferDbg, BindFlags::CopyDst);
+
+            if (fillSize == Constants::wholeSize)
+            {
+                if (dstOffset != 0)
+                    LLGL_DBG_WARN(WarningType::ImproperArgument, "non-zero argument for 'dstOffset' is ignored because 'fillSize' is set to LLGL::wholeSize");
+            }
+            else
+            {
+                if (fillSize % 4 != 0)
+                    LLGL_DBG_ERROR(ErrorType::InvalidArgument, "buffer fill size is not a multiple of 4");
+                ValidateBufferRange(dstBufferDbg, dstOffset, fillSize);
+            }
         }
     }
 
@@ -247,8 +265,12 @@ void DbgCommandBuffer::CopyTexture(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
-        ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
+
+        if (validationEnabled_)
+        {
+            ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
+            ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
+        }
     }
 
     LLGL_DBG_COMMAND( "CopyTexture", instance.CopyTexture(dstTextureDbg.instance, dstLocation, srcTextureDbg.instance, srcLocation, extent) );
@@ -272,11 +294,15 @@ void DbgCommandBuffer::CopyTextureFromBuffer(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
-        //ValidateTextureRegion(dstTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
-        ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
-        //ValidateBufferRange(srcBufferDbg, srcOffset, srcSize);
-        ValidateTextureBufferCopyStrides(dstTextureDbg, rowStride, layerStride, dstRegion.extent);
+
+        if (validationEnabled_)
+        {
+            ValidateBindTextureFlags(dstTextureDbg, BindFlags::CopyDst);
+            //ValidateTextureRegion(dstTextureDbg, TextureRegion{ dstLocation.offset, dstExtent }, srcSize);
+            ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
+            //ValidateBufferRange(srcBufferDbg, srcOffset, srcSize);
+            ValidateTextureBufferCopyStrides(dstTextureDbg, rowStride, layerStride, dstRegion.extent);
+        }
     }
 
     LLGL_DBG_COMMAND( "CopyTextureFromBuffer", instance.CopyTextureFromBuffer(dstTextureDbg.instance, dstRegion, srcBufferDbg.instance, srcOffset, rowStride, layerStride) );
@@ -292,7 +318,9 @@ void DbgCommandBuffer::GenerateMips(Texture& texture)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateGenerateMips(textureDbg);
+
+        if (validationEnabled_)
+            ValidateGenerateMips(textureDbg);
     }
 
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance) );
@@ -308,7 +336,9 @@ void DbgCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateGenerateMips(textureDbg, &subresource);
+
+        if (validationEnabled_)
+            ValidateGenerateMips(textureDbg, &subresource);
     }
 
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance, subresource) );
@@ -324,7 +354,9 @@ void DbgCommandBuffer::SetViewport(const Viewport& viewport)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateViewport(viewport);
+
+        if (validationEnabled_)
+            ValidateViewport(viewport);
     }
 
     LLGL_DBG_COMMAND( "SetViewport", instance.SetViewport(viewport) );
@@ -335,27 +367,30 @@ void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport*
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
-
         AssertRecording();
-        AssertNullPointer(viewports, "viewports");
 
-        /* Validate all viewports in array */
-        if (viewports)
+        if (validationEnabled_)
         {
-            for (std::uint32_t i = 0; i < numViewports; ++i)
-                ValidateViewport(viewports[i]);
-        }
+            AssertNullPointer(viewports, "viewports");
 
-        /* Validate array size */
-        if (numViewports == 0)
-            LLGL_DBG_WARN(WarningType::PointlessOperation, "no viewports are specified");
-        else if (numViewports > limits_.maxViewports)
-        {
-            LLGL_DBG_ERROR(
-                ErrorType::InvalidArgument,
-                "viewport array index out of bounds: " +
-                std::to_string(numViewports) + " specified but limit is " + std::to_string(limits_.maxViewports)
-            );
+            /* Validate all viewports in array */
+            if (viewports)
+            {
+                for (std::uint32_t i = 0; i < numViewports; ++i)
+                    ValidateViewport(viewports[i]);
+            }
+
+            /* Validate array size */
+            if (numViewports == 0)
+                LLGL_DBG_WARN(WarningType::PointlessOperation, "no viewports are specified");
+            else if (numViewports > limits_.maxViewports)
+            {
+                LLGL_DBG_ERROR(
+                    ErrorType::InvalidArgument,
+                    "viewport array index out of bounds: " +
+                    std::to_string(numViewports) + " specified but limit is " + std::to_string(limits_.maxViewports)
+                );
+            }
         }
     }
 
@@ -375,9 +410,13 @@ void DbgCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sci
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        AssertNullPointer(scissors, "scissors");
-        if (numScissors == 0)
-            LLGL_DBG_WARN(WarningType::PointlessOperation, "no scissor rectangles are specified");
+
+        if (validationEnabled_)
+        {
+            AssertNullPointer(scissors, "scissors");
+            if (numScissors == 0)
+                LLGL_DBG_WARN(WarningType::PointlessOperation, "no scissor rectangles are specified");
+        }
     }
 
     LLGL_DBG_COMMAND( "SetScissors", instance.SetScissors(numScissors, scissors) );
@@ -421,8 +460,12 @@ void DbgCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Atta
         LLGL_DBG_SOURCE;
         AssertRecording();
         AssertInsideRenderPass();
-        for (std::uint32_t i = 0; i < numAttachments; ++i)
-            ValidateAttachmentClear(attachments[i]);
+
+        if (validationEnabled_)
+        {
+            for (std::uint32_t i = 0; i < numAttachments; ++i)
+                ValidateAttachmentClear(attachments[i]);
+        }
     }
 
     LLGL_DBG_COMMAND( "ClearAttachments", instance.ClearAttachments(numAttachments, attachments) );
@@ -440,12 +483,16 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindBufferFlags(bufferDbg, BindFlags::VertexBuffer);
 
-        bindings_.vertexBufferStore[0]      = (&bufferDbg);
-        bindings_.vertexBuffers             = bindings_.vertexBufferStore;
-        bindings_.numVertexBuffers          = 1;
-        bindings_.anyNonEmptyVertexBuffer   = (bufferDbg.elements > 0);
+        if (validationEnabled_)
+        {
+            ValidateBindBufferFlags(bufferDbg, BindFlags::VertexBuffer);
+
+            bindings_.vertexBufferStore[0]      = (&bufferDbg);
+            bindings_.vertexBuffers             = bindings_.vertexBufferStore;
+            bindings_.numVertexBuffers          = 1;
+            bindings_.anyNonEmptyVertexBuffer   = (bufferDbg.elements > 0);
+        }
     }
 
     LLGL_DBG_COMMAND( "SetVertexBuffer", instance.SetVertexBuffer(bufferDbg.instance) );
@@ -461,19 +508,23 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateBindFlags(bufferArrayDbg.GetBindFlags(), BindFlags::VertexBuffer, BindFlags::VertexBuffer, "LLGL::BufferArray");
-
-        bindings_.vertexBuffers         = bufferArrayDbg.buffers.data();
-        bindings_.numVertexBuffers      = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
 
-        /* Check if all vertex buffers are empty */
-        bindings_.anyNonEmptyVertexBuffer = false;
-        for (auto buffer : bufferArrayDbg.buffers)
+        if (validationEnabled_)
         {
-            if (buffer->elements > 0)
+            ValidateBindFlags(bufferArrayDbg.GetBindFlags(), BindFlags::VertexBuffer, BindFlags::VertexBuffer, "LLGL::BufferArray");
+
+            bindings_.vertexBuffers         = bufferArrayDbg.buffers.data();
+            bindings_.numVertexBuffers      = static_cast<std::uint32_t>(bufferArrayDbg.buffers.size());
+
+            /* Check if all vertex buffers are empty */
+            bindings_.anyNonEmptyVertexBuffer = false;
+            for (auto buffer : bufferArrayDbg.buffers)
             {
-                bindings_.anyNonEmptyVertexBuffer = true;
-                break;
+                if (buffer->elements > 0)
+                {
+                    bindings_.anyNonEmptyVertexBuffer = true;
+                    break;
+                }
             }
         }
     }
@@ -492,12 +543,15 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
         LLGL_DBG_SOURCE;
         AssertRecording();
 
-        ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
-        ValidateIndexType(bufferDbg.desc.format);
+        if (validationEnabled_)
+        {
+            ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
+            ValidateIndexType(bufferDbg.desc.format);
 
-        bindings_.indexBuffer           = (&bufferDbg);
-        bindings_.indexBufferFormatSize = 0;
-        bindings_.indexBufferOffset     = 0;
+            bindings_.indexBuffer           = (&bufferDbg);
+            bindings_.indexBufferFormatSize = 0;
+            bindings_.indexBufferOffset     = 0;
+        }
     }
 
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance) );
@@ -515,20 +569,23 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::
         LLGL_DBG_SOURCE;
         AssertRecording();
 
-        ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
-        ValidateIndexType(format);
+        if (validationEnabled_)
+        {
+            ValidateBindBufferFlags(bufferDbg, BindFlags::IndexBuffer);
+            ValidateIndexType(format);
 
-        bindings_.indexBuffer           = (&bufferDbg);
-        bindings_.indexBufferFormatSize = (GetFormatAttribs(format).bitSize / 8);
-        bindings_.indexBufferOffset     = offset;
+            bindings_.indexBuffer           = (&bufferDbg);
+            bindings_.indexBufferFormatSize = (GetFormatAttribs(format).bitSize / 8);
+            bindings_.indexBufferOffset     = offset;
 
-        if (offset > bufferDbg.desc.size)
-        {
-            LLGL_DBG_ERROR(
-                ErrorType::InvalidArgument,
-                "index buffer offset out of bounds: " + std::to_string(offset) +
-                " specified but limit is " + std::to_string(bufferDbg.desc.size)
-            );
+            if (offset > bufferDbg.desc.size)
+            {
+                LLGL_DBG_ERROR(
+                    ErrorType::InvalidArgument,
+                    "index buffer offset out of bounds: " + std::to_string(offset) +
+                    " specified but limit is " + std::to_string(bufferDbg.desc.size)
+                );
+            }
         }
     }
 
@@ -551,7 +608,9 @@ void DbgCommandBuffer::SetResourceHeap(
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateDescriptorSetIndex(firstSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
+
+        if (validationEnabled_)
+            ValidateDescriptorSetIndex(firstSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
     }
 
     LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, firstSet, bindPoint) );
@@ -570,10 +629,13 @@ void DbgCommandBuffer::SetResource(
         LLGL_DBG_SOURCE;
         AssertRecording();
 
-        if (!features_.hasDirectResourceBinding)
-            LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, "direct resource binding not supported");
+        if (validationEnabled_)
+        {
+            if (!features_.hasDirectResourceBinding)
+                LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, "direct resource binding not supported");
 
-        ValidateStageFlags(stageFlags, StageFlags::AllStages);
+            ValidateStageFlags(stageFlags, StageFlags::AllStages);
+        }
     }
 
     if (perfProfilerEnabled_)
@@ -656,7 +718,7 @@ void DbgCommandBuffer::ResetResourceSlots(
     long                bindFlags,
     long                stageFlags)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         if (numSlots == 0)
@@ -732,26 +794,29 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         LLGL_DBG_SOURCE;
         AssertRecording();
 
-        /* Bind graphics pipeline and unbind compute pipeline */
-        bindings_.pipelineState         = (&pipelineStateDbg);
-        bindings_.shaderProgram_        = nullptr;
-        bindings_.anyShaderAttributes   = false;
-
-        if (pipelineStateDbg.isGraphicsPSO)
+        if (validationEnabled_)
         {
-            if (auto shaderProgram = pipelineStateDbg.graphicsDesc.shaderProgram)
+            /* Bind graphics pipeline and unbind compute pipeline */
+            bindings_.pipelineState         = (&pipelineStateDbg);
+            bindings_.shaderProgram_        = nullptr;
+            bindings_.anyShaderAttributes   = false;
+
+            if (pipelineStateDbg.isGraphicsPSO)
             {
-                auto shaderProgramDbg = LLGL_CAST(const DbgShaderProgram*, shaderProgram);
-                bindings_.shaderProgram_        = shaderProgramDbg;
-                bindings_.anyShaderAttributes   = !(shaderProgramDbg->GetVertexLayout().attributes.empty());
+                if (auto shaderProgram = pipelineStateDbg.graphicsDesc.shaderProgram)
+                {
+                    auto shaderProgramDbg = LLGL_CAST(const DbgShaderProgram*, shaderProgram);
+                    bindings_.shaderProgram_        = shaderProgramDbg;
+                    bindings_.anyShaderAttributes   = !(shaderProgramDbg->GetVertexLayout().attributes.empty());
+                }
             }
-        }
-        else
-        {
-            if (auto shaderProgram = pipelineStateDbg.computeDesc.shaderProgram)
+            else
             {
-                auto shaderProgramDbg = LLGL_CAST(const DbgShaderProgram*, shaderProgram);
-                bindings_.shaderProgram_ = shaderProgramDbg;
+                if (auto shaderProgram = pipelineStateDbg.computeDesc.shaderProgram)
+                {
+                    auto shaderProgramDbg = LLGL_CAST(const DbgShaderProgram*, shaderProgram);
+                    bindings_.shaderProgram_ = shaderProgramDbg;
+                }
             }
         }
     }
@@ -772,7 +837,7 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 //TODO: add check of opposite state to Draw* commands
 void DbgCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         if (auto pipelineStateDbg = AssertAndGetGraphicsPSO())
@@ -788,7 +853,7 @@ void DbgCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
 //TODO: add check of opposite state to Draw* commands
 void DbgCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         if (auto pipelineStateDbg = AssertAndGetGraphicsPSO())
@@ -868,7 +933,9 @@ void DbgCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-        ValidateRenderCondition(queryHeapDbg, query);
+
+        if (validationEnabled_)
+            ValidateRenderCondition(queryHeapDbg, query);
     }
 
     instance.BeginRenderCondition(queryHeapDbg.instance, query, mode);
@@ -897,51 +964,42 @@ void DbgCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const
     {
         LLGL_DBG_SOURCE;
         AssertRecording();
-
         ValidateStreamOutputs(numBuffers);
-        numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
 
-        /* Bind stream-output buffers */
-        for (std::uint32_t i = 0; i < numBuffers; ++i)
+        /* Validate stream-outputs are currently not active */
+        if (states_.streamOutputBusy)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output is already busy");
+        states_.streamOutputBusy = true;
+    }
+
+    /* Bind stream-output buffers and gather their instances from array */
+    numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
+
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+    {
+        auto bufferDbg = LLGL_CAST(DbgBuffer*, buffers[i]);
+        if (bufferDbg != nullptr)
         {
-            auto bufferDbg = LLGL_CAST(DbgBuffer*, buffers[i]);
-            if (bufferDbg != nullptr)
-            {
+            if (validationEnabled_)
                 ValidateBindBufferFlags(*bufferDbg, BindFlags::StreamOutputBuffer);
-                bindings_.streamOutputs[i] = bufferDbg;
-                bufferInstances[i] = &(bufferDbg->instance);
-            }
-            else
+            bindings_.streamOutputs[i] = bufferDbg;
+            bufferInstances[i] = &(bufferDbg->instance);
+        }
+        else
+        {
+            if (debugger_)
             {
                 LLGL_DBG_ERROR(
                     ErrorType::InvalidArgument,
                     "null pointer in array of stream-output buffers"
                 );
-                validationFailed = true;
             }
-        }
-
-        bindings_.numStreamOutputs = numBuffers;
-
-        /* Validate stream-outputs are currently not active */
-        if (states_.streamOutputBusy)
-            LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output is already busy");
-        states_.streamOutputBusy = true;
-    }
-    else
-    {
-        /* Only gather buffer instances from array */
-        numBuffers = std::min(numBuffers, LLGL_MAX_NUM_SO_BUFFERS);
-        for (std::uint32_t i = 0; i < numBuffers; ++i)
-        {
-            auto bufferDbg = LLGL_CAST(DbgBuffer*, buffers[i]);
-            if (bufferDbg != nullptr)
-                bufferInstances[i] = &(bufferDbg->instance);
-            else
-                return;
+            validationFailed = true;
         }
     }
 
+    bindings_.numStreamOutputs = numBuffers;
+
     if (!validationFailed)
         instance.BeginStreamOutput(numBuffers, bufferInstances);
 
@@ -959,10 +1017,10 @@ void DbgCommandBuffer::EndStreamOutput()
         if (!states_.streamOutputBusy)
             LLGL_DBG_ERROR(ErrorType::InvalidState, "stream-output has not started");
         states_.streamOutputBusy = false;
-
-        bindings_.numStreamOutputs = 0;
     }
 
+    bindings_.numStreamOutputs = 0;
+
     instance.EndStreamOutput();
 }
 
@@ -970,7 +1028,7 @@ void DbgCommandBuffer::EndStreamOutput()
 
 void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawCmd(numVertices, firstVertex, 1, 0);
@@ -983,7 +1041,7 @@ void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex
 
 void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, 0, 0);
@@ -996,7 +1054,7 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
 
 void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, vertexOffset, 0);
@@ -1009,7 +1067,7 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
 
 void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertInstancingSupported();
@@ -1023,7 +1081,7 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
 
 void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertInstancingSupported();
@@ -1038,7 +1096,7 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
 
 void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertInstancingSupported();
@@ -1052,7 +1110,7 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
 
 void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertInstancingSupported();
@@ -1066,7 +1124,7 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
 
 void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertInstancingSupported();
@@ -1083,7 +1141,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
@@ -1101,7 +1159,7 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::u
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
@@ -1120,7 +1178,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
@@ -1138,7 +1196,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         AssertIndirectDrawingSupported();
@@ -1157,7 +1215,7 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 void DbgCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
 
@@ -1179,7 +1237,7 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferDbg = LLGL_CAST(DbgBuffer&, buffer);
 
-    if (debugger_)
+    if (validationEnabled_)
     {
         LLGL_DBG_SOURCE;
         ValidateBindBufferFlags(bufferDbg, BindFlags::IndirectBuffer);
@@ -1192,6 +1250,68 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
     profile_.dispatchCommands++;
 }
 
+void DbgCommandBuffer::ResourceBarrier(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        AssertRecording();
+
+        if (states_.insideRenderPass)
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "cannot insert resource barrier inside a render pass");
+
+        if (validationEnabled_)
+        {
+            if (numBuffers > 0)
+                AssertNullPointer(buffers, "buffers");
+            if (numTextures > 0)
+                AssertNullPointer(textures, "textures");
+        }
+    }
+
+    /* Gather buffer and texture instances from arrays */
+    std::vector<Buffer*> bufferInstances;
+    std::vector<Texture*> textureInstances;
+
+    if (buffers != nullptr)
+    {
+        bufferInstances.reserve(numBuffers);
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+        {
+            if (auto bufferDbg = LLGL_CAST(DbgBuffer*, buffers[i]))
+                bufferInstances.push_back(&(bufferDbg->instance));
+            else if (validationEnabled_)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer in array of buffers for resource barrier");
+        }
+    }
+
+    if (textures != nullptr)
+    {
+        textureInstances.reserve(numTextures);
+        for (std::uint32_t i = 0; i < numTextures; ++i)
+        {
+            if (auto textureDbg = LLGL_CAST(DbgTexture*, textures[i]))
+                textureInstances.push_back(&(textureDbg->instance));
+            else if (validationEnabled_)
+                LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer in array of textures for resource barrier");
+        }
+    }
+
+    LLGL_DBG_COMMAND(
+        "ResourceBarrier",
+        instance.ResourceBarrier(
+            static_cast<std::uint32_t>(bufferInstances.size()),
+            bufferInstances.data(),
+            static_cast<std::uint32_t>(textureInstances.size()),
+            textureInstances.data()
+        )
+    );
+}
+
 /* ----- Debugging ----- */
 
 void DbgCommandBuffer::PushDebugGroup(const char* name)
@@ -1208,10 +1328,17 @@ void DbgCommandBuffer::PushDebugGroup(const char* name)
 
     debugGroups_.push(name);
     instance.PushDebugGroup(name);
+
+    /* Start timer scope for debug group; all commands until the next PopDebugGroup are nested in this scope */
+    if (perfProfilerEnabled_)
+        timerMngr_.Start(name, true);
 }
 
 void DbgCommandBuffer::PopDebugGroup()
 {
+    if (perfProfilerEnabled_)
+        timerMngr_.Stop();
+
     instance.PopDebugGroup();
     debugGroups_.pop();
 
@@ -1240,6 +1367,11 @@ void DbgCommandBuffer::NextProfile(FrameProfile& outputProfile)
     outputProfile.timeRecords = std::move(profile_.timeRecords);
 }
 
+void DbgCommandBuffer::NotifySubmit(CommandQueue& commandQueueInstance)
+{
+    timerMngr_.NotifySubmit(commandQueueInstance);
+}
+
 #undef LLGL_DBG_COMMAND
 
 
@@ -1247,6 +1379,50 @@ void DbgCommandBuffer::NextProfile(FrameProfile& outputProfile)
  * ======= Private: =======
  */
 
+bool DbgCommandBuffer::BeginEncoding(bool nonBlocking)
+{
+    /* Store start time of command buffer encoding for the trace, including the time the instance blocks */
+    const bool          traceEnabled    = (profiler_ != nullptr && profiler_->traceRecordingEnabled);
+    const std::uint64_t startTime       = (traceEnabled ? RenderingProfiler::GetTimestamp() : 0);
+
+    /* Begin encoding with the instance first, so a non-blocking attempt that fails leaves the states of the previous encoding untouched */
+    if (nonBlocking)
+    {
+        if (!instance.TryBegin())
+            return false;
+    }
+    else
+        instance.Begin();
+
+    if (traceEnabled)
+        encodingStartTime_ = startTime;
+
+    /* Reset previous states */
+    ResetFrameProfile();
+    ResetBindings();
+    ResetStates();
+
+    /* Enable performance profiler if it was scheduled */
+    perfProfilerEnabled_ = (profiler_ != nullptr && profiler_->timeRecordingEnabled);
+
+    /* Determine whether all commands of this encoding are validated or only the structural checks */
+    validationEnabled_ = (debugger_ != nullptr && debugger_->SampleValidation());
+
+    /* Take timer records of previous encodings whose query results are available by now */
+    timerMngr_.TakeRecords(profile_.timeRecords);
+
+    /* Begin with command recording  */
+    if (debugger_)
+        EnableRecording(true);
+
+    if (perfProfilerEnabled_)
+        timerMngr_.BeginFrame();
+
+    profile_.commandBufferEncodings++;
+
+    return true;
+}
+
 void DbgCommandBuffer::EnableRecording(bool enable)
 {
     if (debugger_)
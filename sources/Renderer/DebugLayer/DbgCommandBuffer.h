@@ -54,6 +54,9 @@ class DbgCommandBuffer final : public CommandBuffer
         void Begin() override;
         void End() override;
 
+        bool TryBegin() override;
+        std::uint64_t GetLastWaitTime() const override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -225,6 +228,13 @@ class DbgCommandBuffer final : public CommandBuffer
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
         void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
 
+        void ResourceBarrier(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures = 0,
+            Texture* const *    textures    = nullptr
+        ) override;
+
         /* ----- Debugging ----- */
 
         void PushDebugGroup(const char* name) override;
@@ -240,6 +250,9 @@ class DbgCommandBuffer final : public CommandBuffer
 
         void NextProfile(FrameProfile& outputProfile);
 
+        // Notifies this command buffer that it has been submitted to the specified command queue instance.
+        void NotifySubmit(CommandQueue& commandQueueInstance);
+
     public:
 
         /* ----- Debugging members ----- */
@@ -249,6 +262,8 @@ class DbgCommandBuffer final : public CommandBuffer
 
     private:
 
+        bool BeginEncoding(bool nonBlocking);
+
         void EnableRecording(bool enable);
 
         void ValidateGenerateMips(DbgTexture& textureDbg, const TextureSubresource* subresource = nullptr);
@@ -318,6 +333,7 @@ class DbgCommandBuffer final : public CommandBuffer
 
         RenderingDebugger*          debugger_                               = nullptr;
         RenderingProfiler*          profiler_                               = nullptr;
+        bool                        validationEnabled_                      = false;
 
         const RenderingFeatures&    features_;
         const RenderingLimits&      limits_;
@@ -326,6 +342,7 @@ class DbgCommandBuffer final : public CommandBuffer
 
         DbgQueryTimerManager        timerMngr_;
         bool                        perfProfilerEnabled_                    = false;
+        std::uint64_t               encodingStartTime_                      = 0;
 
         /* ----- Render states ----- */
 
@@ -30,7 +30,12 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, commandBuffer);
 
-    instance.Submit(commandBufferDbg.instance);
+    {
+        LLGL_DBG_TRACE_SCOPE("Submit");
+        instance.Submit(commandBufferDbg.instance);
+    }
+
+    commandBufferDbg.NotifySubmit(instance);
 
     if (profiler_)
     {
@@ -77,6 +82,25 @@ void DbgCommandQueue::WaitIdle()
     instance.WaitIdle();
 }
 
+/* ----- Fence values ----- */
+
+void DbgCommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    instance.Signal(fence, value);
+    if (profiler_)
+        profiler_->frameProfile.fenceSubmissions++;
+}
+
+void DbgCommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    instance.Wait(fence, value);
+}
+
+bool DbgCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    return instance.WaitFenceValue(fence, value, timeout);
+}
+
 
 /*
  * ======= Private: =======
@@ -29,6 +29,9 @@ namespace LLGL
 #define LLGL_DBG_ERROR_NOT_SUPPORTED(FEATURE) \
     LLGL_DBG_ERROR(ErrorType::UnsupportedFeature, std::string(FEATURE) + " not supported")
 
+#define LLGL_DBG_TRACE_SCOPE(NAME) \
+    DbgTraceScope dbgTraceScope_ { profiler_, (NAME) }
+
 
 inline void DbgSetSource(RenderingDebugger* debugger, const char* source)
 {
@@ -48,6 +51,37 @@ inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const
         debugger->PostWarning(type, message);
 }
 
+// Records a CPU-side trace scope from construction to destruction if trace recording is enabled.
+class DbgTraceScope
+{
+
+    public:
+
+        inline DbgTraceScope(RenderingProfiler* profiler, const char* annotation) :
+            profiler_   { (profiler != nullptr && profiler->traceRecordingEnabled ? profiler : nullptr) },
+            annotation_ { annotation                                                                     }
+        {
+            if (profiler_)
+                startTime_ = RenderingProfiler::GetTimestamp();
+        }
+
+        inline ~DbgTraceScope()
+        {
+            if (profiler_)
+                profiler_->RecordTraceScope(annotation_, startTime_, RenderingProfiler::GetTimestamp() - startTime_);
+        }
+
+        DbgTraceScope(const DbgTraceScope&) = delete;
+        DbgTraceScope& operator = (const DbgTraceScope&) = delete;
+
+    private:
+
+        RenderingProfiler*  profiler_   = nullptr;
+        const char*         annotation_ = nullptr;
+        std::uint64_t       startTime_  = 0;
+
+};
+
 // Sets the name of the specified debug layer object.
 template <typename T>
 inline void DbgSetObjectName(T& obj, const char* name)
@@ -10,12 +10,15 @@
 #include <LLGL/RenderSystem.h>
 #include <LLGL/CommandQueue.h>
 #include <LLGL/QueryHeap.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+static const std::size_t g_invalidIndex = ~0u;
+
 DbgQueryTimerManager::DbgQueryTimerManager(
     RenderSystem&   renderSystemInstance,
     CommandQueue&   commandQueueInstance,
@@ -25,60 +28,126 @@ DbgQueryTimerManager::DbgQueryTimerManager(
     commandQueue_  { commandQueueInstance  },
     commandBuffer_ { commandBufferInstance }
 {
+    /* Reserve all frames up front, so pointers to frames remain valid */
+    frames_.reserve(g_maxNumFramesInFlight);
 }
 
-void DbgQueryTimerManager::Reset()
+DbgQueryTimerManager::~DbgQueryTimerManager()
 {
-    records_.clear();
-    queryIndex_     = 0;
-    queryHeapIndex_ = 0;
+    for (auto& frame : frames_)
+    {
+        for (auto queryHeap : frame.queryHeaps)
+            renderSystem_.Release(*queryHeap);
+        renderSystem_.Release(*frame.fence);
+    }
 }
 
-void DbgQueryTimerManager::Start(const char* annotation)
+void DbgQueryTimerManager::BeginFrame()
 {
-    /* Store annotation only first */
-    ProfileTimeRecord record;
+    /* Acquire next frame that is not in flight */
+    currentFrame_ = &(frames_[AcquireFrame()]);
     {
-        record.annotation   = annotation;
-        record.elapsedTime  = 0;
+        currentFrame_->numQueries = 0;
+        currentFrame_->records.clear();
+        currentFrame_->parents.clear();
+        currentFrame_->segments.clear();
+        currentFrame_->pending = false;
     }
-    records_.push_back(record);
+    scopeStack_.clear();
+}
 
-    /* Check if end of query heap has been reached */
-    if (queryIndex_ == g_queryHeapSize)
+void DbgQueryTimerManager::EndFrame()
+{
+    if (currentFrame_ != nullptr)
     {
-        queryIndex_ = 0;
-        ++queryHeapIndex_;
-    }
+        /* Close all remaining timer scopes */
+        while (!scopeStack_.empty())
+            Stop();
 
-    /* Check if new query heap must be created */
-    if (queryHeapIndex_ == queryHeaps_.size())
-    {
-        QueryHeapDescriptor queryDesc;
+        /* Schedule frame for deferred query resolution */
+        if (!currentFrame_->records.empty())
         {
-            queryDesc.type          = QueryType::TimeElapsed;
-            queryDesc.numQueries    = g_queryHeapSize;
+            currentFrame_->baseTime     = RenderingProfiler::GetTimestamp();
+            currentFrame_->pending      = true;
+            currentFrame_->submitted    = false;
+            pendingFrames_.push_back(static_cast<std::size_t>(currentFrame_ - frames_.data()));
         }
-        queryHeaps_.push_back(renderSystem_.CreateQueryHeap(queryDesc));
+
+        currentFrame_ = nullptr;
     }
+}
 
-    /* Begin timer query */
-    commandBuffer_.BeginQuery(*queryHeaps_[queryHeapIndex_], queryIndex_);
+void DbgQueryTimerManager::Start(const char* annotation, bool copyAnnotation)
+{
+    if (currentFrame_ == nullptr)
+        return;
+
+    /* Store annotation only first */
+    ProfileTimeRecord record;
+    {
+        record.annotation   = (copyAnnotation ? CopyAnnotation(annotation) : annotation);
+        record.elapsedTime  = 0;
+        record.startTime    = 0;
+    }
+    currentFrame_->records.push_back(record);
+    currentFrame_->parents.push_back(scopeStack_.empty() ? g_invalidIndex : scopeStack_.back());
+
+    /* Interrupt segment of parent scope, since timer queries must not overlap */
+    if (!scopeStack_.empty())
+        EndSegment();
+
+    /* Begin first segment of new timer scope */
+    const auto recordIndex = currentFrame_->records.size() - 1;
+    scopeStack_.push_back(recordIndex);
+    BeginSegment(recordIndex);
 }
 
 void DbgQueryTimerManager::Stop()
 {
-    /* Stop timer query */
-    commandBuffer_.EndQuery(*queryHeaps_[queryHeapIndex_], queryIndex_);
+    if (currentFrame_ == nullptr || scopeStack_.empty())
+        return;
 
-    /* Increase queyr index */
-    ++queryIndex_;
+    /* End segment of current timer scope */
+    EndSegment();
+    scopeStack_.pop_back();
+
+    /* Continue with next segment of parent scope */
+    if (!scopeStack_.empty())
+        BeginSegment(scopeStack_.back());
 }
 
 void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& records)
 {
-    ResolveQueryResults();
-    records = std::move(records_);
+    /* Resolve pending frames in submission order, but only as long as results are available */
+    std::size_t numResolvedFrames = 0;
+
+    for (auto frameIndex : pendingFrames_)
+    {
+        auto& frame = frames_[frameIndex];
+        if (!ResolveQueryResults(frame))
+            break;
+
+        records.insert(records.end(), frame.records.begin(), frame.records.end());
+        frame.pending = false;
+
+        ++numResolvedFrames;
+    }
+
+    pendingFrames_.erase(pendingFrames_.begin(), pendingFrames_.begin() + numResolvedFrames);
+}
+
+void DbgQueryTimerManager::NotifySubmit(CommandQueue& commandQueueInstance)
+{
+    /* Submit fences after the command buffer, so a dropped frame can wait until the GPU has finished its queries */
+    for (auto frameIndex : pendingFrames_)
+    {
+        auto& frame = frames_[frameIndex];
+        if (!frame.submitted)
+        {
+            commandQueueInstance.Submit(*frame.fence);
+            frame.submitted = true;
+        }
+    }
 }
 
 
@@ -86,26 +155,114 @@ void DbgQueryTimerManager::TakeRecords(std::vector<ProfileTimeRecord>& records)
  * ======= Private: =======
  */
 
-void DbgQueryTimerManager::ResolveQueryResults()
+std::size_t DbgQueryTimerManager::AcquireFrame()
 {
-    std::size_t queryHeapIdx = 0;
-    std::uint32_t queryIdx = 0;
+    /* Find frame that is not in flight */
+    for (std::size_t i = 0; i < frames_.size(); ++i)
+    {
+        if (!frames_[i].pending)
+            return i;
+    }
 
-    for (auto& rec : records_)
+    /* Allocate new frame if the limit has not been reached yet */
+    if (frames_.size() < g_maxNumFramesInFlight)
     {
-        if (queryIdx == g_queryHeapSize)
-        {
-            queryIdx = 0;
-            ++queryHeapIdx;
-        }
+        frames_.emplace_back();
+        frames_.back().fence = renderSystem_.CreateFence();
+        return frames_.size() - 1;
+    }
+
+    /*
+    Drop records of oldest frame, but its query heaps must not be reset while the GPU might still use them.
+    Only wait if its fence has been submitted; otherwise, its command buffer has not been submitted and its queries are not in flight.
+    */
+    auto frameIndex = pendingFrames_.front();
+    pendingFrames_.erase(pendingFrames_.begin());
+
+    auto& frame = frames_[frameIndex];
+    if (frame.submitted)
+        commandQueue_.WaitFence(*frame.fence, ~0ull);
+
+    frame.pending   = false;
+    frame.submitted = false;
+
+    return frameIndex;
+}
+
+void DbgQueryTimerManager::BeginSegment(std::size_t record)
+{
+    const auto queryHeapIndex   = static_cast<std::size_t>(currentFrame_->numQueries / g_queryHeapSize);
+    const auto queryIndex       = currentFrame_->numQueries % g_queryHeapSize;
 
-        while (!commandQueue_.QueryResult(*queryHeaps_[queryHeapIdx], queryIdx, 1, &(rec.elapsedTime), sizeof(rec.elapsedTime)))
+    /* Check if new query heap must be created */
+    if (queryHeapIndex == currentFrame_->queryHeaps.size())
+    {
+        QueryHeapDescriptor queryDesc;
         {
-            // dummy
+            queryDesc.type          = QueryType::TimeElapsed;
+            queryDesc.numQueries    = g_queryHeapSize;
         }
+        currentFrame_->queryHeaps.push_back(renderSystem_.CreateQueryHeap(queryDesc));
+    }
+
+    /* Begin timer query */
+    commandBuffer_.BeginQuery(*(currentFrame_->queryHeaps[queryHeapIndex]), queryIndex);
+
+    currentFrame_->segments.push_back(record);
+    currentFrame_->numQueries++;
+}
+
+void DbgQueryTimerManager::EndSegment()
+{
+    const auto query            = currentFrame_->numQueries - 1;
+    const auto queryHeapIndex   = static_cast<std::size_t>(query / g_queryHeapSize);
+    const auto queryIndex       = query % g_queryHeapSize;
+
+    /* End timer query */
+    commandBuffer_.EndQuery(*(currentFrame_->queryHeaps[queryHeapIndex]), queryIndex);
+}
+
+bool DbgQueryTimerManager::ResolveQueryResults(Frame& frame)
+{
+    /* Query results of all segments first, so a partially available frame can be tried again later */
+    queryResults_.resize(frame.numQueries);
+
+    for (std::uint32_t firstQuery = 0; firstQuery < frame.numQueries; firstQuery += g_queryHeapSize)
+    {
+        const auto queryHeapIndex   = static_cast<std::size_t>(firstQuery / g_queryHeapSize);
+        const auto numQueries       = std::min(frame.numQueries - firstQuery, std::uint32_t(g_queryHeapSize));
+        const auto dataSize         = sizeof(std::uint64_t) * numQueries;
+
+        if (!commandQueue_.QueryResult(*(frame.queryHeaps[queryHeapIndex]), 0, numQueries, &(queryResults_[firstQuery]), dataSize))
+            return false;
+    }
+
+    /* Accumulate segments into their records and lay them out consecutively on the timeline */
+    auto timeOffset = frame.baseTime;
+
+    for (std::uint32_t query = 0; query < frame.numQueries; ++query)
+    {
+        auto& record = frame.records[frame.segments[query]];
+        if (record.startTime == 0)
+            record.startTime = timeOffset;
+        record.elapsedTime += queryResults_[query];
+        timeOffset += queryResults_[query];
+    }
 
-        ++queryIdx;
+    /* Accumulate elapsed time of nested records into their parent records (children always come after their parents) */
+    for (auto i = frame.records.size(); i > 0; --i)
+    {
+        const auto parent = frame.parents[i - 1];
+        if (parent != g_invalidIndex)
+            frame.records[parent].elapsedTime += frame.records[i - 1].elapsedTime;
     }
+
+    return true;
+}
+
+const char* DbgQueryTimerManager::CopyAnnotation(const char* annotation)
+{
+    return annotations_.insert(annotation).first->c_str();
 }
 
 
@@ -12,12 +12,21 @@
 #include <LLGL/ForwardDecls.h>
 #include <LLGL/RenderingProfiler.h>
 #include <vector>
+#include <set>
+#include <string>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
+/*
+Timer manager for the rendering profiler. Records are resolved with a latency of several frames,
+so the CPU never waits for the GPU to finish the queries it has just recorded.
+Nested timer scopes are split into non-overlapping query segments, because elapsed-time queries
+cannot be nested on all backends (e.g. GL_TIME_ELAPSED); the segments are summed up on resolve.
+*/
 class DbgQueryTimerManager
 {
 
@@ -29,36 +38,74 @@ class DbgQueryTimerManager
             CommandBuffer&  commandBufferInstance
         );
 
-        // Resets all records in this timer manager.
-        void Reset();
+        ~DbgQueryTimerManager();
+
+        // Starts recording the timer queries for a new frame, i.e. a new command buffer encoding.
+        void BeginFrame();
+
+        // Ends recording the timer queries for the current frame and closes all remaining timer scopes.
+        void EndFrame();
 
-        // Starts measuring the time with the specified annotation.
-        void Start(const char* annotation);
+        // Starts measuring the time with the specified annotation. If 'copyAnnotation' is true, the annotation string is copied.
+        void Start(const char* annotation, bool copyAnnotation = false);
 
         // Stops measing the time and stores the current record.
         void Stop();
 
-        // Moves the internal records to the specified output container.
+        // Appends the records of all frames whose query results are available to the specified output container. This never blocks.
         void TakeRecords(std::vector<ProfileTimeRecord>& records);
 
+        // Submits the fences of all frames that have been recorded since the last submission to the specified command queue.
+        void NotifySubmit(CommandQueue& commandQueueInstance);
+
     private:
 
-        // Resolves all timer values into the output records.
-        void ResolveQueryResults();
+        static const std::uint32_t  g_queryHeapSize         = 64;
+        static const std::size_t    g_maxNumFramesInFlight  = 8;
+
+        struct Frame
+        {
+            std::vector<QueryHeap*>         queryHeaps;
+            std::uint32_t                   numQueries  = 0;
+            std::vector<ProfileTimeRecord>  records;
+            std::vector<std::size_t>        parents;        // Parent record index for each record (or ~0 for root records).
+            std::vector<std::size_t>        segments;       // Record index for each query segment.
+            std::uint64_t                   baseTime    = 0;
+            Fence*                          fence       = nullptr;  // Fence that is submitted after the command buffer of this frame.
+            bool                            pending     = false;
+            bool                            submitted   = false;    // Specifies whether the fence has been submitted since the frame was recorded.
+        };
 
     private:
 
-        static const std::uint32_t g_queryHeapSize = 64;
+        // Returns the index of the next frame that is not pending anymore or allocates a new one. Waits for the oldest frame if all frames are in flight.
+        std::size_t AcquireFrame();
+
+        // Begins a new query segment for the specified record.
+        void BeginSegment(std::size_t record);
+
+        // Ends the current query segment.
+        void EndSegment();
+
+        // Tries to resolve all timer values of the specified frame without blocking. Returns false if the results are not yet available.
+        bool ResolveQueryResults(Frame& frame);
+
+        // Returns a persistent copy of the specified annotation.
+        const char* CopyAnnotation(const char* annotation);
+
+    private:
 
         RenderSystem&                   renderSystem_;
         CommandQueue&                   commandQueue_;
         CommandBuffer&                  commandBuffer_;
 
-        std::vector<QueryHeap*>         queryHeaps_;
-        std::uint32_t                   queryIndex_     = ~0u;
-        std::size_t                     queryHeapIndex_ = 0;
+        std::vector<Frame>              frames_;
+        std::vector<std::size_t>        pendingFrames_;                 // Indices of pending frames in submission order.
+        Frame*                          currentFrame_       = nullptr;
+        std::vector<std::size_t>        scopeStack_;                    // Record indices of all open timer scopes.
+        std::vector<std::uint64_t>      queryResults_;
 
-        std::vector<ProfileTimeRecord>  records_;
+        std::set<std::string>           annotations_;
 
 };
 
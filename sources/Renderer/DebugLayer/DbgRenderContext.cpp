@@ -6,20 +6,23 @@
  */
 
 #include "DbgRenderContext.h"
+#include "DbgCore.h"
 
 
 namespace LLGL
 {
 
 
-DbgRenderContext::DbgRenderContext(RenderContext& instance) :
-    instance { instance }
+DbgRenderContext::DbgRenderContext(RenderContext& instance, RenderingProfiler* profiler) :
+    instance  { instance },
+    profiler_ { profiler }
 {
     ShareSurfaceAndConfig(instance);
 }
 
 void DbgRenderContext::Present()
 {
+    LLGL_DBG_TRACE_SCOPE("Present");
     instance.Present();
 }
 
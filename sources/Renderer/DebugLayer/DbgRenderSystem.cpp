@@ -66,7 +66,7 @@ RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescripto
         commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_);
     }
 
-    return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance));
+    return TakeOwnership(renderContexts_, MakeUnique<DbgRenderContext>(*renderContextInstance, profiler_));
 }
 
 void DbgRenderSystem::Release(RenderContext& renderContext)
@@ -81,6 +81,26 @@ CommandQueue* DbgRenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* DbgRenderSystem::GetCommandQueueOfType(const CommandQueueType type)
+{
+    if (type == CommandQueueType::Graphics || !commandQueue_)
+        return GetCommandQueue();
+
+    /* Return wrapper of an existing queue if the instance has no dedicated queue of this type */
+    auto queueInstance = instance_->GetCommandQueueOfType(type);
+    if (queueInstance == &(commandQueue_->instance))
+        return commandQueue_.get();
+    if (computeQueue_ && queueInstance == &(computeQueue_->instance))
+        return computeQueue_.get();
+    if (transferQueue_ && queueInstance == &(transferQueue_->instance))
+        return transferQueue_.get();
+
+    /* Instantiate wrapper for dedicated command queue */
+    auto& queueDbg = (type == CommandQueueType::Compute ? computeQueue_ : transferQueue_);
+    queueDbg = MakeUnique<DbgCommandQueue>(*queueInstance, profiler_, debugger_);
+    return queueDbg.get();
+}
+
 /* ----- Command buffers ----- */
 
 CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
@@ -108,6 +128,8 @@ void DbgRenderSystem::Release(CommandBuffer& commandBuffer)
 
 Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateBuffer");
+
     /* Validate and store format size (if supported) */
     std::uint32_t formatSize = 0;
 
@@ -163,6 +185,8 @@ void DbgRenderSystem::Release(BufferArray& bufferArray)
 
 void DbgRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_DBG_TRACE_SCOPE("WriteBuffer");
+
     auto& dstBufferDbg = LLGL_CAST(DbgBuffer&, dstBuffer);
 
     if (debugger_)
@@ -229,6 +253,8 @@ void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateTexture");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -244,6 +270,8 @@ void DbgRenderSystem::Release(Texture& texture)
 
 void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
+    LLGL_DBG_TRACE_SCOPE("WriteTexture");
+
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
 
     if (debugger_)
@@ -261,6 +289,8 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textur
 
 void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
+    LLGL_DBG_TRACE_SCOPE("ReadTexture");
+
     auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
 
     if (debugger_)
@@ -276,10 +306,40 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
         profiler_->frameProfile.textureReads++;
 }
 
+TextureUploadRange DbgRenderSystem::ReserveTextureUpload(std::uint64_t size)
+{
+    return instance_->ReserveTextureUpload(size);
+}
+
+void DbgRenderSystem::CommitTextureUpload(const TextureUploadRange& range, Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    auto& textureDbg = LLGL_CAST(DbgTexture&, texture);
+
+    if (debugger_)
+    {
+        LLGL_DBG_SOURCE;
+        if (range.data == nullptr)
+            LLGL_DBG_ERROR(ErrorType::InvalidArgument, "cannot commit texture upload with empty staging range");
+        ValidateTextureRegion(textureDbg, textureRegion);
+        ValidateImageDataSize(textureDbg, textureRegion, format, dataType, static_cast<std::size_t>(range.size));
+    }
+
+    instance_->CommitTextureUpload(range, textureDbg.instance, textureRegion, format, dataType);
+}
+
+void DbgRenderSystem::FlushTextureUploads()
+{
+    LLGL_DBG_TRACE_SCOPE("FlushTextureUploads");
+
+    instance_->FlushTextureUploads();
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateSampler");
+
     return instance_->CreateSampler(desc);
     //return TakeOwnership(samplers_, MakeUnique<DbgSampler>());
 }
@@ -290,10 +350,17 @@ void DbgRenderSystem::Release(Sampler& sampler)
     //ReleaseDbg(samplers_, sampler);
 }
 
+SamplerCacheStatistics DbgRenderSystem::GetSamplerCacheStatistics() const
+{
+    return instance_->GetSamplerCacheStatistics();
+}
+
 /* ----- Resource Views ----- */
 
 ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateResourceHeap");
+
     if (debugger_)
     {
         LLGL_DBG_SOURCE;
@@ -356,6 +423,8 @@ void DbgRenderSystem::Release(RenderPass& renderPass)
 
 RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateRenderTarget");
+
     LLGL_DBG_SOURCE;
 
     auto instanceDesc = desc;
@@ -386,6 +455,8 @@ void DbgRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* DbgRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateShader");
+
     return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc));
 }
 
@@ -401,6 +472,8 @@ static Shader* GetInstanceShader(Shader* shader)
 
 ShaderProgram* DbgRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
+    LLGL_DBG_TRACE_SCOPE("CreateShaderProgram");
+
     ShaderProgramDescriptor instanceDesc;
     {
         instanceDesc.vertexShader           = GetInstanceShader(desc.vertexShader);
@@ -444,6 +517,8 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const Blob& serializedCache)
 
 PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
+    LLGL_DBG_TRACE_SCOPE("CreatePipelineState");
+
     LLGL_DBG_SOURCE;
 
     if (debugger_)
@@ -467,6 +542,8 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescri
 
 PipelineState* DbgRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
+    LLGL_DBG_TRACE_SCOPE("CreatePipelineState");
+
     LLGL_DBG_SOURCE;
 
     if (desc.shaderProgram)
@@ -1439,7 +1516,7 @@ void DbgRenderSystem::AssertMultiSampleTextures()
 }
 
 template <typename T, typename TBase>
-void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
+void DbgRenderSystem::ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
     instance_->Release(entryDbg.instance);
@@ -53,6 +53,7 @@ class DbgRenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetCommandQueueOfType(const CommandQueueType type) override;
 
         /* ----- Command buffers ----- */
 
@@ -82,12 +83,18 @@ class DbgRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        TextureUploadRange ReserveTextureUpload(std::uint64_t size) override;
+        void CommitTextureUpload(const TextureUploadRange& range, Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType) override;
+        void FlushTextureUploads() override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Views ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -192,7 +199,7 @@ class DbgRenderSystem final : public RenderSystem
         void AssertMultiSampleTextures();
 
         template <typename T, typename TBase>
-        void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
+        void ReleaseDbg(HWObjectContainer<T>& cont, TBase& entry);
 
     private:
 
@@ -211,6 +218,8 @@ class DbgRenderSystem final : public RenderSystem
 
         HWObjectContainer<DbgRenderContext>     renderContexts_;
         HWObjectInstance<DbgCommandQueue>       commandQueue_;
+        HWObjectInstance<DbgCommandQueue>       computeQueue_;
+        HWObjectInstance<DbgCommandQueue>       transferQueue_;
         HWObjectContainer<DbgCommandBuffer>     commandBuffers_;
         HWObjectContainer<DbgBuffer>            buffers_;
         HWObjectContainer<DbgBufferArray>       bufferArrays_;
@@ -318,12 +318,26 @@ void D3D11RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
 
 Sampler* D3D11RenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), desc));
+    auto createSampler = [this, &desc]() -> Sampler*
+    {
+        return TakeOwnership(samplers_, MakeUnique<D3D11Sampler>(device_.Get(), desc));
+    };
+
+    if (GetConfiguration().samplerCache)
+        return samplerCache_.Acquire(desc, createSampler);
+    else
+        return createSampler();
 }
 
 void D3D11RenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+SamplerCacheStatistics D3D11RenderSystem::GetSamplerCacheStatistics() const
+{
+    return samplerCache_.GetStatistics();
 }
 
 /* ----- Resource Heaps ----- */
@@ -35,6 +35,7 @@
 #include "Texture/D3D11RenderTarget.h"
 
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 #include "../DXCommon/ComPtr.h"
 
 #include <dxgi.h>
@@ -99,6 +100,8 @@ class D3D11RenderSystem final : public RenderSystem
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Heaps ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -267,6 +270,8 @@ class D3D11RenderSystem final : public RenderSystem
         HWObjectContainer<D3D11QueryHeap>       queryHeaps_;
         HWObjectContainer<D3D11Fence>           fences_;
 
+        SamplerCache                            samplerCache_;
+
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
@@ -188,8 +188,9 @@ bool D3D11Shader::LoadBinary(ID3D11Device* device, const ShaderDescriptor& shade
 {
     if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
     {
-        /* Load binary code from file */
-        byteCode_ = DXCreateBlob(ReadFileBuffer(shaderDesc.source));
+        /* Load binary code from mapped file */
+        auto fileContent = MapFileBuffer(shaderDesc.source);
+        byteCode_ = DXCreateBlob(fileContent->GetData(), fileContent->GetSize());
     }
     else
     {
@@ -864,6 +864,34 @@ void D3D12CommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
     );
 }
 
+void D3D12CommandBuffer::ResourceBarrier(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    /* Insert UAV barriers for all resources with unordered access; copy commands already transition their resources back to their usage state */
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+    {
+        if ((buffers[i]->GetBindFlags() & BindFlags::Storage) != 0)
+        {
+            auto bufferD3D = LLGL_CAST(D3D12Buffer*, buffers[i]);
+            commandContext_.InsertUAVBarrier(bufferD3D->GetResource());
+        }
+    }
+
+    for (std::uint32_t i = 0; i < numTextures; ++i)
+    {
+        if ((textures[i]->GetBindFlags() & BindFlags::Storage) != 0)
+        {
+            auto textureD3D = LLGL_CAST(D3D12Texture*, textures[i]);
+            commandContext_.InsertUAVBarrier(textureD3D->GetResource());
+        }
+    }
+
+    commandContext_.FlushResourceBarrieres();
+}
+
 /* ----- Debugging ----- */
 
 void D3D12CommandBuffer::PushDebugGroup(const char* name)
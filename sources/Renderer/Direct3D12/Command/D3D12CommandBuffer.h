@@ -213,6 +213,13 @@ class D3D12CommandBuffer final : public CommandBuffer
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
         void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
 
+        void ResourceBarrier(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures = 0,
+            Texture* const *    textures    = nullptr
+        ) override;
+
         /* ----- Debugging ----- */
 
         void PushDebugGroup(const char* name) override;
@@ -332,13 +332,29 @@ void D3D12RenderSystem::ReadTexture(Texture& texture, const TextureRegion& textu
 
 Sampler* D3D12RenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(desc));
+    auto createSampler = [this, &desc]() -> Sampler*
+    {
+        return TakeOwnership(samplers_, MakeUnique<D3D12Sampler>(desc));
+    };
+
+    if (GetConfiguration().samplerCache)
+        return samplerCache_.Acquire(desc, createSampler);
+    else
+        return createSampler();
 }
 
 void D3D12RenderSystem::Release(Sampler& sampler)
 {
-    SyncGPU();
-    RemoveFromUniqueSet(samplers_, &sampler);
+    if (samplerCache_.Release(sampler))
+    {
+        SyncGPU();
+        RemoveFromUniqueSet(samplers_, &sampler);
+    }
+}
+
+SamplerCacheStatistics D3D12RenderSystem::GetSamplerCacheStatistics() const
+{
+    return samplerCache_.GetStatistics();
 }
 
 /* ----- Resource Heaps ----- */
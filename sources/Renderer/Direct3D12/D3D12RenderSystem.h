@@ -37,6 +37,7 @@
 #include "Shader/D3D12ShaderProgram.h"
 
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 #include "../DXCommon/ComPtr.h"
 #include <d3d12.h>
 #include <dxgi1_4.h>
@@ -100,6 +101,8 @@ class D3D12RenderSystem final : public RenderSystem
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Heaps ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -255,6 +258,8 @@ class D3D12RenderSystem final : public RenderSystem
         HWObjectContainer<D3D12QueryHeap>       queryHeaps_;
         HWObjectContainer<D3D12Fence>           fences_;
 
+        SamplerCache                            samplerCache_;
+
         /* ----- Other members ----- */
 
         std::vector<VideoAdapterDescriptor>     videoAdatperDescs_;
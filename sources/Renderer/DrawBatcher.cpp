@@ -0,0 +1,321 @@
+/*
+ * DrawBatcher.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/DrawBatcher.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <string>
+#include <map>
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+DrawBatcher::DrawBatcher(RenderSystem& renderSystem, const DrawBatcherDescriptor& desc) :
+    renderSystem_     { renderSystem                                         },
+    maxNumDraws_      { desc.maxNumDraws                                     },
+    maxNumInstances_  { desc.instanceDataSize > 0 ? desc.maxNumInstances : 0 },
+    instanceDataSize_ { desc.instanceDataSize                                },
+    threadPackets_    { desc.numThreads                                      }
+{
+    if (desc.numThreads == 0)
+        throw std::invalid_argument("cannot create draw batcher with zero threads");
+    if (desc.maxNumDraws == 0)
+        throw std::invalid_argument("cannot create draw batcher with zero draws");
+
+    /* Create buffer for indirect arguments of all draw packets */
+    BufferDescriptor indirectBufferDesc;
+    {
+        indirectBufferDesc.size         = sizeof(DrawIndexedIndirectArguments) * maxNumDraws_;
+        indirectBufferDesc.bindFlags    = BindFlags::IndirectBuffer;
+    }
+    indirectBuffer_ = renderSystem_.CreateBuffer(indirectBufferDesc);
+
+    /* Create optional buffer for instance data of all draw packets */
+    if (instanceDataSize_ > 0 && maxNumInstances_ > 0)
+    {
+        auto instanceBufferDesc = desc.instanceBufferDesc;
+        instanceBufferDesc.size = static_cast<std::uint64_t>(instanceDataSize_) * maxNumInstances_;
+        if (instanceBufferDesc.bindFlags == 0)
+            instanceBufferDesc.bindFlags = BindFlags::VertexBuffer;
+        instanceBuffer_ = renderSystem_.CreateBuffer(instanceBufferDesc);
+    }
+}
+
+DrawBatcher::~DrawBatcher()
+{
+    renderSystem_.Release(*indirectBuffer_);
+    if (instanceBuffer_ != nullptr)
+        renderSystem_.Release(*instanceBuffer_);
+}
+
+void DrawBatcher::AddDraw(std::uint32_t threadIndex, const DrawPacket& packet, const void* instanceData)
+{
+    if (threadIndex >= threadPackets_.size())
+        throw std::out_of_range("thread index out of range for draw batcher: " + std::to_string(threadIndex));
+
+    auto& thread = threadPackets_[threadIndex];
+
+    /* Store draw packet with the offset to its instance data */
+    const auto instanceDataOffset = (instanceDataSize_ > 0 && instanceData != nullptr ? thread.instanceData.size() : ~std::size_t(0));
+    thread.entries.push_back({ packet, threadIndex, instanceDataOffset });
+
+    if (instanceDataOffset != ~std::size_t(0))
+    {
+        const auto dataSize = static_cast<std::size_t>(instanceDataSize_) * packet.numInstances;
+        auto bytes = reinterpret_cast<const char*>(instanceData);
+        thread.instanceData.insert(thread.instanceData.end(), bytes, bytes + dataSize);
+    }
+}
+
+void DrawBatcher::Build()
+{
+    /* Gather draw packets of all threads */
+    packets_.clear();
+    for (const auto& thread : threadPackets_)
+    {
+        for (const auto& entry : thread.entries)
+            packets_.push_back(&entry);
+    }
+
+    if (packets_.size() > maxNumDraws_)
+    {
+        throw std::out_of_range(
+            "too many draw packets for draw batcher: " + std::to_string(packets_.size()) +
+            " specified, but limit is " + std::to_string(maxNumDraws_)
+        );
+    }
+
+    /* Validate number of instances before any output is modified, so a failed build leaves the previous batches intact */
+    if (instanceBuffer_ != nullptr)
+    {
+        std::uint64_t numInstances = 0;
+        for (const auto entry : packets_)
+            numInstances += entry->packet.numInstances;
+
+        if (numInstances > maxNumInstances_)
+        {
+            throw std::out_of_range(
+                "too many instances for draw batcher: " + std::to_string(numInstances) +
+                " specified, but limit is " + std::to_string(maxNumInstances_)
+            );
+        }
+    }
+
+    /* Sort draw packets by their pipeline state and resource heap */
+    SortPackets(GenerateSortKeys());
+
+    /* Write indirect arguments and instance data in sorted order, and merge consecutive draw packets with equal keys into batches */
+    arguments_.clear();
+    instanceData_.clear();
+    batches_.clear();
+
+    std::uint32_t numInstances = 0;
+
+    for (std::size_t i = 0; i < sortedPackets_.size(); ++i)
+    {
+        const auto& entry   = *sortedPackets_[i];
+        const auto& packet  = entry.packet;
+
+        DrawIndexedIndirectArguments args;
+        {
+            args.numIndices     = packet.numIndices;
+            args.numInstances   = packet.numInstances;
+            args.firstIndex     = packet.firstIndex;
+            args.vertexOffset   = packet.vertexOffset;
+            args.firstInstance  = (instanceBuffer_ != nullptr ? numInstances : packet.instanceDataIndex);
+        }
+        arguments_.push_back(args);
+
+        if (instanceBuffer_ != nullptr)
+        {
+            /* Copy instance data of this draw packet, or fill it with zeros if none was provided */
+            const auto dataSize = static_cast<std::size_t>(instanceDataSize_) * packet.numInstances;
+            if (entry.instanceDataOffset != ~std::size_t(0))
+            {
+                auto bytes = threadPackets_[entry.threadIndex].instanceData.data() + entry.instanceDataOffset;
+                instanceData_.insert(instanceData_.end(), bytes, bytes + dataSize);
+            }
+            else
+                instanceData_.resize(instanceData_.size() + dataSize, 0);
+            numInstances += packet.numInstances;
+        }
+
+        const auto commandIndex = static_cast<std::uint32_t>(i);
+        if (batches_.empty() || sortedKeys_[i] != sortedKeys_[i - 1])
+            batches_.push_back({ packet.pipelineState, packet.resourceHeap, packet.descriptorSet, commandIndex, 1 });
+        else
+            batches_.back().numCommands++;
+    }
+
+    /* Upload indirect arguments and instance data */
+    if (!arguments_.empty())
+        renderSystem_.WriteBuffer(*indirectBuffer_, 0, arguments_.data(), sizeof(DrawIndexedIndirectArguments) * arguments_.size());
+    if (!instanceData_.empty())
+        renderSystem_.WriteBuffer(*instanceBuffer_, 0, instanceData_.data(), instanceData_.size());
+}
+
+void DrawBatcher::Execute(CommandBuffer& commandBuffer) const
+{
+    PipelineState*  boundPipelineState  = nullptr;
+    ResourceHeap*   boundResourceHeap   = nullptr;
+    std::uint32_t   boundDescriptorSet  = 0;
+
+    for (const auto& batch : batches_)
+    {
+        /* Set pipeline state and resource heap only if they have changed */
+        if (batch.pipelineState != boundPipelineState)
+        {
+            commandBuffer.SetPipelineState(*batch.pipelineState);
+            boundPipelineState = batch.pipelineState;
+        }
+        if (batch.resourceHeap != nullptr && (batch.resourceHeap != boundResourceHeap || batch.descriptorSet != boundDescriptorSet))
+        {
+            commandBuffer.SetResourceHeap(*batch.resourceHeap, batch.descriptorSet);
+            boundResourceHeap   = batch.resourceHeap;
+            boundDescriptorSet  = batch.descriptorSet;
+        }
+
+        /* Draw all commands of this batch with a single multi-draw-indirect command */
+        commandBuffer.DrawIndexedIndirect(
+            *indirectBuffer_,
+            sizeof(DrawIndexedIndirectArguments) * batch.firstCommand,
+            batch.numCommands,
+            sizeof(DrawIndexedIndirectArguments)
+        );
+    }
+}
+
+void DrawBatcher::ExecuteDirect(CommandBuffer& commandBuffer) const
+{
+    PipelineState*  boundPipelineState  = nullptr;
+    ResourceHeap*   boundResourceHeap   = nullptr;
+    std::uint32_t   boundDescriptorSet  = 0;
+
+    for (const auto& batch : batches_)
+    {
+        /* Set states in the same way as for the batched draw path */
+        if (batch.pipelineState != boundPipelineState)
+        {
+            commandBuffer.SetPipelineState(*batch.pipelineState);
+            boundPipelineState = batch.pipelineState;
+        }
+        if (batch.resourceHeap != nullptr && (batch.resourceHeap != boundResourceHeap || batch.descriptorSet != boundDescriptorSet))
+        {
+            commandBuffer.SetResourceHeap(*batch.resourceHeap, batch.descriptorSet);
+            boundResourceHeap   = batch.resourceHeap;
+            boundDescriptorSet  = batch.descriptorSet;
+        }
+
+        /* Draw each command of this batch individually */
+        for (std::uint32_t i = 0; i < batch.numCommands; ++i)
+        {
+            const auto& args = arguments_[batch.firstCommand + i];
+            commandBuffer.DrawIndexedInstanced(args.numIndices, args.numInstances, args.firstIndex, args.vertexOffset, args.firstInstance);
+        }
+    }
+}
+
+void DrawBatcher::Reset()
+{
+    for (auto& thread : threadPackets_)
+    {
+        thread.entries.clear();
+        thread.instanceData.clear();
+    }
+    packets_.clear();
+    sortedPackets_.clear();
+    arguments_.clear();
+    instanceData_.clear();
+    batches_.clear();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t DrawBatcher::GenerateSortKeys()
+{
+    /* Enumerate pipeline states and resource heap sets in order of their first occurrence */
+    std::map<const PipelineState*, std::uint32_t> pipelineStateIndices;
+    std::map<std::pair<const ResourceHeap*, std::uint32_t>, std::uint32_t> resourceHeapIndices;
+
+    for (const auto entry : packets_)
+    {
+        const auto& packet = entry->packet;
+        pipelineStateIndices.insert({ packet.pipelineState, static_cast<std::uint32_t>(pipelineStateIndices.size()) });
+        resourceHeapIndices.insert({ { packet.resourceHeap, packet.descriptorSet }, static_cast<std::uint32_t>(resourceHeapIndices.size()) });
+    }
+
+    /* Combine both indices into one 64-bit key, so the pipeline state is the most significant part and the product cannot overflow */
+    const auto numResourceHeaps = static_cast<std::uint64_t>(resourceHeapIndices.size());
+
+    sortKeys_.resize(packets_.size());
+    std::uint64_t maxKey = 0;
+
+    for (std::size_t i = 0; i < packets_.size(); ++i)
+    {
+        const auto& packet = packets_[i]->packet;
+        const auto pipelineIndex = pipelineStateIndices[packet.pipelineState];
+        const auto resourceHeapIndex = resourceHeapIndices[{ packet.resourceHeap, packet.descriptorSet }];
+        sortKeys_[i] = pipelineIndex * numResourceHeaps + resourceHeapIndex;
+        maxKey = std::max(maxKey, sortKeys_[i]);
+    }
+
+    return maxKey;
+}
+
+void DrawBatcher::SortPackets(std::uint64_t maxKey)
+{
+    /* Sort with LSD radix sort on 8-bit digits, but only as many passes as the maximum key requires */
+    sortedPackets_ = packets_;
+    sortedKeys_ = sortKeys_;
+
+    std::vector<const PacketEntry*> tempPackets(packets_.size());
+    std::vector<std::uint64_t> tempKeys(packets_.size());
+
+    for (std::uint32_t shift = 0; shift < 64 && (maxKey >> shift) != 0; shift += 8)
+    {
+        /* Count occurrences of each digit */
+        std::size_t offsets[256] = {};
+        for (auto key : sortedKeys_)
+            offsets[(key >> shift) & 0xFF]++;
+
+        /* Convert counts into exclusive prefix sums */
+        std::size_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            const auto count = offset;
+            offset = sum;
+            sum += count;
+        }
+
+        /* Scatter entries into their sorted position (stable) */
+        for (std::size_t i = 0; i < sortedKeys_.size(); ++i)
+        {
+            const auto dst = offsets[(sortedKeys_[i] >> shift) & 0xFF]++;
+            tempPackets[dst]    = sortedPackets_[i];
+            tempKeys[dst]       = sortedKeys_[i];
+        }
+
+        sortedPackets_.swap(tempPackets);
+        sortedKeys_.swap(tempKeys);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,726 @@
+/*
+ * GPUCulling.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/GPUCulling.h>
+#include <LLGL/Utility.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderProgram.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal members
+ */
+
+// Number of invocations per work group of the culling compute shader.
+static const std::uint32_t g_workGroupSize = 64;
+
+// Bitmasks for GPUCullingParams::flags.
+static const std::uint32_t g_flagOcclusionCulling   = 0x1;
+static const std::uint32_t g_flagClipMinusOneToOne  = 0x2;
+static const std::uint32_t g_flagHiZUpperLeft       = 0x4;
+
+// Constant buffer of the culling compute shader (std140 layout).
+struct GPUCullingParams
+{
+    float           viewProjection[16];
+    float           planes[6][4];
+    std::uint32_t   numInstances;
+    std::uint32_t   hiZNumLevels;
+    std::uint32_t   flags;
+    std::uint32_t   pad0;
+    float           hiZSize[4];
+};
+
+/*
+The compute shader mirrors the functions IsInsideFrustum and IsOccluded below, so the CPU reference produces the same results.
+The GLSL version is 4.30 to run on OpenGL 4.3; the code can also be compiled into SPIR-V for Vulkan.
+*/
+static const char* g_cullingShaderSource =
+    "#version 430\n"
+    "\n"
+    "layout(local_size_x = 64) in;\n"
+    "\n"
+    "struct CullingInstance\n"
+    "{\n"
+    "    vec4  sphere;\n"
+    "    uvec4 meshIndex;\n"
+    "};\n"
+    "\n"
+    "struct DrawIndexedIndirectArguments\n"
+    "{\n"
+    "    uint numIndices;\n"
+    "    uint numInstances;\n"
+    "    uint firstIndex;\n"
+    "    int  vertexOffset;\n"
+    "    uint firstInstance;\n"
+    "};\n"
+    "\n"
+    "layout(std140, binding = 0) uniform CullingParams\n"
+    "{\n"
+    "    mat4  viewProjection;\n"
+    "    vec4  planes[6];\n"
+    "    uint  numInstances;\n"
+    "    uint  hiZNumLevels;\n"
+    "    uint  flags;\n"
+    "    uint  pad0;\n"
+    "    vec4  hiZSize;\n"
+    "};\n"
+    "\n"
+    "layout(std430, binding = 1) readonly buffer Instances\n"
+    "{\n"
+    "    CullingInstance instances[];\n"
+    "};\n"
+    "\n"
+    "layout(std430, binding = 2) buffer DrawArgs\n"
+    "{\n"
+    "    DrawIndexedIndirectArguments drawArgs[];\n"
+    "};\n"
+    "\n"
+    "layout(std430, binding = 3) writeonly buffer VisibleInstances\n"
+    "{\n"
+    "    uint visibleInstances[];\n"
+    "};\n"
+    "\n"
+    "#ifdef ENABLE_HIZ\n"
+    "#ifdef VULKAN\n"
+    "layout(binding = 4) uniform texture2D hiZTexture;\n"
+    "layout(binding = 5) uniform sampler hiZSampler;\n"
+    "#define HIZ_MAP sampler2D(hiZTexture, hiZSampler)\n"
+    "#else\n"
+    "layout(binding = 4) uniform sampler2D hiZTexture;\n"
+    "#define HIZ_MAP hiZTexture\n"
+    "#endif\n"
+    "#endif\n"
+    "\n"
+    "bool IsInsideFrustum(vec3 center, float radius)\n"
+    "{\n"
+    "    for (int i = 0; i < 6; ++i)\n"
+    "    {\n"
+    "        if (dot(planes[i].xyz, center) + planes[i].w < -radius)\n"
+    "            return false;\n"
+    "    }\n"
+    "    return true;\n"
+    "}\n"
+    "\n"
+    "#ifdef ENABLE_HIZ\n"
+    "\n"
+    "bool IsOccluded(vec3 center, float radius)\n"
+    "{\n"
+    "    // Project corners of the sphere's bounding box into normalized device coordinates\n"
+    "    vec3 minNDC = vec3(1.0e30);\n"
+    "    vec3 maxNDC = vec3(-1.0e30);\n"
+    "    for (int i = 0; i < 8; ++i)\n"
+    "    {\n"
+    "        vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);\n"
+    "        vec4 clipPos = viewProjection * vec4(corner, 1.0);\n"
+    "        if (clipPos.w <= 0.0)\n"
+    "            return false;\n"
+    "        vec3 ndc = clipPos.xyz / clipPos.w;\n"
+    "        minNDC = min(minNDC, ndc);\n"
+    "        maxNDC = max(maxNDC, ndc);\n"
+    "    }\n"
+    "\n"
+    "    float nearestDepth = minNDC.z;\n"
+    "    if ((flags & 2u) != 0u)\n"
+    "        nearestDepth = nearestDepth * 0.5 + 0.5;\n"
+    "\n"
+    "    // Determine screen rectangle in texture space\n"
+    "    vec2 uvMin = clamp(minNDC.xy * 0.5 + 0.5, vec2(0.0), vec2(1.0));\n"
+    "    vec2 uvMax = clamp(maxNDC.xy * 0.5 + 0.5, vec2(0.0), vec2(1.0));\n"
+    "    if ((flags & 4u) != 0u)\n"
+    "    {\n"
+    "        float minV = 1.0 - uvMax.y;\n"
+    "        uvMax.y = 1.0 - uvMin.y;\n"
+    "        uvMin.y = minV;\n"
+    "    }\n"
+    "\n"
+    "    // Select the level where the rectangle covers at most 2x2 texels\n"
+    "    vec2 extent = (uvMax - uvMin) * hiZSize.xy;\n"
+    "    int level = int(min(ceil(log2(max(max(extent.x, extent.y), 1.0))), float(hiZNumLevels - 1u)));\n"
+    "    ivec2 levelSize = textureSize(HIZ_MAP, level);\n"
+    "    ivec2 p0 = clamp(ivec2(uvMin * vec2(levelSize)), ivec2(0), levelSize - 1);\n"
+    "    ivec2 p1 = clamp(ivec2(uvMax * vec2(levelSize)), ivec2(0), levelSize - 1);\n"
+    "\n"
+    "    float maxDepth = max(\n"
+    "        max(texelFetch(HIZ_MAP, ivec2(p0.x, p0.y), level).r, texelFetch(HIZ_MAP, ivec2(p1.x, p0.y), level).r),\n"
+    "        max(texelFetch(HIZ_MAP, ivec2(p0.x, p1.y), level).r, texelFetch(HIZ_MAP, ivec2(p1.x, p1.y), level).r)\n"
+    "    );\n"
+    "\n"
+    "    return (nearestDepth > maxDepth);\n"
+    "}\n"
+    "\n"
+    "#endif\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    uint id = gl_GlobalInvocationID.x;\n"
+    "    if (id >= numInstances)\n"
+    "        return;\n"
+    "\n"
+    "    vec3  center = instances[id].sphere.xyz;\n"
+    "    float radius = instances[id].sphere.w;\n"
+    "\n"
+    "    if (!IsInsideFrustum(center, radius))\n"
+    "        return;\n"
+    "\n"
+    "    #ifdef ENABLE_HIZ\n"
+    "    if ((flags & 1u) != 0u && IsOccluded(center, radius))\n"
+    "        return;\n"
+    "    #endif\n"
+    "\n"
+    "    // Append instance to the range of its mesh\n"
+    "    uint mesh = instances[id].meshIndex.x;\n"
+    "    uint slot = atomicAdd(drawArgs[mesh].numInstances, 1u);\n"
+    "    visibleInstances[drawArgs[mesh].firstInstance + slot] = id;\n"
+    "}\n"
+;
+
+// Extracts the normalized frustum planes (inside is positive) from the column-major view-projection matrix.
+static void ExtractFrustumPlanes(const GPUCullingView& view, float (&planes)[6][4])
+{
+    const auto& m = view.viewProjection;
+
+    /* Gribb-Hartmann: combine rows of the matrix */
+    for (int i = 0; i < 4; ++i)
+    {
+        const float row0 = m[i*4 + 0];
+        const float row1 = m[i*4 + 1];
+        const float row2 = m[i*4 + 2];
+        const float row3 = m[i*4 + 3];
+
+        planes[0][i] = row3 + row0; // Left
+        planes[1][i] = row3 - row0; // Right
+        planes[2][i] = row3 + row1; // Bottom
+        planes[3][i] = row3 - row1; // Top
+        planes[4][i] = (view.clippingRange == ClippingRange::MinusOneToOne ? row3 + row2 : row2); // Near
+        planes[5][i] = row3 - row2; // Far
+    }
+
+    for (auto& plane : planes)
+    {
+        const float len = std::sqrt(plane[0]*plane[0] + plane[1]*plane[1] + plane[2]*plane[2]);
+        if (len > 0.0f)
+        {
+            for (auto& component : plane)
+                component /= len;
+        }
+    }
+}
+
+static bool IsInsideFrustum(const float (&planes)[6][4], const float* center, float radius)
+{
+    for (const auto& plane : planes)
+    {
+        if (plane[0]*center[0] + plane[1]*center[1] + plane[2]*center[2] + plane[3] < -radius)
+            return false;
+    }
+    return true;
+}
+
+static bool IsOccluded(const GPUCullingView& view, const HiZPyramid& hiZPyramid, const float* center, float radius)
+{
+    const auto& m = view.viewProjection;
+
+    /* Project corners of the sphere's bounding box into normalized device coordinates */
+    float minNDC[3] = { 1.0e30f, 1.0e30f, 1.0e30f };
+    float maxNDC[3] = { -1.0e30f, -1.0e30f, -1.0e30f };
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const float corner[3] =
+        {
+            center[0] + radius * ((i & 1) != 0 ? 1.0f : -1.0f),
+            center[1] + radius * ((i & 2) != 0 ? 1.0f : -1.0f),
+            center[2] + radius * ((i & 4) != 0 ? 1.0f : -1.0f),
+        };
+
+        float clipPos[4];
+        for (int r = 0; r < 4; ++r)
+            clipPos[r] = m[r] * corner[0] + m[4 + r] * corner[1] + m[8 + r] * corner[2] + m[12 + r];
+
+        /* Bounding box crosses the near plane, so treat the instance as visible */
+        if (clipPos[3] <= 0.0f)
+            return false;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            const float ndc = clipPos[c] / clipPos[3];
+            minNDC[c] = std::min(minNDC[c], ndc);
+            maxNDC[c] = std::max(maxNDC[c], ndc);
+        }
+    }
+
+    float nearestDepth = minNDC[2];
+    if (view.clippingRange == ClippingRange::MinusOneToOne)
+        nearestDepth = nearestDepth * 0.5f + 0.5f;
+
+    /* Determine screen rectangle in texture space */
+    float uvMin[2], uvMax[2];
+    for (int c = 0; c < 2; ++c)
+    {
+        uvMin[c] = std::max(0.0f, std::min(minNDC[c] * 0.5f + 0.5f, 1.0f));
+        uvMax[c] = std::max(0.0f, std::min(maxNDC[c] * 0.5f + 0.5f, 1.0f));
+    }
+    if (view.hiZOrigin == ScreenOrigin::UpperLeft)
+    {
+        const float minV = 1.0f - uvMax[1];
+        uvMax[1] = 1.0f - uvMin[1];
+        uvMin[1] = minV;
+    }
+
+    /* Select the level where the rectangle covers at most 2x2 texels */
+    const auto& baseExtent = hiZPyramid.extents.front();
+    const float extentX = (uvMax[0] - uvMin[0]) * static_cast<float>(baseExtent.width);
+    const float extentY = (uvMax[1] - uvMin[1]) * static_cast<float>(baseExtent.height);
+    const float maxLevel = static_cast<float>(hiZPyramid.levels.size() - 1);
+    const auto level = static_cast<std::size_t>(std::min(std::ceil(std::log2(std::max(std::max(extentX, extentY), 1.0f))), maxLevel));
+
+    const auto& levelExtent = hiZPyramid.extents[level];
+    const auto& levelData = hiZPyramid.levels[level];
+
+    auto TexelCoord = [](float uv, std::uint32_t size) -> std::uint32_t
+    {
+        const auto coord = static_cast<std::int32_t>(uv * static_cast<float>(size));
+        return static_cast<std::uint32_t>(std::max(0, std::min(coord, static_cast<std::int32_t>(size) - 1)));
+    };
+
+    const auto x0 = TexelCoord(uvMin[0], levelExtent.width);
+    const auto y0 = TexelCoord(uvMin[1], levelExtent.height);
+    const auto x1 = TexelCoord(uvMax[0], levelExtent.width);
+    const auto y1 = TexelCoord(uvMax[1], levelExtent.height);
+
+    const float maxDepth = std::max(
+        std::max(levelData[y0 * levelExtent.width + x0], levelData[y0 * levelExtent.width + x1]),
+        std::max(levelData[y1 * levelExtent.width + x0], levelData[y1 * levelExtent.width + x1])
+    );
+
+    return (nearestDepth > maxDepth);
+}
+
+// Returns the offset of each mesh's range in the visible instance buffer.
+static std::vector<std::uint32_t> GetMeshInstanceOffsets(
+    const std::vector<GPUCullingMesh>&  meshes,
+    const GPUCullingInstance*           instances,
+    std::uint32_t                       numInstances)
+{
+    /* Count instances per mesh */
+    std::vector<std::uint32_t> offsets(meshes.size(), 0);
+
+    for (std::uint32_t i = 0; i < numInstances; ++i)
+    {
+        const auto meshIndex = instances[i].meshIndex;
+        if (meshIndex >= meshes.size())
+        {
+            throw std::out_of_range(
+                "mesh index out of range for GPU culling instance " + std::to_string(i) + ": " +
+                std::to_string(meshIndex) + " specified, but limit is " + std::to_string(meshes.size())
+            );
+        }
+        offsets[meshIndex]++;
+    }
+
+    /* Convert counts into exclusive prefix sums */
+    std::uint32_t sum = 0;
+    for (auto& offset : offsets)
+    {
+        const auto count = offset;
+        offset = sum;
+        sum += count;
+    }
+
+    return offsets;
+}
+
+static void InitializeDrawArgs(
+    const std::vector<GPUCullingMesh>&          meshes,
+    const std::vector<std::uint32_t>&           offsets,
+    std::vector<DrawIndexedIndirectArguments>&  drawArgs)
+{
+    drawArgs.resize(meshes.size());
+    for (std::size_t i = 0; i < meshes.size(); ++i)
+    {
+        auto& args = drawArgs[i];
+        {
+            args.numIndices     = meshes[i].numIndices;
+            args.numInstances   = 0;
+            args.firstIndex     = meshes[i].firstIndex;
+            args.vertexOffset   = meshes[i].vertexOffset;
+            args.firstInstance  = offsets[i];
+        }
+    }
+}
+
+
+/*
+ * GPUCulling class
+ */
+
+GPUCulling::GPUCulling(RenderSystem& renderSystem, const GPUCullingDescriptor& desc) :
+    renderSystem_    { renderSystem         },
+    meshes_          { desc.meshes          },
+    maxNumInstances_ { desc.maxNumInstances },
+    hiZTexture_      { desc.hiZTexture      }
+{
+    if (desc.meshes.empty())
+        throw std::invalid_argument("cannot create GPU culling without meshes");
+    if (desc.maxNumInstances == 0)
+        throw std::invalid_argument("cannot create GPU culling with zero instances");
+    if (!renderSystem_.GetRenderingCaps().features.hasComputeShaders)
+        throw std::runtime_error("cannot create GPU culling without support for compute shaders");
+
+    if (hiZTexture_ != nullptr)
+    {
+        const auto extent = hiZTexture_->GetMipExtent(0);
+        hiZExtent_      = { extent.width, extent.height };
+        hiZNumLevels_   = hiZTexture_->GetDesc().mipLevels;
+    }
+
+    CreateBuffers(desc);
+    CreateComputePipeline(desc);
+}
+
+GPUCulling::~GPUCulling()
+{
+    renderSystem_.Release(*resourceHeap_);
+    renderSystem_.Release(*pipelineState_);
+    renderSystem_.Release(*pipelineLayout_);
+    renderSystem_.Release(*shaderProgram_);
+    if (ownsComputeShader_)
+        renderSystem_.Release(*computeShader_);
+    if (hiZSampler_ != nullptr)
+        renderSystem_.Release(*hiZSampler_);
+    renderSystem_.Release(*paramsBuffer_);
+    renderSystem_.Release(*instanceBuffer_);
+    renderSystem_.Release(*drawArgsBuffer_);
+    renderSystem_.Release(*drawArgsInitBuffer_);
+    renderSystem_.Release(*visibleInstanceBuffer_);
+}
+
+void GPUCulling::SetInstances(const GPUCullingInstance* instances, std::uint32_t numInstances)
+{
+    if (numInstances > maxNumInstances_)
+    {
+        throw std::out_of_range(
+            "too many instances for GPU culling: " + std::to_string(numInstances) +
+            " specified, but limit is " + std::to_string(maxNumInstances_)
+        );
+    }
+
+    /* Write initial indirect arguments with the range of each mesh, which are copied into the argument buffer before each culling pass */
+    std::vector<DrawIndexedIndirectArguments> drawArgs;
+    InitializeDrawArgs(meshes_, GetMeshInstanceOffsets(meshes_, instances, numInstances), drawArgs);
+    renderSystem_.WriteBuffer(*drawArgsInitBuffer_, 0, drawArgs.data(), sizeof(DrawIndexedIndirectArguments) * drawArgs.size());
+
+    if (numInstances > 0)
+        renderSystem_.WriteBuffer(*instanceBuffer_, 0, instances, sizeof(GPUCullingInstance) * numInstances);
+
+    numInstances_ = numInstances;
+}
+
+void GPUCulling::Dispatch(CommandBuffer& commandBuffer, const GPUCullingView& view)
+{
+    /* Update culling parameters */
+    GPUCullingParams params;
+    {
+        ::memcpy(params.viewProjection, view.viewProjection, sizeof(params.viewProjection));
+        ExtractFrustumPlanes(view, params.planes);
+        params.numInstances = numInstances_;
+        params.hiZNumLevels = hiZNumLevels_;
+        params.flags        = 0;
+        params.pad0         = 0;
+        params.hiZSize[0]   = static_cast<float>(hiZExtent_.width);
+        params.hiZSize[1]   = static_cast<float>(hiZExtent_.height);
+        params.hiZSize[2]   = 0.0f;
+        params.hiZSize[3]   = 0.0f;
+
+        if (view.occlusionCulling && hiZTexture_ != nullptr)
+            params.flags |= g_flagOcclusionCulling;
+        if (view.clippingRange == ClippingRange::MinusOneToOne)
+            params.flags |= g_flagClipMinusOneToOne;
+        if (view.hiZOrigin == ScreenOrigin::UpperLeft)
+            params.flags |= g_flagHiZUpperLeft;
+    }
+    commandBuffer.UpdateBuffer(*paramsBuffer_, 0, &params, sizeof(params));
+
+    /* Reset number of instances of all indirect arguments */
+    commandBuffer.CopyBuffer(*drawArgsBuffer_, 0, *drawArgsInitBuffer_, 0, sizeof(DrawIndexedIndirectArguments) * meshes_.size());
+
+    if (numInstances_ > 0)
+    {
+        /* Synchronize the copied indirect arguments with the compute shader that increments them */
+        commandBuffer.ResourceBarrier(1, &drawArgsBuffer_);
+
+        commandBuffer.SetPipelineState(*pipelineState_);
+        commandBuffer.SetResourceHeap(*resourceHeap_);
+        commandBuffer.Dispatch((numInstances_ + g_workGroupSize - 1) / g_workGroupSize, 1, 1);
+    }
+
+    /* Synchronize the written indirect arguments and visible instances with the subsequent draw commands */
+    Buffer* const writtenBuffers[] = { drawArgsBuffer_, visibleInstanceBuffer_ };
+    commandBuffer.ResourceBarrier(2, writtenBuffers);
+}
+
+void GPUCulling::Draw(CommandBuffer& commandBuffer) const
+{
+    commandBuffer.DrawIndexedIndirect(*drawArgsBuffer_, 0, GetNumMeshes(), sizeof(DrawIndexedIndirectArguments));
+}
+
+const char* GPUCulling::GetShaderSource()
+{
+    return g_cullingShaderSource;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GPUCulling::CreateBuffers(const GPUCullingDescriptor& desc)
+{
+    /* Create constant buffer for culling parameters */
+    BufferDescriptor paramsBufferDesc;
+    {
+        paramsBufferDesc.size       = sizeof(GPUCullingParams);
+        paramsBufferDesc.bindFlags  = BindFlags::ConstantBuffer;
+        paramsBufferDesc.miscFlags  = MiscFlags::DynamicUsage;
+    }
+    paramsBuffer_ = renderSystem_.CreateBuffer(paramsBufferDesc);
+
+    /* Create storage buffer for instance bounds */
+    BufferDescriptor instanceBufferDesc;
+    {
+        instanceBufferDesc.size         = sizeof(GPUCullingInstance) * maxNumInstances_;
+        instanceBufferDesc.stride       = sizeof(GPUCullingInstance);
+        instanceBufferDesc.bindFlags    = BindFlags::Storage;
+    }
+    instanceBuffer_ = renderSystem_.CreateBuffer(instanceBufferDesc);
+
+    /* Create buffer for indirect arguments, written by the compute shader and reset by copying from the initial arguments */
+    std::vector<DrawIndexedIndirectArguments> drawArgs;
+    InitializeDrawArgs(meshes_, std::vector<std::uint32_t>(meshes_.size(), 0), drawArgs);
+
+    BufferDescriptor drawArgsBufferDesc;
+    {
+        drawArgsBufferDesc.size         = sizeof(DrawIndexedIndirectArguments) * meshes_.size();
+        drawArgsBufferDesc.bindFlags    = BindFlags::Storage | BindFlags::IndirectBuffer | BindFlags::CopySrc | BindFlags::CopyDst;
+    }
+    drawArgsBuffer_ = renderSystem_.CreateBuffer(drawArgsBufferDesc, drawArgs.data());
+
+    BufferDescriptor drawArgsInitBufferDesc;
+    {
+        drawArgsInitBufferDesc.size         = sizeof(DrawIndexedIndirectArguments) * meshes_.size();
+        drawArgsInitBufferDesc.bindFlags    = BindFlags::CopySrc;
+    }
+    drawArgsInitBuffer_ = renderSystem_.CreateBuffer(drawArgsInitBufferDesc, drawArgs.data());
+
+    /* Create buffer for visible instance indices */
+    auto visibleInstanceBufferDesc = desc.visibleInstanceBufferDesc;
+    {
+        visibleInstanceBufferDesc.size = sizeof(std::uint32_t) * maxNumInstances_;
+        if (visibleInstanceBufferDesc.bindFlags == 0)
+            visibleInstanceBufferDesc.bindFlags = BindFlags::VertexBuffer;
+        visibleInstanceBufferDesc.bindFlags |= BindFlags::Storage;
+    }
+    visibleInstanceBuffer_ = renderSystem_.CreateBuffer(visibleInstanceBufferDesc);
+}
+
+void GPUCulling::CreateComputePipeline(const GPUCullingDescriptor& desc)
+{
+    /* Create compute shader from built-in GLSL code unless a shader has been specified */
+    if (desc.computeShader != nullptr)
+        computeShader_ = desc.computeShader;
+    else
+    {
+        std::string source = g_cullingShaderSource;
+        if (hiZTexture_ != nullptr)
+        {
+            /* Insert macro definition behind the version directive */
+            const auto pos = source.find('\n') + 1;
+            source.insert(pos, "#define ENABLE_HIZ\n");
+        }
+
+        ShaderDescriptor shaderDesc;
+        {
+            shaderDesc.type         = ShaderType::Compute;
+            shaderDesc.source       = source.c_str();
+            shaderDesc.sourceSize   = source.size();
+            shaderDesc.sourceType   = ShaderSourceType::CodeString;
+        }
+        computeShader_      = renderSystem_.CreateShader(shaderDesc);
+        ownsComputeShader_  = true;
+
+        if (computeShader_->HasErrors())
+            throw std::runtime_error("failed to compile GPU culling compute shader:\n" + computeShader_->GetReport());
+    }
+
+    ShaderProgramDescriptor programDesc;
+    {
+        programDesc.computeShader = computeShader_;
+    }
+    shaderProgram_ = renderSystem_.CreateShaderProgram(programDesc);
+
+    if (shaderProgram_->HasErrors())
+        throw std::runtime_error("failed to link GPU culling shader program:\n" + shaderProgram_->GetReport());
+
+    /* Create pipeline layout and resource heap */
+    ResourceHeapDescriptor resourceHeapDesc;
+
+    if (hiZTexture_ != nullptr)
+    {
+        /* Create sampler with point filtering for the hierarchical-Z pyramid (only required for separate samplers) */
+        SamplerDescriptor samplerDesc;
+        {
+            samplerDesc.addressModeU    = SamplerAddressMode::Clamp;
+            samplerDesc.addressModeV    = SamplerAddressMode::Clamp;
+            samplerDesc.addressModeW    = SamplerAddressMode::Clamp;
+            samplerDesc.minFilter       = SamplerFilter::Nearest;
+            samplerDesc.magFilter       = SamplerFilter::Nearest;
+            samplerDesc.mipMapFilter    = SamplerFilter::Nearest;
+        }
+        hiZSampler_ = renderSystem_.CreateSampler(samplerDesc);
+
+        pipelineLayout_ = renderSystem_.CreatePipelineLayout(
+            PipelineLayoutDesc(
+                "cbuffer(CullingParams@0):comp,"
+                "rwbuffer(Instances@1, DrawArgs@2, VisibleInstances@3):comp,"
+                "texture(hiZTexture@4):comp,"
+                "sampler(hiZSampler@5):comp,"
+            )
+        );
+        resourceHeapDesc.resourceViews = { paramsBuffer_, instanceBuffer_, drawArgsBuffer_, visibleInstanceBuffer_, hiZTexture_, hiZSampler_ };
+    }
+    else
+    {
+        pipelineLayout_ = renderSystem_.CreatePipelineLayout(
+            PipelineLayoutDesc(
+                "cbuffer(CullingParams@0):comp,"
+                "rwbuffer(Instances@1, DrawArgs@2, VisibleInstances@3):comp,"
+            )
+        );
+        resourceHeapDesc.resourceViews = { paramsBuffer_, instanceBuffer_, drawArgsBuffer_, visibleInstanceBuffer_ };
+    }
+
+    resourceHeapDesc.pipelineLayout = pipelineLayout_;
+    resourceHeap_ = renderSystem_.CreateResourceHeap(resourceHeapDesc);
+
+    /* Create compute pipeline */
+    ComputePipelineDescriptor pipelineDesc;
+    {
+        pipelineDesc.pipelineLayout = pipelineLayout_;
+        pipelineDesc.shaderProgram  = shaderProgram_;
+    }
+    pipelineState_ = renderSystem_.CreatePipelineState(pipelineDesc);
+}
+
+
+/*
+ * Global functions
+ */
+
+LLGL_EXPORT void BuildHiZPyramid(const float* depthData, const Extent2D& extent, HiZPyramid& pyramid)
+{
+    pyramid.extents.clear();
+    pyramid.levels.clear();
+
+    if (depthData == nullptr || extent.width == 0 || extent.height == 0)
+        return;
+
+    /* Copy depth buffer into first level */
+    pyramid.extents.push_back(extent);
+    pyramid.levels.emplace_back(depthData, depthData + extent.width * extent.height);
+
+    /* Reduce each level to the next one until it is 1x1 */
+    while (pyramid.extents.back().width > 1 || pyramid.extents.back().height > 1)
+    {
+        const auto srcExtent = pyramid.extents.back();
+        const Extent2D dstExtent{ std::max(1u, srcExtent.width / 2), std::max(1u, srcExtent.height / 2) };
+
+        std::vector<float> dstLevel(dstExtent.width * dstExtent.height);
+        const auto& srcLevel = pyramid.levels.back();
+
+        for (std::uint32_t y = 0; y < dstExtent.height; ++y)
+        {
+            /* Cover all source texels, including the last row and column of odd extents */
+            const auto srcY0 = y * srcExtent.height / dstExtent.height;
+            const auto srcY1 = ((y + 1) * srcExtent.height + dstExtent.height - 1) / dstExtent.height;
+
+            for (std::uint32_t x = 0; x < dstExtent.width; ++x)
+            {
+                const auto srcX0 = x * srcExtent.width / dstExtent.width;
+                const auto srcX1 = ((x + 1) * srcExtent.width + dstExtent.width - 1) / dstExtent.width;
+
+                float maxDepth = srcLevel[srcY0 * srcExtent.width + srcX0];
+                for (auto srcY = srcY0; srcY < srcY1; ++srcY)
+                {
+                    for (auto srcX = srcX0; srcX < srcX1; ++srcX)
+                        maxDepth = std::max(maxDepth, srcLevel[srcY * srcExtent.width + srcX]);
+                }
+
+                dstLevel[y * dstExtent.width + x] = maxDepth;
+            }
+        }
+
+        pyramid.extents.push_back(dstExtent);
+        pyramid.levels.push_back(std::move(dstLevel));
+    }
+}
+
+LLGL_EXPORT void CullInstancesCPU(
+    const GPUCullingView&                       view,
+    const std::vector<GPUCullingMesh>&          meshes,
+    const GPUCullingInstance*                   instances,
+    std::uint32_t                               numInstances,
+    const HiZPyramid*                           hiZPyramid,
+    std::vector<DrawIndexedIndirectArguments>&  drawArgs,
+    std::vector<std::uint32_t>&                 visibleInstances)
+{
+    InitializeDrawArgs(meshes, GetMeshInstanceOffsets(meshes, instances, numInstances), drawArgs);
+    visibleInstances.assign(numInstances, 0);
+
+    float planes[6][4];
+    ExtractFrustumPlanes(view, planes);
+
+    const bool occlusionCulling = (view.occlusionCulling && hiZPyramid != nullptr && !hiZPyramid->levels.empty());
+
+    for (std::uint32_t i = 0; i < numInstances; ++i)
+    {
+        const auto& instance = instances[i];
+
+        if (!IsInsideFrustum(planes, instance.center, instance.radius))
+            continue;
+        if (occlusionCulling && IsOccluded(view, *hiZPyramid, instance.center, instance.radius))
+            continue;
+
+        /* Append instance to the range of its mesh */
+        auto& args = drawArgs[instance.meshIndex];
+        visibleInstances[args.firstInstance + args.numInstances] = i;
+        args.numInstances++;
+    }
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_ENABLE_UTILITY
+
+
+
+// ================================================================================
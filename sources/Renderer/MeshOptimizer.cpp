@@ -0,0 +1,687 @@
+/*
+ * MeshOptimizer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/MeshOptimizer.h>
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cmath>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal members
+ */
+
+static const std::uint32_t g_invalidIndex = ~0u;
+
+// Reads the vertex positions from an interleaved vertex buffer.
+struct PositionReader
+{
+    const char*     data        = nullptr;
+    std::size_t     stride      = 0;
+    std::size_t     offset      = 0;
+    std::uint32_t   components  = 0;
+    std::uint32_t   numVertices = 0;
+
+    void Read(std::uint32_t vertex, float* pos) const
+    {
+        pos[2] = 0.0f;
+        std::memcpy(pos, data + stride * vertex + offset, sizeof(float) * components);
+    }
+};
+
+// Range of a triangle cluster and its sort key for overdraw reordering.
+struct TriangleCluster
+{
+    std::size_t firstIndex  = 0;
+    std::size_t numIndices  = 0;
+    float       sortKey     = 0.0f;
+};
+
+static PositionReader MakePositionReader(const SrcVertexDescriptor& vertexDesc)
+{
+    if (vertexDesc.format == nullptr)
+        throw std::invalid_argument("cannot read vertex positions without vertex format");
+
+    const std::size_t stride = vertexDesc.format->GetStride();
+    if (stride == 0)
+        throw std::invalid_argument("cannot read vertex positions with vertex stride of zero");
+
+    const std::string positionName = (vertexDesc.positionName != nullptr ? vertexDesc.positionName : "");
+
+    for (const auto& attrib : vertexDesc.format->attributes)
+    {
+        if (attrib.name != positionName)
+            continue;
+
+        PositionReader reader;
+        {
+            reader.data         = reinterpret_cast<const char*>(vertexDesc.data);
+            reader.stride       = stride;
+            reader.offset       = attrib.offset;
+            reader.numVertices  = static_cast<std::uint32_t>(vertexDesc.dataSize / stride);
+        }
+
+        switch (attrib.format)
+        {
+            case Format::RG32Float:     reader.components = 2; break;
+            case Format::RGB32Float:    reader.components = 3; break;
+            case Format::RGBA32Float:   reader.components = 3; break;
+            default:                    throw std::invalid_argument("vertex position attribute '" + positionName + "' must have format RG32Float, RGB32Float, or RGBA32Float");
+        }
+
+        if (reader.offset + sizeof(float) * reader.components > stride)
+            throw std::invalid_argument("vertex position attribute '" + positionName + "' exceeds vertex stride");
+
+        return reader;
+    }
+
+    throw std::invalid_argument("vertex position attribute '" + positionName + "' not found in vertex format");
+}
+
+static void ValidateIndices(const std::uint32_t* indices, std::size_t numIndices, std::uint32_t numVertices)
+{
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        if (indices[i] >= numVertices)
+        {
+            throw std::invalid_argument(
+                "index " + std::to_string(indices[i]) + " at position " + std::to_string(i) +
+                " out of range for " + std::to_string(numVertices) + " vertices"
+            );
+        }
+    }
+}
+
+static void ValidateCacheSize(std::uint32_t cacheSize)
+{
+    if (cacheSize == 0)
+        throw std::invalid_argument("vertex cache size must be greater than zero");
+}
+
+/*
+Simulates a FIFO cache with timestamps: A vertex is in the cache
+if it has been inserted less than 'cacheSize' insertions ago.
+*/
+static std::uint32_t CountTransformedVertices(
+    const std::uint32_t*    indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize)
+{
+    std::vector<std::uint32_t> cacheTime(numVertices, 0);
+    std::uint32_t time = cacheSize + 1;
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        const auto v = indices[i];
+        if (time - cacheTime[v] > cacheSize)
+            cacheTime[v] = time++;
+    }
+
+    return (time - cacheSize - 1);
+}
+
+static VertexCacheStatistics MakeVertexCacheStatistics(
+    const std::uint32_t*    indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize)
+{
+    const std::size_t numTriangleIndices = numIndices - numIndices % 3;
+
+    VertexCacheStatistics stats;
+    stats.numTransformedVertices = CountTransformedVertices(indices, numTriangleIndices, numVertices, cacheSize);
+    if (numTriangleIndices > 0)
+        stats.acmr = static_cast<float>(stats.numTransformedVertices) / static_cast<float>(numTriangleIndices / 3);
+    if (numVertices > 0)
+        stats.atvr = static_cast<float>(stats.numTransformedVertices) / static_cast<float>(numVertices);
+
+    return stats;
+}
+
+static void Cross(const float* a, const float* b, float* out)
+{
+    out[0] = a[1]*b[2] - a[2]*b[1];
+    out[1] = a[2]*b[0] - a[0]*b[2];
+    out[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static float Dot(const float* a, const float* b)
+{
+    return (a[0]*b[0] + a[1]*b[1] + a[2]*b[2]);
+}
+
+// Computes the triangle normal scaled by twice the triangle area and returns the triangle centroid.
+static void ComputeTriangleNormal(const PositionReader& reader, const std::uint32_t* tri, float* normal, float* centroid)
+{
+    float p0[3], p1[3], p2[3];
+    reader.Read(tri[0], p0);
+    reader.Read(tri[1], p1);
+    reader.Read(tri[2], p2);
+
+    const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    Cross(e1, e2, normal);
+
+    for (int i = 0; i < 3; ++i)
+        centroid[i] = (p0[i] + p1[i] + p2[i]) / 3.0f;
+}
+
+// Returns the next fanning vertex for the Tipsify algorithm or g_invalidIndex if all triangles have been emitted.
+static std::uint32_t GetNextTipsifyVertex(
+    const std::vector<std::uint32_t>&   candidates,
+    const std::vector<std::uint32_t>&   liveTriangles,
+    const std::vector<std::uint32_t>&   cacheTime,
+    std::uint32_t                       time,
+    std::uint32_t                       cacheSize,
+    std::vector<std::uint32_t>&         deadEndStack,
+    std::uint32_t&                      cursor)
+{
+    /* Select the candidate that is going to stay in the cache the longest while its remaining triangles are emitted */
+    std::uint32_t bestVertex = g_invalidIndex;
+    std::int64_t bestPriority = -1;
+
+    for (auto v : candidates)
+    {
+        if (liveTriangles[v] > 0)
+        {
+            std::int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+                priority = time - cacheTime[v];
+            if (priority > bestPriority)
+            {
+                bestPriority    = priority;
+                bestVertex      = v;
+            }
+        }
+    }
+
+    if (bestVertex != g_invalidIndex)
+        return bestVertex;
+
+    /* Resolve dead-end with recently used vertices first */
+    while (!deadEndStack.empty())
+    {
+        const auto v = deadEndStack.back();
+        deadEndStack.pop_back();
+        if (liveTriangles[v] > 0)
+            return v;
+    }
+
+    /* Continue with next vertex in input order */
+    const auto numVertices = static_cast<std::uint32_t>(liveTriangles.size());
+    while (cursor < numVertices)
+    {
+        const auto v = cursor++;
+        if (liveTriangles[v] > 0)
+            return v;
+    }
+
+    return g_invalidIndex;
+}
+
+
+/*
+ * Global functions
+ */
+
+LLGL_EXPORT VertexCacheStatistics AnalyzeVertexCache(
+    const std::uint32_t*    indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize)
+{
+    ValidateCacheSize(cacheSize);
+    ValidateIndices(indices, numIndices, numVertices);
+    return MakeVertexCacheStatistics(indices, numIndices, numVertices, cacheSize);
+}
+
+LLGL_EXPORT MeshOptimizationReport OptimizeVertexCache(
+    std::uint32_t*          indices,
+    std::size_t             numIndices,
+    std::uint32_t           numVertices,
+    std::uint32_t           cacheSize)
+{
+    ValidateCacheSize(cacheSize);
+    ValidateIndices(indices, numIndices, numVertices);
+
+    MeshOptimizationReport report;
+    report.before = MakeVertexCacheStatistics(indices, numIndices, numVertices, cacheSize);
+
+    const std::size_t numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+    {
+        report.after = report.before;
+        return report;
+    }
+
+    /* Build vertex-triangle adjacency with offsets into a single triangle list */
+    std::vector<std::uint32_t> liveTriangles(numVertices, 0);
+    for (std::size_t i = 0; i < numTriangles * 3; ++i)
+        ++liveTriangles[indices[i]];
+
+    std::vector<std::uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (std::uint32_t v = 0; v < numVertices; ++v)
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+
+    std::vector<std::uint32_t> adjacency(numTriangles * 3);
+    {
+        std::vector<std::uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (std::size_t i = 0; i < numTriangles * 3; ++i)
+            adjacency[fillOffsets[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+
+    /* Emit triangles around fanning vertices (Tipsify by Sander et al.) */
+    std::vector<std::uint32_t>  output;
+    std::vector<std::uint32_t>  cacheTime(numVertices, 0);
+    std::vector<bool>           emitted(numTriangles, false);
+    std::vector<std::uint32_t>  deadEndStack;
+    std::vector<std::uint32_t>  candidates;
+    std::uint32_t               time    = cacheSize + 1;
+    std::uint32_t               cursor  = 0;
+
+    output.reserve(numTriangles * 3);
+
+    for (auto fanningVertex = indices[0]; fanningVertex != g_invalidIndex;)
+    {
+        candidates.clear();
+
+        for (auto adj = adjacencyOffsets[fanningVertex]; adj < adjacencyOffsets[fanningVertex + 1]; ++adj)
+        {
+            const auto tri = adjacency[adj];
+            if (emitted[tri])
+                continue;
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const auto v = indices[tri * 3 + i];
+                output.push_back(v);
+                deadEndStack.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (time - cacheTime[v] > cacheSize)
+                    cacheTime[v] = time++;
+            }
+
+            emitted[tri] = true;
+        }
+
+        fanningVertex = GetNextTipsifyVertex(candidates, liveTriangles, cacheTime, time, cacheSize, deadEndStack, cursor);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+
+    report.after = MakeVertexCacheStatistics(indices, numIndices, numVertices, cacheSize);
+
+    return report;
+}
+
+LLGL_EXPORT MeshOptimizationReport OptimizeOverdraw(
+    std::uint32_t*              indices,
+    std::size_t                 numIndices,
+    const SrcVertexDescriptor&  vertexDesc,
+    float                       threshold,
+    std::uint32_t               cacheSize)
+{
+    ValidateCacheSize(cacheSize);
+
+    const auto reader = MakePositionReader(vertexDesc);
+    ValidateIndices(indices, numIndices, reader.numVertices);
+
+    MeshOptimizationReport report;
+    report.before = MakeVertexCacheStatistics(indices, numIndices, reader.numVertices, cacheSize);
+
+    const std::size_t numTriangleIndices = numIndices - numIndices % 3;
+    if (numTriangleIndices == 0)
+    {
+        report.after = report.before;
+        return report;
+    }
+
+    /*
+    Split triangles into clusters: A cluster ends where its ACMR (simulated with a cache that is flushed at the start of each cluster)
+    drops below the threshold, and a new cluster begins where all vertices of a triangle miss the cache
+    */
+    const float maxClusterACMR = report.before.acmr * threshold;
+
+    std::vector<TriangleCluster>    clusters;
+    TriangleCluster                 cluster;
+    std::vector<std::uint32_t>      cacheTime(reader.numVertices, 0);
+    std::uint32_t                   time                = cacheSize + 1;
+    std::uint32_t                   clusterStartTime    = time;
+    std::uint32_t                   clusterMisses       = 0;
+
+    auto IsCacheMiss = [&](std::uint32_t v) -> bool
+    {
+        return (time - cacheTime[v] > cacheSize || cacheTime[v] < clusterStartTime);
+    };
+
+    auto BeginCluster = [&](std::size_t firstIndex)
+    {
+        if (cluster.numIndices > 0)
+            clusters.push_back(cluster);
+        cluster.firstIndex  = firstIndex;
+        cluster.numIndices  = 0;
+        clusterMisses       = 0;
+        clusterStartTime    = time;
+    };
+
+    for (std::size_t i = 0; i < numTriangleIndices; i += 3)
+    {
+        std::uint32_t misses = 0;
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            if (IsCacheMiss(indices[i + j]))
+                ++misses;
+        }
+
+        if (misses == 3)
+            BeginCluster(i);
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            const auto v = indices[i + j];
+            if (IsCacheMiss(v))
+                cacheTime[v] = time++;
+        }
+
+        cluster.numIndices += 3;
+        clusterMisses += misses;
+
+        if (static_cast<float>(clusterMisses) / static_cast<float>(cluster.numIndices / 3) <= maxClusterACMR)
+            BeginCluster(i + 3);
+    }
+
+    BeginCluster(numTriangleIndices);
+
+    /* Compute area weighted centroid of the entire mesh */
+    float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+
+    for (std::size_t i = 0; i < numTriangleIndices; i += 3)
+    {
+        float normal[3], centroid[3];
+        ComputeTriangleNormal(reader, indices + i, normal, centroid);
+        const float area = std::sqrt(Dot(normal, normal));
+        for (int j = 0; j < 3; ++j)
+            meshCentroid[j] += centroid[j] * area;
+        meshArea += area;
+    }
+
+    if (meshArea > 0.0f)
+    {
+        for (int j = 0; j < 3; ++j)
+            meshCentroid[j] /= meshArea;
+    }
+
+    /* Sort clusters that face away from the mesh center to the front, since they are likely to occlude other clusters */
+    for (auto& cl : clusters)
+    {
+        float clusterNormal[3] = { 0.0f, 0.0f, 0.0f }, clusterCentroid[3] = { 0.0f, 0.0f, 0.0f };
+        float clusterArea = 0.0f;
+
+        for (std::size_t i = cl.firstIndex; i < cl.firstIndex + cl.numIndices; i += 3)
+        {
+            float normal[3], centroid[3];
+            ComputeTriangleNormal(reader, indices + i, normal, centroid);
+            const float area = std::sqrt(Dot(normal, normal));
+            for (int j = 0; j < 3; ++j)
+            {
+                clusterNormal[j]    += normal[j];
+                clusterCentroid[j]  += centroid[j] * area;
+            }
+            clusterArea += area;
+        }
+
+        const float normalLength = std::sqrt(Dot(clusterNormal, clusterNormal));
+        if (clusterArea > 0.0f && normalLength > 0.0f)
+        {
+            const float direction[3] =
+            {
+                clusterCentroid[0] / clusterArea - meshCentroid[0],
+                clusterCentroid[1] / clusterArea - meshCentroid[1],
+                clusterCentroid[2] / clusterArea - meshCentroid[2],
+            };
+            cl.sortKey = Dot(direction, clusterNormal) / normalLength;
+        }
+    }
+
+    std::stable_sort(
+        clusters.begin(), clusters.end(),
+        [](const TriangleCluster& lhs, const TriangleCluster& rhs)
+        {
+            return (lhs.sortKey > rhs.sortKey);
+        }
+    );
+
+    /* Write clusters back in sorted order */
+    std::vector<std::uint32_t> output;
+    output.reserve(numTriangleIndices);
+
+    for (const auto& cl : clusters)
+        output.insert(output.end(), indices + cl.firstIndex, indices + cl.firstIndex + cl.numIndices);
+
+    std::copy(output.begin(), output.end(), indices);
+
+    report.after = MakeVertexCacheStatistics(indices, numIndices, reader.numVertices, cacheSize);
+
+    return report;
+}
+
+LLGL_EXPORT std::uint32_t OptimizeVertexFetch(
+    const VertexFormat&     vertexFormat,
+    void*                   vertexData,
+    std::size_t             vertexDataSize,
+    std::uint32_t*          indices,
+    std::size_t             numIndices)
+{
+    const std::size_t stride = vertexFormat.GetStride();
+    if (stride == 0)
+        throw std::invalid_argument("cannot reorder vertices with vertex stride of zero");
+
+    const auto numVertices = static_cast<std::uint32_t>(vertexDataSize / stride);
+    ValidateIndices(indices, numIndices, numVertices);
+
+    /* Assign new vertex indices in the order of first reference */
+    std::vector<std::uint32_t> remap(numVertices, g_invalidIndex);
+    std::uint32_t numReferencedVertices = 0;
+
+    for (std::size_t i = 0; i < numIndices; ++i)
+    {
+        auto& newIndex = remap[indices[i]];
+        if (newIndex == g_invalidIndex)
+            newIndex = numReferencedVertices++;
+        indices[i] = newIndex;
+    }
+
+    /* Move unreferenced vertices behind the referenced ones */
+    std::uint32_t numRemappedVertices = numReferencedVertices;
+    for (auto& newIndex : remap)
+    {
+        if (newIndex == g_invalidIndex)
+            newIndex = numRemappedVertices++;
+    }
+
+    /* Reorder vertex buffer via a copy of the original vertices */
+    auto dst = reinterpret_cast<char*>(vertexData);
+    const std::vector<char> src(dst, dst + stride * numVertices);
+
+    for (std::uint32_t v = 0; v < numVertices; ++v)
+        std::memcpy(dst + stride * remap[v], src.data() + stride * v, stride);
+
+    return numReferencedVertices;
+}
+
+LLGL_EXPORT MeshletBuffer GenerateMeshlets(
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    const SrcVertexDescriptor&  vertexDesc,
+    std::uint32_t               maxVertices,
+    std::uint32_t               maxTriangles)
+{
+    if (maxVertices < 3 || maxVertices > 256)
+        throw std::invalid_argument("maximum number of vertices per meshlet must be in the range [3, 256]");
+    if (maxTriangles == 0)
+        throw std::invalid_argument("maximum number of triangles per meshlet must be greater than zero");
+
+    const auto reader = MakePositionReader(vertexDesc);
+    ValidateIndices(indices, numIndices, reader.numVertices);
+
+    const std::size_t numTriangleIndices = numIndices - numIndices % 3;
+
+    MeshletBuffer buffer;
+    std::vector<std::uint32_t> localIndices(reader.numVertices, g_invalidIndex);
+
+    /* Assign triangles to meshlets in the order of the index buffer */
+    Meshlet meshlet;
+
+    auto FlushMeshlet = [&]()
+    {
+        if (meshlet.numTriangles == 0)
+            return;
+
+        for (auto i = meshlet.firstVertex; i < meshlet.firstVertex + meshlet.numVertices; ++i)
+            localIndices[buffer.vertices[i]] = g_invalidIndex;
+
+        buffer.meshlets.push_back(meshlet);
+
+        meshlet.firstVertex     = static_cast<std::uint32_t>(buffer.vertices.size());
+        meshlet.numVertices     = 0;
+        meshlet.firstTriangle   = static_cast<std::uint32_t>(buffer.triangles.size());
+        meshlet.numTriangles    = 0;
+    };
+
+    for (std::size_t i = 0; i < numTriangleIndices; i += 3)
+    {
+        std::uint32_t numNewVertices = 0;
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            if (localIndices[indices[i + j]] == g_invalidIndex)
+                ++numNewVertices;
+        }
+
+        if (meshlet.numVertices + numNewVertices > maxVertices || meshlet.numTriangles + 1 > maxTriangles)
+            FlushMeshlet();
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            auto& localIndex = localIndices[indices[i + j]];
+            if (localIndex == g_invalidIndex)
+            {
+                localIndex = meshlet.numVertices++;
+                buffer.vertices.push_back(indices[i + j]);
+            }
+            buffer.triangles.push_back(static_cast<std::uint8_t>(localIndex));
+        }
+
+        ++meshlet.numTriangles;
+    }
+
+    FlushMeshlet();
+
+    /* Generate bounding sphere and normal cone for each meshlet */
+    buffer.bounds.resize(buffer.meshlets.size());
+
+    std::vector<float> normals;
+    normals.reserve(std::min<std::size_t>(maxTriangles, numTriangleIndices / 3) * 3);
+
+    for (std::size_t m = 0; m < buffer.meshlets.size(); ++m)
+    {
+        const auto& ml = buffer.meshlets[m];
+        auto& bounds = buffer.bounds[m];
+
+        /* Bounding sphere around the center of the bounding box */
+        float minPos[3], maxPos[3], pos[3];
+        reader.Read(buffer.vertices[ml.firstVertex], minPos);
+        std::copy(minPos, minPos + 3, maxPos);
+
+        for (auto i = ml.firstVertex + 1; i < ml.firstVertex + ml.numVertices; ++i)
+        {
+            reader.Read(buffer.vertices[i], pos);
+            for (int j = 0; j < 3; ++j)
+            {
+                minPos[j] = std::min(minPos[j], pos[j]);
+                maxPos[j] = std::max(maxPos[j], pos[j]);
+            }
+        }
+
+        for (int j = 0; j < 3; ++j)
+            bounds.center[j] = (minPos[j] + maxPos[j]) * 0.5f;
+
+        float maxDistSq = 0.0f;
+        for (auto i = ml.firstVertex; i < ml.firstVertex + ml.numVertices; ++i)
+        {
+            reader.Read(buffer.vertices[i], pos);
+            const float dir[3] = { pos[0] - bounds.center[0], pos[1] - bounds.center[1], pos[2] - bounds.center[2] };
+            maxDistSq = std::max(maxDistSq, Dot(dir, dir));
+        }
+        bounds.radius = std::sqrt(maxDistSq);
+
+        /* Normal cone from the average of all non-degenerate triangle normals */
+        normals.clear();
+        float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+        for (std::uint32_t t = 0; t < ml.numTriangles; ++t)
+        {
+            const auto localTri = &(buffer.triangles[ml.firstTriangle + t * 3]);
+            const std::uint32_t tri[3] =
+            {
+                buffer.vertices[ml.firstVertex + localTri[0]],
+                buffer.vertices[ml.firstVertex + localTri[1]],
+                buffer.vertices[ml.firstVertex + localTri[2]],
+            };
+
+            float normal[3], centroid[3];
+            ComputeTriangleNormal(reader, tri, normal, centroid);
+
+            const float length = std::sqrt(Dot(normal, normal));
+            if (length > 0.0f)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    normal[j] /= length;
+                    axis[j] += normal[j];
+                    normals.push_back(normal[j]);
+                }
+            }
+        }
+
+        const float axisLength = std::sqrt(Dot(axis, axis));
+        if (axisLength > 0.0f)
+        {
+            for (int j = 0; j < 3; ++j)
+                bounds.coneAxis[j] = axis[j] / axisLength;
+
+            float minDot = 1.0f;
+            for (std::size_t i = 0; i < normals.size(); i += 3)
+                minDot = std::min(minDot, Dot(&normals[i], bounds.coneAxis));
+
+            /* Normal cones with an aperture of 180 degrees or more cannot be used for culling */
+            bounds.coneCutoff = (minDot > 0.0f ? std::sqrt(1.0f - minDot * minDot) : 1.0f);
+        }
+    }
+
+    return buffer;
+}
+
+
+} // /namespace LLGL
+
+#endif // /LLGL_ENABLE_UTILITY
+
+
+
+// ================================================================================
@@ -13,6 +13,7 @@
 
 #include <LLGL/RenderSystem.h>
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 
 #include "MTCommandQueue.h"
 #include "MTCommandBuffer.h"
@@ -93,6 +94,8 @@ class MTRenderSystem final : public RenderSystem
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Heaps ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -181,6 +184,8 @@ class MTRenderSystem final : public RenderSystem
         //HWObjectContainer<MTQueryHeap>      queryHeaps_;
         HWObjectContainer<MTFence>          fences_;
 
+        SamplerCache                        samplerCache_;
+
 };
 
 
@@ -165,12 +165,26 @@ void MTRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
 
 Sampler* MTRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<MTSampler>(device_, desc));
+    auto createSampler = [this, &desc]() -> Sampler*
+    {
+        return TakeOwnership(samplers_, MakeUnique<MTSampler>(device_, desc));
+    };
+
+    if (GetConfiguration().samplerCache)
+        return samplerCache_.Acquire(desc, createSampler);
+    else
+        return createSampler();
 }
 
 void MTRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+SamplerCacheStatistics MTRenderSystem::GetSamplerCacheStatistics() const
+{
+    return samplerCache_.GetStatistics();
 }
 
 /* ----- Resource Heaps ----- */
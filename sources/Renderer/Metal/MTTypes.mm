@@ -242,6 +242,9 @@ MTLVertexFormat ToMTLVertexFormat(const Format format)
         case Format::RGBA32SInt:    return MTLVertexFormatInt4;
         case Format::RGBA32Float:   return MTLVertexFormatFloat4;
 
+        /* --- Packed formats --- */
+        case Format::RGB10A2UNorm:  return MTLVertexFormatUInt1010102Normalized;
+
         default:                    break;
     }
     MapFailed("Format", "MTLVertexFormat");
@@ -24,11 +24,9 @@ GLBufferArrayWithVAO::GLBufferArrayWithVAO(long bindFlags) :
 
 void GLBufferArrayWithVAO::SetName(const char* name)
 {
-    #ifdef LLGL_GL_ENABLE_OPENGL2X
-    if (HasExtension(GLExt::ARB_vertex_array_object))
-    #endif
+    /* Set label for VAO (shared VAOs are not labeled) */
+    if (vao_.GetID() != 0)
     {
-        /* Set label for VAO */
         GLSetObjectLabel(GL_VERTEX_ARRAY, vao_.GetID(), name);
     }
 }
@@ -43,6 +41,12 @@ void GLBufferArrayWithVAO::BuildVertexArray(std::uint32_t numBuffers, Buffer* co
     }
     else
     #endif // /LLGL_GL_ENABLE_OPENGL2X
+    if (GLVertexBufferBinding::IsSupported())
+    {
+        /* Build vertex buffer binding for a VAO that is shared between all vertex buffer arrays with the same format */
+        BuildVertexArrayWithBinding(numBuffers, bufferArray);
+    }
+    else
     {
         /* Build vertex array with native VAO */
         BuildVertexArrayWithVAO(numBuffers, bufferArray);
@@ -65,6 +69,7 @@ static void ThrowNoVertexBufferErr()
 void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
     /* Bind VAO */
+    vao_.Create();
     GLStateManager::Get().BindVertexArray(GetVaoID());
     {
         while (numBuffers-- > 0)
@@ -87,6 +92,23 @@ void GLBufferArrayWithVAO::BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buf
     GLStateManager::Get().BindVertexArray(0);
 }
 
+void GLBufferArrayWithVAO::BuildVertexArrayWithBinding(std::uint32_t numBuffers, Buffer* const * bufferArray)
+{
+    while (numBuffers-- > 0)
+    {
+        if (((*bufferArray)->GetBindFlags() & BindFlags::VertexBuffer) != 0)
+        {
+            /* Append VBO with its vertex attributes to the next binding point */
+            auto vertexBufferGL = LLGL_CAST(GLBufferWithVAO*, (*bufferArray++));
+            const auto& vertexAttribs = vertexBufferGL->GetVertexAttribs();
+            vertexBufferBinding_.AppendVertexBuffer(vertexBufferGL->GetID(), vertexAttribs.size(), vertexAttribs.data());
+        }
+        else
+            ThrowNoVertexBufferErr();
+    }
+    vertexBufferBinding_.Finalize();
+}
+
 #ifdef LLGL_GL_ENABLE_OPENGL2X
 
 void GLBufferArrayWithVAO::BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray)
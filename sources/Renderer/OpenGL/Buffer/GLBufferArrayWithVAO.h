@@ -11,6 +11,7 @@
 
 #include "GLBufferArray.h"
 #include "GLVertexArrayObject.h"
+#include "GLVertexBufferBinding.h"
 #include "GL2XVertexArray.h"
 
 
@@ -37,6 +38,12 @@ class GLBufferArrayWithVAO final : public GLBufferArray
             return vao_.GetID();
         }
 
+        // Returns the vertex buffer binding for a shared VAO (only used if GL_ARB_vertex_attrib_binding is supported).
+        inline const GLVertexBufferBinding& GetVertexBufferBinding() const
+        {
+            return vertexBufferBinding_;
+        }
+
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         // Returns the GL 2.x compatible vertex-array emulator.
         inline const GL2XVertexArray& GetVertexArrayGL2X() const
@@ -48,16 +55,18 @@ class GLBufferArrayWithVAO final : public GLBufferArray
     private:
 
         void BuildVertexArrayWithVAO(std::uint32_t numBuffers, Buffer* const * bufferArray);
+        void BuildVertexArrayWithBinding(std::uint32_t numBuffers, Buffer* const * bufferArray);
         #ifdef LLGL_GL_ENABLE_OPENGL2X
         void BuildVertexArrayWithEmulator(std::uint32_t numBuffers, Buffer* const * bufferArray);
         #endif
 
     private:
 
-        GLVertexArrayObject vao_;
+        GLVertexArrayObject     vao_;
+        GLVertexBufferBinding   vertexBufferBinding_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
-        GL2XVertexArray     vertexArrayGL2X_;
+        GL2XVertexArray         vertexArrayGL2X_;
         #endif
 
 };
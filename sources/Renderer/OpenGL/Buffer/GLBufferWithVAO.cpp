@@ -35,6 +35,13 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
     }
     else
     #endif // /LLGL_GL_ENABLE_OPENGL2X
+    if (GLVertexBufferBinding::IsSupported())
+    {
+        /* Build vertex buffer binding for a VAO that is shared between all vertex buffers with the same format */
+        vertexBufferBinding_.AppendVertexBuffer(GetID(), vertexAttribs_.size(), vertexAttribs_.data());
+        vertexBufferBinding_.Finalize();
+    }
+    else
     {
         /* Build vertex array with native VAO */
         BuildVertexArrayWithVAO();
@@ -49,6 +56,7 @@ void GLBufferWithVAO::BuildVertexArray(std::size_t numVertexAttribs, const Verte
 void GLBufferWithVAO::BuildVertexArrayWithVAO()
 {
     /* Bind VAO */
+    vao_.Create();
     GLStateManager::Get().BindVertexArray(GetVaoID());
     {
         /* Bind VBO */
@@ -11,6 +11,7 @@
 
 #include "GLBuffer.h"
 #include "GLVertexArrayObject.h"
+#include "GLVertexBufferBinding.h"
 #include "GL2XVertexArray.h"
 
 
@@ -33,6 +34,12 @@ class GLBufferWithVAO final : public GLBuffer
             return vao_.GetID();
         }
 
+        // Returns the vertex buffer binding for a shared VAO (only used if GL_ARB_vertex_attrib_binding is supported).
+        inline const GLVertexBufferBinding& GetVertexBufferBinding() const
+        {
+            return vertexBufferBinding_;
+        }
+
         // Returns the list of vertex attributes.
         inline const std::vector<VertexAttribute>& GetVertexAttribs() const
         {
@@ -57,6 +64,7 @@ class GLBufferWithVAO final : public GLBuffer
     private:
 
         GLVertexArrayObject             vao_;
+        GLVertexBufferBinding           vertexBufferBinding_;
         std::vector<VertexAttribute>    vertexAttribs_;
 
         #ifdef LLGL_GL_ENABLE_OPENGL2X
@@ -0,0 +1,77 @@
+/*
+ * GLSharedVertexArray.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLSharedVertexArray.h"
+#include "../RenderState/GLStateManager.h"
+#include "../../../Core/HelperMacros.h"
+
+
+namespace LLGL
+{
+
+
+GLSharedVertexArray::GLSharedVertexArray(const std::vector<GLVertexAttribFormat>& attribFormats) :
+    attribFormats_ { attribFormats }
+{
+}
+
+GLSharedVertexArray::GLSharedVertexArray(const GLSharedVertexArray& rhs) :
+    attribFormats_ { rhs.attribFormats_ }
+{
+}
+
+void GLSharedVertexArray::Build()
+{
+    if (vao_.GetID() != 0)
+        return;
+
+    vao_.Create();
+
+    /* Bind VAO and build each vertex attribute format (no VBO is required) */
+    GLStateManager::Get().BindVertexArray(GetID());
+    {
+        for (const auto& attribFormat : attribFormats_)
+            vao_.BuildVertexAttribFormat(attribFormat);
+    }
+    GLStateManager::Get().BindVertexArray(0);
+}
+
+static int CompareAttribFormatSWO(const GLVertexAttribFormat& lhs, const GLVertexAttribFormat& rhs)
+{
+    LLGL_COMPARE_MEMBER_SWO( index          );
+    LLGL_COMPARE_MEMBER_SWO( components     );
+    LLGL_COMPARE_MEMBER_SWO( dataType       );
+    LLGL_COMPARE_MEMBER_SWO( normalized     );
+    LLGL_COMPARE_MEMBER_SWO( integral       );
+    LLGL_COMPARE_MEMBER_SWO( relativeOffset );
+    LLGL_COMPARE_MEMBER_SWO( bindingIndex   );
+    LLGL_COMPARE_MEMBER_SWO( divisor        );
+    return 0;
+}
+
+int GLSharedVertexArray::CompareSWO(const GLSharedVertexArray& rhs) const
+{
+    const auto& lhs = *this;
+
+    LLGL_COMPARE_MEMBER_SWO( attribFormats_.size() );
+
+    for (std::size_t i = 0, n = attribFormats_.size(); i < n; ++i)
+    {
+        auto order = CompareAttribFormatSWO(lhs.attribFormats_[i], rhs.attribFormats_[i]);
+        if (order != 0)
+            return order;
+    }
+
+    return 0;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,67 @@
+/*
+ * GLSharedVertexArray.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SHARED_VERTEX_ARRAY_H
+#define LLGL_GL_SHARED_VERTEX_ARRAY_H
+
+
+#include "GLVertexArrayObject.h"
+#include <vector>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class GLSharedVertexArray;
+
+using GLSharedVertexArraySPtr = std::shared_ptr<GLSharedVertexArray>;
+
+/*
+Vertex-array-object (VAO) that only stores a vertex format and is shared between all vertex buffers with that format.
+The vertex buffers are bound to the binding points of this VAO with glBindVertexBuffer(s) (see GL_ARB_vertex_attrib_binding).
+*/
+class GLSharedVertexArray
+{
+
+    public:
+
+        GLSharedVertexArray(const std::vector<GLVertexAttribFormat>& attribFormats);
+
+        // Copies only the vertex format, i.e. the hardware VAO is not generated for the copy (required by GLStatePool).
+        GLSharedVertexArray(const GLSharedVertexArray& rhs);
+        GLSharedVertexArray& operator = (const GLSharedVertexArray&) = delete;
+
+        // Generates the hardware VAO and builds all vertex attribute formats if this has not already been done.
+        void Build();
+
+        // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
+        int CompareSWO(const GLSharedVertexArray& rhs) const;
+
+        // Returns the ID of the hardware vertex-array-object (VAO)
+        inline GLuint GetID() const
+        {
+            return vao_.GetID();
+        }
+
+    private:
+
+        std::vector<GLVertexAttribFormat>   attribFormats_;
+        GLVertexArrayObject                 vao_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -19,54 +19,49 @@ namespace LLGL
 {
 
 
-GLVertexArrayObject::GLVertexArrayObject()
-{
-    if (HasExtension(GLExt::ARB_vertex_array_object))
-        glGenVertexArrays(1, &id_);
-}
-
 GLVertexArrayObject::~GLVertexArrayObject()
 {
-    if (HasExtension(GLExt::ARB_vertex_array_object))
+    if (id_ != 0)
     {
         glDeleteVertexArrays(1, &id_);
         GLStateManager::Get().NotifyVertexArrayRelease(id_);
     }
 }
 
+void GLVertexArrayObject::Create()
+{
+    if (id_ == 0 && HasExtension(GLExt::ARB_vertex_array_object))
+        glGenVertexArrays(1, &id_);
+}
+
 void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
 {
     if (!HasExtension(GLExt::ARB_vertex_array_object))
         ThrowNotSupportedExcept(__FUNCTION__, "OpenGL extension 'GL_ARB_vertex_array_object'");
 
     /* Get data type and components of vector type */
-    const auto& formatAttribs = GetFormatAttribs(attribute.format);
-    if ((formatAttribs.flags & FormatFlags::SupportsVertex) == 0)
-        ThrowNotSupportedExcept(__FUNCTION__, "specified vertex attribute");
+    const auto attribFormat = GetVertexAttribFormat(attribute, 0, 0);
 
     /* Convert offset to pointer sized type (for 32- and 64 bit builds) */
-    auto dataType       = GLTypes::Map(formatAttribs.dataType);
-    auto components     = static_cast<GLint>(formatAttribs.components);
-    auto attribIndex    = static_cast<GLuint>(attribute.location);
     auto stride         = static_cast<GLsizei>(attribute.stride);
     auto offsetPtrSized = static_cast<GLsizeiptr>(attribute.offset);
 
     /* Enable array index in currently bound VAO */
-    glEnableVertexAttribArray(attribIndex);
+    glEnableVertexAttribArray(attribFormat.index);
 
     /* Set instance divisor */
-    if (attribute.instanceDivisor > 0)
-        glVertexAttribDivisor(attribIndex, attribute.instanceDivisor);
+    if (attribFormat.divisor > 0)
+        glVertexAttribDivisor(attribFormat.index, attribFormat.divisor);
 
     /* Use currently bound VBO for VertexAttribPointer functions */
-    if ((formatAttribs.flags & FormatFlags::IsNormalized) == 0 && !IsFloatFormat(attribute.format))
+    if (attribFormat.integral)
     {
         if (HasExtension(GLExt::EXT_gpu_shader4))
         {
             glVertexAttribIPointer(
-                attribIndex,
-                components,
-                dataType,
+                attribFormat.index,
+                attribFormat.components,
+                attribFormat.dataType,
                 stride,
                 reinterpret_cast<const void*>(offsetPtrSized)
             );
@@ -77,16 +72,81 @@ void GLVertexArrayObject::BuildVertexAttribute(const VertexAttribute& attribute)
     else
     {
         glVertexAttribPointer(
-            attribIndex,
-            components,
-            dataType,
-            GLBoolean((formatAttribs.flags & FormatFlags::IsNormalized) != 0),
+            attribFormat.index,
+            attribFormat.components,
+            attribFormat.dataType,
+            attribFormat.normalized,
             stride,
             reinterpret_cast<const void*>(offsetPtrSized)
         );
     }
 }
 
+void GLVertexArrayObject::BuildVertexAttribFormat(const GLVertexAttribFormat& attribFormat)
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    if (!HasExtension(GLExt::ARB_vertex_attrib_binding))
+        ThrowNotSupportedExcept(__FUNCTION__, "OpenGL extension 'GL_ARB_vertex_attrib_binding'");
+
+    /* Enable array index in currently bound VAO */
+    glEnableVertexAttribArray(attribFormat.index);
+
+    /* Specify format independently of the vertex buffer */
+    if (attribFormat.integral)
+    {
+        glVertexAttribIFormat(
+            attribFormat.index,
+            attribFormat.components,
+            attribFormat.dataType,
+            attribFormat.relativeOffset
+        );
+    }
+    else
+    {
+        glVertexAttribFormat(
+            attribFormat.index,
+            attribFormat.components,
+            attribFormat.dataType,
+            attribFormat.normalized,
+            attribFormat.relativeOffset
+        );
+    }
+
+    /* Associate attribute with vertex buffer binding point and set its instance divisor */
+    glVertexAttribBinding(attribFormat.index, attribFormat.bindingIndex);
+
+    if (attribFormat.divisor > 0)
+        glVertexBindingDivisor(attribFormat.bindingIndex, attribFormat.divisor);
+
+    #else
+
+    ThrowNotSupportedExcept(__FUNCTION__, "OpenGL extension 'GL_ARB_vertex_attrib_binding'");
+
+    #endif // /GL_ARB_vertex_attrib_binding
+}
+
+GLVertexAttribFormat GLVertexArrayObject::GetVertexAttribFormat(const VertexAttribute& attribute, GLuint bindingIndex, GLuint relativeOffset)
+{
+    /* Get data type and components of vector type */
+    const auto& formatAttribs = GetFormatAttribs(attribute.format);
+    if ((formatAttribs.flags & FormatFlags::SupportsVertex) == 0)
+        ThrowNotSupportedExcept(__FUNCTION__, "specified vertex attribute");
+
+    GLVertexAttribFormat attribFormat;
+    {
+        attribFormat.index          = static_cast<GLuint>(attribute.location);
+        attribFormat.components     = static_cast<GLint>(formatAttribs.components);
+        attribFormat.dataType       = GLTypes::ToVertexAttribType(attribute.format);
+        attribFormat.normalized     = GLBoolean((formatAttribs.flags & FormatFlags::IsNormalized) != 0);
+        attribFormat.integral       = GLBoolean((formatAttribs.flags & FormatFlags::IsNormalized) == 0 && !IsFloatFormat(attribute.format));
+        attribFormat.relativeOffset = relativeOffset;
+        attribFormat.bindingIndex   = bindingIndex;
+        attribFormat.divisor        = static_cast<GLuint>(attribute.instanceDivisor);
+    }
+    return attribFormat;
+}
+
 
 } // /namespace LLGL
 
@@ -18,18 +18,43 @@ namespace LLGL
 
 struct VertexAttribute;
 
+// Vertex attribute format that is separated from its vertex buffer (see GL_ARB_vertex_attrib_binding).
+struct GLVertexAttribFormat
+{
+    GLuint      index;
+    GLint       components;
+    GLenum      dataType;
+    GLboolean   normalized;
+    GLboolean   integral;
+    GLuint      relativeOffset;
+    GLuint      bindingIndex;
+    GLuint      divisor;
+};
+
 // Wrapper class for an OpenGL Vertex-Array-Object (VAO), for GL 3.0+.
 class GLVertexArrayObject
 {
 
     public:
 
-        GLVertexArrayObject();
+        GLVertexArrayObject() = default;
         ~GLVertexArrayObject();
 
+        GLVertexArrayObject(const GLVertexArrayObject&) = delete;
+        GLVertexArrayObject& operator = (const GLVertexArrayObject&) = delete;
+
+        // Generates the hardware VAO if it has not already been generated.
+        void Create();
+
         // Builds the specified attribute using a 'glVertexAttrib*Pointer' function.
         void BuildVertexAttribute(const VertexAttribute& attribute);
 
+        // Builds the specified attribute format using the 'glVertexAttrib*Format' functions (see GL_ARB_vertex_attrib_binding).
+        void BuildVertexAttribFormat(const GLVertexAttribFormat& attribFormat);
+
+        // Returns the attribute format of the specified vertex attribute for the specified vertex buffer binding point and offset relative to that binding point.
+        static GLVertexAttribFormat GetVertexAttribFormat(const VertexAttribute& attribute, GLuint bindingIndex, GLuint relativeOffset);
+
         // Returns the ID of the hardware vertex-array-object (VAO)
         inline GLuint GetID() const
         {
@@ -0,0 +1,138 @@
+/*
+ * GLVertexBufferBinding.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLVertexBufferBinding.h"
+#include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLStatePool.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include <LLGL/VertexAttribute.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+GLVertexBufferBinding::~GLVertexBufferBinding()
+{
+    GLStatePool::Get().ReleaseVertexArray(std::move(vertexArray_));
+}
+
+bool GLVertexBufferBinding::IsSupported()
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+    return HasExtension(GLExt::ARB_vertex_attrib_binding);
+    #else
+    return false;
+    #endif
+}
+
+// Minimum value of GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET that is guaranteed by the specification.
+static const GLuint g_minMaxVertexAttribRelativeOffset = 2047;
+
+void GLVertexBufferBinding::AppendVertexBuffer(GLuint buffer, std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs)
+{
+    if (numVertexAttribs == 0)
+    {
+        AppendBindingPoint(buffer, 0, 0);
+        return;
+    }
+
+    /* Sort attributes by their offsets */
+    std::vector<const VertexAttribute*> sortedAttribs(numVertexAttribs);
+    for (std::size_t i = 0; i < numVertexAttribs; ++i)
+        sortedAttribs[i] = &(vertexAttribs[i]);
+
+    std::stable_sort(
+        sortedAttribs.begin(),
+        sortedAttribs.end(),
+        [](const VertexAttribute* lhs, const VertexAttribute* rhs)
+        {
+            return (lhs->offset < rhs->offset);
+        }
+    );
+
+    /*
+    Bind the buffer at the offset of its first attribute, and start another binding point of the same buffer
+    whenever an attribute exceeds the maximum relative offset or has another stride (e.g. for planar layouts with large offsets).
+    This way, the relative offsets are small and the VAO is shared with all buffers of the same layout.
+    */
+    const auto maxRelativeOffset = std::max(GLStateManager::GetCommonLimits().maxVertexAttribRelativeOffset, g_minMaxVertexAttribRelativeOffset);
+
+    GLintptr bindingOffset = static_cast<GLintptr>(sortedAttribs.front()->offset);
+    AppendBindingPoint(buffer, bindingOffset, static_cast<GLsizei>(sortedAttribs.front()->stride));
+
+    for (auto attrib : sortedAttribs)
+    {
+        const auto offset = static_cast<GLintptr>(attrib->offset);
+        const auto stride = static_cast<GLsizei>(attrib->stride);
+        if (static_cast<GLuint>(offset - bindingOffset) > maxRelativeOffset || stride != strides_.back())
+        {
+            bindingOffset = offset;
+            AppendBindingPoint(buffer, bindingOffset, stride);
+        }
+
+        const auto bindingIndex = static_cast<GLuint>(buffers_.size() - 1);
+        attribFormats_.push_back(GLVertexArrayObject::GetVertexAttribFormat(*attrib, bindingIndex, static_cast<GLuint>(offset - bindingOffset)));
+    }
+}
+
+void GLVertexBufferBinding::Finalize()
+{
+    /* Replace previous VAO by the one that is shared with all vertex buffers of the same format */
+    GLStatePool::Get().ReleaseVertexArray(std::move(vertexArray_));
+    vertexArray_ = GLStatePool::Get().CreateVertexArray(attribFormats_);
+
+    /* Vertex format is no longer needed after the shared VAO has been acquired */
+    attribFormats_.clear();
+    attribFormats_.shrink_to_fit();
+}
+
+void GLVertexBufferBinding::Bind(GLStateManager& stateMngr) const
+{
+    #ifdef GL_ARB_vertex_attrib_binding
+
+    /* Bind shared VAO (only if it has changed) */
+    stateMngr.BindVertexArray(vertexArray_->GetID());
+
+    /* Bind vertex buffers to binding points of the shared VAO */
+    const auto numBuffers = static_cast<GLsizei>(buffers_.size());
+
+    #ifdef GL_ARB_multi_bind
+    if (HasExtension(GLExt::ARB_multi_bind))
+    {
+        glBindVertexBuffers(0, numBuffers, buffers_.data(), offsets_.data(), strides_.data());
+    }
+    else
+    #endif // /GL_ARB_multi_bind
+    {
+        for (GLsizei i = 0; i < numBuffers; ++i)
+            glBindVertexBuffer(static_cast<GLuint>(i), buffers_[i], offsets_[i], strides_[i]);
+    }
+
+    #endif // /GL_ARB_vertex_attrib_binding
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLVertexBufferBinding::AppendBindingPoint(GLuint buffer, GLintptr offset, GLsizei stride)
+{
+    buffers_.push_back(buffer);
+    offsets_.push_back(offset);
+    strides_.push_back(stride);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,73 @@
+/*
+ * GLVertexBufferBinding.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_VERTEX_BUFFER_BINDING_H
+#define LLGL_GL_VERTEX_BUFFER_BINDING_H
+
+
+#include "GLSharedVertexArray.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLStateManager;
+
+/*
+Binding of one or more vertex buffers to a shared VAO (see GL_ARB_vertex_attrib_binding).
+Each vertex buffer is bound to the binding point that corresponds to its index within a vertex buffer array,
+so switching between vertex buffers with the same vertex format does not switch the VAO.
+*/
+class GLVertexBufferBinding
+{
+
+    public:
+
+        GLVertexBufferBinding() = default;
+        ~GLVertexBufferBinding();
+
+        GLVertexBufferBinding(const GLVertexBufferBinding&) = delete;
+        GLVertexBufferBinding& operator = (const GLVertexBufferBinding&) = delete;
+
+        // Returns true if vertex formats can be separated from vertex buffers, i.e. GL_ARB_vertex_attrib_binding is supported.
+        static bool IsSupported();
+
+        // Appends the specified vertex buffer and its vertex attributes to the next binding point(s).
+        void AppendVertexBuffer(GLuint buffer, std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
+
+        // Acquires the shared VAO for the vertex format of all appended vertex buffers.
+        void Finalize();
+
+        // Binds the shared VAO and all vertex buffers.
+        void Bind(GLStateManager& stateMngr) const;
+
+    private:
+
+        // Appends a binding point for the specified buffer range.
+        void AppendBindingPoint(GLuint buffer, GLintptr offset, GLsizei stride);
+
+    private:
+
+        GLSharedVertexArraySPtr             vertexArray_;
+        std::vector<GLVertexAttribFormat>   attribFormats_;
+        std::vector<GLuint>                 buffers_;
+        std::vector<GLintptr>               offsets_;
+        std::vector<GLsizei>                strides_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -32,6 +32,7 @@ class GLRenderTarget;
 class GLRenderPass;
 class GLDeferredCommandBuffer;
 class GL2XVertexArray;
+class GLVertexBufferBinding;
 
 
 struct GLCmdBufferSubData
@@ -174,6 +175,11 @@ struct GLCmdBindGL2XVertexArray
     const GL2XVertexArray* vertexArrayGL2X;
 };
 
+struct GLCmdBindVertexBuffers
+{
+    const GLVertexBufferBinding* vertexBufferBinding;
+};
+
 struct GLCmdBindElementArrayBufferToVAO
 {
     GLuint id;
@@ -389,6 +395,11 @@ struct GLCmdDispatchComputeIndirect
     GLintptr    indirect;
 };
 
+struct GLCmdMemoryBarrier
+{
+    GLbitfield barriers;
+};
+
 struct GLCmdBindTexture
 {
     std::uint32_t       slot;
@@ -204,6 +204,12 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.CallMember(&GL2XVertexArray::Bind, cmd->vertexArrayGL2X, g_stateMngrArg);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindVertexBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindVertexBuffers*>(pc);
+            compiler.CallMember(&GLVertexBufferBinding::Bind, cmd->vertexBufferBinding, g_stateMngrArg);
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindElementArrayBufferToVAO:
         {
             auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
@@ -421,6 +427,14 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             return sizeof(*cmd);
         }
         #endif // /GL_ARB_compute_shader
+        #ifdef GL_ARB_shader_image_load_store
+        case GLOpcodeMemoryBarrier:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMemoryBarrier*>(pc);
+            compiler.Call(glMemoryBarrier, cmd->barriers);
+            return sizeof(*cmd);
+        }
+        #endif // /GL_ARB_shader_image_load_store
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
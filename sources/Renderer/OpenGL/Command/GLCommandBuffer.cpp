@@ -7,6 +7,7 @@
 
 #include "GLCommandBuffer.h"
 #include "../RenderState/GLState.h"
+#include <LLGL/Texture.h>
 
 
 namespace LLGL
@@ -29,6 +30,56 @@ void GLCommandBuffer::SetIndexFormat(GLRenderState& renderState, bool indexType1
     renderState.indexBufferOffset = static_cast<GLsizeiptr>(offset);
 }
 
+GLbitfield GLCommandBuffer::GetMemoryBarrierBitfield(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    GLbitfield barriers = 0;
+
+    #ifdef GL_ARB_shader_image_load_store
+
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+    {
+        const long bindFlags = buffers[i]->GetBindFlags();
+
+        if ((bindFlags & BindFlags::VertexBuffer) != 0)
+            barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+        if ((bindFlags & BindFlags::IndexBuffer) != 0)
+            barriers |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+        if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+            barriers |= GL_UNIFORM_BARRIER_BIT;
+        if ((bindFlags & BindFlags::IndirectBuffer) != 0)
+            barriers |= GL_COMMAND_BARRIER_BIT;
+        if ((bindFlags & BindFlags::Sampled) != 0)
+            barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+        if ((bindFlags & BindFlags::Storage) != 0)
+            barriers |= GL_SHADER_STORAGE_BARRIER_BIT;
+
+        /* Buffer updates also include mapping and reading back the buffer */
+        barriers |= GL_BUFFER_UPDATE_BARRIER_BIT;
+    }
+
+    for (std::uint32_t i = 0; i < numTextures; ++i)
+    {
+        const long bindFlags = textures[i]->GetBindFlags();
+
+        if ((bindFlags & BindFlags::Sampled) != 0)
+            barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+        if ((bindFlags & BindFlags::Storage) != 0)
+            barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+        if ((bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0)
+            barriers |= GL_FRAMEBUFFER_BARRIER_BIT;
+
+        barriers |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+    }
+
+    #endif // /GL_ARB_shader_image_load_store
+
+    return barriers;
+}
+
 
 } // /namespace LLGL
 
@@ -10,6 +10,7 @@
 
 
 #include <LLGL/CommandBuffer.h>
+#include "../OpenGL.h"
 
 
 namespace LLGL
@@ -32,6 +33,14 @@ class GLCommandBuffer : public CommandBuffer
         // Configures the attributes of 'renderState' for the type of index buffers.
         void SetIndexFormat(GLRenderState& renderState, bool indexType16Bits, std::uint64_t offset);
 
+        // Returns the bitfield of <glMemoryBarrier> for subsequent accesses to the specified resources, determined by their binding flags.
+        static GLbitfield GetMemoryBarrierBitfield(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures,
+            Texture* const *    textures
+        );
+
 };
 
 
@@ -210,6 +210,12 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             cmd->vertexArrayGL2X->Bind(stateMngr);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindVertexBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindVertexBuffers*>(pc);
+            cmd->vertexBufferBinding->Bind(stateMngr);
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindElementArrayBufferToVAO:
         {
             auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
@@ -436,6 +442,14 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return sizeof(*cmd);
         }
+        case GLOpcodeMemoryBarrier:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMemoryBarrier*>(pc);
+            #ifdef GL_ARB_shader_image_load_store
+            glMemoryBarrier(cmd->barriers);
+            #endif
+            return sizeof(*cmd);
+        }
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
@@ -40,6 +40,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeClearBuffers,
     GLOpcodeBindVertexArray,
     GLOpcodeBindGL2XVertexArray,
+    GLOpcodeBindVertexBuffers,
     GLOpcodeBindElementArrayBufferToVAO,
     GLOpcodeBindBufferBase,
     GLOpcodeBindBuffersBase,
@@ -71,6 +72,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeMultiDrawElementsIndirect,
     GLOpcodeDispatchCompute,
     GLOpcodeDispatchComputeIndirect,
+    GLOpcodeMemoryBarrier,
     GLOpcodeBindTexture,
     GLOpcodeBindSampler,
     GLOpcodeUnbindResources,
@@ -8,6 +8,7 @@
 #include "GLCommandQueue.h"
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommandExecutor.h"
+#include "GLSubmissionThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../RenderState/GLFence.h"
 #include "../RenderState/GLQueryHeap.h"
@@ -28,17 +29,41 @@ GLCommandQueue::GLCommandQueue(const std::shared_ptr<GLStateManager>& stateManag
 
 /* ----- Command Buffers ----- */
 
+// Removes a pending submission from a deferred command buffer when it goes out of scope, even if the execution throws an exception.
+struct GLPendingSubmissionGuard
+{
+    GLDeferredCommandBuffer& cmdBuffer;
+
+    ~GLPendingSubmissionGuard()
+    {
+        cmdBuffer.RemovePendingSubmission();
+    }
+};
+
 void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     /*
     Only deferred command buffers can be submitted multiple times (via GLDeferredCommandBuffer),
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
     */
-    auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, commandBuffer);
+    auto& cmdBufferGL = LLGL_CAST(GLCommandBuffer&, commandBuffer);
     if (!cmdBufferGL.IsImmediateCmdBuffer())
     {
-        auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
-        ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, *stateMngr_);
+        auto& deferredCmdBufferGL = LLGL_CAST(GLDeferredCommandBuffer&, cmdBufferGL);
+        if (auto submissionThread = GLSubmissionThread::Get())
+        {
+            /* Only enqueue command buffer; it must not be recorded again until the submission thread has executed it */
+            deferredCmdBufferGL.AddPendingSubmission();
+            submissionThread->Enqueue(
+                [&deferredCmdBufferGL, this]()
+                {
+                    GLPendingSubmissionGuard guard { deferredCmdBufferGL };
+                    ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, *stateMngr_);
+                }
+            );
+        }
+        else
+            ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, *stateMngr_);
     }
 }
 
@@ -158,6 +183,8 @@ bool GLCommandQueue::QueryResult(
     void*           data,
     std::size_t     dataSize)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(QueryResult(queryHeap, firstQuery, numQueries, data, dataSize));
+
     auto& queryHeapGL = LLGL_CAST(GLQueryHeap&, queryHeap);
 
     /* Multiply query range by the query group size */
@@ -185,17 +212,24 @@ bool GLCommandQueue::QueryResult(
 void GLCommandQueue::Submit(Fence& fence)
 {
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
-    fenceGL.Submit();
+    if (auto submissionThread = GLSubmissionThread::Get())
+        submissionThread->Enqueue([&fenceGL]() { fenceGL.Submit(); });
+    else
+        fenceGL.Submit();
 }
 
 bool GLCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(WaitFence(fence, timeout));
+
     auto& fenceGL = LLGL_CAST(GLFence&, fence);
     return fenceGL.Wait(timeout);
 }
 
 void GLCommandQueue::WaitIdle()
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(WaitIdle());
+
     glFinish();
 }
 
@@ -56,6 +56,12 @@ GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t reserve
 
 void GLDeferredCommandBuffer::Begin()
 {
+    /* Wait until the GL submission thread has executed all previous submissions of this command buffer */
+    {
+        std::unique_lock<std::mutex> lock { pendingSubmissionsMutex_ };
+        pendingSubmissionsVar_.wait(lock, [this]() { return (pendingSubmissions_ == 0); });
+    }
+
     /* Reset internal command buffer */
     buffer_.clear();
     boundShaderProgram_ = 0;
@@ -70,6 +76,21 @@ void GLDeferredCommandBuffer::Begin()
     #endif // /LLGL_ENABLE_JIT_COMPILER
 }
 
+void GLDeferredCommandBuffer::AddPendingSubmission()
+{
+    std::lock_guard<std::mutex> guard { pendingSubmissionsMutex_ };
+    ++pendingSubmissions_;
+}
+
+void GLDeferredCommandBuffer::RemovePendingSubmission()
+{
+    {
+        std::lock_guard<std::mutex> guard { pendingSubmissionsMutex_ };
+        --pendingSubmissions_;
+    }
+    pendingSubmissionsVar_.notify_all();
+}
+
 void GLDeferredCommandBuffer::End()
 {
     #ifdef LLGL_ENABLE_JIT_COMPILER
@@ -393,6 +414,12 @@ void GLDeferredCommandBuffer::SetVertexBuffer(Buffer& buffer)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (GLVertexBufferBinding::IsSupported())
+        {
+            auto cmd = AllocCommand<GLCmdBindVertexBuffers>(GLOpcodeBindVertexBuffers);
+            cmd->vertexBufferBinding = &(bufferWithVAO.GetVertexBufferBinding());
+        }
+        else
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
             cmd->vao = bufferWithVAO.GetVaoID();
@@ -413,6 +440,12 @@ void GLDeferredCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
         else
         #endif
+        if (GLVertexBufferBinding::IsSupported())
+        {
+            auto cmd = AllocCommand<GLCmdBindVertexBuffers>(GLOpcodeBindVertexBuffers);
+            cmd->vertexBufferBinding = &(bufferArrayWithVAO.GetVertexBufferBinding());
+        }
+        else
         {
             auto cmd = AllocCommand<GLCmdBindVertexArray>(GLOpcodeBindVertexArray);
             cmd->vao = bufferArrayWithVAO.GetVaoID();
@@ -952,6 +985,22 @@ void GLDeferredCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t off
     #endif
 }
 
+void GLDeferredCommandBuffer::ResourceBarrier(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    #ifdef GL_ARB_shader_image_load_store
+    const GLbitfield barriers = GetMemoryBarrierBitfield(numBuffers, buffers, numTextures, textures);
+    if (barriers != 0)
+    {
+        auto cmd = AllocCommand<GLCmdMemoryBarrier>(GLOpcodeMemoryBarrier);
+        cmd->barriers = barriers;
+    }
+    #endif
+}
+
 /* ----- Debugging ----- */
 
 void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
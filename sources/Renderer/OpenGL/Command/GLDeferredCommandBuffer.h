@@ -15,6 +15,8 @@
 #include "../OpenGL.h"
 #include <memory>
 #include <vector>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
 #   include "../../../JIT/JITProgram.h"
@@ -48,6 +50,14 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
+        /* ----- Threaded submission ----- */
+
+        // Increments the number of submissions of this command buffer that have not been executed by the GL submission thread yet.
+        void AddPendingSubmission();
+
+        // Decrements the number of pending submissions. This is called by the GL submission thread.
+        void RemovePendingSubmission();
+
         /* ----- Blitting ----- */
 
         void UpdateBuffer(
@@ -212,6 +222,13 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
         void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
 
+        void ResourceBarrier(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures = 0,
+            Texture* const *    textures    = nullptr
+        ) override;
+
         /* ----- Debugging ----- */
 
         void PushDebugGroup(const char* name) override;
@@ -288,6 +305,10 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         long                        flags_              = 0;
         std::vector<std::uint8_t>   buffer_;
 
+        std::mutex                  pendingSubmissionsMutex_;
+        std::condition_variable     pendingSubmissionsVar_;
+        std::uint32_t               pendingSubmissions_ = 0;    // Guarded by 'pendingSubmissionsMutex_'.
+
         #ifdef LLGL_ENABLE_JIT_COMPILER
         std::unique_ptr<JITProgram> executable_;
         std::uint32_t               maxNumViewports_    = 0;
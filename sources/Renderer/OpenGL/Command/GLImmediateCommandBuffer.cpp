@@ -311,6 +311,12 @@ void GLImmediateCommandBuffer::SetVertexBuffer(Buffer& buffer)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (GLVertexBufferBinding::IsSupported())
+        {
+            /* Bind vertex buffers to shared VAO */
+            vertexBufferGL.GetVertexBufferBinding().Bind(*stateMngr_);
+        }
+        else
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferGL.GetVaoID());
@@ -333,6 +339,12 @@ void GLImmediateCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
         else
         #endif // /LLGL_GL_ENABLE_OPENGL2X
+        if (GLVertexBufferBinding::IsSupported())
+        {
+            /* Bind vertex buffers to shared VAO */
+            vertexBufferArrayGL.GetVertexBufferBinding().Bind(*stateMngr_);
+        }
+        else
         {
             /* Bind vertex array with native VAO */
             stateMngr_->BindVertexArray(vertexBufferArrayGL.GetVaoID());
@@ -827,6 +839,19 @@ void GLImmediateCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t of
     #endif
 }
 
+void GLImmediateCommandBuffer::ResourceBarrier(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    #ifdef GL_ARB_shader_image_load_store
+    const GLbitfield barriers = GetMemoryBarrierBitfield(numBuffers, buffers, numTextures, textures);
+    if (barriers != 0)
+        glMemoryBarrier(barriers);
+    #endif
+}
+
 /* ----- Debugging ----- */
 
 void GLImmediateCommandBuffer::PushDebugGroup(const char* name)
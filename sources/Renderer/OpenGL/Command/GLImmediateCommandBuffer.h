@@ -204,6 +204,13 @@ class GLImmediateCommandBuffer final : public GLCommandBuffer
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
         void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
 
+        void ResourceBarrier(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures = 0,
+            Texture* const *    textures    = nullptr
+        ) override;
+
         /* ----- Debugging ----- */
 
         void PushDebugGroup(const char* name) override;
@@ -0,0 +1,160 @@
+/*
+ * GLSubmissionThread.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLSubmissionThread.h"
+#include "../Platform/GLContext.h"
+#include <LLGL/Log.h>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GLSubmissionThread* GLSubmissionThread::active_ = nullptr;
+
+GLSubmissionThread::GLSubmissionThread() :
+    context_ { GLContext::Active() },
+    head_    { &stub_              },
+    tail_    { &stub_              }
+{
+    /* Release GL context from the calling thread, since a GL context can only be current on one thread at a time */
+    GLContext::MakeCurrent(nullptr);
+    thread_ = std::thread(&GLSubmissionThread::Run, this);
+    active_ = this;
+}
+
+GLSubmissionThread::~GLSubmissionThread()
+{
+    /* Stop submission thread after all pending tasks have been executed */
+    Enqueue([this]() { quit_ = true; });
+    thread_.join();
+    active_ = nullptr;
+
+    /* Make GL context current on the calling thread again */
+    GLContext::MakeCurrent(context_);
+}
+
+void GLSubmissionThread::Enqueue(std::function<void()>&& task)
+{
+    auto node = new Task();
+    node->func = std::move(task);
+
+    /* Count task before it is linked, so the submission thread does not go to sleep in between */
+    numTasks_.fetch_add(1);
+    Push(node);
+
+    /* Only take the mutex if the submission thread might be sleeping */
+    if (sleeping_.load())
+    {
+        {
+            std::lock_guard<std::mutex> lock { sleepMutex_ };
+        }
+        sleepVar_.notify_one();
+    }
+}
+
+bool GLSubmissionThread::IsCurrentThread() const
+{
+    return (std::this_thread::get_id() == thread_.get_id());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLSubmissionThread::Run()
+{
+    GLContext::MakeCurrent(context_);
+
+    while (!quit_)
+    {
+        if (auto task = Pop())
+        {
+            numTasks_.fetch_sub(1);
+            try
+            {
+                task->func();
+            }
+            catch (const std::exception& e)
+            {
+                Log::PostReport(Log::ReportType::Error, e.what(), "in 'LLGL::GLSubmissionThread::Run'");
+            }
+            delete task;
+        }
+        else if (numTasks_.load() == 0)
+        {
+            /* Sleep until the next task is enqueued */
+            std::unique_lock<std::mutex> lock { sleepMutex_ };
+            sleeping_.store(true);
+            sleepVar_.wait(lock, [this]() { return (numTasks_.load() > 0); });
+            sleeping_.store(false);
+        }
+        else
+        {
+            /* Another thread is about to link its task into the queue */
+            std::this_thread::yield();
+        }
+    }
+
+    /* Release GL context from this thread; tasks might have made another GL context current */
+    context_ = GLContext::Active();
+    GLContext::MakeCurrent(nullptr);
+}
+
+void GLSubmissionThread::Push(Task* task)
+{
+    task->next.store(nullptr, std::memory_order_relaxed);
+    auto prev = head_.exchange(task, std::memory_order_acq_rel);
+    prev->next.store(task, std::memory_order_release);
+}
+
+GLSubmissionThread::Task* GLSubmissionThread::Pop()
+{
+    auto tail = tail_;
+    auto next = tail->next.load(std::memory_order_acquire);
+
+    /* Skip stub node */
+    if (tail == &stub_)
+    {
+        if (next == nullptr)
+            return nullptr;
+        tail_   = next;
+        tail    = next;
+        next    = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        tail_ = next;
+        return tail;
+    }
+
+    /* Tail is not the last node yet if a producer has exchanged the head but not linked its node */
+    if (tail != head_.load(std::memory_order_acquire))
+        return nullptr;
+
+    /* Append stub node again, so the last task can be removed from the queue */
+    Push(&stub_);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr)
+    {
+        tail_ = next;
+        return tail;
+    }
+
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,132 @@
+/*
+ * GLSubmissionThread.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SUBMISSION_THREAD_H
+#define LLGL_GL_SUBMISSION_THREAD_H
+
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+
+/*
+Dispatches the enclosing function to the GL submission thread if threaded submission is enabled and the caller is another thread.
+The function is then called again on the submission thread, where this macro has no effect.
+*/
+#define LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CALL)                         \
+    if (auto submissionThread = GLSubmissionThread::Get())                  \
+    {                                                                       \
+        if (!submissionThread->IsCurrentThread())                           \
+            return submissionThread->Invoke([&]() { return CALL; });        \
+    }
+
+
+namespace LLGL
+{
+
+
+class GLContext;
+
+/*
+Dedicated thread that owns the active GL context and executes all tasks in the order they were enqueued.
+Any thread can enqueue tasks into its lock-free multi-producer/single-consumer queue.
+*/
+class GLSubmissionThread
+{
+
+    public:
+
+        GLSubmissionThread(const GLSubmissionThread&) = delete;
+        GLSubmissionThread& operator = (const GLSubmissionThread&) = delete;
+
+        // Takes over the GL context that is active on the calling thread and starts the submission thread.
+        GLSubmissionThread();
+
+        // Executes all pending tasks, stops the submission thread, and makes the GL context current on the calling thread again.
+        ~GLSubmissionThread();
+
+        // Enqueues the specified task and returns immediately.
+        void Enqueue(std::function<void()>&& task);
+
+        // Enqueues the specified function and returns a future for its result.
+        template <typename TFunc>
+        auto EnqueueAsync(TFunc&& func) -> std::future<decltype(func())>
+        {
+            auto task = std::make_shared<std::packaged_task<decltype(func())()>>(std::forward<TFunc>(func));
+            auto result = task->get_future();
+            Enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        // Enqueues the specified function and blocks until it has been executed. Exceptions are passed on to the caller.
+        template <typename TFunc>
+        auto Invoke(TFunc&& func) -> decltype(func())
+        {
+            return EnqueueAsync(std::forward<TFunc>(func)).get();
+        }
+
+        // Returns true if the calling thread is this submission thread.
+        bool IsCurrentThread() const;
+
+        // Returns the active submission thread, or null if threaded submission is disabled.
+        static inline GLSubmissionThread* Get()
+        {
+            return active_;
+        }
+
+    private:
+
+        struct Task
+        {
+            std::function<void()>   func;
+            std::atomic<Task*>      next { nullptr };
+        };
+
+    private:
+
+        void Run();
+
+        void Push(Task* task);
+        Task* Pop();
+
+    private:
+
+        static GLSubmissionThread*  active_;
+
+        GLContext*                  context_        = nullptr;
+
+        // Lock-free MPSC queue (producers exchange the head, the submission thread pops from the tail)
+        Task                        stub_;
+        std::atomic<Task*>          head_;
+        Task*                       tail_           = nullptr;
+        std::atomic<std::size_t>    numTasks_       { 0 };
+
+        // Only used to put the submission thread to sleep while the queue is empty
+        std::mutex                  sleepMutex_;
+        std::condition_variable     sleepVar_;
+        std::atomic<bool>           sleeping_       { false };
+
+        bool                        quit_           = false;
+        std::thread                 thread_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -150,6 +150,16 @@ static bool Load_GL_ARB_vertex_array_object(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_vertex_attrib_binding(bool usePlaceholder)
+{
+    LOAD_GLPROC( glBindVertexBuffer     );
+    LOAD_GLPROC( glVertexAttribFormat   );
+    LOAD_GLPROC( glVertexAttribIFormat  );
+    LOAD_GLPROC( glVertexAttribBinding  );
+    LOAD_GLPROC( glVertexBindingDivisor );
+    return true;
+}
+
 static bool Load_GL_ARB_vertex_shader(bool usePlaceholder)
 {
     LOAD_GLPROC( glEnableVertexAttribArray  );
@@ -634,7 +644,17 @@ static bool Load_GL_ARB_texture_storage_multisample(bool usePlaceholder)
 
 static bool Load_GL_ARB_buffer_storage(bool usePlaceholder)
 {
-    LOAD_GLPROC( glBufferStorage );
+    LOAD_GLPROC( glBufferStorage  );
+    LOAD_GLPROC( glMapBufferRange );
+    return true;
+}
+
+static bool Load_GL_ARB_bindless_texture(bool usePlaceholder)
+{
+    LOAD_GLPROC( glGetTextureHandleARB             );
+    LOAD_GLPROC( glGetTextureSamplerHandleARB      );
+    LOAD_GLPROC( glMakeTextureHandleResidentARB    );
+    LOAD_GLPROC( glMakeTextureHandleNonResidentARB );
     return true;
 }
 
@@ -1001,6 +1021,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     /* Load hardware buffer extensions */
     LOAD_GLEXT( ARB_vertex_buffer_object         );
     LOAD_GLEXT( ARB_vertex_array_object          );
+    LOAD_GLEXT( ARB_vertex_attrib_binding        );
     LOAD_GLEXT( ARB_vertex_shader                );
     LOAD_GLEXT( ARB_framebuffer_object           );
     LOAD_GLEXT( ARB_uniform_buffer_object        );
@@ -1061,6 +1082,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_texture_storage              );
     LOAD_GLEXT( ARB_texture_storage_multisample  );
     LOAD_GLEXT( ARB_buffer_storage               );
+    LOAD_GLEXT( ARB_bindless_texture             );
     LOAD_GLEXT( ARB_copy_buffer                  );
     LOAD_GLEXT( ARB_copy_image                   );
     LOAD_GLEXT( ARB_polygon_offset_clamp         );
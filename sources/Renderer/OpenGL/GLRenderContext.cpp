@@ -6,6 +6,7 @@
  */
 
 #include "GLRenderContext.h"
+#include "Command/GLSubmissionThread.h"
 
 
 namespace LLGL
@@ -56,7 +57,15 @@ GLRenderContext::GLRenderContext(
 
 void GLRenderContext::Present()
 {
-    context_->SwapBuffers();
+    if (auto submissionThread = GLSubmissionThread::Get())
+    {
+        /* Wait until the previous frame has been presented, so the submission thread is at most one frame behind */
+        if (presentResult_.valid())
+            presentResult_.wait();
+        presentResult_ = submissionThread->EnqueueAsync([this]() { context_->SwapBuffers(); });
+    }
+    else
+        context_->SwapBuffers();
 }
 
 std::uint32_t GLRenderContext::GetSamples() const
@@ -101,6 +110,8 @@ bool GLRenderContext::GLMakeCurrent(GLRenderContext* renderContext)
 
 bool GLRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(OnSetVideoMode(videoModeDesc));
+
     /* Update context height */
     contextHeight_ = static_cast<GLint>(videoModeDesc.resolution.height);
     stateMngr_->NotifyRenderTargetHeight(contextHeight_);
@@ -117,6 +128,8 @@ bool GLRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
 
 bool GLRenderContext::OnSetVsync(const VsyncDescriptor& vsyncDesc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(OnSetVsync(vsyncDesc));
+
     int swapInterval = (vsyncDesc.enabled ? static_cast<int>(vsyncDesc.interval) : 0);
     return context_->SetSwapInterval(swapInterval);
 }
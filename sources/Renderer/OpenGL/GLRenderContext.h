@@ -16,6 +16,7 @@
 #include "RenderState/GLStateManager.h"
 #include "Platform/GLContext.h"
 #include <memory>
+#include <future>
 
 #ifdef __linux__
 #include <LLGL/Platform/NativeHandle.h>
@@ -95,6 +96,8 @@ class GLRenderContext final : public RenderContext
 
         GLint                           contextHeight_  = 0;
 
+        std::future<void>               presentResult_; // Only used with threaded submission
+
 };
 
 
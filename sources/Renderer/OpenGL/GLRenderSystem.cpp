@@ -9,6 +9,7 @@
 #include "GLProfile.h"
 #include "Texture/GLMipGenerator.h"
 #include "Texture/GLTextureViewPool.h"
+#include "Texture/GLTextureHandlePool.h"
 #include "Ext/GLExtensions.h"
 #include "Ext/GLExtensionRegistry.h"
 #include "RenderState/GLStatePool.h"
@@ -19,6 +20,7 @@
 #include "Buffer/GLBufferArrayWithVAO.h"
 #include "../CheckedCast.h"
 #include "../TextureUtils.h"
+#include "../BufferUtils.h"
 #include "../../Core/Helper.h"
 #include "../../Core/Assertion.h"
 #include "GLRenderingCaps.h"
@@ -26,6 +28,7 @@
 #include "Command/GLDeferredCommandBuffer.h"
 #include "RenderState/GLGraphicsPSO.h"
 #include "RenderState/GLComputePSO.h"
+#include <cstring>
 
 
 namespace LLGL
@@ -48,7 +51,11 @@ GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
 
 GLRenderSystem::~GLRenderSystem()
 {
+    /* Stop submission thread first, so the GL context is current on this thread while all objects are deleted */
+    submissionThread_.reset();
+
     /* Clear all render state containers first, the rest will be deleted automatically */
+    GLTextureHandlePool::Get().Clear();
     GLTextureViewPool::Get().Clear();
     GLMipGenerator::Get().Clear();
     GLStatePool::Get().Clear();
@@ -64,11 +71,15 @@ GLRenderContext* GLRenderSystem::GetSharedRenderContext() const
 
 RenderContext* GLRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
 {
+    if (submissionThread_)
+        throw std::runtime_error("cannot create more than one OpenGL render context with threaded submission");
     return AddRenderContext(MakeUnique<GLRenderContext>(desc, config_, surface, GetSharedRenderContext()));
 }
 
 void GLRenderSystem::Release(RenderContext& renderContext)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(renderContext));
+
     RemoveFromUniqueSet(renderContexts_, &renderContext);
 }
 
@@ -83,12 +94,14 @@ CommandQueue* GLRenderSystem::GetCommandQueue()
 
 CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateCommandBuffer(desc));
+
     /* Get state manager from shared render context */
     if (auto sharedContext = GetSharedRenderContext())
     {
-        if ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit)) != 0)
+        if ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit)) != 0 || submissionThread_)
         {
-            /* Create deferred command buffer */
+            /* Create deferred command buffer (also with threaded submission, since it can be recorded on any thread) */
             return TakeOwnership(
                 commandBuffers_,
                 MakeUnique<GLDeferredCommandBuffer>(desc.flags)
@@ -109,12 +122,14 @@ CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
 
 void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(commandBuffer));
+
     RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
 }
 
 /* ----- Buffers ------ */
 
-static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
+static GLbitfield GetGLBufferStorageFlags(const BufferDescriptor& desc)
 {
     #ifdef GL_ARB_buffer_storage
 
@@ -123,11 +138,15 @@ static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
     /* Allways enable dynamic storage, to enable usage of 'glBufferSubData' */
     flagsGL |= GL_DYNAMIC_STORAGE_BIT;
 
-    if ((cpuAccessFlags & CPUAccessFlags::Read) != 0)
+    if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0)
         flagsGL |= GL_MAP_READ_BIT;
-    if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
+    if ((desc.cpuAccessFlags & CPUAccessFlags::Write) != 0)
         flagsGL |= GL_MAP_WRITE_BIT;
 
+    /* Prefer client memory for readback buffers (i.e. pixel-pack buffers), since they are only read by the CPU */
+    if (IsReadbackBuffer(desc))
+        flagsGL |= GL_CLIENT_STORAGE_BIT;
+
     return flagsGL;
 
     #else
@@ -137,9 +156,12 @@ static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
     #endif // /GL_ARB_buffer_storage
 }
 
-static GLenum GetGLBufferUsage(long miscFlags)
+static GLenum GetGLBufferUsage(const BufferDescriptor& desc)
 {
-    return ((miscFlags & MiscFlags::DynamicUsage) != 0 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    if (IsReadbackBuffer(desc))
+        return GL_STREAM_READ;
+    else
+        return ((desc.miscFlags & MiscFlags::DynamicUsage) != 0 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 }
 
 static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
@@ -147,13 +169,15 @@ static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, co
     bufferGL.BufferStorage(
         static_cast<GLsizeiptr>(desc.size),
         initialData,
-        GetGLBufferStorageFlags(desc.cpuAccessFlags),
-        GetGLBufferUsage(desc.miscFlags)
+        GetGLBufferStorageFlags(desc),
+        GetGLBufferUsage(desc)
     );
 }
 
 Buffer* GLRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateBuffer(desc, initialData));
+
     AssertCreateBuffer(desc, static_cast<std::uint64_t>(std::numeric_limits<GLsizeiptr>::max()));
 
     auto bufferGL = CreateGLBuffer(desc, initialData);
@@ -192,6 +216,8 @@ GLBuffer* GLRenderSystem::CreateGLBuffer(const BufferDescriptor& desc, const voi
 
 BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateBufferArray(numBuffers, bufferArray));
+
     AssertCreateBufferArray(numBuffers, bufferArray);
 
     auto refBindFlags = bufferArray[0]->GetBindFlags();
@@ -208,28 +234,38 @@ BufferArray* GLRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void GLRenderSystem::Release(Buffer& buffer)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(buffer));
+
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
 void GLRenderSystem::Release(BufferArray& bufferArray)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(bufferArray));
+
     RemoveFromUniqueSet(bufferArrays_, &bufferArray);
 }
 
 void GLRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(WriteBuffer(dstBuffer, dstOffset, data, dataSize));
+
     auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
     dstBufferGL.BufferSubData(static_cast<GLintptr>(dstOffset), static_cast<GLsizeiptr>(dataSize), data);
 }
 
 void* GLRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(MapBuffer(buffer, access));
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     return bufferGL.MapBuffer(GLTypes::Map(access));
 }
 
 void GLRenderSystem::UnmapBuffer(Buffer& buffer)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(UnmapBuffer(buffer));
+
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     bufferGL.UnmapBuffer();
 }
@@ -276,6 +312,8 @@ void GLRenderSystem::ValidateGLTextureType(const TextureType type)
 
 Texture* GLRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateTexture(textureDesc, imageDesc));
+
     ValidateGLTextureType(textureDesc.type);
 
     /* Create <GLTexture> object; will result in a GL renderbuffer or texture instance */
@@ -319,48 +357,139 @@ Texture* GLRenderSystem::CreateTextureView(Texture& sharedTexture, const Texture
 
 void GLRenderSystem::Release(Texture& texture)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(texture));
+
     RemoveFromUniqueSet(textures_, &texture);
 }
 
 void GLRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
 {
-    /* Bind texture and write texture sub data */
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(WriteTexture(texture, textureRegion, imageDesc));
+
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
+
+    if (pixelUnpackRing_ && imageDesc.data != nullptr && !textureGL.IsRenderbuffer())
+    {
+        /*
+        Copy image data into pixel-unpack ring, so the driver doesn't have to copy client memory synchronously.
+        If the ring is full, recycle completed regions first, and fall back to client memory if there is still no space left.
+        */
+        const auto dataSize = static_cast<GLsizeiptr>(imageDesc.dataSize);
+        GLintptr offset = 0;
+
+        auto mappedData = pixelUnpackRing_->Reserve(dataSize, offset);
+        if (mappedData == nullptr)
+        {
+            pixelUnpackRing_->Flush();
+            mappedData = pixelUnpackRing_->Reserve(dataSize, offset);
+        }
+
+        if (mappedData != nullptr)
+        {
+            ::memcpy(mappedData, imageDesc.data, imageDesc.dataSize);
+            pixelUnpackRing_->Commit(offset, textureGL, textureRegion, imageDesc.format, imageDesc.dataType);
+            pixelUnpackRing_->Flush();
+            return;
+        }
+    }
+
+    /* Bind texture and write texture sub data */
     textureGL.TextureSubImage(textureRegion, imageDesc, false);
 }
 
 void GLRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(ReadTexture(texture, textureRegion, imageDesc));
+
     /* Bind texture and write texture sub data */
     LLGL_ASSERT_PTR(imageDesc.data);
     auto& textureGL = LLGL_CAST(GLTexture&, texture);
     textureGL.GetTextureSubImage(textureRegion, imageDesc, false);
 }
 
+TextureUploadRange GLRenderSystem::ReserveTextureUpload(std::uint64_t size)
+{
+    /* Reserve region in pixel-unpack ring; this does not issue any GL commands, so it is not dispatched to the submission thread */
+    TextureUploadRange range;
+
+    if (pixelUnpackRing_)
+    {
+        GLintptr offset = 0;
+        if (auto mappedData = pixelUnpackRing_->Reserve(static_cast<GLsizeiptr>(size), offset))
+        {
+            range.data      = mappedData;
+            range.size      = size;
+            range.offset    = static_cast<std::uint64_t>(offset);
+        }
+    }
+
+    return range;
+}
+
+void GLRenderSystem::CommitTextureUpload(const TextureUploadRange& range, Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    if (pixelUnpackRing_ && range.data != nullptr)
+    {
+        auto& textureGL = LLGL_CAST(GLTexture&, texture);
+        pixelUnpackRing_->Commit(static_cast<GLintptr>(range.offset), textureGL, textureRegion, format, dataType);
+    }
+}
+
+void GLRenderSystem::FlushTextureUploads()
+{
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(FlushTextureUploads());
+
+    if (pixelUnpackRing_)
+        pixelUnpackRing_->Flush();
+}
+
 /* ----- Sampler States ---- */
 
 Sampler* GLRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateSampler(desc));
+
     LLGL_ASSERT_FEATURE_SUPPORT(hasSamplers);
-    auto sampler = MakeUnique<GLSampler>();
-    sampler->SetDesc(desc);
-    return TakeOwnership(samplers_, std::move(sampler));
+
+    auto createSampler = [this, &desc]() -> Sampler*
+    {
+        auto sampler = MakeUnique<GLSampler>();
+        sampler->SetDesc(desc);
+        return TakeOwnership(samplers_, std::move(sampler));
+    };
+
+    if (GetConfiguration().samplerCache)
+        return samplerCache_.Acquire(desc, createSampler);
+    else
+        return createSampler();
 }
 
 void GLRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(sampler));
+
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+SamplerCacheStatistics GLRenderSystem::GetSamplerCacheStatistics() const
+{
+    return samplerCache_.GetStatistics();
 }
 
 /* ----- Resource Heaps ----- */
 
 ResourceHeap* GLRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<GLResourceHeap>(desc));
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateResourceHeap(desc));
+
+    return TakeOwnership(resourceHeaps_, MakeUnique<GLResourceHeap>(desc, config_));
 }
 
 void GLRenderSystem::Release(ResourceHeap& resourceHeap)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(resourceHeap));
+
     RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
 }
 
@@ -368,12 +497,16 @@ void GLRenderSystem::Release(ResourceHeap& resourceHeap)
 
 RenderPass* GLRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateRenderPass(desc));
+
     AssertCreateRenderPass(desc);
     return TakeOwnership(renderPasses_, MakeUnique<GLRenderPass>(desc));
 }
 
 void GLRenderSystem::Release(RenderPass& renderPass)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(renderPass));
+
     RemoveFromUniqueSet(renderPasses_, &renderPass);
 }
 
@@ -381,6 +514,8 @@ void GLRenderSystem::Release(RenderPass& renderPass)
 
 RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateRenderTarget(desc));
+
     LLGL_ASSERT_FEATURE_SUPPORT(hasRenderTargets);
     AssertCreateRenderTarget(desc);
     return TakeOwnership(renderTargets_, MakeUnique<GLRenderTarget>(desc));
@@ -388,6 +523,8 @@ RenderTarget* GLRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& d
 
 void GLRenderSystem::Release(RenderTarget& renderTarget)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(renderTarget));
+
     RemoveFromUniqueSet(renderTargets_, &renderTarget);
 }
 
@@ -395,6 +532,8 @@ void GLRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateShader(desc));
+
     AssertCreateShader(desc);
 
     /* Validate rendering capabilities for required shader type */
@@ -414,23 +553,29 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
             break;
     }
 
-    /* Make and return shader object */
-    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc));
+    /* Make and return shader object; compilation is deferred if the program might be loaded from the binary cache */
+    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc, programCache_ != nullptr));
 }
 
 ShaderProgram* GLRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateShaderProgram(desc));
+
     AssertCreateShaderProgram(desc);
-    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc));
+    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc, programCache_.get()));
 }
 
 void GLRenderSystem::Release(Shader& shader)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(shader));
+
     RemoveFromUniqueSet(shaders_, &shader);
 }
 
 void GLRenderSystem::Release(ShaderProgram& shaderProgram)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(shaderProgram));
+
     RemoveFromUniqueSet(shaderPrograms_, &shaderProgram);
 }
 
@@ -438,33 +583,43 @@ void GLRenderSystem::Release(ShaderProgram& shaderProgram)
 
 PipelineLayout* GLRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreatePipelineLayout(desc));
+
     return TakeOwnership(pipelineLayouts_, MakeUnique<GLPipelineLayout>(desc));
 }
 
 void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(pipelineLayout));
+
     RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
 
-PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
     return nullptr;//TODO
 }
 
 PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreatePipelineState(desc, nullptr));
+
     return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(desc, GetRenderingCaps().limits));
 }
 
 PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreatePipelineState(desc, nullptr));
+
     return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(desc));
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(pipelineState));
+
     RemoveFromUniqueSet(pipelineStates_, &pipelineState);
 }
 
@@ -472,11 +627,15 @@ void GLRenderSystem::Release(PipelineState& pipelineState)
 
 QueryHeap* GLRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateQueryHeap(desc));
+
     return TakeOwnership(queryHeaps_, MakeUnique<GLQueryHeap>(desc));
 }
 
 void GLRenderSystem::Release(QueryHeap& queryHeap)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(queryHeap));
+
     RemoveFromUniqueSet(queryHeaps_, &queryHeap);
 }
 
@@ -484,11 +643,15 @@ void GLRenderSystem::Release(QueryHeap& queryHeap)
 
 Fence* GLRenderSystem::CreateFence()
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(CreateFence());
+
     return TakeOwnership(fences_, MakeUnique<GLFence>());
 }
 
 void GLRenderSystem::Release(Fence& fence)
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Release(fence));
+
     RemoveFromUniqueSet(fences_, &fence);
 }
 
@@ -510,6 +673,10 @@ RenderContext* GLRenderSystem::AddRenderContext(std::unique_ptr<GLRenderContext>
     GLStateManager::Get().SetClipControl(GL_UPPER_LEFT, GL_ZERO_TO_ONE);
     #endif
 
+    /* Hand over the GL context to the submission thread once the first render context has been initialized */
+    if (config_.threadedSubmission)
+        submissionThread_ = MakeUnique<GLSubmissionThread>();
+
     /* Take ownership and return raw pointer */
     return TakeOwnership(renderContexts_, std::move(renderContext));
 }
@@ -532,6 +699,14 @@ void GLRenderSystem::CreateGLContextDependentDevices(GLRenderContext& renderCont
 
     /* Create command queue instance */
     commandQueue_ = MakeUnique<GLCommandQueue>(renderContext.GetStateManager());
+
+    /* Create program binary cache if enabled */
+    if (GLProgramCache::IsSupported(config_))
+        programCache_ = MakeUnique<GLProgramCache>(config_, GetRendererInfo());
+
+    /* Create ring buffer for streaming texture uploads if enabled */
+    if (config_.streamingBufferSize > 0 && GLPixelUnpackRing::IsSupported())
+        pixelUnpackRing_ = MakeUnique<GLPixelUnpackRing>(static_cast<GLsizeiptr>(config_.streamingBufferSize));
 }
 
 void GLRenderSystem::LoadGLExtensions(bool hasGLCoreProfile)
@@ -12,9 +12,11 @@
 #include <LLGL/RenderSystem.h>
 #include "Ext/GLExtensionLoader.h"
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 
 #include "Command/GLCommandQueue.h"
 #include "Command/GLCommandBuffer.h"
+#include "Command/GLSubmissionThread.h"
 #include "GLRenderContext.h"
 
 #include "Buffer/GLBuffer.h"
@@ -22,10 +24,12 @@
 
 #include "Shader/GLShader.h"
 #include "Shader/GLShaderProgram.h"
+#include "Shader/GLProgramCache.h"
 
 #include "Texture/GLTexture.h"
 #include "Texture/GLSampler.h"
 #include "Texture/GLRenderTarget.h"
+#include "Texture/GLPixelUnpackRing.h"
 
 #include "RenderState/GLQueryHeap.h"
 #include "RenderState/GLFence.h"
@@ -92,12 +96,18 @@ class GLRenderSystem final : public RenderSystem
         void WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc) override;
         void ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc) override;
 
+        TextureUploadRange ReserveTextureUpload(std::uint64_t size) override;
+        void CommitTextureUpload(const TextureUploadRange& range, Texture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType) override;
+        void FlushTextureUploads() override;
+
         /* ----- Sampler States ---- */
 
         Sampler* CreateSampler(const SamplerDescriptor& desc) override;
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Heaps ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -191,8 +201,13 @@ class GLRenderSystem final : public RenderSystem
         HWObjectContainer<GLQueryHeap>          queryHeaps_;
         HWObjectContainer<GLFence>              fences_;
 
+        SamplerCache                            samplerCache_;
+
         RendererConfigurationOpenGL             config_;
         DebugCallback                           debugCallback_;
+        std::unique_ptr<GLProgramCache>         programCache_;
+        std::unique_ptr<GLPixelUnpackRing>      pixelUnpackRing_;
+        std::unique_ptr<GLSubmissionThread>     submissionThread_;
 
 };
 
@@ -43,6 +43,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClear );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdClearBuffers );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindVertexArray );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindGL2XVertexArray );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindVertexBuffers );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindElementArrayBufferToVAO );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindBufferBase );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindBuffersBase );
@@ -613,6 +613,14 @@ GLenum ToPrimitiveMode(const PrimitiveTopology primitiveTopology)
     MapFailed("PrimitiveTopology");
 }
 
+GLenum ToVertexAttribType(const Format format)
+{
+    /* Packed formats have no data type for their components */
+    if (format == Format::RGB10A2UNorm)
+        return GL_UNSIGNED_INT_2_10_10_10_REV;
+    return Map(GetFormatAttribs(format).dataType);
+}
+
 
 /* ----- Unmap functions ----- */
 
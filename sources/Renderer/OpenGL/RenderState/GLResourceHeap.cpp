@@ -13,10 +13,13 @@
 #include "../Texture/GLSampler.h"
 #include "../Texture/GLTexture.h"
 #include "../Texture/GLTextureViewPool.h"
+#include "../Texture/GLTextureHandlePool.h"
 #include "../../CheckedCast.h"
 #include "../../ResourceBindingIterator.h"
 #include "../GLTypes.h"
+#include "../../../Core/Helper.h"
 #include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/RendererConfiguration.h>
 #include <string.h>
 
 
@@ -144,7 +147,7 @@ static GLTexture* GetAsTextureView(const ResourceViewDescriptor& rvDesc)
  * GLResourceHeap class
  */
 
-GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
+GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc, const RendererConfigurationOpenGL& config)
 {
     /* Get pipeline layout object */
     auto pipelineLayoutGL = LLGL_CAST(GLPipelineLayout*, desc.pipelineLayout);
@@ -176,6 +179,10 @@ GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
         BuildTextureViews(resourceIterator, BindFlags::Storage);
     }
 
+    /* Replace texture and sampler bindings by a buffer of bindless texture handles if enabled */
+    const bool isBindless = (config.bindlessTextures && GLTextureHandlePool::IsSupported());
+    std::vector<std::vector<GLuint64>> bindlessHandleSets;
+
     /* Build all resource view segments */
     for (std::size_t i = 0; i < numResourceViews; i += numBindings)
     {
@@ -186,21 +193,46 @@ GLResourceHeap::GLResourceHeap(const ResourceHeapDescriptor& desc)
         /* Build resource view segments for current descriptor set */
         BuildUniformBufferSegments(resourceIterator);
         BuildStorageBufferSegments(resourceIterator);
-        BuildTextureSegments(resourceIterator);
+        if (isBindless)
+        {
+            bindlessHandleSets.emplace_back();
+            BuildBindlessTextureHandles(resourceIterator, bindlessHandleSets.back());
+        }
+        else
+            BuildTextureSegments(resourceIterator);
         BuildImageTextureSegments(resourceIterator);
-        BuildSamplerSegments(resourceIterator);
+        if (!isBindless)
+            BuildSamplerSegments(resourceIterator);
     }
 
     /* Store buffer stride */
     stride_ = GetSegmentationHeapSize() / (numResourceViews / numBindings);
+
+    /* Upload bindless texture handles of all descriptor sets */
+    if (isBindless)
+    {
+        bindlessSlot_ = static_cast<GLuint>(config.bindlessTextureSlot);
+        BuildBindlessTextureBuffer(bindlessHandleSets);
+    }
 }
 
 GLResourceHeap::~GLResourceHeap()
 {
+    /* Release all bindless texture handles first, since they might refer to the texture views of this resource heap */
+    for (const auto& bindlessTex : bindlessTextures_)
+        GLTextureHandlePool::Get().ReleaseHandle(bindlessTex.texID, bindlessTex.samplerID, bindlessTex.generation);
+
     /* Release all texture views for this resource heap */
     const GLuint* textureViewIDs = reinterpret_cast<const GLuint*>(buffer_.data());
     for (std::size_t i = 0; i < numTextureViews_; ++i)
         GLTextureViewPool::Get().ReleaseTextureView(textureViewIDs[i]);
+
+    /* Release buffer of bindless texture handles */
+    if (bindlessBuffer_ != 0)
+    {
+        glDeleteBuffers(1, &bindlessBuffer_);
+        GLStateManager::Get().NotifyBufferRelease(bindlessBuffer_, GLBufferTarget::SHADER_STORAGE_BUFFER);
+    }
 }
 
 static void BindBuffersBaseSegment(GLStateManager& stateMngr, const std::int8_t*& byteAlignedBuffer, const GLBufferTarget bufferTarget)
@@ -276,7 +308,11 @@ static void BindSamplersSegment(GLStateManager& stateMngr, const std::int8_t*& b
 
 std::uint32_t GLResourceHeap::GetNumDescriptorSets() const
 {
-    return static_cast<std::uint32_t>(stride_ > 0 ? GetSegmentationHeapSize() / stride_ : 0);
+    if (stride_ > 0)
+        return static_cast<std::uint32_t>(GetSegmentationHeapSize() / stride_);
+    if (bindlessStride_ > 0)
+        return static_cast<std::uint32_t>(bindlessSize_ / bindlessStride_);
+    return 0;
 }
 
 void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t firstSet)
@@ -307,6 +343,18 @@ void GLResourceHeap::Bind(GLStateManager& stateMngr, std::uint32_t firstSet)
     for (std::uint8_t i = 0; i < segmentation_.numTextureSegments; ++i)
         BindTexturesSegment(stateMngr, byteAlignedBuffer);
 
+    /* Bind range of bindless texture handles for the selected descriptor set */
+    if (bindlessBuffer_ != 0)
+    {
+        stateMngr.BindBufferRange(
+            GLBufferTarget::SHADER_STORAGE_BUFFER,
+            bindlessSlot_,
+            bindlessBuffer_,
+            static_cast<GLintptr>(bindlessStride_ * firstSet),
+            bindlessStride_
+        );
+    }
+
     /* Bind all image texture units */
     for (std::uint8_t i = 0; i < segmentation_.numImageTextureSegments; ++i)
         BindImageTexturesSegment(stateMngr, byteAlignedBuffer);
@@ -570,6 +618,93 @@ void GLResourceHeap::BuildSamplerSegments(ResourceBindingIterator& resourceItera
     );
 }
 
+void GLResourceHeap::BuildBindlessTextureHandles(ResourceBindingIterator& resourceIterator, std::vector<GLuint64>& handles)
+{
+    /* Collect all textures with sampled binding, in the same way as for texture segments */
+    auto textureBindings = CollectGLResourceBindings(
+        resourceIterator,
+        ResourceType::Texture,
+        BindFlags::Sampled,
+        [this](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& rvDesc, std::uint32_t slot)
+        {
+            binding.slot = slot;
+            if (IsTextureViewEnabled(rvDesc.textureView))
+                binding.object = GetTextureViewID(this->numTextureViews_++);
+            else
+                binding.object = LLGL_CAST(GLTexture*, resource)->GetID();
+        }
+    );
+
+    if (textureBindings.empty())
+        return;
+
+    /* Collect all samplers that are combined with the textures at the same binding slots */
+    auto samplerBindings = CollectGLResourceBindings(
+        resourceIterator,
+        ResourceType::Sampler,
+        0,
+        [](GLResourceBinding& binding, Resource* resource, const ResourceViewDescriptor& /*rvDesc*/, std::uint32_t slot)
+        {
+            binding.slot    = slot;
+            binding.object  = LLGL_CAST(GLSampler*, resource)->GetID();
+        }
+    );
+
+    /* Make handles resident and store them at the index of their binding slot (both lists are sorted by slot) */
+    handles.resize(textureBindings.back().slot + 1, 0);
+
+    auto itSampler = samplerBindings.begin();
+    for (const auto& texBinding : textureBindings)
+    {
+        while (itSampler != samplerBindings.end() && itSampler->slot < texBinding.slot)
+            ++itSampler;
+
+        const GLuint samplerID = (itSampler != samplerBindings.end() && itSampler->slot == texBinding.slot ? itSampler->object : 0);
+
+        std::uint64_t generation = 0;
+        handles[texBinding.slot] = GLTextureHandlePool::Get().AcquireHandle(texBinding.object, samplerID, generation);
+        bindlessTextures_.push_back({ texBinding.object, samplerID, generation });
+    }
+}
+
+void GLResourceHeap::BuildBindlessTextureBuffer(const std::vector<std::vector<GLuint64>>& handleSets)
+{
+    #ifdef GL_ARB_shader_storage_buffer_object
+
+    /* Determine buffer stride per descriptor set, which must be a multiple of the storage buffer offset alignment */
+    std::size_t maxNumHandles = 0;
+    for (const auto& handles : handleSets)
+        maxNumHandles = std::max(maxNumHandles, handles.size());
+
+    if (maxNumHandles == 0)
+        return;
+
+    GLint offsetAlignment = 1;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+    bindlessStride_ = GetAlignedSize(
+        static_cast<GLsizeiptr>(maxNumHandles * sizeof(GLuint64)),
+        static_cast<GLsizeiptr>(std::max(1, offsetAlignment))
+    );
+    bindlessSize_ = bindlessStride_ * static_cast<GLsizeiptr>(handleSets.size());
+
+    /* Copy handles of each descriptor set into their segment of the buffer */
+    std::vector<std::int8_t> data(static_cast<std::size_t>(bindlessSize_), 0);
+    for (std::size_t i = 0; i < handleSets.size(); ++i)
+    {
+        const auto& handles = handleSets[i];
+        if (!handles.empty())
+            ::memcpy(&data[static_cast<std::size_t>(bindlessStride_) * i], handles.data(), handles.size() * sizeof(GLuint64));
+    }
+
+    /* Create storage buffer with all handles; it is never modified */
+    glGenBuffers(1, &bindlessBuffer_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::SHADER_STORAGE_BUFFER, bindlessBuffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, bindlessSize_, data.data(), GL_STATIC_DRAW);
+
+    #endif // /GL_ARB_shader_storage_buffer_object
+}
+
 void GLResourceHeap::BuildAllSegments(
     const std::vector<GLResourceBinding>&   resourceBindings,
     const BuildSegmentFunc&                 buildSegmentFunc,
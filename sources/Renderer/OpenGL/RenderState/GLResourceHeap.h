@@ -23,6 +23,7 @@ namespace LLGL
 class GLStateManager;
 class ResourceBindingIterator;
 struct ResourceHeapDescriptor;
+struct RendererConfigurationOpenGL;
 struct GLResourceBinding;
 
 /*
@@ -38,7 +39,7 @@ class GLResourceHeap final : public ResourceHeap
 
     public:
 
-        GLResourceHeap(const ResourceHeapDescriptor& desc);
+        GLResourceHeap(const ResourceHeapDescriptor& desc, const RendererConfigurationOpenGL& config);
         ~GLResourceHeap();
 
         // Binds this resource heap with the specified GL state manager.
@@ -59,6 +60,9 @@ class GLResourceHeap final : public ResourceHeap
         void BuildImageTextureSegments(ResourceBindingIterator& resourceIterator);
         void BuildSamplerSegments(ResourceBindingIterator& resourceIterator);
 
+        void BuildBindlessTextureHandles(ResourceBindingIterator& resourceIterator, std::vector<GLuint64>& handles);
+        void BuildBindlessTextureBuffer(const std::vector<std::vector<GLuint64>>& handleSets);
+
         void BuildAllSegments(
             const std::vector<GLResourceBinding>&   resourceBindings,
             const BuildSegmentFunc&                 buildSegmentFunc,
@@ -92,15 +96,29 @@ class GLResourceHeap final : public ResourceHeap
             std::uint8_t numSamplerSegments             = 0;
         };
 
+        // Texture and sampler IDs of a resident bindless texture handle, and the generation of its entry in the handle pool.
+        struct BindlessTexture
+        {
+            GLuint          texID;
+            GLuint          samplerID;
+            std::uint64_t   generation;
+        };
+
     private:
 
-        BufferSegmentation          segmentation_;
+        BufferSegmentation              segmentation_;
+
+        std::size_t                     numTextureViews_    = 0;    // Number of GL texture objects generated with glTextureView
+        std::size_t                     stride_             = 0;    // Buffer stride (in bytes) per descriptor set
+        std::vector<std::int8_t>        buffer_;                    // Raw buffer with resource binding information
 
-        std::size_t                 numTextureViews_    = 0;    // Number of GL texture objects generated with glTextureView
-        std::size_t                 stride_             = 0;    // Buffer stride (in bytes) per descriptor set
-        std::vector<std::int8_t>    buffer_;                    // Raw buffer with resource binding information
+        GLbitfield                      barriers_           = 0;    // Bitmask for glMemoryBarrier
 
-        GLbitfield                  barriers_           = 0;    // Bitmask for glMemoryBarrier
+        std::vector<BindlessTexture>    bindlessTextures_;          // Textures whose handles are made resident by this resource heap
+        GLuint                          bindlessBuffer_     = 0;    // Shader storage buffer with bindless texture handles (GL_ARB_bindless_texture)
+        GLuint                          bindlessSlot_       = 0;    // Binding slot of the bindless texture buffer
+        GLsizeiptr                      bindlessStride_     = 0;    // Bindless texture buffer stride (in bytes) per descriptor set
+        GLsizeiptr                      bindlessSize_       = 0;    // Bindless texture buffer size (in bytes)
 
 };
 
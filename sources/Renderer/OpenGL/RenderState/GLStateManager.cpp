@@ -1480,14 +1480,15 @@ static void AccumCommonGLLimits(GLStateManager::GLLimits& dst, const GLStateMana
     else
     {
         /* Find smallest limits */
-        dst.maxViewports        = std::min(dst.maxViewports, src.maxViewports);
-        dst.lineWidthRange[0]   = std::min(dst.lineWidthRange[0], src.lineWidthRange[0]);
-        dst.lineWidthRange[1]   = std::min(dst.lineWidthRange[1], src.lineWidthRange[1]);
-        dst.maxDebugNameLength  = std::min(dst.maxDebugNameLength, src.maxDebugNameLength);
-        dst.maxDebugStackDepth  = std::min(dst.maxDebugStackDepth, src.maxDebugStackDepth);
-        dst.maxLabelLength      = std::min(dst.maxLabelLength, src.maxLabelLength);
-        dst.maxTextureLayers    = std::min(dst.maxTextureLayers, src.maxTextureLayers);
-        dst.maxImageUnits       = std::min(dst.maxImageUnits, src.maxImageUnits);
+        dst.maxViewports                  = std::min(dst.maxViewports, src.maxViewports);
+        dst.lineWidthRange[0]             = std::min(dst.lineWidthRange[0], src.lineWidthRange[0]);
+        dst.lineWidthRange[1]             = std::min(dst.lineWidthRange[1], src.lineWidthRange[1]);
+        dst.maxDebugNameLength            = std::min(dst.maxDebugNameLength, src.maxDebugNameLength);
+        dst.maxDebugStackDepth            = std::min(dst.maxDebugStackDepth, src.maxDebugStackDepth);
+        dst.maxLabelLength                = std::min(dst.maxLabelLength, src.maxLabelLength);
+        dst.maxTextureLayers              = std::min(dst.maxTextureLayers, src.maxTextureLayers);
+        dst.maxImageUnits                 = std::min(dst.maxImageUnits, src.maxImageUnits);
+        dst.maxVertexAttribRelativeOffset = std::min(dst.maxVertexAttribRelativeOffset, src.maxVertexAttribRelativeOffset);
     }
 }
 
@@ -1533,6 +1534,16 @@ void GLStateManager::DetermineLimits()
     }
     #endif // /GL_ARB_shader_image_load_store
 
+    /* Get maximum relative offset of vertex attributes */
+    #ifdef GL_ARB_vertex_attrib_binding
+    if (HasExtension(GLExt::ARB_vertex_attrib_binding))
+    {
+        GLint maxVertexAttribRelativeOffset = 0;
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET, &maxVertexAttribRelativeOffset);
+        limits_.maxVertexAttribRelativeOffset = static_cast<GLuint>(maxVertexAttribRelativeOffset);
+    }
+    #endif // /GL_ARB_vertex_attrib_binding
+
     /* Accumulate common limitations */
     AccumCommonGLLimits(GLStateManager::commonLimits_, limits_);
 }
@@ -47,13 +47,14 @@ class GLStateManager
         // GL limitations required for validation of state parameters
         struct GLLimits
         {
-            GLint       maxViewports        = 0;                // Maximum number of viewports (minimum value is 16).
-            GLfloat     lineWidthRange[2]   = { 1.0f, 1.0f };   // Minimal range of both <aliased> and <smooth> line width range.
-            GLint       maxDebugNameLength  = 0;                // Maximal length of names for debug groups (minimum value is 1).
-            GLint       maxDebugStackDepth  = 0;                // Maximal depth of the debug group stack (minimum value is 64).
-            GLint       maxLabelLength      = 0;                // Maximal length of debug labels (minimum value is 256).
-            GLuint      maxTextureLayers    = 0;                // Maximal number of texture layers (minimum value is 16).
-            GLuint      maxImageUnits       = 0;                // Maximal number of image units.
+            GLint       maxViewports                  = 0;                // Maximum number of viewports (minimum value is 16).
+            GLfloat     lineWidthRange[2]             = { 1.0f, 1.0f };   // Minimal range of both <aliased> and <smooth> line width range.
+            GLint       maxDebugNameLength            = 0;                // Maximal length of names for debug groups (minimum value is 1).
+            GLint       maxDebugStackDepth            = 0;                // Maximal depth of the debug group stack (minimum value is 64).
+            GLint       maxLabelLength                = 0;                // Maximal length of debug labels (minimum value is 256).
+            GLuint      maxTextureLayers              = 0;                // Maximal number of texture layers (minimum value is 16).
+            GLuint      maxImageUnits                 = 0;                // Maximal number of image units.
+            GLuint      maxVertexAttribRelativeOffset = 0;                // Maximal offset of vertex attributes relative to their vertex buffer binding (minimum value is 2047).
         };
 
     public:
@@ -342,25 +343,25 @@ class GLStateManager
             #ifdef LLGL_OPENGL
             GLenum      polygonMode     = GL_FILL;
             #endif
-            GLfloat     offsetFactor    = 0.0f;
-            GLfloat     offsetUnits     = 0.0f;
-            GLfloat     offsetClamp     = 0.0f;
+            GLfloat      offsetFactor    = 0.0f;
+            GLfloat      offsetUnits     = 0.0f;
+            GLfloat      offsetClamp     = 0.0f;
             GLenum      cullFace        = GL_BACK;
             GLenum      frontFace       = GL_CCW;
             GLenum      frontFaceAct    = GL_CCW; // actual front face input (without possible inversion)
-            GLint       patchVertices   = 0;
-            GLfloat     lineWidth       = 1.0f;
+            GLint        patchVertices   = 0;
+            GLfloat      lineWidth       = 1.0f;
 
             GLenum      depthFunc       = GL_LESS;
             GLboolean   depthMask       = GL_TRUE;
             GLboolean   cachedDepthMask = GL_TRUE;
 
-            GLfloat     blendColor[4]   = { 0.0f, 0.0f, 0.0f, 0.0f };
+            GLfloat      blendColor[4]   = { 0.0f, 0.0f, 0.0f, 0.0f };
             #ifdef LLGL_OPENGL
             GLenum      logicOpCode     = GL_COPY;
             #endif
             #ifdef LLGL_PRIMITIVE_RESTART
-            GLuint      primitiveRestartIndex = 0;
+            GLuint       primitiveRestartIndex = 0;
             #endif
         };
 
@@ -396,12 +397,12 @@ class GLStateManager
             struct StackEntry
             {
                 GLBufferTarget  target;
-                GLuint          buffer;
+                GLuint           buffer;
             };
 
             std::array<GLuint, numBufferTargets>    boundBuffers;
             std::stack<StackEntry>                  boundBufferStack;
-            GLuint                                  lastVertexAttribArray   = 0;
+            GLuint                                   lastVertexAttribArray   = 0;
         };
 
         struct GLFramebufferState
@@ -409,7 +410,7 @@ class GLStateManager
             struct StackEntry
             {
                 GLFramebufferTarget target;
-                GLuint              framebuffer;
+                GLuint               framebuffer;
             };
 
             std::array<GLuint, numFramebufferTargets>   boundFramebuffers;
@@ -419,7 +420,7 @@ class GLStateManager
 
         struct GLRenderbufferState
         {
-            GLuint              boundRenderbuffer = 0;
+            GLuint               boundRenderbuffer = 0;
             std::stack<GLuint>  boundRenderbufferStack;
         };
 
@@ -434,7 +435,7 @@ class GLStateManager
             {
                 std::uint32_t   layer;
                 GLTextureTarget target;
-                GLuint          texture;
+                GLuint           texture;
             };
 
             std::uint32_t                                   activeTexture       = 0;
@@ -96,6 +96,7 @@ void GLStatePool::Clear()
     rasterizerStates_.clear();
     blendStates_.clear();
     shaderBindingLayouts_.clear();
+    vertexArrays_.clear();
 }
 
 GLDepthStencilStateSPtr GLStatePool::CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
@@ -154,6 +155,23 @@ void GLStatePool::ReleaseShaderBindingLayout(GLShaderBindingLayoutSPtr&& shaderB
     );
 }
 
+GLSharedVertexArraySPtr GLStatePool::CreateVertexArray(const std::vector<GLVertexAttribFormat>& attribFormats)
+{
+    /* Generate hardware VAO only for new entries, since the pool only stores copies of the vertex format */
+    auto vertexArray = CreateRenderStateObject(vertexArrays_, attribFormats);
+    vertexArray->Build();
+    return vertexArray;
+}
+
+void GLStatePool::ReleaseVertexArray(GLSharedVertexArraySPtr&& vertexArray)
+{
+    ReleaseRenderStateObject<GLSharedVertexArray>(
+        vertexArrays_,
+        nullptr,
+        std::forward<GLSharedVertexArraySPtr>(vertexArray)
+    );
+}
+
 
 } // /namespace LLGL
 
@@ -15,6 +15,7 @@
 #include "GLBlendState.h"
 #include "GLPipelineLayout.h"
 #include "../Shader/GLShaderBindingLayout.h"
+#include "../Buffer/GLSharedVertexArray.h"
 #include <vector>
 
 
@@ -23,7 +24,7 @@ namespace LLGL
 
 
 /*
-Singleton pool for OpenGL depth-stencil-, rasterizer-, and blend states.
+Singleton pool for OpenGL depth-stencil-, rasterizer-, and blend states as well as shared vertex-array-objects.
 These states are separated from the GLStateManager, because they don't need to exist for every GL context.
 */
 class GLStatePool
@@ -60,6 +61,11 @@ class GLStatePool
         GLShaderBindingLayoutSPtr CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout);
         void ReleaseShaderBindingLayout(GLShaderBindingLayoutSPtr&& shaderBindingLayout);
 
+        /* ----- Vertex arrays ----- */
+
+        GLSharedVertexArraySPtr CreateVertexArray(const std::vector<GLVertexAttribFormat>& attribFormats);
+        void ReleaseVertexArray(GLSharedVertexArraySPtr&& vertexArray);
+
     private:
 
         GLStatePool() = default;
@@ -70,6 +76,7 @@ class GLStatePool
         std::vector<GLRasterizerStateSPtr>      rasterizerStates_;
         std::vector<GLBlendStateSPtr>           blendStates_;
         std::vector<GLShaderBindingLayoutSPtr>  shaderBindingLayouts_;
+        std::vector<GLSharedVertexArraySPtr>    vertexArrays_;
 
 };
 
@@ -0,0 +1,275 @@
+/*
+ * GLProgramCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLProgramCache.h"
+#include "GLShader.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include "../../../Core/HashUtils.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/ShaderProgramFlags.h>
+#include <LLGL/Blob.h>
+#include <LLGL/Platform/Platform.h>
+#include <fstream>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <cstdio>
+#include <cstring>
+
+#if defined LLGL_OS_WIN32
+#   include "../../../Platform/Win32/Win32LeanAndMean.h"
+#   include <Windows.h>
+#else
+#   include <unistd.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Header of each cached program binary, followed by the binary data from glGetProgramBinary.
+struct GLProgramBinaryHeader
+{
+    std::uint32_t   magic;
+    std::uint32_t   format;
+};
+
+static const std::uint32_t g_programBinaryMagic = 0x42504C47; // "GLPB"
+
+
+/*
+ * GLProgramBinaryDiskStore class
+ */
+
+// Default program binary store that keeps each binary in a separate file.
+class GLProgramBinaryDiskStore final : public OpenGLProgramBinaryStore
+{
+
+    public:
+
+        GLProgramBinaryDiskStore(const std::string& directory) :
+            directory_ { directory }
+        {
+            if (!directory_.empty() && directory_.back() != '/' && directory_.back() != '\\')
+                directory_ += '/';
+        }
+
+        std::unique_ptr<Blob> LoadProgramBinary(const std::string& key) override
+        {
+            return Blob::CreateMapped(GetFilename(key), BlobMappingFlags::Sequential);
+        }
+
+        void StoreProgramBinary(const std::string& key, const Blob& binary) override
+        {
+            /*
+            Write binary into a temporary file first and then replace the cache file, so another thread or process
+            that loads the same key concurrently never sees a partially written file.
+            */
+            const auto filename     = GetFilename(key);
+            const auto tempFilename = filename + "." + GetUniqueWriterID() + ".tmp";
+
+            {
+                std::ofstream file { tempFilename, std::ios::out | std::ios::binary | std::ios::trunc };
+                if (!file.good())
+                    return;
+
+                file.write(reinterpret_cast<const char*>(binary.GetData()), static_cast<std::streamsize>(binary.GetSize()));
+                file.close();
+
+                if (file.fail())
+                {
+                    std::remove(tempFilename.c_str());
+                    return;
+                }
+            }
+
+            if (!MoveCacheFile(tempFilename, filename))
+                std::remove(tempFilename.c_str());
+        }
+
+    private:
+
+        // Returns an identifier of the calling thread and process for the names of temporary files.
+        static std::string GetUniqueWriterID()
+        {
+            #if defined LLGL_OS_WIN32
+            const auto processID = static_cast<std::uint64_t>(GetCurrentProcessId());
+            #else
+            const auto processID = static_cast<std::uint64_t>(getpid());
+            #endif
+            const auto threadID = static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+            return ToHex(processID) + ToHex(threadID);
+        }
+
+        // Replaces the destination file by the source file in a single step. Returns false on failure.
+        static bool MoveCacheFile(const std::string& srcFilename, const std::string& dstFilename)
+        {
+            #if defined LLGL_OS_WIN32
+            return (MoveFileExA(srcFilename.c_str(), dstFilename.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE);
+            #else
+            return (std::rename(srcFilename.c_str(), dstFilename.c_str()) == 0);
+            #endif
+        }
+
+        std::string GetFilename(const std::string& key) const
+        {
+            return directory_ + key + ".glbin";
+        }
+
+    private:
+
+        std::string directory_;
+
+};
+
+
+/*
+ * GLProgramCache class
+ */
+
+GLProgramCache::GLProgramCache(const RendererConfigurationOpenGL& config, const RendererInfo& info)
+{
+    /* Use user-supplied store or fall back to the disk store */
+    if (config.programBinaryStore != nullptr)
+        store_ = config.programBinaryStore;
+    else
+    {
+        diskStore_  = MakeUnique<GLProgramBinaryDiskStore>(config.programBinaryCacheDir);
+        store_      = diskStore_.get();
+    }
+
+    /* Program binaries are only valid for the same renderer and driver version */
+    driverHash_ = HashString(info.rendererName.c_str());
+    driverHash_ = HashString(info.deviceName.c_str(), driverHash_);
+    driverHash_ = HashString(info.vendorName.c_str(), driverHash_);
+}
+
+GLProgramCache::~GLProgramCache()
+{
+    // dummy
+}
+
+bool GLProgramCache::IsSupported(const RendererConfigurationOpenGL& config)
+{
+    if (config.programBinaryStore == nullptr && config.programBinaryCacheDir.empty())
+        return false;
+
+    #ifdef GL_ARB_get_program_binary
+    if (HasExtension(GLExt::ARB_get_program_binary))
+    {
+        /* Some drivers expose the extension without supporting any binary format */
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        return (numFormats > 0);
+    }
+    #endif
+
+    return false;
+}
+
+// Includes the hash of the specified shader into the program hash.
+static void HashShader(std::uint64_t& hash, const Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderGL = LLGL_CAST(const GLShader*, shader);
+        hash = HashValue(shaderGL->GetHash(), hash);
+    }
+    else
+        hash = HashValue(std::uint64_t(0), hash);
+}
+
+std::string GLProgramCache::MakeKey(const ShaderProgramDescriptor& desc) const
+{
+    auto hash = driverHash_;
+    {
+        HashShader(hash, desc.vertexShader);
+        HashShader(hash, desc.tessControlShader);
+        HashShader(hash, desc.tessEvaluationShader);
+        HashShader(hash, desc.geometryShader);
+        HashShader(hash, desc.fragmentShader);
+        HashShader(hash, desc.computeShader);
+    }
+    return ToHex(hash);
+}
+
+void GLProgramCache::MarkRetrievable(GLuint program)
+{
+    #ifdef GL_ARB_get_program_binary
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    #endif
+}
+
+bool GLProgramCache::LoadProgram(GLuint program, const std::string& key)
+{
+    #ifdef GL_ARB_get_program_binary
+
+    /* Find program binary in store */
+    auto binary = store_->LoadProgramBinary(key);
+    if (!binary || binary->GetSize() <= sizeof(GLProgramBinaryHeader))
+        return false;
+
+    GLProgramBinaryHeader header;
+    ::memcpy(&header, binary->GetData(), sizeof(header));
+
+    if (header.magic != g_programBinaryMagic)
+        return false;
+
+    /* Load program binary; the driver rejects it if the binary is no longer compatible */
+    auto data = reinterpret_cast<const std::int8_t*>(binary->GetData()) + sizeof(header);
+    glProgramBinary(program, header.format, data, static_cast<GLsizei>(binary->GetSize() - sizeof(header)));
+
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    return (status != GL_FALSE);
+
+    #else
+
+    return false;
+
+    #endif
+}
+
+void GLProgramCache::StoreProgram(GLuint program, const std::string& key)
+{
+    #ifdef GL_ARB_get_program_binary
+
+    /* Query program binary size */
+    GLint binaryLength = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    /* Query program binary behind the header */
+    std::vector<std::int8_t> buffer(sizeof(GLProgramBinaryHeader) + static_cast<std::size_t>(binaryLength));
+
+    GLProgramBinaryHeader header;
+    GLenum format = 0;
+    glGetProgramBinary(program, binaryLength, nullptr, &format, buffer.data() + sizeof(header));
+    {
+        header.magic    = g_programBinaryMagic;
+        header.format   = static_cast<std::uint32_t>(format);
+    }
+    ::memcpy(buffer.data(), &header, sizeof(header));
+
+    /* Pass binary to store */
+    auto binary = Blob::CreateStrongRef(std::move(buffer));
+    store_->StoreProgramBinary(key, *binary);
+
+    #endif
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,66 @@
+/*
+ * GLProgramCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PROGRAM_CACHE_H
+#define LLGL_GL_PROGRAM_CACHE_H
+
+
+#include <LLGL/ForwardDecls.h>
+#include <LLGL/RendererConfiguration.h>
+#include "../OpenGL.h"
+#include <memory>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+Cache of linked GL program binaries (GL_ARB_get_program_binary).
+Shaders are compiled lazily when this cache is enabled, so a cache hit skips both compilation and linking.
+*/
+class GLProgramCache
+{
+
+    public:
+
+        GLProgramCache(const RendererConfigurationOpenGL& config, const RendererInfo& info);
+        ~GLProgramCache();
+
+        // Returns true if the program binary cache is enabled by the specified configuration and supported by the GL implementation.
+        static bool IsSupported(const RendererConfigurationOpenGL& config);
+
+        // Returns the cache key for the shaders of the specified program descriptor and the current driver.
+        std::string MakeKey(const ShaderProgramDescriptor& desc) const;
+
+        // Tells the GL implementation that the binary of the specified program will be retrieved. Must be called before the program is linked.
+        void MarkRetrievable(GLuint program);
+
+        // Tries to load the specified program from its cached binary. Returns false on a cache miss or if the binary has been rejected by the driver.
+        bool LoadProgram(GLuint program, const std::string& key);
+
+        // Stores the binary of the specified linked program in the cache.
+        void StoreProgram(GLuint program, const std::string& key);
+
+    private:
+
+        OpenGLProgramBinaryStore*                   store_      = nullptr;
+        std::unique_ptr<OpenGLProgramBinaryStore>   diskStore_;
+        std::uint64_t                               driverHash_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
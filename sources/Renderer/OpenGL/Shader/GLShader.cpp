@@ -10,7 +10,9 @@
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../GLTypes.h"
+#include "../Command/GLSubmissionThread.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/HashUtils.h"
 #include "../../../Core/Exception.h"
 #include <vector>
 #include <sstream>
@@ -22,16 +24,17 @@ namespace LLGL
 {
 
 
-GLShader::GLShader(const ShaderDescriptor& desc) :
+GLShader::GLShader(const ShaderDescriptor& desc, bool deferCompilation) :
     Shader { desc.type }
 {
     /* Create shader and  */
     id_ = glCreateShader(GLTypes::Map(desc.type));
-    BuildShader(desc);
+    BuildShader(desc, deferCompilation);
     ReserveAttribs(desc);
     BuildVertexInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
     BuildTransformFeedbackVaryings(desc.vertex.outputAttribs.size(), desc.vertex.outputAttribs.data());
     BuildFragmentOutputLayout(desc.fragment.outputAttribs.size(), desc.fragment.outputAttribs.data());
+    HashAttribs();
 }
 
 GLShader::~GLShader()
@@ -46,6 +49,10 @@ void GLShader::SetName(const char* name)
 
 bool GLShader::HasErrors() const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(HasErrors());
+
+    CompileDeferred();
+
     GLint status = 0;
     glGetShaderiv(id_, GL_COMPILE_STATUS, &status);
     return (status == GL_FALSE);
@@ -53,6 +60,10 @@ bool GLShader::HasErrors() const
 
 std::string GLShader::GetReport() const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(GetReport());
+
+    CompileDeferred();
+
     /* Query info log length */
     GLint infoLogLength = 0;
     glGetShaderiv(id_, GL_INFO_LOG_LENGTH, &infoLogLength);
@@ -74,6 +85,15 @@ std::string GLShader::GetReport() const
     return "";
 }
 
+void GLShader::CompileDeferred() const
+{
+    if (compilePending_)
+    {
+        glCompileShader(id_);
+        compilePending_ = false;
+    }
+}
+
 const GLShaderAttribute* GLShader::GetVertexAttribs() const
 {
     if (!shaderAttribs_.empty())
@@ -105,10 +125,11 @@ std::size_t GLShader::GetNumFragmentAttribs() const
  * ======= Private: =======
  */
 
-void GLShader::BuildShader(const ShaderDescriptor& shaderDesc)
+void GLShader::BuildShader(const ShaderDescriptor& shaderDesc, bool deferCompilation)
 {
+    HashShaderDesc(shaderDesc);
     if (IsShaderSourceCode(shaderDesc.sourceType))
-        CompileSource(shaderDesc);
+        CompileSource(shaderDesc, deferCompilation);
     else
         LoadBinary(shaderDesc);
 }
@@ -201,7 +222,7 @@ void GLShader::BuildTransformFeedbackVaryings(std::size_t numVaryings, const Ver
     }
 }
 
-void GLShader::CompileSource(const ShaderDescriptor& shaderDesc)
+void GLShader::CompileSource(const ShaderDescriptor& shaderDesc, bool deferCompilation)
 {
     /* Get source code */
     std::string fileContent;
@@ -217,9 +238,16 @@ void GLShader::CompileSource(const ShaderDescriptor& shaderDesc)
         strings[0] = shaderDesc.source;
     }
 
-    /* Load shader source code, then compile shader */
+    /* Include source code in shader hash */
+    hash_ = HashString(strings[0], hash_);
+
+    /* Load shader source code, then compile shader (unless it might be loaded from a program binary) */
     glShaderSource(id_, 1, strings, nullptr);
-    glCompileShader(id_);
+
+    if (deferCompilation)
+        compilePending_ = true;
+    else
+        glCompileShader(id_);
 }
 
 void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
@@ -228,16 +256,16 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
     if (HasExtension(GLExt::ARB_gl_spirv) && HasExtension(GLExt::ARB_ES2_compatibility))
     {
         /* Get shader binary */
-        std::vector<char>   fileContent;
-        const void*         binaryBuffer    = nullptr;
-        GLsizei             binaryLength    = 0;
+        std::unique_ptr<Blob>   fileContent;
+        const void*             binaryBuffer    = nullptr;
+        GLsizei                 binaryLength    = 0;
 
         if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
         {
-            /* Load binary from file */
-            fileContent = ReadFileBuffer(shaderDesc.source);
-            binaryBuffer = fileContent.data();
-            binaryLength = static_cast<GLsizei>(fileContent.size());
+            /* Load binary from mapped file */
+            fileContent = MapFileBuffer(shaderDesc.source);
+            binaryBuffer = fileContent->GetData();
+            binaryLength = static_cast<GLsizei>(fileContent->GetSize());
         }
         else
         {
@@ -246,12 +274,36 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
             binaryLength = static_cast<GLsizei>(shaderDesc.sourceSize);
         }
 
+        /* Include shader binary in shader hash */
+        hash_ = HashBytes(binaryBuffer, static_cast<std::size_t>(binaryLength), hash_);
+
         /* Load shader binary */
         glShaderBinary(1, &id_, GL_SHADER_BINARY_FORMAT_SPIR_V, binaryBuffer, binaryLength);
 
+        /* Gather specialization constants as 32-bit words, and merge duplicate constant IDs so the last value is used */
+        std::vector<GLuint> constantIndices;
+        std::vector<GLuint> constantValues;
+
+        constantIndices.reserve(shaderDesc.specializationConstants.size());
+        constantValues.reserve(shaderDesc.specializationConstants.size());
+
+        for (const auto& constant : shaderDesc.specializationConstants)
+        {
+            auto it = std::find(constantIndices.begin(), constantIndices.end(), constant.constantID);
+            if (it != constantIndices.end())
+                constantValues[static_cast<std::size_t>(it - constantIndices.begin())] = constant.u32;
+            else
+            {
+                constantIndices.push_back(constant.constantID);
+                constantValues.push_back(constant.u32);
+            }
+        }
+
+        const auto numConstants = constantIndices.size();
+
         /* Specialize for the default "main" function in a SPIR-V module  */
         const char* entryPoint = (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0' ? "main" : shaderDesc.entryPoint);
-        glSpecializeShader(id_, entryPoint, 0, nullptr, nullptr);
+        glSpecializeShader(id_, entryPoint, static_cast<GLuint>(numConstants), constantIndices.data(), constantValues.data());
     }
     else
     #endif
@@ -260,6 +312,43 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
     }
 }
 
+void GLShader::HashShaderDesc(const ShaderDescriptor& shaderDesc)
+{
+    /* Hash shader type, entry point, macros, and specialization constants; the source is hashed when it is loaded */
+    hash_ = HashValue(shaderDesc.type);
+    hash_ = HashString(shaderDesc.entryPoint, hash_);
+
+    if (auto defines = shaderDesc.defines)
+    {
+        for (; defines->name != nullptr; ++defines)
+        {
+            hash_ = HashString(defines->name, hash_);
+            hash_ = HashString(defines->definition, hash_);
+        }
+    }
+
+    for (const auto& constant : shaderDesc.specializationConstants)
+    {
+        hash_ = HashValue(constant.constantID, hash_);
+        hash_ = HashValue(constant.u32, hash_);
+    }
+}
+
+void GLShader::HashAttribs()
+{
+    /* Hash vertex input and fragment output bindings, as well as transform feedback varyings */
+    hash_ = HashValue(numVertexAttribs_, hash_);
+
+    for (const auto& attr : shaderAttribs_)
+    {
+        hash_ = HashValue(attr.index, hash_);
+        hash_ = HashString(attr.name, hash_);
+    }
+
+    for (auto varying : transformFeedbackVaryings_)
+        hash_ = HashString(varying, hash_);
+}
+
 
 } // /namespace LLGL
 
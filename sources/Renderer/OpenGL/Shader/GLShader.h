@@ -37,9 +37,18 @@ class GLShader final : public Shader
 
     public:
 
-        GLShader(const ShaderDescriptor& desc);
+        GLShader(const ShaderDescriptor& desc, bool deferCompilation = false);
         ~GLShader();
 
+        // Compiles the shader if its compilation has been deferred (see GLProgramCache).
+        void CompileDeferred() const;
+
+        // Returns the hash of the shader source, macros, and attribute bindings.
+        inline std::uint64_t GetHash() const
+        {
+            return hash_;
+        }
+
         // Returns the native shader ID.
         inline GLuint GetID() const
         {
@@ -62,15 +71,18 @@ class GLShader final : public Shader
 
     private:
 
-        void BuildShader(const ShaderDescriptor& shaderDesc);
+        void BuildShader(const ShaderDescriptor& shaderDesc, bool deferCompilation);
         void ReserveAttribs(const ShaderDescriptor& desc);
         void BuildVertexInputLayout(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
         void BuildFragmentOutputLayout(std::size_t numFragmentAttribs, const FragmentAttribute* fragmentAttribs);
         void BuildTransformFeedbackVaryings(std::size_t numVaryings, const VertexAttribute* varyings);
 
-        void CompileSource(const ShaderDescriptor& shaderDesc);
+        void CompileSource(const ShaderDescriptor& shaderDesc, bool deferCompilation);
         void LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        void HashShaderDesc(const ShaderDescriptor& shaderDesc);
+        void HashAttribs();
+
     private:
 
         GLuint                          id_                         = 0;
@@ -80,6 +92,9 @@ class GLShader final : public Shader
         std::size_t                     numVertexAttribs_           = 0;
         std::vector<const char*>        transformFeedbackVaryings_;
 
+        std::uint64_t                   hash_                       = 0;
+        mutable bool                    compilePending_             = false;
+
 };
 
 
@@ -8,9 +8,11 @@
 #include "GLShaderProgram.h"
 #include "GLShader.h"
 #include "GLShaderBindingLayout.h"
+#include "GLProgramCache.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../RenderState/GLStateManager.h"
+#include "../Command/GLSubmissionThread.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
@@ -25,9 +27,50 @@ namespace LLGL
 {
 
 
-GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
+// Returns the shader whose transform feedback varyings are used for the program, i.e. the geometry shader if present, or otherwise the vertex shader.
+static GLShader* GetShaderWithVaryings(const ShaderProgramDescriptor& desc)
+{
+    if (auto gs = desc.geometryShader)
+    {
+        auto gsGL = LLGL_CAST(GLShader*, gs);
+        if (!gsGL->GetTransformFeedbackVaryings().empty())
+            return gsGL;
+    }
+    else if (auto vs = desc.vertexShader)
+    {
+        auto vsGL = LLGL_CAST(GLShader*, vs);
+        if (!vsGL->GetTransformFeedbackVaryings().empty())
+            return vsGL;
+    }
+    return nullptr;
+}
+
+GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc, GLProgramCache* programCache) :
     id_ { glCreateProgram() }
 {
+    /* Try to load program from binary cache before any shader is compiled */
+    std::string cacheKey;
+    if (programCache != nullptr)
+    {
+        cacheKey = programCache->MakeKey(desc);
+        if (programCache->LoadProgram(id_, cacheKey))
+        {
+            #if defined GL_NV_transform_feedback && !defined __APPLE__
+            /* Varyings for GL_NV_transform_feedback are specified after linking, so they are not restored by the program binary */
+            if (!HasExtension(GLExt::EXT_transform_feedback) && HasExtension(GLExt::NV_transform_feedback))
+            {
+                if (auto shaderWithVaryings = GetShaderWithVaryings(desc))
+                {
+                    const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
+                    BuildTransformFeedbackVaryingsNV(varyings.size(), varyings.data());
+                }
+            }
+            #endif
+            return;
+        }
+        programCache->MarkRetrievable(id_);
+    }
+
     Attach(desc.vertexShader);
     Attach(desc.tessControlShader);
     Attach(desc.tessEvaluationShader);
@@ -50,28 +93,17 @@ GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
     }
 
     /* Build transform feedback varyings for vertex or geometry shader (latter one has higher order) */
-    GLShader* shaderWithVaryings = nullptr;
-
-    if (auto gs = desc.geometryShader)
-    {
-        auto gsGL = LLGL_CAST(GLShader*, gs);
-        if (!gsGL->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = gsGL;
-    }
-    else if (auto vs = desc.vertexShader)
-    {
-        auto vsGL = LLGL_CAST(GLShader*, vs);
-        if (!vsGL->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = vsGL;
-    }
-
-    if (shaderWithVaryings != nullptr)
+    if (auto shaderWithVaryings = GetShaderWithVaryings(desc))
     {
         const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
         LinkProgram(varyings.size(), varyings.data());
     }
     else
         LinkProgram(0, nullptr);
+
+    /* Store linked program in binary cache */
+    if (programCache != nullptr && !HasErrors())
+        programCache->StoreProgram(id_, cacheKey);
 }
 
 GLShaderProgram::~GLShaderProgram()
@@ -87,6 +119,8 @@ void GLShaderProgram::SetName(const char* name)
 
 bool GLShaderProgram::HasErrors() const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(HasErrors());
+
     GLint status = 0;
     glGetProgramiv(id_, GL_LINK_STATUS, &status);
     return (status == GL_FALSE);
@@ -94,6 +128,8 @@ bool GLShaderProgram::HasErrors() const
 
 std::string GLShaderProgram::GetReport() const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(GetReport());
+
     /* Query info log length */
     GLint infoLogLength = 0;
     glGetProgramiv(id_, GL_INFO_LOG_LENGTH, &infoLogLength);
@@ -117,6 +153,8 @@ std::string GLShaderProgram::GetReport() const
 
 bool GLShaderProgram::Reflect(ShaderReflection& reflection) const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(Reflect(reflection));
+
     ShaderProgram::ClearShaderReflection(reflection);
     QueryReflection(reflection);
     ShaderProgram::FinalizeShaderReflection(reflection);
@@ -125,6 +163,8 @@ bool GLShaderProgram::Reflect(ShaderReflection& reflection) const
 
 UniformLocation GLShaderProgram::FindUniformLocation(const char* name) const
 {
+    LLGL_GL_DISPATCH_TO_SUBMISSION_THREAD(FindUniformLocation(name));
+
     if (id_ != 0)
         return static_cast<UniformLocation>(glGetUniformLocation(id_, name));
     else
@@ -157,6 +197,9 @@ void GLShaderProgram::Attach(Shader* shader)
     {
         auto shaderGL = LLGL_CAST(GLShader*, shader);
 
+        /* Compile shader if it has been deferred for the program binary cache */
+        shaderGL->CompileDeferred();
+
         /* Attach shader to shader program */
         glAttachShader(id_, shaderGL->GetID());
     }
@@ -20,6 +20,7 @@ namespace LLGL
 
 struct GLShaderAttribute;
 class GLShaderBindingLayout;
+class GLProgramCache;
 
 class GLShaderProgram final : public ShaderProgram
 {
@@ -36,7 +37,7 @@ class GLShaderProgram final : public ShaderProgram
 
     public:
 
-        GLShaderProgram(const ShaderProgramDescriptor& desc);
+        GLShaderProgram(const ShaderProgramDescriptor& desc, GLProgramCache* programCache = nullptr);
         ~GLShaderProgram();
 
         /*
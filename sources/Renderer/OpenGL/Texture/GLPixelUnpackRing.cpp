@@ -0,0 +1,202 @@
+/*
+ * GLPixelUnpackRing.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLPixelUnpackRing.h"
+#include "GLTexture.h"
+#include "../RenderState/GLStateManager.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include <LLGL/ImageFlags.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Alignment (in bytes) of each region within the ring buffer.
+static const GLintptr g_regionAlignment = 16;
+
+GLPixelUnpackRing::GLPixelUnpackRing(GLsizeiptr size) :
+    size_ { size }
+{
+    #ifdef GL_ARB_buffer_storage
+
+    const GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+    /* Create immutable buffer storage and map it persistently */
+    glGenBuffers(1, &id_);
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, id_);
+    {
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, flags);
+        mappedData_ = reinterpret_cast<char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags));
+    }
+    GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+
+    #endif // /GL_ARB_buffer_storage
+}
+
+GLPixelUnpackRing::~GLPixelUnpackRing()
+{
+    for (const auto& fence : fences_)
+        glDeleteSync(fence.sync);
+
+    /* Deleting the buffer also unmaps it */
+    glDeleteBuffers(1, &id_);
+    GLStateManager::Get().NotifyBufferRelease(id_, GLBufferTarget::PIXEL_UNPACK_BUFFER);
+}
+
+bool GLPixelUnpackRing::IsSupported()
+{
+    #ifdef GL_ARB_buffer_storage
+    return (HasExtension(GLExt::ARB_buffer_storage) && HasExtension(GLExt::ARB_sync));
+    #else
+    return false;
+    #endif
+}
+
+void* GLPixelUnpackRing::Reserve(GLsizeiptr size, GLintptr& offset)
+{
+    if (mappedData_ == nullptr || size <= 0 || size > size_)
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Allocate next region behind the head, or wrap around to the beginning */
+    offset = ((head_ + g_regionAlignment - 1) / g_regionAlignment) * g_regionAlignment;
+
+    if (regions_.empty())
+    {
+        /* Entire buffer is free */
+        if (offset + size > size_)
+            offset = 0;
+    }
+    else
+    {
+        const auto tail = regions_.front().offset;
+        if (head_ > tail)
+        {
+            /* Free space is behind the head and in front of the oldest region */
+            if (offset + size > size_)
+            {
+                if (size > tail)
+                    return nullptr;
+                offset = 0;
+            }
+        }
+        else if (offset + size > tail)
+        {
+            /* Free space is only between the head and the oldest region */
+            return nullptr;
+        }
+    }
+
+    regions_.push_back({ offset, size, 0 });
+    head_ = offset + size;
+
+    return (mappedData_ + offset);
+}
+
+void GLPixelUnpackRing::Commit(GLintptr offset, GLTexture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto it = std::find_if(
+        regions_.begin(),
+        regions_.end(),
+        [offset](const Region& region)
+        {
+            return (region.offset == offset && region.fenceValue == 0);
+        }
+    );
+
+    if (it != regions_.end())
+        uploads_.push_back({ &texture, textureRegion, format, dataType, offset, it->size });
+}
+
+void GLPixelUnpackRing::Flush()
+{
+    /* Take all committed uploads, so other threads can continue to reserve and commit regions */
+    std::vector<Upload> uploads;
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        uploads.swap(uploads_);
+    }
+
+    if (!uploads.empty())
+    {
+        /* Write texture sub data from buffer offsets; imageDesc.data is interpreted as offset while the pixel-unpack buffer is bound */
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, id_);
+        {
+            for (const auto& upload : uploads)
+            {
+                if (!upload.texture->IsRenderbuffer())
+                {
+                    const SrcImageDescriptor imageDesc
+                    {
+                        upload.format,
+                        upload.dataType,
+                        reinterpret_cast<const void*>(upload.offset),
+                        static_cast<std::size_t>(upload.size)
+                    };
+                    upload.texture->TextureSubImage(upload.textureRegion, imageDesc, false);
+                }
+            }
+        }
+        GLStateManager::Get().BindBuffer(GLBufferTarget::PIXEL_UNPACK_BUFFER, 0);
+
+        /* Submit one fence for all uploads of this flush */
+        const auto fenceValue = ++lastFenceValue_;
+        fences_.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), fenceValue });
+
+        std::lock_guard<std::mutex> guard { mutex_ };
+        for (const auto& upload : uploads)
+        {
+            for (auto& region : regions_)
+            {
+                if (region.offset == upload.offset && region.fenceValue == 0)
+                {
+                    region.fenceValue = fenceValue;
+                    break;
+                }
+            }
+        }
+    }
+
+    RetireCompletedRegions();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLPixelUnpackRing::RetireCompletedRegions()
+{
+    /* Poll fences in submission order without waiting, but flush the command queue so they are eventually signaled */
+    while (!fences_.empty())
+    {
+        const auto result = glClientWaitSync(fences_.front().sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            break;
+        completedFenceValue_ = fences_.front().value;
+        glDeleteSync(fences_.front().sync);
+        fences_.pop_front();
+    }
+
+    /* Remove the oldest regions whose uploads have completed; a region that has not been committed yet blocks all newer regions */
+    std::lock_guard<std::mutex> guard { mutex_ };
+    while (!regions_.empty() && regions_.front().fenceValue != 0 && regions_.front().fenceValue <= completedFenceValue_)
+        regions_.pop_front();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
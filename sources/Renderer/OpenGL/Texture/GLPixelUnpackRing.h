@@ -0,0 +1,119 @@
+/*
+ * GLPixelUnpackRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PIXEL_UNPACK_RING_H
+#define LLGL_GL_PIXEL_UNPACK_RING_H
+
+
+#include "../OpenGL.h"
+#include <LLGL/TextureFlags.h>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class GLTexture;
+
+/*
+Ring buffer of persistently mapped pixel-unpack buffer memory (GL_ARB_buffer_storage) for streaming texture uploads.
+Any thread can reserve a region, write image data into its mapped memory, and commit the upload of that region, without issuing GL commands.
+The GL thread then issues a glTexSubImage* call from the buffer offset for each committed upload when the ring is flushed.
+Regions are recycled with sync objects (GL_ARB_sync), i.e. a region is only reused after the GPU has finished reading from it.
+*/
+class GLPixelUnpackRing
+{
+
+    public:
+
+        GLPixelUnpackRing(GLsizeiptr size);
+        ~GLPixelUnpackRing();
+
+        GLPixelUnpackRing(const GLPixelUnpackRing&) = delete;
+        GLPixelUnpackRing& operator = (const GLPixelUnpackRing&) = delete;
+
+        // Returns true if the extensions for persistently mapped buffers and sync objects are supported.
+        static bool IsSupported();
+
+        /*
+        Reserves a region of the specified size and returns a pointer to its mapped memory and its offset within the buffer.
+        Returns null if the size exceeds the free space of the ring buffer. This never blocks and can be called from any thread.
+        */
+        void* Reserve(GLsizeiptr size, GLintptr& offset);
+
+        // Commits the upload of the reserved region at the specified offset into the texture. This can be called from any thread.
+        void Commit(GLintptr offset, GLTexture& texture, const TextureRegion& textureRegion, const ImageFormat format, const DataType dataType);
+
+        // Issues all committed uploads and recycles the regions the GPU has finished reading from. This must be called on the GL thread and never blocks.
+        void Flush();
+
+        // Returns the ID of the pixel-unpack buffer.
+        inline GLuint GetID() const
+        {
+            return id_;
+        }
+
+    private:
+
+        struct Region
+        {
+            GLintptr        offset;
+            GLsizeiptr      size;
+            std::uint64_t   fenceValue; // Value of the fence after the upload from this region, or zero if it has not been issued yet.
+        };
+
+        struct Upload
+        {
+            GLTexture*      texture;
+            TextureRegion   textureRegion;
+            ImageFormat     format;
+            DataType        dataType;
+            GLintptr        offset;
+            GLsizeiptr      size;
+        };
+
+        struct Fence
+        {
+            GLsync          sync;
+            std::uint64_t   value;
+        };
+
+    private:
+
+        // Polls all pending fences without blocking and removes all regions whose uploads the GPU has completed.
+        void RetireCompletedRegions();
+
+    private:
+
+        GLuint              id_                     = 0;
+        char*               mappedData_             = nullptr;
+        GLsizeiptr          size_                   = 0;
+
+        std::mutex          mutex_;                 // Guards head_, regions_, and uploads_.
+        GLintptr            head_                   = 0;
+        std::deque<Region>  regions_;
+        std::vector<Upload> uploads_;
+
+        std::deque<Fence>   fences_;                // Only accessed on the GL thread.
+        std::uint64_t       lastFenceValue_         = 0;
+        std::uint64_t       completedFenceValue_    = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
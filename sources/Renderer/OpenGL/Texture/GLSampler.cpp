@@ -6,6 +6,7 @@
  */
 
 #include "GLSampler.h"
+#include "GLTextureHandlePool.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
@@ -25,6 +26,7 @@ GLSampler::~GLSampler()
 {
     glDeleteSamplers(1, &id_);
     GLStateManager::Get().NotifySamplerRelease(id_);
+    GLTextureHandlePool::Get().NotifySamplerRelease(id_);
 }
 
 void GLSampler::SetName(const char* name)
@@ -7,6 +7,7 @@
 
 #include "GLTexture.h"
 #include "GLTextureViewPool.h"
+#include "GLTextureHandlePool.h"
 #include "GLRenderbuffer.h"
 #include "GLReadTextureFBO.h"
 #include "GLMipGenerator.h"
@@ -133,6 +134,7 @@ GLTexture::~GLTexture()
         /* Delete texture and notify state manager as well as texture-view pool since this could be the source for a texture-view */
         GLStateManager::Get().DeleteTexture(id_, GLStateManager::GetTextureTarget(GetType()));
         GLTextureViewPool::Get().NotifyTextureRelease(id_);
+        GLTextureHandlePool::Get().NotifyTextureRelease(id_);
     }
 }
 
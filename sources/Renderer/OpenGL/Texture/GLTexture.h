@@ -84,6 +84,7 @@ class GLTexture final : public Texture
         );
 
         // Writes the specified image data to a subregion of this texture.
+        // If a GL_PIXEL_UNPACK_BUFFER is bound, 'imageDesc.data' is a byte offset into that buffer and is only passed to GL, never dereferenced.
         void TextureSubImage(const TextureRegion& region, const SrcImageDescriptor& imageDesc, bool restoreBoundTexture = true);
 
         // Reads the specified image data from a subregion of this texture.
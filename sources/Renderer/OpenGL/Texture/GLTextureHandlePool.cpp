@@ -0,0 +1,156 @@
+/*
+ * GLTextureHandlePool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLTextureHandlePool.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+GLTextureHandlePool& GLTextureHandlePool::Get()
+{
+    static GLTextureHandlePool instance;
+    return instance;
+}
+
+bool GLTextureHandlePool::IsSupported()
+{
+    #if defined GL_ARB_bindless_texture && defined GL_ARB_shader_storage_buffer_object
+    return (HasExtension(GLExt::ARB_bindless_texture) && HasExtension(GLExt::ARB_shader_storage_buffer_object));
+    #else
+    return false;
+    #endif
+}
+
+void GLTextureHandlePool::Clear()
+{
+    #ifdef GL_ARB_bindless_texture
+    for (const auto& entry : handles_)
+        glMakeTextureHandleNonResidentARB(entry.handle);
+    #endif
+    handles_.clear();
+}
+
+GLuint64 GLTextureHandlePool::AcquireHandle(GLuint texID, GLuint samplerID, std::uint64_t& generation)
+{
+    #ifdef GL_ARB_bindless_texture
+
+    /* Try to find resident handle with same texture and sampler */
+    auto index = FindHandleIndex(texID, samplerID);
+    if (index < handles_.size() && handles_[index].texID == texID && handles_[index].samplerID == samplerID)
+    {
+        auto& entry = handles_[index];
+        ++entry.refCount;
+        generation = entry.generation;
+        return entry.handle;
+    }
+
+    /* Create new handle and make it resident (the handle is the same for each combination of texture and sampler) */
+    GLTextureHandle entry;
+    {
+        entry.texID         = texID;
+        entry.samplerID     = samplerID;
+        entry.handle        = (samplerID != 0 ? glGetTextureSamplerHandleARB(texID, samplerID) : glGetTextureHandleARB(texID));
+        entry.refCount      = 1;
+        entry.generation    = ++lastGeneration_;
+    }
+    glMakeTextureHandleResidentARB(entry.handle);
+
+    handles_.insert(handles_.begin() + index, entry);
+
+    generation = entry.generation;
+    return entry.handle;
+
+    #else
+
+    generation = 0;
+    return 0;
+
+    #endif // /GL_ARB_bindless_texture
+}
+
+void GLTextureHandlePool::ReleaseHandle(GLuint texID, GLuint samplerID, std::uint64_t generation)
+{
+    #ifdef GL_ARB_bindless_texture
+
+    /* Ignore stale references whose entry was removed when its texture or sampler was released, even if GL reused the names in the meantime */
+    auto index = FindHandleIndex(texID, samplerID);
+    if (index < handles_.size() && handles_[index].texID == texID && handles_[index].samplerID == samplerID && handles_[index].generation == generation)
+    {
+        /* Make handle non-resident when it is no longer referenced */
+        auto& entry = handles_[index];
+        if (--entry.refCount == 0)
+        {
+            glMakeTextureHandleNonResidentARB(entry.handle);
+            handles_.erase(handles_.begin() + index);
+        }
+    }
+
+    #endif // /GL_ARB_bindless_texture
+}
+
+void GLTextureHandlePool::NotifyTextureRelease(GLuint texID)
+{
+    if (!handles_.empty())
+    {
+        /* Entries are sorted by texture ID, so all handles of this texture are consecutive */
+        auto first = handles_.begin() + FindHandleIndex(texID, 0);
+        auto last = first;
+        while (last != handles_.end() && last->texID == texID)
+            ++last;
+        handles_.erase(first, last);
+    }
+}
+
+void GLTextureHandlePool::NotifySamplerRelease(GLuint samplerID)
+{
+    if (!handles_.empty())
+    {
+        handles_.erase(
+            std::remove_if(
+                handles_.begin(), handles_.end(),
+                [samplerID](const GLTextureHandle& entry)
+                {
+                    return (entry.samplerID == samplerID);
+                }
+            ),
+            handles_.end()
+        );
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::size_t GLTextureHandlePool::FindHandleIndex(GLuint texID, GLuint samplerID) const
+{
+    auto it = std::lower_bound(
+        handles_.begin(), handles_.end(), texID,
+        [samplerID](const GLTextureHandle& lhs, GLuint rhsTexID)
+        {
+            if (lhs.texID < rhsTexID)
+                return true;
+            if (lhs.texID > rhsTexID)
+                return false;
+            return (lhs.samplerID < samplerID);
+        }
+    );
+    return static_cast<std::size_t>(it - handles_.begin());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * GLTextureHandlePool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_TEXTURE_HANDLE_POOL_H
+#define LLGL_GL_TEXTURE_HANDLE_POOL_H
+
+
+#include "../OpenGL.h"
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Class to manage the residency of bindless texture handles (GL_ARB_bindless_texture); used by <GLResourceHeap>
+class GLTextureHandlePool
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLTextureHandlePool& Get();
+
+    public:
+
+        GLTextureHandlePool(const GLTextureHandlePool&) = delete;
+        GLTextureHandlePool& operator = (const GLTextureHandlePool&) = delete;
+
+        // Returns true if bindless textures can be stored in shader storage buffers.
+        static bool IsSupported();
+
+        // Releases all resources for this singleton class.
+        void Clear();
+
+        /*
+        Returns the resident handle for the specified texture and sampler (which may be 0 to use the texture's own sampler state).
+        The handle is made resident on its first acquisition and stays resident until it has been released as often as it was acquired.
+        The output parameter 'generation' identifies the pool entry, since GL reuses the names of released textures and samplers.
+        */
+        GLuint64 AcquireHandle(GLuint texID, GLuint samplerID, std::uint64_t& generation);
+
+        // Releases the handle that was acquired with AcquireHandle. This is ignored if the entry of that generation has already been removed.
+        void ReleaseHandle(GLuint texID, GLuint samplerID, std::uint64_t generation);
+
+        // Notifies the pool that the specified texture (or texture view) was released. All handles of this texture are implicitly invalidated by GL.
+        void NotifyTextureRelease(GLuint texID);
+
+        // Notifies the pool that the specified sampler was released. All handles of this sampler are implicitly invalidated by GL.
+        void NotifySamplerRelease(GLuint samplerID);
+
+    private:
+
+        GLTextureHandlePool() = default;
+
+    private:
+
+        struct GLTextureHandle
+        {
+            GLuint          texID       = 0;
+            GLuint          samplerID   = 0;
+            GLuint64        handle      = 0;
+            GLuint          refCount    = 0;
+            std::uint64_t   generation  = 0;
+        };
+
+        // Returns the index of the first entry that is not ordered before the specified texture and sampler.
+        std::size_t FindHandleIndex(GLuint texID, GLuint samplerID) const;
+
+    private:
+
+        // Container of all resident handles, sorted by texture and sampler IDs.
+        std::vector<GLTextureHandle>    handles_;
+
+        // Generation of the last created entry.
+        std::uint64_t                   lastGeneration_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
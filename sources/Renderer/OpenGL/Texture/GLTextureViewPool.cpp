@@ -7,6 +7,7 @@
 
 #include "GLTextureViewPool.h"
 #include "GLTexture.h"
+#include "GLTextureHandlePool.h"
 #include "../RenderState/GLStateManager.h"
 #include "../GLProfile.h"
 #include "../GLTypes.h"
@@ -239,7 +240,9 @@ static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
 
 void GLTextureViewPool::DeleteGLTextureView(GLTextureView& texView)
 {
+    /* Bindless handles of this texture view are invalidated by GL, so the handle pool must forget them before the name can be reused */
     GLStateManager::Get().DeleteTexture(texView.texID, UncompressGLTextureTarget(texView.view.type));
+    GLTextureHandlePool::Get().NotifyTextureRelease(texView.texID);
 }
 
 void GLTextureViewPool::RetainSharedGLTextureView(GLTextureView& texView, GLuint texID)
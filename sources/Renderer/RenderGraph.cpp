@@ -0,0 +1,732 @@
+/*
+ * RenderGraph.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderGraph.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/Texture.h>
+#include <LLGL/RenderTarget.h>
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <ostream>
+#include <queue>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+static bool IsWriteState(const RenderGraphResourceState state)
+{
+    return (state != RenderGraphResourceState::ShaderResource);
+}
+
+static const char* ToString(const RenderGraphResourceState state)
+{
+    switch (state)
+    {
+        case RenderGraphResourceState::Undefined:               return "Undefined";
+        case RenderGraphResourceState::ShaderResource:          return "ShaderResource";
+        case RenderGraphResourceState::ColorAttachment:         return "ColorAttachment";
+        case RenderGraphResourceState::DepthStencilAttachment:  return "DepthStencilAttachment";
+        case RenderGraphResourceState::Storage:                 return "Storage";
+    }
+    return "";
+}
+
+// Calls the specified function for each resource the pass accesses, with the state of that access.
+static void ForEachAccess(
+    const RenderGraphPassDescriptor&                                                passDesc,
+    const std::function<void(RenderGraphResource, RenderGraphResourceState)>&      callback)
+{
+    for (auto resource : passDesc.reads)
+        callback(resource, RenderGraphResourceState::ShaderResource);
+    for (auto resource : passDesc.colorAttachments)
+        callback(resource, RenderGraphResourceState::ColorAttachment);
+    if (passDesc.depthStencilAttachment != 0)
+        callback(passDesc.depthStencilAttachment, RenderGraphResourceState::DepthStencilAttachment);
+    for (auto resource : passDesc.storages)
+        callback(resource, RenderGraphResourceState::Storage);
+}
+
+static bool IsTextureDescEqual(const TextureDescriptor& lhs, const TextureDescriptor& rhs)
+{
+    return
+    (
+        lhs.type        == rhs.type         &&
+        lhs.bindFlags   == rhs.bindFlags    &&
+        lhs.miscFlags   == rhs.miscFlags    &&
+        lhs.format      == rhs.format       &&
+        lhs.extent      == rhs.extent       &&
+        lhs.arrayLayers == rhs.arrayLayers  &&
+        lhs.mipLevels   == rhs.mipLevels    &&
+        lhs.samples     == rhs.samples
+    );
+}
+
+static std::uint64_t GetTextureMemorySize(const TextureDescriptor& textureDesc)
+{
+    const auto size = static_cast<std::uint64_t>(GetMemoryFootprint(textureDesc.format, NumMipTexels(textureDesc)));
+    return size * std::max(1u, textureDesc.samples);
+}
+
+
+/*
+ * RenderGraph class
+ */
+
+RenderGraph::RenderGraph(RenderSystem* renderSystem) :
+    renderSystem_ { renderSystem }
+{
+}
+
+RenderGraph::~RenderGraph()
+{
+    ReleaseRenderTargets();
+    if (renderSystem_ != nullptr)
+    {
+        for (auto& physicalTexture : physicalTextures_)
+            renderSystem_->Release(*physicalTexture.texture);
+        for (auto& physicalTexture : texturePool_)
+            renderSystem_->Release(*physicalTexture.texture);
+    }
+}
+
+RenderGraphResource RenderGraph::CreateTexture(const std::string& name, const TextureDescriptor& textureDesc)
+{
+    VirtualResource resource;
+    {
+        resource.name           = name;
+        resource.textureDesc    = textureDesc;
+    }
+    resources_.push_back(resource);
+    compiled_ = false;
+    return static_cast<RenderGraphResource>(resources_.size());
+}
+
+RenderGraphResource RenderGraph::ImportTexture(const std::string& name, Texture& texture)
+{
+    VirtualResource resource;
+    {
+        resource.name               = name;
+        resource.importedTexture    = &texture;
+    }
+    resources_.push_back(resource);
+    compiled_ = false;
+    return static_cast<RenderGraphResource>(resources_.size());
+}
+
+std::uint32_t RenderGraph::AddPass(const RenderGraphPassDescriptor& passDesc)
+{
+    ForEachAccess(
+        passDesc,
+        [this](RenderGraphResource resource, RenderGraphResourceState)
+        {
+            ValidateResource(resource);
+        }
+    );
+
+    Pass pass;
+    {
+        pass.desc = passDesc;
+    }
+    passes_.push_back(std::move(pass));
+    compiled_ = false;
+    return static_cast<std::uint32_t>(passes_.size() - 1);
+}
+
+void RenderGraph::Compile()
+{
+    BuildDependencies();
+    CullPasses();
+    SortPasses();
+    ComputeLifetimes();
+    ComputeTransitions();
+    AssignPhysicalTextures();
+    CreateRenderTargets();
+    compiled_ = true;
+}
+
+void RenderGraph::Execute(CommandBuffer& commandBuffer)
+{
+    if (renderSystem_ == nullptr)
+        throw std::runtime_error("cannot execute render graph without render system");
+    if (!compiled_)
+        throw std::runtime_error("cannot execute render graph that has not been compiled");
+
+    std::vector<Texture*> barrierTextures;
+
+    for (auto passIndex : schedule_)
+    {
+        const auto& pass = passes_[passIndex];
+
+        if (!pass.desc.name.empty())
+            commandBuffer.PushDebugGroup(pass.desc.name.c_str());
+
+        /* Synchronize all resources that have been accessed by a previous pass before their render pass begins */
+        barrierTextures.clear();
+        for (const auto& transition : pass.transitions)
+        {
+            if (transition.oldState != RenderGraphResourceState::Undefined)
+            {
+                if (auto texture = GetTexture(transition.resource))
+                    barrierTextures.push_back(texture);
+            }
+        }
+
+        if (!barrierTextures.empty())
+            commandBuffer.ResourceBarrier(0, nullptr, static_cast<std::uint32_t>(barrierTextures.size()), barrierTextures.data());
+
+        if (pass.renderTarget != nullptr)
+        {
+            commandBuffer.BeginRenderPass(*pass.renderTarget);
+            {
+                if (pass.desc.execute)
+                    pass.desc.execute(commandBuffer, *this);
+            }
+            commandBuffer.EndRenderPass();
+        }
+        else if (pass.desc.execute)
+            pass.desc.execute(commandBuffer, *this);
+
+        if (!pass.desc.name.empty())
+            commandBuffer.PopDebugGroup();
+    }
+}
+
+void RenderGraph::Reset()
+{
+    /* Keep render targets in the cache for the next compilation */
+    for (auto& pass : passes_)
+        pass.renderTarget = nullptr;
+
+    /* Keep physical textures for the next compilation */
+    texturePool_.insert(texturePool_.end(), physicalTextures_.begin(), physicalTextures_.end());
+    physicalTextures_.clear();
+
+    resources_.clear();
+    passes_.clear();
+    schedule_.clear();
+
+    transientMemory_    = 0;
+    aliasedMemory_      = 0;
+    compiled_           = false;
+}
+
+void RenderGraph::PrintSchedule(std::ostream& stream) const
+{
+    /* Print scheduled passes with their transitions */
+    stream << "render graph schedule (" << schedule_.size() << " of " << passes_.size() << " passes):\n";
+
+    for (std::size_t i = 0; i < schedule_.size(); ++i)
+    {
+        const auto& pass = passes_[schedule_[i]];
+        stream << "  [" << i << "] " << pass.desc.name << '\n';
+        for (const auto& transition : pass.transitions)
+        {
+            stream << "        " << resources_[transition.resource - 1].name << ": "
+                << ToString(transition.oldState) << " -> " << ToString(transition.newState) << '\n';
+        }
+    }
+
+    /* Print culled passes */
+    for (const auto& pass : passes_)
+    {
+        if (pass.culled)
+            stream << "  culled: " << pass.desc.name << '\n';
+    }
+
+    /* Print resource lifetimes and their physical textures */
+    stream << "resources:\n";
+
+    for (const auto& resource : resources_)
+    {
+        stream << "  " << resource.name << ": ";
+        if (resource.importedTexture != nullptr)
+            stream << "imported";
+        else if (resource.firstUse == invalidIndex)
+            stream << "unused";
+        else
+        {
+            stream << "passes [" << resource.firstUse << ", " << resource.lastUse << "], physical texture #" << resource.physicalIndex
+                << " (" << GetTextureMemorySize(resource.textureDesc) << " bytes)";
+        }
+        stream << '\n';
+    }
+
+    /* Print memory statistics */
+    stream << "transient memory: " << transientMemory_ << " bytes without aliasing, " << aliasedMemory_ << " bytes with aliasing ("
+        << (transientMemory_ - aliasedMemory_) << " bytes saved)\n";
+}
+
+Texture* RenderGraph::GetTexture(RenderGraphResource resource) const
+{
+    if (resource > 0 && resource <= resources_.size())
+    {
+        const auto& virtualResource = resources_[resource - 1];
+        if (virtualResource.importedTexture != nullptr)
+            return virtualResource.importedTexture;
+        if (virtualResource.physicalIndex != invalidIndex)
+            return physicalTextures_[virtualResource.physicalIndex].texture;
+    }
+    return nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void RenderGraph::ValidateResource(RenderGraphResource resource) const
+{
+    if (resource == 0 || resource > resources_.size())
+        throw std::out_of_range("invalid render graph resource: " + std::to_string(resource));
+}
+
+void RenderGraph::BuildDependencies()
+{
+    for (auto& pass : passes_)
+    {
+        pass.dependencies.clear();
+        pass.successors.clear();
+    }
+
+    auto AddEdge = [this](std::uint32_t from, std::uint32_t to, bool isDependency)
+    {
+        if (from != to)
+        {
+            if (isDependency)
+                passes_[to].dependencies.push_back(from);
+            passes_[from].successors.push_back(to);
+        }
+    };
+
+    struct ResourceTracking
+    {
+        std::uint32_t               lastWriter  = invalidIndex;
+        std::vector<std::uint32_t>  readers;        // Readers since the last writer
+        std::vector<std::uint32_t>  earlyReaders;   // Readers before the first writer
+    };
+
+    std::vector<ResourceTracking> tracking(resources_.size());
+
+    for (std::uint32_t passIndex = 0; passIndex < passes_.size(); ++passIndex)
+    {
+        ForEachAccess(
+            passes_[passIndex].desc,
+            [&](RenderGraphResource resource, RenderGraphResourceState state)
+            {
+                auto& entry = tracking[resource - 1];
+                if (IsWriteState(state))
+                {
+                    if (entry.lastWriter != invalidIndex)
+                    {
+                        /* Write after write, and write after read */
+                        AddEdge(entry.lastWriter, passIndex, true);
+                        for (auto reader : entry.readers)
+                            AddEdge(reader, passIndex, false);
+                    }
+                    else
+                    {
+                        /* Readers that were added before the first writer depend on it */
+                        for (auto reader : entry.earlyReaders)
+                            AddEdge(passIndex, reader, true);
+                        entry.earlyReaders.clear();
+                    }
+                    entry.readers.clear();
+                    entry.lastWriter = passIndex;
+                }
+                else
+                {
+                    /* Read after write */
+                    if (entry.lastWriter != invalidIndex)
+                    {
+                        AddEdge(entry.lastWriter, passIndex, true);
+                        entry.readers.push_back(passIndex);
+                    }
+                    else
+                        entry.earlyReaders.push_back(passIndex);
+                }
+            }
+        );
+    }
+}
+
+void RenderGraph::CullPasses()
+{
+    /* Start with passes that have side effects or write imported resources */
+    std::vector<std::uint32_t> stack;
+
+    for (std::uint32_t passIndex = 0; passIndex < passes_.size(); ++passIndex)
+    {
+        auto& pass = passes_[passIndex];
+
+        bool isRoot = pass.desc.hasSideEffects;
+        ForEachAccess(
+            pass.desc,
+            [&](RenderGraphResource resource, RenderGraphResourceState state)
+            {
+                if (IsWriteState(state) && resources_[resource - 1].importedTexture != nullptr)
+                    isRoot = true;
+            }
+        );
+
+        pass.culled = !isRoot;
+        if (isRoot)
+            stack.push_back(passIndex);
+    }
+
+    /* Keep all passes the root passes depend on */
+    while (!stack.empty())
+    {
+        const auto passIndex = stack.back();
+        stack.pop_back();
+
+        for (auto dependency : passes_[passIndex].dependencies)
+        {
+            if (passes_[dependency].culled)
+            {
+                passes_[dependency].culled = false;
+                stack.push_back(dependency);
+            }
+        }
+    }
+}
+
+void RenderGraph::SortPasses()
+{
+    /* Count incoming edges of all passes that are not culled */
+    std::vector<std::uint32_t> numIncomingEdges(passes_.size(), 0);
+    std::size_t numPasses = 0;
+
+    for (const auto& pass : passes_)
+    {
+        if (!pass.culled)
+        {
+            for (auto successor : pass.successors)
+                numIncomingEdges[successor]++;
+            numPasses++;
+        }
+    }
+
+    /* Topological sort that prefers the order in which the passes were added */
+    std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> readyPasses;
+
+    for (std::uint32_t passIndex = 0; passIndex < passes_.size(); ++passIndex)
+    {
+        if (!passes_[passIndex].culled && numIncomingEdges[passIndex] == 0)
+            readyPasses.push(passIndex);
+    }
+
+    schedule_.clear();
+
+    while (!readyPasses.empty())
+    {
+        const auto passIndex = readyPasses.top();
+        readyPasses.pop();
+        schedule_.push_back(passIndex);
+
+        for (auto successor : passes_[passIndex].successors)
+        {
+            if (!passes_[successor].culled && --numIncomingEdges[successor] == 0)
+                readyPasses.push(successor);
+        }
+    }
+
+    if (schedule_.size() != numPasses)
+        throw std::runtime_error("cannot compile render graph with cyclic dependencies between passes");
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+    for (auto& resource : resources_)
+    {
+        resource.firstUse   = invalidIndex;
+        resource.lastUse    = invalidIndex;
+    }
+
+    for (std::uint32_t i = 0; i < schedule_.size(); ++i)
+    {
+        ForEachAccess(
+            passes_[schedule_[i]].desc,
+            [&](RenderGraphResource resource, RenderGraphResourceState)
+            {
+                auto& virtualResource = resources_[resource - 1];
+                if (virtualResource.firstUse == invalidIndex)
+                    virtualResource.firstUse = i;
+                virtualResource.lastUse = i;
+            }
+        );
+    }
+}
+
+void RenderGraph::ComputeTransitions()
+{
+    std::vector<RenderGraphResourceState> states(resources_.size(), RenderGraphResourceState::Undefined);
+
+    for (auto& pass : passes_)
+        pass.transitions.clear();
+
+    for (auto passIndex : schedule_)
+    {
+        auto& pass = passes_[passIndex];
+        ForEachAccess(
+            pass.desc,
+            [&](RenderGraphResource resource, RenderGraphResourceState state)
+            {
+                /* Storage resources also need a barrier between two consecutive passes that write them */
+                auto& currentState = states[resource - 1];
+                if (currentState != state || state == RenderGraphResourceState::Storage)
+                {
+                    RenderGraphTransition transition;
+                    {
+                        transition.resource = resource;
+                        transition.oldState = currentState;
+                        transition.newState = state;
+                    }
+                    pass.transitions.push_back(transition);
+                    currentState = state;
+                }
+            }
+        );
+    }
+}
+
+void RenderGraph::AssignPhysicalTextures()
+{
+    /* Return physical textures of the previous compilation into the pool */
+    texturePool_.insert(texturePool_.end(), physicalTextures_.begin(), physicalTextures_.end());
+    physicalTextures_.clear();
+
+    transientMemory_    = 0;
+    aliasedMemory_      = 0;
+
+    /* Sort transient resources that are used by scheduled passes by their first use */
+    std::vector<std::uint32_t> resourceOrder;
+
+    for (std::uint32_t i = 0; i < resources_.size(); ++i)
+    {
+        auto& resource = resources_[i];
+        resource.physicalIndex = invalidIndex;
+        if (resource.importedTexture == nullptr && resource.firstUse != invalidIndex)
+            resourceOrder.push_back(i);
+    }
+
+    std::stable_sort(
+        resourceOrder.begin(),
+        resourceOrder.end(),
+        [this](std::uint32_t lhs, std::uint32_t rhs)
+        {
+            return (resources_[lhs].firstUse < resources_[rhs].firstUse);
+        }
+    );
+
+    /* Assign each resource to a physical texture with the same descriptor whose previous resources are no longer used */
+    for (auto resourceIndex : resourceOrder)
+    {
+        auto& resource = resources_[resourceIndex];
+        const auto size = GetTextureMemorySize(resource.textureDesc);
+        transientMemory_ += size;
+
+        for (std::uint32_t i = 0; i < physicalTextures_.size(); ++i)
+        {
+            auto& physicalTexture = physicalTextures_[i];
+            if (physicalTexture.lastUse < resource.firstUse && IsTextureDescEqual(physicalTexture.textureDesc, resource.textureDesc))
+            {
+                resource.physicalIndex = i;
+                break;
+            }
+        }
+
+        if (resource.physicalIndex == invalidIndex)
+        {
+            PhysicalTexture physicalTexture;
+            {
+                physicalTexture.textureDesc = resource.textureDesc;
+            }
+            physicalTextures_.push_back(physicalTexture);
+            resource.physicalIndex = static_cast<std::uint32_t>(physicalTextures_.size() - 1);
+            aliasedMemory_ += size;
+        }
+
+        physicalTextures_[resource.physicalIndex].lastUse = resource.lastUse;
+    }
+
+    if (renderSystem_ != nullptr)
+    {
+        /* Reuse textures from the pool or create new ones */
+        for (auto& physicalTexture : physicalTextures_)
+        {
+            auto it = std::find_if(
+                texturePool_.begin(),
+                texturePool_.end(),
+                [&physicalTexture](const PhysicalTexture& entry)
+                {
+                    return IsTextureDescEqual(entry.textureDesc, physicalTexture.textureDesc);
+                }
+            );
+
+            if (it != texturePool_.end())
+            {
+                physicalTexture.texture = it->texture;
+                texturePool_.erase(it);
+            }
+            else
+                physicalTexture.texture = renderSystem_->CreateTexture(physicalTexture.textureDesc);
+        }
+
+        /* Release textures that are no longer used, and the cached render targets that refer to them */
+        for (auto& physicalTexture : texturePool_)
+        {
+            ReleaseRenderTargets(*physicalTexture.texture);
+            renderSystem_->Release(*physicalTexture.texture);
+        }
+    }
+
+    texturePool_.clear();
+}
+
+void RenderGraph::CreateRenderTargets()
+{
+    for (auto& pass : passes_)
+        pass.renderTarget = nullptr;
+
+    if (renderSystem_ == nullptr)
+        return;
+
+    for (auto& entry : renderTargetCache_)
+        entry.used = false;
+
+    std::vector<Texture*> attachments;
+
+    for (auto passIndex : schedule_)
+    {
+        auto& pass = passes_[passIndex];
+        if (pass.desc.colorAttachments.empty() && pass.desc.depthStencilAttachment == 0)
+            continue;
+
+        /* Reuse render target with the same attachments from the cache */
+        attachments.clear();
+        for (auto resource : pass.desc.colorAttachments)
+            attachments.push_back(GetTexture(resource));
+        if (pass.desc.depthStencilAttachment != 0)
+            attachments.push_back(GetTexture(pass.desc.depthStencilAttachment));
+
+        auto it = std::find_if(
+            renderTargetCache_.begin(),
+            renderTargetCache_.end(),
+            [&attachments](const CachedRenderTarget& entry)
+            {
+                return (entry.attachments == attachments);
+            }
+        );
+
+        if (it == renderTargetCache_.end())
+        {
+            CachedRenderTarget entry;
+            {
+                entry.attachments   = attachments;
+                entry.renderTarget  = CreateRenderTarget(pass.desc);
+            }
+            renderTargetCache_.push_back(std::move(entry));
+            it = renderTargetCache_.end() - 1;
+        }
+
+        it->used            = true;
+        pass.renderTarget   = it->renderTarget;
+    }
+
+    /* Release render targets that are not used by this compilation */
+    for (auto it = renderTargetCache_.begin(); it != renderTargetCache_.end();)
+    {
+        if (!it->used)
+        {
+            renderSystem_->Release(*it->renderTarget);
+            it = renderTargetCache_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+RenderTarget* RenderGraph::CreateRenderTarget(const RenderGraphPassDescriptor& passDesc)
+{
+    RenderTargetDescriptor renderTargetDesc;
+
+    for (auto resource : passDesc.colorAttachments)
+        renderTargetDesc.attachments.push_back(AttachmentDescriptor{ AttachmentType::Color, GetTexture(resource) });
+
+    if (passDesc.depthStencilAttachment != 0)
+    {
+        auto texture = GetTexture(passDesc.depthStencilAttachment);
+        const auto format = texture->GetFormat();
+
+        AttachmentType type = AttachmentType::Depth;
+        if (IsDepthFormat(format) && IsStencilFormat(format))
+            type = AttachmentType::DepthStencil;
+        else if (IsStencilFormat(format))
+            type = AttachmentType::Stencil;
+
+        renderTargetDesc.attachments.push_back(AttachmentDescriptor{ type, texture });
+    }
+
+    /* Determine resolution and multi-sampling by the first attachment */
+    auto firstTexture = renderTargetDesc.attachments.front().texture;
+    const auto extent = firstTexture->GetMipExtent(0);
+    renderTargetDesc.resolution = { extent.width, extent.height };
+
+    if (IsMultiSampleTexture(firstTexture->GetType()))
+    {
+        renderTargetDesc.samples                = firstTexture->GetDesc().samples;
+        renderTargetDesc.customMultiSampling    = true;
+    }
+
+    return renderSystem_->CreateRenderTarget(renderTargetDesc);
+}
+
+void RenderGraph::ReleaseRenderTargets()
+{
+    for (auto& pass : passes_)
+        pass.renderTarget = nullptr;
+
+    for (auto& entry : renderTargetCache_)
+        renderSystem_->Release(*entry.renderTarget);
+
+    renderTargetCache_.clear();
+}
+
+void RenderGraph::ReleaseRenderTargets(const Texture& texture)
+{
+    for (auto it = renderTargetCache_.begin(); it != renderTargetCache_.end();)
+    {
+        if (std::find(it->attachments.begin(), it->attachments.end(), &texture) != it->attachments.end())
+        {
+            for (auto& pass : passes_)
+            {
+                if (pass.renderTarget == it->renderTarget)
+                    pass.renderTarget = nullptr;
+            }
+            renderSystem_->Release(*it->renderTarget);
+            it = renderTargetCache_.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -240,6 +240,34 @@ void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     config_ = config;
 }
 
+CommandQueue* RenderSystem::GetCommandQueueOfType(const CommandQueueType /*type*/)
+{
+    /* Rendering APIs with a single queue use the graphics queue for all types */
+    return GetCommandQueue();
+}
+
+TextureUploadRange RenderSystem::ReserveTextureUpload(std::uint64_t /*size*/)
+{
+    /* Render systems without streaming texture uploads never provide staging memory */
+    return {};
+}
+
+void RenderSystem::CommitTextureUpload(const TextureUploadRange& /*range*/, Texture& /*texture*/, const TextureRegion& /*textureRegion*/, const ImageFormat /*format*/, const DataType /*dataType*/)
+{
+    // dummy
+}
+
+void RenderSystem::FlushTextureUploads()
+{
+    // dummy
+}
+
+SamplerCacheStatistics RenderSystem::GetSamplerCacheStatistics() const
+{
+    /* Render systems without a sampler cache never share samplers */
+    return {};
+}
+
 
 /*
  * ======= Protected: =======
@@ -14,6 +14,50 @@ namespace LLGL
 {
 
 
+// Posts a report in the same format as Message::ToReportString, but lets the log format the message when the report is drained.
+static void PostMessageReport(
+    Log::ReportType     reportType,
+    const char*         reportTypeName,
+    const char*         typeName,
+    const std::string&  groupName,
+    const std::string&  source,
+    const std::string&  text)
+{
+    if (!groupName.empty() && !source.empty())
+        Log::PostReportFormat(reportType, "%s (%s): during '%s': in '%s': %s", { reportTypeName, typeName, groupName.c_str(), source.c_str(), text.c_str() });
+    else if (!groupName.empty())
+        Log::PostReportFormat(reportType, "%s (%s): during '%s': %s", { reportTypeName, typeName, groupName.c_str(), text.c_str() });
+    else if (!source.empty())
+        Log::PostReportFormat(reportType, "%s (%s): in '%s': %s", { reportTypeName, typeName, source.c_str(), text.c_str() });
+    else
+        Log::PostReportFormat(reportType, "%s (%s): %s", { reportTypeName, typeName, text.c_str() });
+}
+
+RenderingDebugger::RenderingDebugger(const RenderingDebugger& rhs) :
+    errors_         { rhs.errors_                                           },
+    warnings_       { rhs.warnings_                                         },
+    source_         { rhs.source_                                           },
+    groupName_      { rhs.groupName_                                        },
+    level_          { rhs.level_                                            },
+    sampleInterval_ { rhs.sampleInterval_                                   },
+    randomSampling_ { rhs.randomSampling_                                   },
+    sampleCounter_  { rhs.sampleCounter_.load(std::memory_order_relaxed)    }
+{
+}
+
+RenderingDebugger& RenderingDebugger::operator = (const RenderingDebugger& rhs)
+{
+    errors_         = rhs.errors_;
+    warnings_       = rhs.warnings_;
+    source_         = rhs.source_;
+    groupName_      = rhs.groupName_;
+    level_          = rhs.level_;
+    sampleInterval_ = rhs.sampleInterval_;
+    randomSampling_ = rhs.randomSampling_;
+    sampleCounter_.store(rhs.sampleCounter_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
 void RenderingDebugger::SetSource(const char* source)
 {
     source_ = (source != nullptr ? source : "");
@@ -61,25 +105,59 @@ void RenderingDebugger::PostWarning(const WarningType type, const std::string& m
 }
 
 
+void RenderingDebugger::SetValidationLevel(const ValidationLevel level, std::uint32_t sampleInterval, bool randomSampling)
+{
+    level_          = level;
+    sampleInterval_ = (sampleInterval > 0 ? sampleInterval : 1);
+    randomSampling_ = randomSampling;
+}
+
+// Returns a well distributed hash of the specified value (finalizer of MurmurHash3).
+static std::uint32_t HashSampleIndex(std::uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+    return x;
+}
+
+bool RenderingDebugger::SampleValidation()
+{
+    switch (level_)
+    {
+        case ValidationLevel::Full:
+            return true;
+
+        case ValidationLevel::Sampled:
+        {
+            const auto index = sampleCounter_.fetch_add(1, std::memory_order_relaxed);
+            if (randomSampling_)
+                return (HashSampleIndex(index) % sampleInterval_ == 0);
+            else
+                return (index % sampleInterval_ == 0);
+        }
+
+        default:
+            return false;
+    }
+}
+
+
 /*
  * ====== Protected: =======
  */
 
 void RenderingDebugger::OnError(ErrorType type, Message& message)
 {
-    Log::PostReport(
-        Log::ReportType::Error,
-        message.ToReportString("ERROR (" + std::string(ToString(type)) + ')')
-    );
+    PostMessageReport(Log::ReportType::Error, "ERROR", ToString(type), message.GetGroupName(), message.GetSource(), message.GetText());
     message.Block();
 }
 
 void RenderingDebugger::OnWarning(WarningType type, Message& message)
 {
-    Log::PostReport(
-        Log::ReportType::Warning,
-        message.ToReportString("WARNING (" + std::string(ToString(type)) + ')')
-    );
+    PostMessageReport(Log::ReportType::Warning, "WARNING", ToString(type), message.GetGroupName(), message.GetSource(), message.GetText());
     message.Block();
 }
 
@@ -6,13 +6,344 @@
  */
 
 #include <LLGL/RenderingProfiler.h>
+#include "../Core/Helper.h"
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <ostream>
 
 
 namespace LLGL
 {
 
 
+/*
+ * TraceRecorder class
+ */
+
+// Recorder of trace events with one lock-free event buffer per thread.
+class RenderingProfiler::TraceRecorder
+{
+
+    public:
+
+        TraceRecorder();
+
+        // Appends a new event to the event buffer of the calling thread.
+        void Record(const char* annotation, std::uint64_t startTime, std::uint64_t elapsedTime, bool gpu);
+
+        // Writes all events in the Chrome trace event format.
+        void Write(std::ostream& stream) const;
+
+        // Clears all events.
+        void Clear();
+
+        // Appends all events of the specified recorder, each into the event buffer of the same thread.
+        void Append(const TraceRecorder& rhs);
+
+    private:
+
+        struct Event
+        {
+            const char*     annotation;
+            std::uint64_t   startTime;
+            std::uint64_t   elapsedTime;
+            bool            gpu;
+        };
+
+        // Event chunk that is only written by its owning thread; 'count' is published with release semantics.
+        struct EventChunk
+        {
+            static const std::size_t capacity = 1024;
+
+            Event                       events[capacity];
+            std::atomic<std::size_t>    count { 0 };
+            std::unique_ptr<EventChunk> next;
+        };
+
+        struct ThreadBuffer
+        {
+            std::thread::id         threadID;
+            std::uint32_t           threadIndex = 0;
+            EventChunk              firstChunk;
+            EventChunk*             lastChunk   = nullptr;
+            std::set<std::string>   annotations;    // Copies of GPU annotations, which are owned by the command buffers that recorded them.
+        };
+
+        // Per-thread cache to find the event buffer without locking.
+        struct ThreadCache
+        {
+            std::uint64_t   recorderID  = 0;
+            ThreadBuffer*   buffer      = nullptr;
+        };
+
+    private:
+
+        ThreadBuffer* GetThreadBuffer();
+
+        // Appends the event to the specified buffer, which must only be written by the calling thread. GPU annotations are copied into the buffer.
+        static void AppendEvent(ThreadBuffer& buffer, Event event);
+
+    private:
+
+        const std::uint64_t                         id_;
+        mutable std::mutex                          buffersMutex_;
+        std::vector<std::unique_ptr<ThreadBuffer>>  buffers_;
+
+        static std::atomic<std::uint64_t>           g_idCounter;
+        static thread_local ThreadCache             g_threadCache;
+
+};
+
+std::atomic<std::uint64_t> RenderingProfiler::TraceRecorder::g_idCounter { 0 };
+thread_local RenderingProfiler::TraceRecorder::ThreadCache RenderingProfiler::TraceRecorder::g_threadCache;
+
+RenderingProfiler::TraceRecorder::TraceRecorder() :
+    id_ { ++g_idCounter }
+{
+}
+
+void RenderingProfiler::TraceRecorder::Record(const char* annotation, std::uint64_t startTime, std::uint64_t elapsedTime, bool gpu)
+{
+    AppendEvent(*GetThreadBuffer(), { annotation, startTime, elapsedTime, gpu });
+}
+
+void RenderingProfiler::TraceRecorder::AppendEvent(ThreadBuffer& buffer, Event event)
+{
+    /* Copy GPU annotations, since they might be released with their command buffer before the trace is written */
+    if (event.gpu && event.annotation != nullptr)
+        event.annotation = buffer.annotations.insert(event.annotation).first->c_str();
+
+    auto chunk = buffer.lastChunk;
+
+    /* Allocate next chunk if the current one is full */
+    auto index = chunk->count.load(std::memory_order_relaxed);
+    if (index == EventChunk::capacity)
+    {
+        chunk->next = MakeUnique<EventChunk>();
+        chunk = chunk->next.get();
+        buffer.lastChunk = chunk;
+        index = 0;
+    }
+
+    /* Write event and publish it to readers */
+    chunk->events[index] = event;
+    chunk->count.store(index + 1, std::memory_order_release);
+}
+
+// Writes the specified string as JSON string literal.
+static void WriteJSONString(std::ostream& stream, const char* s)
+{
+    stream << '\"';
+    for (; s != nullptr && *s != '\0'; ++s)
+    {
+        switch (*s)
+        {
+            case '\"':  stream << "\\\""; break;
+            case '\\':  stream << "\\\\"; break;
+            case '\n':  stream << "\\n";  break;
+            case '\t':  stream << "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(*s) >= 0x20)
+                    stream << *s;
+                break;
+        }
+    }
+    stream << '\"';
+}
+
+// Writes the specified time (in nanoseconds) as microseconds, which is the time unit of the Chrome trace event format.
+static void WriteMicroseconds(std::ostream& stream, std::uint64_t t)
+{
+    const auto fraction = static_cast<unsigned>(t % 1000);
+    stream << (t / 1000) << '.' << (fraction < 100 ? (fraction < 10 ? "00" : "0") : "") << fraction;
+}
+
+void RenderingProfiler::TraceRecorder::Write(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> guard { buffersMutex_ };
+
+    /* Find earliest timestamp as origin of the timeline */
+    auto origin = ~0ull;
+
+    for (const auto& buffer : buffers_)
+    {
+        for (auto chunk = &(buffer->firstChunk); chunk != nullptr; chunk = chunk->next.get())
+        {
+            const auto count = chunk->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i)
+                origin = std::min(origin, static_cast<unsigned long long>(chunk->events[i].startTime));
+        }
+    }
+
+    /* Write track names: GPU track has thread ID 0, all CPU threads start with thread ID 1 */
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+
+    for (const auto& buffer : buffers_)
+    {
+        stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex;
+        stream << ",\"args\":{\"name\":\"CPU Thread " << buffer->threadIndex << "\"}}";
+    }
+
+    /* Write all events as complete events */
+    for (const auto& buffer : buffers_)
+    {
+        for (auto chunk = &(buffer->firstChunk); chunk != nullptr; chunk = chunk->next.get())
+        {
+            const auto count = chunk->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto& event = chunk->events[i];
+                stream << ",\n{\"name\":";
+                WriteJSONString(stream, event.annotation);
+                stream << ",\"cat\":\"" << (event.gpu ? "GPU" : "CPU") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+                stream << (event.gpu ? 0u : buffer->threadIndex) << ",\"ts\":";
+                WriteMicroseconds(stream, event.startTime - origin);
+                stream << ",\"dur\":";
+                WriteMicroseconds(stream, event.elapsedTime);
+                stream << '}';
+            }
+        }
+    }
+
+    stream << "\n]}\n";
+}
+
+void RenderingProfiler::TraceRecorder::Clear()
+{
+    std::lock_guard<std::mutex> guard { buffersMutex_ };
+    for (auto& buffer : buffers_)
+    {
+        buffer->firstChunk.next.reset();
+        buffer->firstChunk.count.store(0, std::memory_order_release);
+        buffer->lastChunk = &(buffer->firstChunk);
+        buffer->annotations.clear();
+    }
+}
+
+void RenderingProfiler::TraceRecorder::Append(const TraceRecorder& rhs)
+{
+    std::lock(buffersMutex_, rhs.buffersMutex_);
+    std::lock_guard<std::mutex> guard { buffersMutex_, std::adopt_lock };
+    std::lock_guard<std::mutex> rhsGuard { rhs.buffersMutex_, std::adopt_lock };
+
+    for (const auto& rhsBuffer : rhs.buffers_)
+    {
+        /* Find or create event buffer for the same thread */
+        auto it = std::find_if(
+            buffers_.begin(),
+            buffers_.end(),
+            [&rhsBuffer](const std::unique_ptr<ThreadBuffer>& buffer)
+            {
+                return (buffer->threadID == rhsBuffer->threadID);
+            }
+        );
+
+        if (it == buffers_.end())
+        {
+            auto buffer = MakeUnique<ThreadBuffer>();
+            {
+                buffer->threadID    = rhsBuffer->threadID;
+                buffer->threadIndex = static_cast<std::uint32_t>(buffers_.size() + 1);
+                buffer->lastChunk   = &(buffer->firstChunk);
+            }
+            buffers_.push_back(std::move(buffer));
+            it = buffers_.end() - 1;
+        }
+
+        /* Copy all published events */
+        for (auto chunk = &(rhsBuffer->firstChunk); chunk != nullptr; chunk = chunk->next.get())
+        {
+            const auto count = chunk->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i)
+                AppendEvent(**it, chunk->events[i]);
+        }
+    }
+}
+
+RenderingProfiler::TraceRecorder::ThreadBuffer* RenderingProfiler::TraceRecorder::GetThreadBuffer()
+{
+    /* Fast path: thread has already recorded into this recorder */
+    if (g_threadCache.recorderID == id_)
+        return g_threadCache.buffer;
+
+    /* Slow path: find event buffer of calling thread or register a new one */
+    std::lock_guard<std::mutex> guard { buffersMutex_ };
+
+    const auto threadID = std::this_thread::get_id();
+
+    auto it = std::find_if(
+        buffers_.begin(),
+        buffers_.end(),
+        [threadID](const std::unique_ptr<ThreadBuffer>& buffer)
+        {
+            return (buffer->threadID == threadID);
+        }
+    );
+
+    if (it == buffers_.end())
+    {
+        auto buffer = MakeUnique<ThreadBuffer>();
+        {
+            buffer->threadID    = threadID;
+            buffer->threadIndex = static_cast<std::uint32_t>(buffers_.size() + 1);
+            buffer->lastChunk   = &(buffer->firstChunk);
+        }
+        buffers_.push_back(std::move(buffer));
+        it = buffers_.end() - 1;
+    }
+
+    g_threadCache.recorderID    = id_;
+    g_threadCache.buffer        = it->get();
+
+    return g_threadCache.buffer;
+}
+
+
+/*
+ * RenderingProfiler class
+ */
+
+RenderingProfiler::RenderingProfiler() :
+    traceRecorder_ { MakeUnique<TraceRecorder>() }
+{
+}
+
+RenderingProfiler::~RenderingProfiler()
+{
+    // dummy
+}
+
+RenderingProfiler::RenderingProfiler(const RenderingProfiler& rhs) :
+    frameProfile            { rhs.frameProfile                  },
+    timeRecordingEnabled    { rhs.timeRecordingEnabled          },
+    traceRecordingEnabled   { rhs.traceRecordingEnabled         },
+    traceRecorder_          { MakeUnique<TraceRecorder>()       }
+{
+    traceRecorder_->Append(*rhs.traceRecorder_);
+}
+
+RenderingProfiler& RenderingProfiler::operator = (const RenderingProfiler& rhs)
+{
+    if (this != &rhs)
+    {
+        frameProfile            = rhs.frameProfile;
+        timeRecordingEnabled    = rhs.timeRecordingEnabled;
+        traceRecordingEnabled   = rhs.traceRecordingEnabled;
+
+        /* Replace recorder instead of clearing it, so the thread caches of the previous recorder can never match the new one */
+        auto traceRecorder = MakeUnique<TraceRecorder>();
+        traceRecorder->Append(*rhs.traceRecorder_);
+        traceRecorder_ = std::move(traceRecorder);
+    }
+    return *this;
+}
+
 void RenderingProfiler::NextProfile(FrameProfile* outputProfile)
 {
     /* Copy current counters to the output profile (if set) */
@@ -26,6 +357,35 @@ void RenderingProfiler::NextProfile(FrameProfile* outputProfile)
 void RenderingProfiler::Accumulate(const FrameProfile& profile)
 {
     frameProfile.Accumulate(profile);
+
+    /* Add GPU time records to trace */
+    if (traceRecordingEnabled)
+    {
+        for (const auto& record : profile.timeRecords)
+            traceRecorder_->Record(record.annotation, record.startTime, record.elapsedTime, true);
+    }
+}
+
+void RenderingProfiler::RecordTraceScope(const char* annotation, std::uint64_t startTime, std::uint64_t elapsedTime)
+{
+    if (traceRecordingEnabled)
+        traceRecorder_->Record(annotation, startTime, elapsedTime, false);
+}
+
+void RenderingProfiler::WriteTrace(std::ostream& stream) const
+{
+    traceRecorder_->Write(stream);
+}
+
+void RenderingProfiler::ClearTrace()
+{
+    traceRecorder_->Clear();
+}
+
+std::uint64_t RenderingProfiler::GetTimestamp()
+{
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t).count());
 }
 
 
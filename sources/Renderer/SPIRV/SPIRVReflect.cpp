@@ -44,9 +44,16 @@ bool SPIRVReflect::SpvType::RefersToType(const spv::Op opcodeType) const
 
 void SPIRVReflect::OnParseHeader(const SPIRVHeader& header)
 {
+    SPIRVParser::OnParseHeader(header);
+
+    /* Allocate all ID-indexed arrays at once, so references between module objects remain valid */
     idBound_ = header.idBound;
-    if (idBound_ > 0)
-        names_.resize(idBound_);
+    names_.assign(idBound_, nullptr);
+    types_.assign(idBound_, SpvType{});
+    constants_.assign(idBound_, SpvConstant{});
+    uniforms_.assign(idBound_, SpvUniform{});
+    varyings_.assign(idBound_, SpvVarying{});
+    specConstants_.assign(idBound_, SpvSpecConstant{});
 }
 
 void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
@@ -82,6 +89,15 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpConstant:
             OpConstant(instr);
             break;
+        case spv::Op::OpSpecConstantTrue:
+        case spv::Op::OpSpecConstantFalse:
+        case spv::Op::OpSpecConstant:
+            OpSpecConstant(instr);
+            break;
+        case spv::Op::OpFunction:
+            /* Skip function bodies, since all reflected declarations precede them */
+            Finish();
+            break;
         default:
             break;
     }
@@ -106,6 +122,9 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
         case spv::Decoration::BuiltIn:
             OpDecorateBuiltin(instr);
             break;
+        case spv::Decoration::SpecId:
+            OpDecorateSpecId(instr);
+            break;
         default:
             break;
     }
@@ -114,7 +133,7 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
 void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = uniforms_[id];
+    auto& variable  = GetOrMakeUniform(id);
 
     variable.name       = GetName(id);
     variable.binding    = instr.GetUInt32(2);
@@ -123,7 +142,7 @@ void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 void SPIRVReflect::OpDecorateLocation(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
+    auto& variable  = GetOrMakeVarying(id);
 
     variable.name       = GetName(id);
     variable.location   = instr.GetUInt32(2);
@@ -132,15 +151,26 @@ void SPIRVReflect::OpDecorateLocation(const Instr& instr)
 void SPIRVReflect::OpDecorateBuiltin(const Instr& instr)
 {
     auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
+    auto& variable  = GetOrMakeVarying(id);
 
     variable.name       = GetName(id);
     variable.builtin    = static_cast<spv::BuiltIn>(instr.GetUInt32(2));
 }
 
+void SPIRVReflect::OpDecorateSpecId(const Instr& instr)
+{
+    auto id         = instr.GetUInt32(0);
+    auto& constant  = GetOrMakeSpecConstant(id);
+
+    constant.name       = GetName(id);
+    constant.hasSpecId  = true;
+    constant.constantID = instr.GetUInt32(2);
+}
+
 void SPIRVReflect::OpType(const Instr& instr)
 {
     /* Register type and store it as current type to operate on */
+    AssertIdBound(instr.result);
     auto& type = types_[instr.result];
     {
         type.opcode = instr.opcode;
@@ -291,7 +321,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
         case spv::StorageClass::UniformConstant:
         //case spv::StorageClass::PushConstant:
         {
-            auto& var = uniforms_[instr.result];
+            auto& var = GetOrMakeUniform(instr.result);
             {
                 var.type = FindType(instr.type);
                 if (auto structType = var.type->DereferencePtr(spv::Op::OpTypeStruct))
@@ -308,7 +338,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Input:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = GetOrMakeVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = true;
@@ -318,7 +348,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Output:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = GetOrMakeVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = false;
@@ -333,6 +363,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
 void SPIRVReflect::OpConstant(const Instr& instr)
 {
+    AssertIdBound(instr.result);
     auto& val = constants_[instr.result];
     {
         val.type = FindType(instr.type);
@@ -356,6 +387,23 @@ void SPIRVReflect::OpConstant(const Instr& instr)
     }
 }
 
+void SPIRVReflect::OpSpecConstant(const Instr& instr)
+{
+    /* Register default value as regular constant, so it can be used for array types */
+    if (instr.opcode == spv::Op::OpSpecConstant)
+        OpConstant(instr);
+
+    auto& constant = GetOrMakeSpecConstant(instr.result);
+    {
+        constant.type = FindType(instr.type);
+
+        if (instr.opcode == spv::Op::OpSpecConstantTrue)
+            constant.value = 1;
+        else if (instr.opcode == spv::Op::OpSpecConstant)
+            constant.value = instr.GetUInt32(0);
+    }
+}
+
 void SPIRVReflect::SetName(spv::Id id, const char* name)
 {
     AssertIdBound(id);
@@ -381,18 +429,40 @@ void SPIRVReflect::AssertIdBound(spv::Id id) const
 
 const SPIRVReflect::SpvType* SPIRVReflect::FindType(spv::Id id) const
 {
-    auto it = types_.find(id);
-    if (it == types_.end())
+    if (id >= idBound_ || types_[id].opcode == spv::Op::Max)
         throw std::runtime_error("cannot find SPIR-V OpType* instruction with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(types_[id]);
 }
 
 const SPIRVReflect::SpvConstant* SPIRVReflect::FindConstant(spv::Id id) const
 {
-    auto it = constants_.find(id);
-    if (it == constants_.end())
+    if (id >= idBound_ || constants_[id].type == nullptr)
         throw std::runtime_error("cannot find SPIR-V OpConstant instruction with with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(constants_[id]);
+}
+
+SPIRVReflect::SpvUniform& SPIRVReflect::GetOrMakeUniform(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& var = uniforms_[id];
+    var.id = id;
+    return var;
+}
+
+SPIRVReflect::SpvVarying& SPIRVReflect::GetOrMakeVarying(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& var = varyings_[id];
+    var.id = id;
+    return var;
+}
+
+SPIRVReflect::SpvSpecConstant& SPIRVReflect::GetOrMakeSpecConstant(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& constant = specConstants_[id];
+    constant.id = id;
+    return constant;
 }
 
 
@@ -11,14 +11,17 @@
 
 #include "SPIRVParser.h"
 #include <vector>
-#include <map>
 
 
 namespace LLGL
 {
 
 
-// SPIR-V shader module parser.
+/*
+SPIR-V shader module reflection.
+All module objects are stored in arrays that are indexed by their result ID, since the module header provides the ID-bound up front.
+Parsing stops at the first function definition, because all declarations that are reflected precede the function bodies.
+*/
 class SPIRVReflect final : public SPIRVParser
 {
 
@@ -57,17 +60,10 @@ class SPIRVReflect final : public SPIRVParser
             };
         };
 
-        // SPIR-V structures (a.k.a. records).
-        struct SpvRecord
-        {
-            const char*     name    = nullptr;
-            std::uint32_t   size    = 0;
-            std::uint32_t   padding = 0;
-        };
-
         // Global uniform objects.
         struct SpvUniform
         {
+            spv::Id         id      = 0;        // Result ID of the variable, or 0 if this entry is unused.
             const char*     name    = nullptr;
             const SpvType*  type    = nullptr;
             std::uint32_t   set     = 0;        // Descriptor set
@@ -78,6 +74,7 @@ class SPIRVReflect final : public SPIRVParser
         // Module varyings, i.e. either input or output attributes.
         struct SpvVarying
         {
+            spv::Id         id          = 0;                    // Result ID of the variable, or 0 if this entry is unused.
             const char*     name        = nullptr;
             spv::BuiltIn    builtin     = spv::BuiltIn::Max;    // Optional built-in type
             const SpvType*  type        = nullptr;
@@ -85,21 +82,35 @@ class SPIRVReflect final : public SPIRVParser
             bool            input       = false;
         };
 
+        // Specialization constants, i.e. constants with a SpecId decoration.
+        struct SpvSpecConstant
+        {
+            spv::Id         id          = 0;        // Result ID of the constant, or 0 if this entry is unused.
+            const char*     name        = nullptr;
+            const SpvType*  type        = nullptr;  // Type of the constant, or null if the constant has only been decorated.
+            bool            hasSpecId   = false;    // Specifies whether the constant has a SpecId decoration. Otherwise, it cannot be specialized.
+            std::uint32_t   constantID  = 0;        // Constant ID of the SpecId decoration.
+            std::uint32_t   value       = 0;        // Default value as 32-bit word (lower 32 bits for 64-bit types).
+        };
+
     public:
 
-        inline const std::map<spv::Id, SpvRecord>& GetRecords() const
+        // Returns the uniforms indexed by their result ID. Unused entries have an ID of 0.
+        inline const std::vector<SpvUniform>& GetUniforms() const
         {
-            return records_;
+            return uniforms_;
         }
 
-        inline const std::map<spv::Id, SpvUniform>& GetUniforms() const
+        // Returns the varyings indexed by their result ID. Unused entries have an ID of 0.
+        inline const std::vector<SpvVarying>& GetVaryings() const
         {
-            return uniforms_;
+            return varyings_;
         }
 
-        inline const std::map<spv::Id, SpvVarying>& GetVaryings() const
+        // Returns the specialization constants indexed by their result ID. Unused entries have an ID of 0.
+        inline const std::vector<SpvSpecConstant>& GetSpecConstants() const
         {
-            return varyings_;
+            return specConstants_;
         }
 
     private:
@@ -114,6 +125,7 @@ class SPIRVReflect final : public SPIRVParser
         void OpDecorateBinding(const Instr& instr);
         void OpDecorateLocation(const Instr& instr);
         void OpDecorateBuiltin(const Instr& instr);
+        void OpDecorateSpecId(const Instr& instr);
         void OpType(const Instr& instr);
         void OpTypeVoid(const Instr& instr, SpvType& type);
         void OpTypeBool(const Instr& instr, SpvType& type);
@@ -132,6 +144,7 @@ class SPIRVReflect final : public SPIRVParser
         void OpTypeFunction(const Instr& instr, SpvType& type);
         void OpVariable(const Instr& instr);
         void OpConstant(const Instr& instr);
+        void OpSpecConstant(const Instr& instr);
 
     private:
 
@@ -143,16 +156,20 @@ class SPIRVReflect final : public SPIRVParser
         const SpvType* FindType(spv::Id id) const;
         const SpvConstant* FindConstant(spv::Id id) const;
 
+        SpvUniform& GetOrMakeUniform(spv::Id id);
+        SpvVarying& GetOrMakeVarying(spv::Id id);
+        SpvSpecConstant& GetOrMakeSpecConstant(spv::Id id);
+
     private:
 
-        std::uint32_t                   idBound_    = 0;
+        std::uint32_t                   idBound_        = 0;
         std::vector<const char*>        names_;
 
-        std::map<spv::Id, SpvType>      types_;
-        std::map<spv::Id, SpvConstant>  constants_;
-        std::map<spv::Id, SpvRecord>    records_;
-        std::map<spv::Id, SpvUniform>   uniforms_;
-        std::map<spv::Id, SpvVarying>   varyings_;
+        std::vector<SpvType>            types_;         // Types indexed by result ID. Unused entries have the opcode spv::Op::Max.
+        std::vector<SpvConstant>        constants_;     // Constants indexed by result ID. Unused entries have a null type.
+        std::vector<SpvUniform>         uniforms_;
+        std::vector<SpvVarying>         varyings_;
+        std::vector<SpvSpecConstant>    specConstants_;
 
 };
 
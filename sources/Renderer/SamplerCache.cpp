@@ -0,0 +1,152 @@
+/*
+ * SamplerCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "SamplerCache.h"
+#include "../Core/HashUtils.h"
+
+
+namespace LLGL
+{
+
+
+// Hashes each member separately, since the descriptor contains padding bytes
+static std::uint64_t HashSamplerDesc(const SamplerDescriptor& desc)
+{
+    auto hash = g_hashSeed;
+    hash = HashValue(desc.addressModeU, hash);
+    hash = HashValue(desc.addressModeV, hash);
+    hash = HashValue(desc.addressModeW, hash);
+    hash = HashValue(desc.minFilter, hash);
+    hash = HashValue(desc.magFilter, hash);
+    hash = HashValue(desc.mipMapFilter, hash);
+    hash = HashValue(desc.mipMapping, hash);
+    hash = HashValue(desc.mipMapLODBias, hash);
+    hash = HashValue(desc.minLOD, hash);
+    hash = HashValue(desc.maxLOD, hash);
+    hash = HashValue(desc.maxAnisotropy, hash);
+    hash = HashValue(desc.compareEnabled, hash);
+    hash = HashValue(desc.compareOp, hash);
+    hash = HashValue(desc.borderColor.r, hash);
+    hash = HashValue(desc.borderColor.g, hash);
+    hash = HashValue(desc.borderColor.b, hash);
+    hash = HashValue(desc.borderColor.a, hash);
+    return hash;
+}
+
+static bool CompareSamplerDescEqual(const SamplerDescriptor& lhs, const SamplerDescriptor& rhs)
+{
+    return
+    (
+        lhs.addressModeU    == rhs.addressModeU     &&
+        lhs.addressModeV    == rhs.addressModeV     &&
+        lhs.addressModeW    == rhs.addressModeW     &&
+        lhs.minFilter       == rhs.minFilter        &&
+        lhs.magFilter       == rhs.magFilter        &&
+        lhs.mipMapFilter    == rhs.mipMapFilter     &&
+        lhs.mipMapping      == rhs.mipMapping       &&
+        lhs.mipMapLODBias   == rhs.mipMapLODBias    &&
+        lhs.minLOD          == rhs.minLOD           &&
+        lhs.maxLOD          == rhs.maxLOD           &&
+        lhs.maxAnisotropy   == rhs.maxAnisotropy    &&
+        lhs.compareEnabled  == rhs.compareEnabled   &&
+        lhs.compareOp       == rhs.compareOp        &&
+        lhs.borderColor.r   == rhs.borderColor.r    &&
+        lhs.borderColor.g   == rhs.borderColor.g    &&
+        lhs.borderColor.b   == rhs.borderColor.b    &&
+        lhs.borderColor.a   == rhs.borderColor.a
+    );
+}
+
+Sampler* SamplerCache::Acquire(const SamplerDescriptor& desc, const std::function<Sampler*()>& createSampler)
+{
+    const auto hash = HashSamplerDesc(desc);
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Share sampler with an equal descriptor */
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        auto& entry = it->second;
+        if (CompareSamplerDescEqual(entry.desc, desc))
+        {
+            ++entry.refCount;
+            ++numRequested_;
+            return entry.sampler;
+        }
+    }
+
+    /* Create new native sampler */
+    Entry entry;
+    {
+        entry.desc      = desc;
+        entry.sampler   = createSampler();
+        entry.refCount  = 1;
+    }
+    if (entry.sampler != nullptr)
+    {
+        entries_.insert({ hash, entry });
+        samplerHashes_[entry.sampler] = hash;
+        ++numRequested_;
+    }
+
+    return entry.sampler;
+}
+
+bool SamplerCache::Release(const Sampler& sampler)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    /* Samplers that have been created while the cache was disabled are not shared */
+    auto hashIt = samplerHashes_.find(&sampler);
+    if (hashIt == samplerHashes_.end())
+        return true;
+
+    auto range = entries_.equal_range(hashIt->second);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.sampler == &sampler)
+        {
+            --numRequested_;
+            if (--(it->second.refCount) > 0)
+                return false;
+
+            /* Remove entry with the last reference */
+            entries_.erase(it);
+            samplerHashes_.erase(hashIt);
+            return true;
+        }
+    }
+
+    return true;
+}
+
+void SamplerCache::Clear()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    entries_.clear();
+    samplerHashes_.clear();
+    numRequested_ = 0;
+}
+
+SamplerCacheStatistics SamplerCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    SamplerCacheStatistics stats;
+    {
+        stats.numRequestedSamplers  = numRequested_;
+        stats.numUniqueSamplers     = static_cast<std::uint32_t>(entries_.size());
+    }
+    return stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
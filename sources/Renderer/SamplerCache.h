@@ -0,0 +1,79 @@
+/*
+ * SamplerCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SAMPLER_CACHE_H
+#define LLGL_SAMPLER_CACHE_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Sampler;
+
+/*
+Reference counted cache of samplers that is keyed by a hash of the sampler descriptor (see RenderSystemConfiguration::samplerCache).
+The cache does not own the samplers, it only decides when a shared sampler can be destroyed by its render system.
+*/
+class LLGL_EXPORT SamplerCache
+{
+
+    public:
+
+        SamplerCache() = default;
+
+        SamplerCache(const SamplerCache&) = delete;
+        SamplerCache& operator = (const SamplerCache&) = delete;
+
+        // Returns the shared sampler for the specified descriptor and increments its reference count, or creates a new one with the specified callback.
+        Sampler* Acquire(const SamplerDescriptor& desc, const std::function<Sampler*()>& createSampler);
+
+        // Decrements the reference count of the specified sampler. Returns true if the sampler is no longer shared and must be destroyed by the caller.
+        bool Release(const Sampler& sampler);
+
+        // Removes all entries from this cache without destroying any sampler.
+        void Clear();
+
+        // Returns the number of requested and unique samplers.
+        SamplerCacheStatistics GetStatistics() const;
+
+    private:
+
+        struct Entry
+        {
+            SamplerDescriptor   desc;
+            Sampler*            sampler     = nullptr;
+            std::uint32_t       refCount    = 0;
+        };
+
+    private:
+
+        mutable std::mutex                                  mutex_;
+        std::unordered_multimap<std::uint64_t, Entry>       entries_;       // Entries keyed by the hash of their descriptor
+        std::unordered_map<const Sampler*, std::uint64_t>   samplerHashes_; // Descriptor hash of each shared sampler
+        std::uint32_t                                       numRequested_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -99,6 +99,7 @@ void ShaderProgram::ClearShaderReflection(ShaderReflection& reflection)
 {
     reflection.resources.clear();
     reflection.uniforms.clear();
+    reflection.specializationConstants.clear();
     reflection.vertex.inputAttribs.clear();
     reflection.vertex.outputAttribs.clear();
     reflection.fragment.outputAttribs.clear();
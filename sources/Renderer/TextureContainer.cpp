@@ -0,0 +1,727 @@
+/*
+ * TextureContainer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureContainer.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Format.h>
+#include "../Core/Helper.h"
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+ * DDS file structures
+ */
+
+static const std::uint32_t g_ddsMagic = 0x20534444; // "DDS "
+
+enum DDSFlags : std::uint32_t
+{
+    // DDSHeader::flags
+    DDSD_DEPTH              = 0x00800000,
+
+    // DDSPixelFormat::flags
+    DDPF_ALPHAPIXELS        = 0x00000001,
+    DDPF_FOURCC             = 0x00000004,
+    DDPF_RGB                = 0x00000040,
+    DDPF_LUMINANCE          = 0x00020000,
+
+    // DDSHeader::caps2
+    DDSCAPS2_CUBEMAP        = 0x00000200,
+    DDSCAPS2_CUBEMAP_ALL    = 0x0000FC00,
+    DDSCAPS2_VOLUME         = 0x00200000,
+
+    // DDSHeaderDX10::miscFlag
+    DDS_RESOURCE_MISC_TEXTURECUBE = 0x00000004,
+};
+
+enum DDSResourceDimension : std::uint32_t
+{
+    DDS_DIMENSION_TEXTURE1D = 2,
+    DDS_DIMENSION_TEXTURE2D = 3,
+    DDS_DIMENSION_TEXTURE3D = 4,
+};
+
+struct DDSPixelFormat
+{
+    std::uint32_t   size;
+    std::uint32_t   flags;
+    std::uint32_t   fourCC;
+    std::uint32_t   rgbBitCount;
+    std::uint32_t   rBitMask;
+    std::uint32_t   gBitMask;
+    std::uint32_t   bBitMask;
+    std::uint32_t   aBitMask;
+};
+
+struct DDSHeader
+{
+    std::uint32_t   size;
+    std::uint32_t   flags;
+    std::uint32_t   height;
+    std::uint32_t   width;
+    std::uint32_t   pitchOrLinearSize;
+    std::uint32_t   depth;
+    std::uint32_t   mipMapCount;
+    std::uint32_t   reserved1[11];
+    DDSPixelFormat  pixelFormat;
+    std::uint32_t   caps;
+    std::uint32_t   caps2;
+    std::uint32_t   caps3;
+    std::uint32_t   caps4;
+    std::uint32_t   reserved2;
+};
+
+struct DDSHeaderDX10
+{
+    std::uint32_t   dxgiFormat;
+    std::uint32_t   resourceDimension;
+    std::uint32_t   miscFlag;
+    std::uint32_t   arraySize;
+    std::uint32_t   miscFlags2;
+};
+
+static_assert(sizeof(DDSHeader) == 124, "DDSHeader must have a size of 124 bytes");
+static_assert(sizeof(DDSHeaderDX10) == 20, "DDSHeaderDX10 must have a size of 20 bytes");
+
+static constexpr std::uint32_t MakeFourCC(char c0, char c1, char c2, char c3)
+{
+    return
+    (
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c0))      ) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c1)) <<  8) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c2)) << 16) |
+        (static_cast<std::uint32_t>(static_cast<std::uint8_t>(c3)) << 24)
+    );
+}
+
+// Maps the DXGI_FORMAT of the DX10 header extension to a hardware format.
+static Format MapDXGIFormat(std::uint32_t dxgiFormat)
+{
+    switch (dxgiFormat)
+    {
+        case  2: return Format::RGBA32Float;        // DXGI_FORMAT_R32G32B32A32_FLOAT
+        case  3: return Format::RGBA32UInt;         // DXGI_FORMAT_R32G32B32A32_UINT
+        case  4: return Format::RGBA32SInt;         // DXGI_FORMAT_R32G32B32A32_SINT
+        case  6: return Format::RGB32Float;         // DXGI_FORMAT_R32G32B32_FLOAT
+        case  7: return Format::RGB32UInt;          // DXGI_FORMAT_R32G32B32_UINT
+        case  8: return Format::RGB32SInt;          // DXGI_FORMAT_R32G32B32_SINT
+        case 10: return Format::RGBA16Float;        // DXGI_FORMAT_R16G16B16A16_FLOAT
+        case 11: return Format::RGBA16UNorm;        // DXGI_FORMAT_R16G16B16A16_UNORM
+        case 12: return Format::RGBA16UInt;         // DXGI_FORMAT_R16G16B16A16_UINT
+        case 13: return Format::RGBA16SNorm;        // DXGI_FORMAT_R16G16B16A16_SNORM
+        case 14: return Format::RGBA16SInt;         // DXGI_FORMAT_R16G16B16A16_SINT
+        case 16: return Format::RG32Float;          // DXGI_FORMAT_R32G32_FLOAT
+        case 17: return Format::RG32UInt;           // DXGI_FORMAT_R32G32_UINT
+        case 18: return Format::RG32SInt;           // DXGI_FORMAT_R32G32_SINT
+        case 20: return Format::D32FloatS8X24UInt;  // DXGI_FORMAT_D32_FLOAT_S8X24_UINT
+        case 24: return Format::RGB10A2UNorm;       // DXGI_FORMAT_R10G10B10A2_UNORM
+        case 25: return Format::RGB10A2UInt;        // DXGI_FORMAT_R10G10B10A2_UINT
+        case 26: return Format::RG11B10Float;       // DXGI_FORMAT_R11G11B10_FLOAT
+        case 28: return Format::RGBA8UNorm;         // DXGI_FORMAT_R8G8B8A8_UNORM
+        case 29: return Format::RGBA8UNorm_sRGB;    // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+        case 30: return Format::RGBA8UInt;          // DXGI_FORMAT_R8G8B8A8_UINT
+        case 31: return Format::RGBA8SNorm;         // DXGI_FORMAT_R8G8B8A8_SNORM
+        case 32: return Format::RGBA8SInt;          // DXGI_FORMAT_R8G8B8A8_SINT
+        case 34: return Format::RG16Float;          // DXGI_FORMAT_R16G16_FLOAT
+        case 35: return Format::RG16UNorm;          // DXGI_FORMAT_R16G16_UNORM
+        case 36: return Format::RG16UInt;           // DXGI_FORMAT_R16G16_UINT
+        case 37: return Format::RG16SNorm;          // DXGI_FORMAT_R16G16_SNORM
+        case 38: return Format::RG16SInt;           // DXGI_FORMAT_R16G16_SINT
+        case 40: return Format::D32Float;           // DXGI_FORMAT_D32_FLOAT
+        case 41: return Format::R32Float;           // DXGI_FORMAT_R32_FLOAT
+        case 42: return Format::R32UInt;            // DXGI_FORMAT_R32_UINT
+        case 43: return Format::R32SInt;            // DXGI_FORMAT_R32_SINT
+        case 45: return Format::D24UNormS8UInt;     // DXGI_FORMAT_D24_UNORM_S8_UINT
+        case 49: return Format::RG8UNorm;           // DXGI_FORMAT_R8G8_UNORM
+        case 50: return Format::RG8UInt;            // DXGI_FORMAT_R8G8_UINT
+        case 51: return Format::RG8SNorm;           // DXGI_FORMAT_R8G8_SNORM
+        case 52: return Format::RG8SInt;            // DXGI_FORMAT_R8G8_SINT
+        case 54: return Format::R16Float;           // DXGI_FORMAT_R16_FLOAT
+        case 55: return Format::D16UNorm;           // DXGI_FORMAT_D16_UNORM
+        case 56: return Format::R16UNorm;           // DXGI_FORMAT_R16_UNORM
+        case 57: return Format::R16UInt;            // DXGI_FORMAT_R16_UINT
+        case 58: return Format::R16SNorm;           // DXGI_FORMAT_R16_SNORM
+        case 59: return Format::R16SInt;            // DXGI_FORMAT_R16_SINT
+        case 61: return Format::R8UNorm;            // DXGI_FORMAT_R8_UNORM
+        case 62: return Format::R8UInt;             // DXGI_FORMAT_R8_UINT
+        case 63: return Format::R8SNorm;            // DXGI_FORMAT_R8_SNORM
+        case 64: return Format::R8SInt;             // DXGI_FORMAT_R8_SINT
+        case 65: return Format::A8UNorm;            // DXGI_FORMAT_A8_UNORM
+        case 67: return Format::RGB9E5Float;        // DXGI_FORMAT_R9G9B9E5_SHAREDEXP
+        case 71: return Format::BC1UNorm;           // DXGI_FORMAT_BC1_UNORM
+        case 72: return Format::BC1UNorm_sRGB;      // DXGI_FORMAT_BC1_UNORM_SRGB
+        case 74: return Format::BC2UNorm;           // DXGI_FORMAT_BC2_UNORM
+        case 75: return Format::BC2UNorm_sRGB;      // DXGI_FORMAT_BC2_UNORM_SRGB
+        case 77: return Format::BC3UNorm;           // DXGI_FORMAT_BC3_UNORM
+        case 78: return Format::BC3UNorm_sRGB;      // DXGI_FORMAT_BC3_UNORM_SRGB
+        case 80: return Format::BC4UNorm;           // DXGI_FORMAT_BC4_UNORM
+        case 81: return Format::BC4SNorm;           // DXGI_FORMAT_BC4_SNORM
+        case 83: return Format::BC5UNorm;           // DXGI_FORMAT_BC5_UNORM
+        case 84: return Format::BC5SNorm;           // DXGI_FORMAT_BC5_SNORM
+        case 87: return Format::BGRA8UNorm;         // DXGI_FORMAT_B8G8R8A8_UNORM
+        case 91: return Format::BGRA8UNorm_sRGB;    // DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+        default: return Format::Undefined;
+    }
+}
+
+// Maps the legacy pixel format of the DDS header to a hardware format.
+static Format MapDDSPixelFormat(const DDSPixelFormat& pf)
+{
+    if ((pf.flags & DDPF_FOURCC) != 0)
+    {
+        switch (pf.fourCC)
+        {
+            case MakeFourCC('D', 'X', 'T', '1'): return Format::BC1UNorm;
+            case MakeFourCC('D', 'X', 'T', '2'): return Format::BC2UNorm;
+            case MakeFourCC('D', 'X', 'T', '3'): return Format::BC2UNorm;
+            case MakeFourCC('D', 'X', 'T', '4'): return Format::BC3UNorm;
+            case MakeFourCC('D', 'X', 'T', '5'): return Format::BC3UNorm;
+            case MakeFourCC('A', 'T', 'I', '1'): return Format::BC4UNorm;
+            case MakeFourCC('B', 'C', '4', 'U'): return Format::BC4UNorm;
+            case MakeFourCC('B', 'C', '4', 'S'): return Format::BC4SNorm;
+            case MakeFourCC('A', 'T', 'I', '2'): return Format::BC5UNorm;
+            case MakeFourCC('B', 'C', '5', 'U'): return Format::BC5UNorm;
+            case MakeFourCC('B', 'C', '5', 'S'): return Format::BC5SNorm;
+            case  36: return Format::RGBA16UNorm;   // D3DFMT_A16B16G16R16
+            case 110: return Format::RGBA16SNorm;   // D3DFMT_Q16W16V16U16
+            case 111: return Format::R16Float;      // D3DFMT_R16F
+            case 112: return Format::RG16Float;     // D3DFMT_G16R16F
+            case 113: return Format::RGBA16Float;   // D3DFMT_A16B16G16R16F
+            case 114: return Format::R32Float;      // D3DFMT_R32F
+            case 115: return Format::RG32Float;     // D3DFMT_G32R32F
+            case 116: return Format::RGBA32Float;   // D3DFMT_A32B32G32R32F
+            default:  return Format::Undefined;
+        }
+    }
+
+    auto HasMasks = [&pf](std::uint32_t r, std::uint32_t g, std::uint32_t b, std::uint32_t a)
+    {
+        return (pf.rBitMask == r && pf.gBitMask == g && pf.bBitMask == b && ((pf.flags & DDPF_ALPHAPIXELS) == 0 ? 0u : pf.aBitMask) == a);
+    };
+
+    if ((pf.flags & DDPF_RGB) != 0)
+    {
+        if (pf.rgbBitCount == 32)
+        {
+            if (HasMasks(0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000))
+                return Format::RGBA8UNorm;
+            if (HasMasks(0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000))
+                return Format::BGRA8UNorm;
+            if (HasMasks(0x000003FF, 0x000FFC00, 0x3FF00000, 0xC0000000))
+                return Format::RGB10A2UNorm;
+            if (HasMasks(0x0000FFFF, 0xFFFF0000, 0x00000000, 0x00000000))
+                return Format::RG16UNorm;
+            if (HasMasks(0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000))
+                return Format::R32Float;
+        }
+        else if (pf.rgbBitCount == 24)
+        {
+            if (HasMasks(0x000000FF, 0x0000FF00, 0x00FF0000, 0x00000000))
+                return Format::RGB8UNorm;
+        }
+    }
+    else if ((pf.flags & DDPF_LUMINANCE) != 0)
+    {
+        if (pf.rgbBitCount == 8 && pf.rBitMask == 0x000000FF)
+            return Format::R8UNorm;
+        if (pf.rgbBitCount == 16 && pf.rBitMask == 0x0000FFFF)
+            return Format::R16UNorm;
+        if (pf.rgbBitCount == 16 && pf.rBitMask == 0x000000FF && pf.aBitMask == 0x0000FF00)
+            return Format::RG8UNorm;
+    }
+
+    return Format::Undefined;
+}
+
+
+/*
+ * KTX2 file structures
+ */
+
+static const std::uint8_t g_ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+struct KTX2Header
+{
+    std::uint8_t    identifier[12];
+    std::uint32_t   vkFormat;
+    std::uint32_t   typeSize;
+    std::uint32_t   pixelWidth;
+    std::uint32_t   pixelHeight;
+    std::uint32_t   pixelDepth;
+    std::uint32_t   layerCount;
+    std::uint32_t   faceCount;
+    std::uint32_t   levelCount;
+    std::uint32_t   supercompressionScheme;
+    std::uint32_t   dfdByteOffset;
+    std::uint32_t   dfdByteLength;
+    std::uint32_t   kvdByteOffset;
+    std::uint32_t   kvdByteLength;
+    std::uint64_t   sgdByteOffset;
+    std::uint64_t   sgdByteLength;
+};
+
+struct KTX2LevelIndex
+{
+    std::uint64_t   byteOffset;
+    std::uint64_t   byteLength;
+    std::uint64_t   uncompressedByteLength;
+};
+
+static_assert(sizeof(KTX2Header) == 80, "KTX2Header must have a size of 80 bytes");
+static_assert(sizeof(KTX2LevelIndex) == 24, "KTX2LevelIndex must have a size of 24 bytes");
+
+// Maps the VkFormat of the KTX2 header to a hardware format.
+static Format MapVkFormat(std::uint32_t vkFormat)
+{
+    switch (vkFormat)
+    {
+        case   9: return Format::R8UNorm;           // VK_FORMAT_R8_UNORM
+        case  10: return Format::R8SNorm;           // VK_FORMAT_R8_SNORM
+        case  13: return Format::R8UInt;            // VK_FORMAT_R8_UINT
+        case  14: return Format::R8SInt;            // VK_FORMAT_R8_SINT
+        case  16: return Format::RG8UNorm;          // VK_FORMAT_R8G8_UNORM
+        case  17: return Format::RG8SNorm;          // VK_FORMAT_R8G8_SNORM
+        case  20: return Format::RG8UInt;           // VK_FORMAT_R8G8_UINT
+        case  21: return Format::RG8SInt;           // VK_FORMAT_R8G8_SINT
+        case  23: return Format::RGB8UNorm;         // VK_FORMAT_R8G8B8_UNORM
+        case  24: return Format::RGB8SNorm;         // VK_FORMAT_R8G8B8_SNORM
+        case  27: return Format::RGB8UInt;          // VK_FORMAT_R8G8B8_UINT
+        case  28: return Format::RGB8SInt;          // VK_FORMAT_R8G8B8_SINT
+        case  29: return Format::RGB8UNorm_sRGB;    // VK_FORMAT_R8G8B8_SRGB
+        case  37: return Format::RGBA8UNorm;        // VK_FORMAT_R8G8B8A8_UNORM
+        case  38: return Format::RGBA8SNorm;        // VK_FORMAT_R8G8B8A8_SNORM
+        case  41: return Format::RGBA8UInt;         // VK_FORMAT_R8G8B8A8_UINT
+        case  42: return Format::RGBA8SInt;         // VK_FORMAT_R8G8B8A8_SINT
+        case  43: return Format::RGBA8UNorm_sRGB;   // VK_FORMAT_R8G8B8A8_SRGB
+        case  44: return Format::BGRA8UNorm;        // VK_FORMAT_B8G8R8A8_UNORM
+        case  45: return Format::BGRA8SNorm;        // VK_FORMAT_B8G8R8A8_SNORM
+        case  48: return Format::BGRA8UInt;         // VK_FORMAT_B8G8R8A8_UINT
+        case  49: return Format::BGRA8SInt;         // VK_FORMAT_B8G8R8A8_SINT
+        case  50: return Format::BGRA8UNorm_sRGB;   // VK_FORMAT_B8G8R8A8_SRGB
+        case  64: return Format::RGB10A2UNorm;      // VK_FORMAT_A2B10G10R10_UNORM_PACK32
+        case  68: return Format::RGB10A2UInt;       // VK_FORMAT_A2B10G10R10_UINT_PACK32
+        case  70: return Format::R16UNorm;          // VK_FORMAT_R16_UNORM
+        case  71: return Format::R16SNorm;          // VK_FORMAT_R16_SNORM
+        case  74: return Format::R16UInt;           // VK_FORMAT_R16_UINT
+        case  75: return Format::R16SInt;           // VK_FORMAT_R16_SINT
+        case  76: return Format::R16Float;          // VK_FORMAT_R16_SFLOAT
+        case  77: return Format::RG16UNorm;         // VK_FORMAT_R16G16_UNORM
+        case  78: return Format::RG16SNorm;         // VK_FORMAT_R16G16_SNORM
+        case  81: return Format::RG16UInt;          // VK_FORMAT_R16G16_UINT
+        case  82: return Format::RG16SInt;          // VK_FORMAT_R16G16_SINT
+        case  83: return Format::RG16Float;         // VK_FORMAT_R16G16_SFLOAT
+        case  84: return Format::RGB16UNorm;        // VK_FORMAT_R16G16B16_UNORM
+        case  85: return Format::RGB16SNorm;        // VK_FORMAT_R16G16B16_SNORM
+        case  88: return Format::RGB16UInt;         // VK_FORMAT_R16G16B16_UINT
+        case  89: return Format::RGB16SInt;         // VK_FORMAT_R16G16B16_SINT
+        case  90: return Format::RGB16Float;        // VK_FORMAT_R16G16B16_SFLOAT
+        case  91: return Format::RGBA16UNorm;       // VK_FORMAT_R16G16B16A16_UNORM
+        case  92: return Format::RGBA16SNorm;       // VK_FORMAT_R16G16B16A16_SNORM
+        case  95: return Format::RGBA16UInt;        // VK_FORMAT_R16G16B16A16_UINT
+        case  96: return Format::RGBA16SInt;        // VK_FORMAT_R16G16B16A16_SINT
+        case  97: return Format::RGBA16Float;       // VK_FORMAT_R16G16B16A16_SFLOAT
+        case  98: return Format::R32UInt;           // VK_FORMAT_R32_UINT
+        case  99: return Format::R32SInt;           // VK_FORMAT_R32_SINT
+        case 100: return Format::R32Float;          // VK_FORMAT_R32_SFLOAT
+        case 101: return Format::RG32UInt;          // VK_FORMAT_R32G32_UINT
+        case 102: return Format::RG32SInt;          // VK_FORMAT_R32G32_SINT
+        case 103: return Format::RG32Float;         // VK_FORMAT_R32G32_SFLOAT
+        case 104: return Format::RGB32UInt;         // VK_FORMAT_R32G32B32_UINT
+        case 105: return Format::RGB32SInt;         // VK_FORMAT_R32G32B32_SINT
+        case 106: return Format::RGB32Float;        // VK_FORMAT_R32G32B32_SFLOAT
+        case 107: return Format::RGBA32UInt;        // VK_FORMAT_R32G32B32A32_UINT
+        case 108: return Format::RGBA32SInt;        // VK_FORMAT_R32G32B32A32_SINT
+        case 109: return Format::RGBA32Float;       // VK_FORMAT_R32G32B32A32_SFLOAT
+        case 112: return Format::R64Float;          // VK_FORMAT_R64_SFLOAT
+        case 115: return Format::RG64Float;         // VK_FORMAT_R64G64_SFLOAT
+        case 118: return Format::RGB64Float;        // VK_FORMAT_R64G64B64_SFLOAT
+        case 121: return Format::RGBA64Float;       // VK_FORMAT_R64G64B64A64_SFLOAT
+        case 122: return Format::RG11B10Float;      // VK_FORMAT_B10G11R11_UFLOAT_PACK32
+        case 123: return Format::RGB9E5Float;       // VK_FORMAT_E5B9G9R9_UFLOAT_PACK32
+        case 124: return Format::D16UNorm;          // VK_FORMAT_D16_UNORM
+        case 126: return Format::D32Float;          // VK_FORMAT_D32_SFLOAT
+        case 129: return Format::D24UNormS8UInt;    // VK_FORMAT_D24_UNORM_S8_UINT
+        case 130: return Format::D32FloatS8X24UInt; // VK_FORMAT_D32_SFLOAT_S8_UINT
+        case 131: return Format::BC1UNorm;          // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132: return Format::BC1UNorm_sRGB;     // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 133: return Format::BC1UNorm;          // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134: return Format::BC1UNorm_sRGB;     // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 135: return Format::BC2UNorm;          // VK_FORMAT_BC2_UNORM_BLOCK
+        case 136: return Format::BC2UNorm_sRGB;     // VK_FORMAT_BC2_SRGB_BLOCK
+        case 137: return Format::BC3UNorm;          // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: return Format::BC3UNorm_sRGB;     // VK_FORMAT_BC3_SRGB_BLOCK
+        case 139: return Format::BC4UNorm;          // VK_FORMAT_BC4_UNORM_BLOCK
+        case 140: return Format::BC4SNorm;          // VK_FORMAT_BC4_SNORM_BLOCK
+        case 141: return Format::BC5UNorm;          // VK_FORMAT_BC5_UNORM_BLOCK
+        case 142: return Format::BC5SNorm;          // VK_FORMAT_BC5_SNORM_BLOCK
+        default:  return Format::Undefined;
+    }
+}
+
+
+/*
+ * Internal functions
+ */
+
+// Copies a structure of type <T> from the specified byte offset of the blob; the data might not be aligned for <T>.
+template <typename T>
+void ReadContainerValue(const Blob& blob, std::size_t offset, T& value)
+{
+    if (offset > blob.GetSize() || blob.GetSize() - offset < sizeof(T))
+        throw std::runtime_error("unexpected end of texture container");
+    ::memcpy(&value, reinterpret_cast<const std::uint8_t*>(blob.GetData()) + offset, sizeof(T));
+}
+
+// Upper bound of array layers (including cube faces) a container may declare; far beyond any hardware limit.
+static const std::uint64_t g_maxArrayLayers = 65536;
+
+static std::uint32_t MipExtent(std::uint32_t extent, std::uint32_t mipLevel)
+{
+    /* Shifting a 32-bit value by 32 or more bits is undefined */
+    return (mipLevel < 32 ? std::max(1u, extent >> mipLevel) : 1u);
+}
+
+// Returns the product of the two sizes and throws if it overflows.
+static std::size_t MulContainerSize(std::size_t lhs, std::size_t rhs)
+{
+    if (rhs != 0 && lhs > std::numeric_limits<std::size_t>::max() / rhs)
+        throw std::runtime_error("size overflow in texture container");
+    return (lhs * rhs);
+}
+
+// Returns the number of array layers (including cube faces) and throws if it is zero or out of range.
+static std::uint32_t GetContainerArrayLayers(std::uint64_t numLayers, std::uint64_t numFaces)
+{
+    const auto numArrayLayers = numLayers * numFaces;
+    if (numArrayLayers == 0 || numArrayLayers > g_maxArrayLayers)
+        throw std::runtime_error("invalid number of array layers in texture container: " + std::to_string(numArrayLayers));
+    return static_cast<std::uint32_t>(numArrayLayers);
+}
+
+
+/*
+ * TextureContainer class
+ */
+
+TextureContainer::TextureContainer(std::unique_ptr<Blob>&& blob) :
+    blob_ { std::move(blob) }
+{
+    if (!blob_)
+        throw std::invalid_argument("cannot create texture container from null pointer blob");
+
+    /* Determine container format by file identifier */
+    if (blob_->GetSize() >= sizeof(g_ktx2Identifier) && ::memcmp(blob_->GetData(), g_ktx2Identifier, sizeof(g_ktx2Identifier)) == 0)
+        ParseKTX2();
+    else
+        ParseDDS();
+}
+
+std::unique_ptr<TextureContainer> TextureContainer::LoadFromFile(const std::string& filename)
+{
+    auto blob = Blob::CreateMapped(filename, BlobMappingFlags::Sequential);
+    if (!blob)
+        throw std::runtime_error("failed to open texture container file: " + filename);
+    return MakeUnique<TextureContainer>(std::move(blob));
+}
+
+SrcImageDescriptor TextureContainer::GetSubresourceImage(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
+{
+    const auto& subresource = GetSubresource(mipLevel, arrayLayer);
+    SrcImageDescriptor imageDesc = imageDesc_;
+    {
+        imageDesc.data      = subresource.data;
+        imageDesc.dataSize  = subresource.size;
+    }
+    return imageDesc;
+}
+
+TextureRegion TextureContainer::GetSubresourceRegion(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
+{
+    GetSubresource(mipLevel, arrayLayer);
+
+    const auto& extent = textureDesc_.extent;
+    return TextureRegion
+    {
+        TextureSubresource{ arrayLayer, mipLevel },
+        Offset3D{},
+        Extent3D{ MipExtent(extent.width, mipLevel), MipExtent(extent.height, mipLevel), MipExtent(extent.depth, mipLevel) }
+    };
+}
+
+void TextureContainer::WriteTexture(RenderSystem& renderSystem, Texture& texture) const
+{
+    const auto numLayers = textureDesc_.arrayLayers;
+
+    for (std::uint32_t mipLevel = 0; mipLevel < textureDesc_.mipLevels; ++mipLevel)
+    {
+        /* Write all array layers at once if they are stored consecutively */
+        bool consecutiveLayers = true;
+        for (std::uint32_t arrayLayer = 1; arrayLayer < numLayers && consecutiveLayers; ++arrayLayer)
+        {
+            const auto& prev = GetSubresource(mipLevel, arrayLayer - 1);
+            const auto& next = GetSubresource(mipLevel, arrayLayer);
+            consecutiveLayers = (reinterpret_cast<const std::uint8_t*>(prev.data) + prev.size == next.data);
+        }
+
+        if (consecutiveLayers)
+        {
+            auto region = GetSubresourceRegion(mipLevel);
+            region.subresource.numArrayLayers = numLayers;
+
+            auto imageDesc = GetSubresourceImage(mipLevel);
+            imageDesc.dataSize *= numLayers;
+
+            renderSystem.WriteTexture(texture, region, imageDesc);
+        }
+        else
+        {
+            for (std::uint32_t arrayLayer = 0; arrayLayer < numLayers; ++arrayLayer)
+                renderSystem.WriteTexture(texture, GetSubresourceRegion(mipLevel, arrayLayer), GetSubresourceImage(mipLevel, arrayLayer));
+        }
+    }
+}
+
+Texture* TextureContainer::CreateTexture(RenderSystem& renderSystem) const
+{
+    auto texture = renderSystem.CreateTexture(textureDesc_);
+    WriteTexture(renderSystem, *texture);
+    return texture;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void TextureContainer::ParseDDS()
+{
+    containerFormat_ = TextureContainerFormat::DDS;
+
+    /* Read magic number and headers */
+    std::uint32_t magic = 0;
+    ReadContainerValue(*blob_, 0, magic);
+    if (magic != g_ddsMagic)
+        throw std::runtime_error("invalid identifier in texture container (expected DDS or KTX2 file)");
+
+    DDSHeader header;
+    ReadContainerValue(*blob_, sizeof(magic), header);
+    if (header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat))
+        throw std::runtime_error("invalid header size in DDS file");
+
+    std::size_t dataOffset = sizeof(magic) + sizeof(header);
+
+    auto& desc = textureDesc_;
+    desc.extent.width   = std::max(1u, header.width);
+    desc.extent.height  = std::max(1u, header.height);
+    desc.extent.depth   = 1;
+    desc.arrayLayers    = 1;
+    desc.mipLevels      = std::max(1u, header.mipMapCount);
+
+    if ((header.pixelFormat.flags & DDPF_FOURCC) != 0 && header.pixelFormat.fourCC == MakeFourCC('D', 'X', '1', '0'))
+    {
+        /* Read DX10 header extension */
+        DDSHeaderDX10 headerDX10;
+        ReadContainerValue(*blob_, dataOffset, headerDX10);
+        dataOffset += sizeof(headerDX10);
+
+        desc.format = MapDXGIFormat(headerDX10.dxgiFormat);
+        if (desc.format == Format::Undefined)
+            throw std::runtime_error("unsupported DXGI_FORMAT in DDS file: " + std::to_string(headerDX10.dxgiFormat));
+
+        const std::uint32_t arraySize = std::max(1u, headerDX10.arraySize);
+
+        switch (headerDX10.resourceDimension)
+        {
+            case DDS_DIMENSION_TEXTURE1D:
+                desc.type           = (arraySize > 1 ? TextureType::Texture1DArray : TextureType::Texture1D);
+                desc.extent.height  = 1;
+                desc.arrayLayers    = GetContainerArrayLayers(arraySize, 1);
+                break;
+
+            case DDS_DIMENSION_TEXTURE2D:
+                if ((headerDX10.miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0)
+                {
+                    desc.type           = (arraySize > 1 ? TextureType::TextureCubeArray : TextureType::TextureCube);
+                    desc.arrayLayers    = GetContainerArrayLayers(arraySize, 6);
+                }
+                else
+                {
+                    desc.type           = (arraySize > 1 ? TextureType::Texture2DArray : TextureType::Texture2D);
+                    desc.arrayLayers    = GetContainerArrayLayers(arraySize, 1);
+                }
+                break;
+
+            case DDS_DIMENSION_TEXTURE3D:
+                desc.type           = TextureType::Texture3D;
+                desc.extent.depth   = std::max(1u, header.depth);
+                break;
+
+            default:
+                throw std::runtime_error("invalid resource dimension in DDS file: " + std::to_string(headerDX10.resourceDimension));
+        }
+    }
+    else
+    {
+        desc.format = MapDDSPixelFormat(header.pixelFormat);
+        if (desc.format == Format::Undefined)
+            throw std::runtime_error("unsupported pixel format in DDS file");
+
+        if ((header.caps2 & DDSCAPS2_CUBEMAP) != 0)
+        {
+            /* Partial cube maps cannot be represented by a cube texture */
+            if ((header.caps2 & DDSCAPS2_CUBEMAP_ALL) != DDSCAPS2_CUBEMAP_ALL)
+                throw std::runtime_error("DDS file with partial cube map is not supported");
+            desc.type           = TextureType::TextureCube;
+            desc.arrayLayers    = 6;
+        }
+        else if ((header.caps2 & DDSCAPS2_VOLUME) != 0 && (header.flags & DDSD_DEPTH) != 0)
+        {
+            desc.type           = TextureType::Texture3D;
+            desc.extent.depth   = std::max(1u, header.depth);
+        }
+        else
+            desc.type = TextureType::Texture2D;
+    }
+
+    desc.bindFlags  = BindFlags::Sampled;
+    desc.miscFlags  = MiscFlags::NoInitialData;
+
+    const auto& formatAttribs = GetFormatAttribs(desc.format);
+    imageDesc_.format   = formatAttribs.format;
+    imageDesc_.dataType = formatAttribs.dataType;
+
+    /* DDS files store the entire MIP-map chain of each array layer consecutively */
+    AllocSubresources();
+
+    for (std::uint32_t arrayLayer = 0; arrayLayer < desc.arrayLayers; ++arrayLayer)
+    {
+        for (std::uint32_t mipLevel = 0; mipLevel < desc.mipLevels; ++mipLevel)
+        {
+            const auto layerSize = GetLayerSize(mipLevel);
+            SetSubresource(mipLevel, arrayLayer, dataOffset, layerSize);
+            dataOffset += layerSize;
+        }
+    }
+}
+
+void TextureContainer::ParseKTX2()
+{
+    containerFormat_ = TextureContainerFormat::KTX2;
+
+    /* Read header */
+    KTX2Header header;
+    ReadContainerValue(*blob_, 0, header);
+
+    if (header.supercompressionScheme != 0)
+        throw std::runtime_error("KTX2 file with supercompression is not supported: scheme " + std::to_string(header.supercompressionScheme));
+    if (header.pixelWidth == 0 || (header.faceCount != 1 && header.faceCount != 6))
+        throw std::runtime_error("invalid dimensions in KTX2 file");
+
+    auto& desc = textureDesc_;
+    desc.format = MapVkFormat(header.vkFormat);
+    if (desc.format == Format::Undefined)
+        throw std::runtime_error("unsupported VkFormat in KTX2 file: " + std::to_string(header.vkFormat));
+
+    desc.extent.width   = header.pixelWidth;
+    desc.extent.height  = std::max(1u, header.pixelHeight);
+    desc.extent.depth   = std::max(1u, header.pixelDepth);
+    desc.arrayLayers    = GetContainerArrayLayers(std::max(1u, header.layerCount), header.faceCount);
+    desc.mipLevels      = std::max(1u, header.levelCount);
+
+    if (header.faceCount == 6)
+        desc.type = (header.layerCount > 0 ? TextureType::TextureCubeArray : TextureType::TextureCube);
+    else if (header.pixelDepth > 0)
+        desc.type = TextureType::Texture3D;
+    else if (header.pixelHeight > 0)
+        desc.type = (header.layerCount > 0 ? TextureType::Texture2DArray : TextureType::Texture2D);
+    else
+        desc.type = (header.layerCount > 0 ? TextureType::Texture1DArray : TextureType::Texture1D);
+
+    desc.bindFlags  = BindFlags::Sampled;
+    desc.miscFlags  = MiscFlags::NoInitialData;
+
+    const auto& formatAttribs = GetFormatAttribs(desc.format);
+    imageDesc_.format   = formatAttribs.format;
+    imageDesc_.dataType = formatAttribs.dataType;
+
+    /* KTX2 files store all array layers and cube faces of each MIP-map level consecutively */
+    AllocSubresources();
+
+    for (std::uint32_t mipLevel = 0; mipLevel < desc.mipLevels; ++mipLevel)
+    {
+        KTX2LevelIndex levelIndex;
+        ReadContainerValue(*blob_, sizeof(header) + mipLevel * sizeof(levelIndex), levelIndex);
+
+        const auto layerSize = GetLayerSize(mipLevel);
+        if (levelIndex.byteLength != MulContainerSize(layerSize, desc.arrayLayers) || levelIndex.byteOffset > blob_->GetSize())
+            throw std::runtime_error("invalid level index in KTX2 file");
+
+        for (std::uint32_t arrayLayer = 0; arrayLayer < desc.arrayLayers; ++arrayLayer)
+            SetSubresource(mipLevel, arrayLayer, static_cast<std::size_t>(levelIndex.byteOffset) + MulContainerSize(arrayLayer, layerSize), layerSize);
+    }
+}
+
+std::size_t TextureContainer::GetLayerSize(std::uint32_t mipLevel) const
+{
+    const auto& formatAttribs = GetFormatAttribs(textureDesc_.format);
+    const auto& extent = textureDesc_.extent;
+
+    const std::size_t numBlocksX = (MipExtent(extent.width,  mipLevel) + formatAttribs.blockWidth  - 1) / formatAttribs.blockWidth;
+    const std::size_t numBlocksY = (MipExtent(extent.height, mipLevel) + formatAttribs.blockHeight - 1) / formatAttribs.blockHeight;
+    const std::size_t numSlices  = MipExtent(extent.depth, mipLevel);
+
+    const auto numBlocks = MulContainerSize(MulContainerSize(numBlocksX, numBlocksY), numSlices);
+    return (MulContainerSize(numBlocks, formatAttribs.bitSize) / 8);
+}
+
+void TextureContainer::AllocSubresources()
+{
+    const auto& desc = textureDesc_;
+
+    /* Reject more MIP-map levels than the full MIP-map chain of the texture extent */
+    if (desc.mipLevels > NumMipLevels(desc.extent.width, desc.extent.height, desc.extent.depth))
+        throw std::runtime_error("invalid number of MIP-map levels in texture container: " + std::to_string(desc.mipLevels));
+
+    /* Each subresource takes at least one byte, so a valid container cannot have more subresources than bytes */
+    const auto numSubresources = MulContainerSize(desc.mipLevels, desc.arrayLayers);
+    if (numSubresources > blob_->GetSize())
+        throw std::runtime_error("unexpected end of texture container");
+
+    subresources_.resize(numSubresources);
+}
+
+void TextureContainer::SetSubresource(std::uint32_t mipLevel, std::uint32_t arrayLayer, std::size_t offset, std::size_t size)
+{
+    if (offset > blob_->GetSize() || blob_->GetSize() - offset < size)
+        throw std::runtime_error("unexpected end of texture container");
+
+    auto& subresource = subresources_[static_cast<std::size_t>(mipLevel) * textureDesc_.arrayLayers + arrayLayer];
+    subresource.data = reinterpret_cast<const std::uint8_t*>(blob_->GetData()) + offset;
+    subresource.size = size;
+}
+
+const TextureContainer::SubresourceView& TextureContainer::GetSubresource(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
+{
+    if (mipLevel >= textureDesc_.mipLevels || arrayLayer >= textureDesc_.arrayLayers)
+        throw std::out_of_range("texture container subresource out of range");
+    return subresources_[static_cast<std::size_t>(mipLevel) * textureDesc_.arrayLayers + arrayLayer];
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
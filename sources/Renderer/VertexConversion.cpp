@@ -0,0 +1,441 @@
+/*
+ * VertexConversion.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/VertexConversion.h>
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include "../Core/Float16Compressor.h"
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Component encoders: Each encoder writes the (already transformed) components 'v' into 'dst' and returns the decoded components in 'decoded'.
+
+struct Float32Encoder
+{
+    static void Encode(char* dst, const float* v, float* decoded, std::uint32_t n)
+    {
+        std::memcpy(dst, v, sizeof(float) * n);
+        std::copy(v, v + n, decoded);
+    }
+};
+
+struct Float16Encoder
+{
+    static void Encode(char* dst, const float* v, float* decoded, std::uint32_t n)
+    {
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const auto value = CompressFloat16(v[i]);
+            std::memcpy(dst + i * sizeof(value), &value, sizeof(value));
+            decoded[i] = DecompressFloat16(value);
+        }
+    }
+};
+
+// Rounds the value to the nearest integer within [minValue, maxValue]. NaN is mapped to zero, so the cast to int is always well-defined.
+static int RoundToInt(float value, float minValue, float maxValue)
+{
+    if (std::isnan(value))
+        return 0;
+    value = std::max(minValue, std::min(value, maxValue));
+    return static_cast<int>(value < 0.0f ? value - 0.5f : value + 0.5f);
+}
+
+template <typename T>
+struct UNormEncoder
+{
+    static void Encode(char* dst, const float* v, float* decoded, std::uint32_t n)
+    {
+        const float maxValue = static_cast<float>(std::numeric_limits<T>::max());
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const auto value = static_cast<T>(RoundToInt(v[i] * maxValue, 0.0f, maxValue));
+            std::memcpy(dst + i * sizeof(T), &value, sizeof(T));
+            decoded[i] = static_cast<float>(value) / maxValue;
+        }
+    }
+};
+
+template <typename T>
+struct SNormEncoder
+{
+    static void Encode(char* dst, const float* v, float* decoded, std::uint32_t n)
+    {
+        const float maxValue = static_cast<float>(std::numeric_limits<T>::max());
+        for (std::uint32_t i = 0; i < n; ++i)
+        {
+            const auto value = static_cast<T>(RoundToInt(v[i] * maxValue, -maxValue, maxValue));
+            std::memcpy(dst + i * sizeof(T), &value, sizeof(T));
+            decoded[i] = std::max(-1.0f, static_cast<float>(value) / maxValue);
+        }
+    }
+};
+
+struct RGB10A2UNormEncoder
+{
+    static void Encode(char* dst, const float* v, float* decoded, std::uint32_t /*n*/)
+    {
+        static const float maxValues[4] = { 1023.0f, 1023.0f, 1023.0f, 3.0f };
+        static const int   shifts[4]    = { 0, 10, 20, 30 };
+
+        std::uint32_t packed = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto value = static_cast<std::uint32_t>(RoundToInt(v[i] * maxValues[i], 0.0f, maxValues[i]));
+            packed |= (value << shifts[i]);
+            decoded[i] = static_cast<float>(value) / maxValues[i];
+        }
+        std::memcpy(dst, &packed, sizeof(packed));
+    }
+};
+
+// Per-attribute conversion state.
+struct AttributeConversion
+{
+    std::size_t                 srcOffset       = 0;
+    std::uint32_t               srcComponents   = 0;
+    std::size_t                 dstOffset       = 0;
+    std::uint32_t               dstComponents   = 0;
+    VertexAttributeEncoding     encoding        = VertexAttributeEncoding::Direct;
+    float                       invScale[4]     = { 1.0f, 1.0f, 1.0f, 1.0f };
+    VertexAttributeQuantization quantization;
+};
+
+
+/* ----- Internal functions ----- */
+
+[[noreturn]]
+static void ThrowVertexConversionError(const VertexAttribute& attrib, const char* reason)
+{
+    throw std::invalid_argument(
+        "cannot convert vertex attribute '" + attrib.name + "' (semantic index " + std::to_string(attrib.semanticIndex) + "): " + reason
+    );
+}
+
+static const VertexAttribute* FindSourceAttribute(const VertexFormat& srcFormat, const VertexAttribute& dstAttrib)
+{
+    for (const auto& attrib : srcFormat.attributes)
+    {
+        if (attrib.name == dstAttrib.name && attrib.semanticIndex == dstAttrib.semanticIndex)
+            return (&attrib);
+    }
+    return nullptr;
+}
+
+static bool IsUNormEncoding(const Format format)
+{
+    const auto& formatAttribs = GetFormatAttribs(format);
+    return ((formatAttribs.flags & (FormatFlags::IsNormalized | FormatFlags::IsUnsigned)) == (FormatFlags::IsNormalized | FormatFlags::IsUnsigned));
+}
+
+// Reads the source vertex components and fills the missing components with (0, 0, 0, 1).
+static void ReadSourceComponents(const char* src, std::uint32_t numComponents, float* v)
+{
+    v[0] = 0.0f;
+    v[1] = 0.0f;
+    v[2] = 0.0f;
+    v[3] = 1.0f;
+    std::memcpy(v, src, sizeof(float) * numComponents);
+}
+
+static float SignNotZero(float value)
+{
+    return (value >= 0.0f ? 1.0f : -1.0f);
+}
+
+// Encodes the normalized 3D vector 'v' as octahedral 2D vector in the range [-1, 1].
+static void EncodeOctahedral(const float* v, float* oct)
+{
+    const float sum = std::abs(v[0]) + std::abs(v[1]) + std::abs(v[2]);
+    if (sum > 0.0f)
+    {
+        const float x = v[0] / sum;
+        const float y = v[1] / sum;
+        if (v[2] < 0.0f)
+        {
+            oct[0] = (1.0f - std::abs(y)) * SignNotZero(x);
+            oct[1] = (1.0f - std::abs(x)) * SignNotZero(y);
+        }
+        else
+        {
+            oct[0] = x;
+            oct[1] = y;
+        }
+    }
+    else
+    {
+        oct[0] = 0.0f;
+        oct[1] = 0.0f;
+    }
+}
+
+// Decodes the octahedral 2D vector into a normalized 3D vector.
+static void DecodeOctahedral(const float* oct, float* v)
+{
+    v[0] = oct[0];
+    v[1] = oct[1];
+    v[2] = 1.0f - std::abs(oct[0]) - std::abs(oct[1]);
+    if (v[2] < 0.0f)
+    {
+        v[0] = (1.0f - std::abs(oct[1])) * SignNotZero(oct[0]);
+        v[1] = (1.0f - std::abs(oct[0])) * SignNotZero(oct[1]);
+    }
+    const float len = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+    v[0] /= len;
+    v[1] /= len;
+    v[2] /= len;
+}
+
+static bool NormalizeVector3(float* v)
+{
+    const float len = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+    if (len > 0.0f)
+    {
+        v[0] /= len;
+        v[1] /= len;
+        v[2] /= len;
+        return true;
+    }
+    return false;
+}
+
+// Determines scale and offset to map the bounding box of all source components into the range of the destination format.
+static void ComputeBoundsQuantization(
+    AttributeConversion&    conv,
+    const char*             srcData,
+    std::size_t             srcStride,
+    std::size_t             numVertices,
+    bool                    isUNorm)
+{
+    if (numVertices == 0)
+        return;
+
+    float minValues[4], maxValues[4], v[4];
+
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        minValues[i] = std::numeric_limits<float>::max();
+        maxValues[i] = std::numeric_limits<float>::lowest();
+    }
+
+    for (std::size_t vertex = 0; vertex < numVertices; ++vertex)
+    {
+        ReadSourceComponents(srcData + vertex * srcStride + conv.srcOffset, conv.srcComponents, v);
+        for (std::uint32_t i = 0; i < conv.dstComponents; ++i)
+        {
+            minValues[i] = std::min(minValues[i], v[i]);
+            maxValues[i] = std::max(maxValues[i], v[i]);
+        }
+    }
+
+    for (std::uint32_t i = 0; i < conv.dstComponents; ++i)
+    {
+        /* Map [min, max] to [0, 1] for UNorm formats and to [-1, 1] otherwise; a scale of zero decodes all vertices to the offset */
+        const float extent  = maxValues[i] - minValues[i];
+        const float scale   = (isUNorm ? extent : extent * 0.5f);
+        const float offset  = (isUNorm ? minValues[i] : minValues[i] + extent * 0.5f);
+
+        conv.quantization.scale[i]  = scale;
+        conv.quantization.offset[i] = offset;
+        conv.invScale[i]            = (scale > 0.0f ? 1.0f / scale : 0.0f);
+    }
+}
+
+// Converts all vertices of a single attribute. The encoder is a template parameter to keep the inner loop free of format switches.
+template <typename TEncoder>
+void ConvertAttribute(
+    AttributeConversion&    conv,
+    const char*             srcData,
+    std::size_t             srcStride,
+    char*                   dstData,
+    std::size_t             dstStride,
+    std::size_t             numVertices)
+{
+    const auto& q = conv.quantization;
+
+    float v[4], t[4], decoded[4], unpacked[3];
+    float maxError = 0.0f;
+
+    for (std::size_t vertex = 0; vertex < numVertices; ++vertex)
+    {
+        ReadSourceComponents(srcData + vertex * srcStride + conv.srcOffset, conv.srcComponents, v);
+
+        if (conv.encoding == VertexAttributeEncoding::Octahedral)
+        {
+            /* Encode normalized direction and remap into the range of the destination format */
+            const bool hasDirection = NormalizeVector3(v);
+            EncodeOctahedral(v, t);
+            t[0] = (t[0] - q.offset[0]) * conv.invScale[0];
+            t[1] = (t[1] - q.offset[1]) * conv.invScale[1];
+
+            TEncoder::Encode(dstData + vertex * dstStride + conv.dstOffset, t, decoded, 2);
+
+            if (hasDirection)
+            {
+                decoded[0] = decoded[0] * q.scale[0] + q.offset[0];
+                decoded[1] = decoded[1] * q.scale[1] + q.offset[1];
+                DecodeOctahedral(decoded, unpacked);
+                for (std::uint32_t i = 0; i < 3; ++i)
+                    maxError = std::max(maxError, std::abs(unpacked[i] - v[i]));
+            }
+        }
+        else
+        {
+            /* Transform components into the range of the destination format (identity for direct encoding) */
+            for (std::uint32_t i = 0; i < conv.dstComponents; ++i)
+                t[i] = (v[i] - q.offset[i]) * conv.invScale[i];
+
+            TEncoder::Encode(dstData + vertex * dstStride + conv.dstOffset, t, decoded, conv.dstComponents);
+
+            for (std::uint32_t i = 0; i < conv.dstComponents; ++i)
+                maxError = std::max(maxError, std::abs(decoded[i] * q.scale[i] + q.offset[i] - v[i]));
+        }
+    }
+
+    conv.quantization.maxError = maxError;
+}
+
+
+/* ----- Public functions ----- */
+
+LLGL_EXPORT VertexConversionReport ConvertVertexBuffer(
+    const VertexFormat&                         srcFormat,
+    const void*                                 srcData,
+    std::size_t                                 srcDataSize,
+    const VertexFormat&                         dstFormat,
+    void*                                       dstData,
+    std::size_t                                 dstDataSize,
+    const std::vector<VertexAttributeEncoding>& encodings)
+{
+    if (!encodings.empty() && encodings.size() != dstFormat.attributes.size())
+        throw std::invalid_argument("number of vertex attribute encodings does not match number of destination vertex attributes");
+
+    const std::size_t srcStride = srcFormat.GetStride();
+    const std::size_t dstStride = dstFormat.GetStride();
+
+    if (srcStride == 0 || dstStride == 0)
+        throw std::invalid_argument("cannot convert vertex buffer with vertex stride of zero");
+
+    VertexConversionReport report;
+    report.numVertices = srcDataSize / srcStride;
+
+    if (dstDataSize < report.numVertices * dstStride)
+    {
+        throw std::invalid_argument(
+            "destination vertex buffer too small: " + std::to_string(dstDataSize) + " byte(s) specified but " +
+            std::to_string(report.numVertices * dstStride) + " byte(s) required"
+        );
+    }
+
+    auto src = reinterpret_cast<const char*>(srcData);
+    auto dst = reinterpret_cast<char*>(dstData);
+
+    report.attributes.reserve(dstFormat.attributes.size());
+
+    for (std::size_t attribIndex = 0; attribIndex < dstFormat.attributes.size(); ++attribIndex)
+    {
+        const auto& dstAttrib = dstFormat.attributes[attribIndex];
+
+        /* Find and validate source attribute */
+        auto srcAttrib = FindSourceAttribute(srcFormat, dstAttrib);
+        if (srcAttrib == nullptr)
+            ThrowVertexConversionError(dstAttrib, "no source attribute with the same name and semantic index");
+
+        const auto& srcFormatAttribs = GetFormatAttribs(srcAttrib->format);
+        if (srcFormatAttribs.dataType != DataType::Float32 || (srcFormatAttribs.flags & FormatFlags::IsPacked) != 0)
+            ThrowVertexConversionError(dstAttrib, "source attribute must have a 32-bit floating-point format");
+
+        const auto& dstFormatAttribs = GetFormatAttribs(dstAttrib.format);
+
+        AttributeConversion conv;
+        {
+            conv.srcOffset      = srcAttrib->offset;
+            conv.srcComponents  = std::min<std::uint32_t>(srcFormatAttribs.components, 4u);
+            conv.dstOffset      = dstAttrib.offset;
+            conv.dstComponents  = std::min<std::uint32_t>(dstFormatAttribs.components, 4u);
+            conv.encoding       = (encodings.empty() ? VertexAttributeEncoding::Direct : encodings[attribIndex]);
+        }
+
+        if (conv.srcOffset + conv.srcComponents * sizeof(float) > srcStride)
+            ThrowVertexConversionError(dstAttrib, "source attribute exceeds vertex stride");
+        if (conv.dstOffset + dstFormatAttribs.bitSize / 8 > dstStride)
+            ThrowVertexConversionError(dstAttrib, "destination attribute exceeds vertex stride");
+
+        /* Determine quantization parameters */
+        const bool isUNorm = IsUNormEncoding(dstAttrib.format);
+
+        switch (conv.encoding)
+        {
+            case VertexAttributeEncoding::Direct:
+                break;
+
+            case VertexAttributeEncoding::Bounds:
+                ComputeBoundsQuantization(conv, src, srcStride, report.numVertices, isUNorm);
+                break;
+
+            case VertexAttributeEncoding::Octahedral:
+                if (conv.dstComponents != 2)
+                    ThrowVertexConversionError(dstAttrib, "octahedral encoding requires a destination format with two components");
+                if (isUNorm)
+                {
+                    /* Map octahedral range [-1, 1] to [0, 1] */
+                    for (std::uint32_t i = 0; i < 2; ++i)
+                    {
+                        conv.quantization.scale[i]  = 2.0f;
+                        conv.quantization.offset[i] = -1.0f;
+                        conv.invScale[i]            = 0.5f;
+                    }
+                }
+                break;
+        }
+
+        /* Convert attribute with encoder for destination format */
+        const bool isNormalized = ((dstFormatAttribs.flags & FormatFlags::IsNormalized) != 0);
+        const bool isUnsupported = ((dstFormatAttribs.flags & (FormatFlags::HasDepth | FormatFlags::HasStencil | FormatFlags::IsCompressed)) != 0);
+
+        if (dstAttrib.format == Format::RGB10A2UNorm)
+            ConvertAttribute<RGB10A2UNormEncoder>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (isUnsupported || (dstFormatAttribs.flags & FormatFlags::IsPacked) != 0)
+            ThrowVertexConversionError(dstAttrib, "unsupported destination format");
+        else if (dstFormatAttribs.dataType == DataType::Float32 && !isNormalized)
+            ConvertAttribute<Float32Encoder>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (dstFormatAttribs.dataType == DataType::Float16 && !isNormalized)
+            ConvertAttribute<Float16Encoder>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (dstFormatAttribs.dataType == DataType::UInt8 && isNormalized)
+            ConvertAttribute<UNormEncoder<std::uint8_t>>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (dstFormatAttribs.dataType == DataType::Int8 && isNormalized)
+            ConvertAttribute<SNormEncoder<std::int8_t>>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (dstFormatAttribs.dataType == DataType::UInt16 && isNormalized)
+            ConvertAttribute<UNormEncoder<std::uint16_t>>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else if (dstFormatAttribs.dataType == DataType::Int16 && isNormalized)
+            ConvertAttribute<SNormEncoder<std::int16_t>>(conv, src, srcStride, dst, dstStride, report.numVertices);
+        else
+            ThrowVertexConversionError(dstAttrib, "unsupported destination format");
+
+        report.attributes.push_back(conv.quantization);
+    }
+
+    return report;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -10,6 +10,7 @@
 #include "../VKTypes.h"
 #include "../Ext/VKExtensions.h"
 #include "../Ext/VKExtensionRegistry.h"
+#include "../../BufferUtils.h"
 
 
 namespace LLGL
@@ -51,11 +52,13 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
     return flags;
 }
 
-VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc) :
-    Buffer            { desc.bindFlags },
-    bufferObj_        { device         },
-    bufferObjStaging_ { device         },
-    size_             { desc.size      }
+VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc, const std::vector<std::uint32_t>& sharedQueueFamilies) :
+    Buffer            { desc.bindFlags         },
+    bufferObj_        { device                 },
+    bufferObjStaging_ { device                 },
+    size_             { desc.size              },
+    cpuAccessFlags_   { desc.cpuAccessFlags    },
+    hostVisible_      { IsReadbackBuffer(desc) }
 {
     if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
         indexType_ = VKTypes::ToVkIndexType(desc.format);
@@ -67,9 +70,18 @@ VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc)
         createInfo.flags                    = 0;
         createInfo.size                     = desc.size;
         createInfo.usage                    = GetVkBufferUsageFlags(desc);
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+        if (sharedQueueFamilies.size() > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies.size());
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.data();
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
     }
     bufferObj_.CreateVkBuffer(device, createInfo);
 }
@@ -80,8 +92,8 @@ BufferDescriptor VKBuffer::GetDesc() const
 
     bufferDesc.size             = GetSize();
     bufferDesc.bindFlags        = GetBindFlags();
+    bufferDesc.cpuAccessFlags   = cpuAccessFlags_;
     #if 0//TODO
-    bufferDesc.cpuAccessFlags   = 0;
     bufferDesc.miscFlags        = 0;
     #endif
 
@@ -101,12 +113,18 @@ void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
 void* VKBuffer::Map(VkDevice device, const CPUAccess access)
 {
     mappedCPUAccess_ = access;
-    return bufferObjStaging_.Map(device);
+    if (hostVisible_)
+        return bufferObj_.Map(device);
+    else
+        return bufferObjStaging_.Map(device);
 }
 
 void VKBuffer::Unmap(VkDevice device)
 {
-    bufferObjStaging_.Unmap(device);
+    if (hostVisible_)
+        bufferObj_.Unmap(device);
+    else
+        bufferObjStaging_.Unmap(device);
 }
 
 
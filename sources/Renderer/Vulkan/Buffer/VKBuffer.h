@@ -12,6 +12,7 @@
 #include <LLGL/Buffer.h>
 #include "VKDeviceBuffer.h"
 #include "../Memory/VKDeviceMemory.h"
+#include <vector>
 
 
 namespace LLGL
@@ -27,7 +28,8 @@ class VKBuffer : public Buffer
 
     public:
 
-        VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc);
+        // Creates the buffer with concurrent sharing mode if 'sharedQueueFamilies' contains more than one queue family.
+        VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc, const std::vector<std::uint32_t>& sharedQueueFamilies = {});
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
         void TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer);
@@ -71,6 +73,12 @@ class VKBuffer : public Buffer
             return mappedCPUAccess_;
         }
 
+        // Returns true if the device buffer is allocated in host visible memory and is mapped directly, i.e. without staging buffer.
+        inline bool IsHostVisible() const
+        {
+            return hostVisible_;
+        }
+
         // Returns the VkIndexType specified at creation time.
         inline VkIndexType GetIndexType() const
         {
@@ -83,7 +91,9 @@ class VKBuffer : public Buffer
         VKDeviceBuffer  bufferObjStaging_;
 
         VkDeviceSize    size_               = 0;
+        long            cpuAccessFlags_     = 0;
         CPUAccess       mappedCPUAccess_    = CPUAccess::ReadOnly;
+        bool            hostVisible_        = false;
 
         VkIndexType     indexType_          = VK_INDEX_TYPE_MAX_ENUM;
 
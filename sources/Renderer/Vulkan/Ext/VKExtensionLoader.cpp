@@ -107,6 +107,18 @@ static bool Load_VK_KHR_get_physical_device_properties2(VkDevice handle)
     return true;
 }
 
+#ifdef VK_KHR_timeline_semaphore
+
+static bool Load_VK_KHR_timeline_semaphore(VkDevice handle)
+{
+    LOAD_VKPROC( vkGetSemaphoreCounterValueKHR );
+    LOAD_VKPROC( vkWaitSemaphoresKHR           );
+    LOAD_VKPROC( vkSignalSemaphoreKHR          );
+    return true;
+}
+
+#endif
+
 #undef LOAD_VKPROC
 
 
@@ -180,6 +192,10 @@ bool VKLoadDeviceExtensions(VkDevice device, const std::vector<const char*>& sup
     LOAD_VKEXT( EXT_conditional_rendering           );
     LOAD_VKEXT( EXT_transform_feedback              );
 
+    #ifdef VK_KHR_timeline_semaphore
+    LOAD_VKEXT( KHR_timeline_semaphore              );
+    #endif
+
     ENABLE_VKEXT( EXT_conservative_rasterization );
 
     #undef LOAD_VKEXT
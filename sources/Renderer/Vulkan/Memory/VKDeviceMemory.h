@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #ifdef LLGL_DEBUG
 #   include <ostream>
@@ -46,10 +47,14 @@ class VKDeviceMemory
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
 
-        VKDeviceMemory(VKDeviceMemory&&) = default;
-        VKDeviceMemory& operator = (VKDeviceMemory&&) = default;
-
+        /*
+        Maps the specified range of this device memory chunk into CPU memory space.
+        The entire chunk is mapped only once and reference counted, because a VkDeviceMemory object must not be mapped twice,
+        but multiple buffers within the same chunk can be mapped from different threads.
+        */
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
+
+        // Releases one mapping reference and unmaps the chunk when the last reference is released.
         void Unmap(VkDevice device);
 
         // Tries to allocate a new block within this device memory chunk, and returns null of failure.
@@ -137,6 +142,10 @@ class VKDeviceMemory
         VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
         std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
 
+        std::mutex                                          mapMutex_;
+        void*                                               mappedData_             = nullptr;
+        std::uint32_t                                       mapCount_               = 0;
+
 };
 
 
@@ -37,6 +37,8 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
     const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
+    std::lock_guard<std::mutex> guard { chunks_[memoryTypeIndex].mutex };
+
     if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
         return chunk->Allocate(size, alignment);
     else
@@ -61,6 +63,9 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
     {
         if (auto chunk = region->GetParentChunk())
         {
+            auto& memoryType = chunks_[chunk->GetMemoryTypeIndex()];
+            std::lock_guard<std::mutex> guard { memoryType.mutex };
+
             /* Release block in chunk */
             chunk->Release(region);
 
@@ -68,7 +73,7 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
             if (chunk->IsEmpty())
             {
                 RemoveFromListIf(
-                    chunks_,
+                    memoryType.chunks,
                     [chunk](std::unique_ptr<VKDeviceMemory>& entry)
                     {
                         return (entry.get() == chunk);
@@ -82,8 +87,10 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
 VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 {
     VKDeviceMemoryDetails details;
+    for (const auto& memoryType : chunks_)
     {
-        for (const auto& chunk : chunks_)
+        std::lock_guard<std::mutex> guard { memoryType.mutex };
+        for (const auto& chunk : memoryType.chunks)
             chunk->AccumDetails(details);
     }
     return details;
@@ -94,24 +101,28 @@ VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
 {
     std::size_t i = 0;
-    for (const auto& chunk : chunks_)
+    for (const auto& memoryType : chunks_)
     {
-        s << "chunk[" << (i++) << "]:";
+        std::lock_guard<std::mutex> guard { memoryType.mutex };
+        for (const auto& chunk : memoryType.chunks)
+        {
+            s << "chunk[" << (i++) << "]:";
 
-        if (!title.empty())
-            s << " \"" << title << '\"';
+            if (!title.empty())
+                s << " \"" << title << '\"';
 
-        s << '\n';
-        s << "  size             = " << chunk->GetSize() << '\n';
-        s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
+            s << '\n';
+            s << "  size             = " << chunk->GetSize() << '\n';
+            s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
 
-        s << "  blocks           = ";
-        chunk->PrintBlocks(s);
-        s << '\n';
+            s << "  blocks           = ";
+            chunk->PrintBlocks(s);
+            s << '\n';
 
-        s << "  fragmentedBlocks = ";
-        chunk->PrintFragmentedBlocks(s);
-        s << '\n';
+            s << "  fragmentedBlocks = ";
+            chunk->PrintFragmentedBlocks(s);
+            s << '\n';
+        }
     }
 }
 
@@ -129,15 +140,15 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
 
 VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    return TakeOwnership(chunks_[memoryTypeIndex].chunks, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
 }
 
 VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
+    /* Search for a suitable chunk of the same memory type */
+    for (const auto& chunk : chunks_[memoryTypeIndex].chunks)
     {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
+        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize)
             return chunk.get();
     }
 
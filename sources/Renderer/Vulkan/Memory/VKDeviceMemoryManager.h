@@ -16,6 +16,7 @@
 #include "VKDeviceMemoryRegion.h"
 #include <vector>
 #include <memory>
+#include <mutex>
 
 
 namespace LLGL
@@ -27,6 +28,8 @@ Vulkan device memory manager. Memory allocations are stored in a small hierarchy
  - Chunk: denotes a single Vulkan memory allocation of type VkDeviceMemory
  - Block: denotes one of multiple regions inside a chunk of type VkBuffer
  - Region: denotes a sub-range inside a block and holds a reference to the VkBuffer and its offset and size (both of type VkDeviceSize).
+Allocate and Release can be called from multiple threads. The chunks are lock-striped by their memory type,
+so only allocations of the same memory type (e.g. two staging buffers) are serialized.
 */
 class VKDeviceMemoryManager
 {
@@ -80,12 +83,21 @@ class VKDeviceMemoryManager
         // Finds a memory type index for the specified attributes.
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
-        // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
+        // Allocates a new VkDeviceMemory chunk of the specified size and memory type. The lock of that memory type must be held.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
+        // Finds a suitable device memory chunk or allocates a new one. The lock of that memory type must be held.
         VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
 
+    private:
+
+        // List of chunks of a single memory type with its own lock.
+        struct MemoryTypeChunks
+        {
+            mutable std::mutex                              mutex;
+            std::vector<std::unique_ptr<VKDeviceMemory>>    chunks;
+        };
+
     private:
 
         const VKPtr<VkDevice>&                          device_;
@@ -94,7 +106,7 @@ class VKDeviceMemoryManager
         VkDeviceSize                                    minAllocationSize_      = 1024*1024;
         bool                                            reduceFragmentation_    = false;
 
-        std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        MemoryTypeChunks                                chunks_[VK_MAX_MEMORY_TYPES];
 
 };
 
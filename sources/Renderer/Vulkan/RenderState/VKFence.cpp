@@ -7,15 +7,42 @@
 
 #include "VKFence.h"
 #include "../VKCore.h"
+#include "../Ext/VKExtensions.h"
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
 {
 
 
-VKFence::VKFence(const VKPtr<VkDevice>& device) :
-    fence_ { device, vkDestroyFence }
+VKFence::VKFence(const VKPtr<VkDevice>& device, bool timeline) :
+    fence_     { device, vkDestroyFence     },
+    semaphore_ { device, vkDestroySemaphore }
 {
+    #ifdef VK_KHR_timeline_semaphore
+    if (timeline)
+    {
+        /* Create timeline semaphore with initial value of zero */
+        VkSemaphoreTypeCreateInfoKHR typeCreateInfo;
+        {
+            typeCreateInfo.sType            = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            typeCreateInfo.pNext            = nullptr;
+            typeCreateInfo.semaphoreType    = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            typeCreateInfo.initialValue     = 0;
+        }
+        VkSemaphoreCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext = &typeCreateInfo;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateSemaphore(device, &createInfo, nullptr, semaphore_.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan timeline semaphore");
+        return;
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
     VkFenceCreateInfo createInfo;
     {
         createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
@@ -28,14 +55,59 @@ VKFence::VKFence(const VKPtr<VkDevice>& device) :
 
 void VKFence::Reset(VkDevice device)
 {
-    vkResetFences(device, 1, &fence_);
+    /* Timeline semaphores are never reset, their value only increases */
+    if (!IsTimeline())
+        vkResetFences(device, 1, &fence_);
 }
 
 bool VKFence::Wait(VkDevice device, std::uint64_t timeout)
 {
+    if (IsTimeline())
+        return WaitValue(device, signalValue_, timeout);
+    else
+        return (vkWaitForFences(device, 1, &fence_, VK_TRUE, timeout) == VK_SUCCESS);
+}
+
+bool VKFence::WaitValue(VkDevice device, std::uint64_t value, std::uint64_t timeout)
+{
+    #ifdef VK_KHR_timeline_semaphore
+    if (IsTimeline())
+    {
+        VkSemaphoreWaitInfoKHR waitInfo;
+        {
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext          = nullptr;
+            waitInfo.flags          = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &semaphore_;
+            waitInfo.pValues        = &value;
+        }
+        return (vkWaitSemaphoresKHR(device, &waitInfo, timeout) == VK_SUCCESS);
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
     return (vkWaitForFences(device, 1, &fence_, VK_TRUE, timeout) == VK_SUCCESS);
 }
 
+std::uint64_t VKFence::NextSignalValue()
+{
+    return ++signalValue_;
+}
+
+std::uint64_t VKFence::AdvanceSignalValue(std::uint64_t value)
+{
+    /* Timeline semaphores must be signaled with strictly increasing values */
+    if (value <= signalValue_)
+    {
+        throw std::invalid_argument(
+            "cannot signal fence with value " + std::to_string(value) +
+            " (must be greater than previous signal value " + std::to_string(signalValue_) + ")"
+        );
+    }
+    signalValue_ = value;
+    return signalValue_;
+}
+
 
 } // /namespace LLGL
 
@@ -23,20 +23,44 @@ class VKFence final : public Fence
 
     public:
 
-        VKFence(const VKPtr<VkDevice>& device);
+        // Creates a binary fence, or a timeline semaphore if 'timeline' is true (requires VK_KHR_timeline_semaphore).
+        VKFence(const VKPtr<VkDevice>& device, bool timeline = false);
 
         void Reset(VkDevice device);
         bool Wait(VkDevice device, std::uint64_t timeout);
 
-        // Returns the native VkFence handle.
+        // Waits until the timeline semaphore has reached the specified value. Binary fences ignore the value.
+        bool WaitValue(VkDevice device, std::uint64_t value, std::uint64_t timeout);
+
+        // Returns the next value to signal the timeline semaphore with, when the fence is submitted without an explicit value.
+        std::uint64_t NextSignalValue();
+
+        // Advances the signal value to the specified value. Throws std::invalid_argument if the value is not greater than the current signal value.
+        std::uint64_t AdvanceSignalValue(std::uint64_t value);
+
+        // Returns the native VkFence handle, or VK_NULL_HANDLE if this fence is a timeline semaphore.
         inline VkFence GetVkFence() const
         {
             return fence_;
         }
 
+        // Returns the native VkSemaphore handle of the timeline semaphore, or VK_NULL_HANDLE if this fence is a binary fence.
+        inline VkSemaphore GetVkSemaphore() const
+        {
+            return semaphore_;
+        }
+
+        // Returns true if this fence is a timeline semaphore.
+        inline bool IsTimeline() const
+        {
+            return (semaphore_.Get() != VK_NULL_HANDLE);
+        }
+
     private:
 
-        VKPtr<VkFence> fence_;
+        VKPtr<VkFence>      fence_;
+        VKPtr<VkSemaphore>  semaphore_;
+        std::uint64_t       signalValue_    = 0;
 
 };
 
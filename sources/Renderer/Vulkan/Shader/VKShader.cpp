@@ -6,11 +6,14 @@
  */
 
 #include "VKShader.h"
+#include "VKShaderReflectionCache.h"
 #include "../VKCore.h"
 #include "../VKTypes.h"
 #include "../../../Core/Helper.h"
+#include "../../../Core/HashUtils.h"
 #include <LLGL/ShaderProgramFlags.h>
 #include <LLGL/Strings.h>
+#include <algorithm>
 
 #ifdef LLGL_ENABLE_SPIRV_REFLECT
 #   include "../../SPIRV/SPIRVReflect.h"
@@ -22,13 +25,28 @@ namespace LLGL
 {
 
 
-VKShader::VKShader(const VKPtr<VkDevice>& device, const ShaderDescriptor& desc) :
-    Shader        { desc.type                     },
-    device_       { device                        },
-    shaderModule_ { device, vkDestroyShaderModule }
+VKShader::VKShader(const VKPtr<VkDevice>& device, const ShaderDescriptor& desc, VKShaderReflectionCache* reflectionCache) :
+    Shader           { desc.type                     },
+    device_          { device                        },
+    shaderModule_    { device, vkDestroyShaderModule },
+    reflectionCache_ { reflectionCache               }
 {
     BuildShader(desc);
     BuildInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
+    BuildSpecializationInfo(desc.specializationConstants);
+
+    /* Register shader module, so its cached reflection is kept until the last shader with the same module is released */
+    if (reflectionCache_ != nullptr)
+    {
+        reflectionKey_ = HashValue(GetType(), HashBytes(shaderModuleData_.data(), shaderModuleData_.size()));
+        reflectionCache_->Register(reflectionKey_);
+    }
+}
+
+VKShader::~VKShader()
+{
+    if (reflectionCache_ != nullptr)
+        reflectionCache_->Unregister(reflectionKey_);
 }
 
 bool VKShader::HasErrors() const
@@ -68,7 +86,7 @@ void VKShader::FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& create
     createInfo.stage                = VKTypes::Map(GetType());
     createInfo.module               = shaderModule_;
     createInfo.pName                = entryPoint_.c_str();
-    createInfo.pSpecializationInfo  = nullptr;
+    createInfo.pSpecializationInfo  = (specialization_.mapEntries.empty() ? nullptr : &(specialization_.info));
 }
 
 void VKShader::FillVertexInputStateCreateInfo(VkPipelineVertexInputStateCreateInfo& createInfo) const
@@ -322,16 +340,114 @@ static ShaderResource* FindOrAppendShaderResource(ShaderReflection& reflection,
     return &(reflection.resources.back());
 }
 
+// Returns true if the specified SPIR-V type can be used as specialization constant in LLGL, i.e. a 32-bit scalar type
+static bool SpvTypeToSpecializationConstantType(const SPIRVReflect::SpvType* type, SpecializationConstantType& outType)
+{
+    if (type != nullptr)
+    {
+        switch (type->opcode)
+        {
+            case spv::Op::OpTypeBool:
+                outType = SpecializationConstantType::Boolean;
+                return true;
+
+            case spv::Op::OpTypeInt:
+                if (type->size == 4)
+                {
+                    outType = (type->sign ? SpecializationConstantType::Int32 : SpecializationConstantType::UInt32);
+                    return true;
+                }
+                break;
+
+            case spv::Op::OpTypeFloat:
+                if (type->size == 4)
+                {
+                    outType = SpecializationConstantType::Float32;
+                    return true;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+// Merges the reflection of a single shader module into the reflection of a shader program
+static void MergeShaderReflection(ShaderReflection& dst, const ShaderReflection& src)
+{
+    /* Append input/output attributes */
+    dst.vertex.inputAttribs.insert(dst.vertex.inputAttribs.end(), src.vertex.inputAttribs.begin(), src.vertex.inputAttribs.end());
+    dst.vertex.outputAttribs.insert(dst.vertex.outputAttribs.end(), src.vertex.outputAttribs.begin(), src.vertex.outputAttribs.end());
+    dst.fragment.outputAttribs.insert(dst.fragment.outputAttribs.end(), src.fragment.outputAttribs.begin(), src.fragment.outputAttribs.end());
+
+    /* Append resources or only extend the stage flags if there already is a resource at the same binding slot */
+    for (const auto& srcResource : src.resources)
+    {
+        auto it = std::find_if(
+            dst.resources.begin(),
+            dst.resources.end(),
+            [&srcResource](const ShaderResource& dstResource)
+            {
+                return (dstResource.binding.slot == srcResource.binding.slot);
+            }
+        );
+        if (it != dst.resources.end())
+            it->binding.stageFlags |= srcResource.binding.stageFlags;
+        else
+            dst.resources.push_back(srcResource);
+    }
+
+    /* Append specialization constants that have not been declared by another shader of the same program */
+    for (const auto& srcConstant : src.specializationConstants)
+    {
+        auto it = std::find_if(
+            dst.specializationConstants.begin(),
+            dst.specializationConstants.end(),
+            [&srcConstant](const SpecializationConstant& dstConstant)
+            {
+                return (dstConstant.constantID == srcConstant.constantID);
+            }
+        );
+        if (it == dst.specializationConstants.end())
+            dst.specializationConstants.push_back(srcConstant);
+    }
+}
+
 bool VKShader::Reflect(ShaderReflection& reflection) const
+{
+    ShaderReflection moduleReflection;
+
+    if (reflectionCache_ != nullptr)
+    {
+        /* Reflect shader module only once for all shaders with the same module */
+        if (!reflectionCache_->Find(reflectionKey_, GetType(), shaderModuleData_, moduleReflection))
+        {
+            ReflectShaderModule(moduleReflection);
+            reflectionCache_->Store(reflectionKey_, GetType(), shaderModuleData_, moduleReflection);
+        }
+    }
+    else
+        ReflectShaderModule(moduleReflection);
+
+    MergeShaderReflection(reflection, moduleReflection);
+
+    return true;
+}
+
+void VKShader::ReflectShaderModule(ShaderReflection& reflection) const
 {
     /* Parse shader module */
     SPIRVReflect spvReflect;
     spvReflect.Parse(shaderModuleData_.data(), shaderModuleData_.size());
 
     /* Gather input/output attributes */
-    for (const auto& it : spvReflect.GetVaryings())
+    for (const auto& var : spvReflect.GetVaryings())
     {
-        const auto& var = it.second;
+        if (var.id == 0)
+            continue;
+
         if (GetType() == ShaderType::Vertex)
         {
             std::uint32_t numVectors = 1;
@@ -370,14 +486,30 @@ bool VKShader::Reflect(ShaderReflection& reflection) const
     }
 
     /* Gather resources */
-    for (const auto& it : spvReflect.GetUniforms())
+    for (const auto& var : spvReflect.GetUniforms())
     {
-        const auto& var = it.second;
+        if (var.id == 0)
+            continue;
+
         if (auto resource = FindOrAppendShaderResource(reflection, var))
             resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
     }
 
-    return true;
+    /* Gather specialization constants with their default values */
+    for (const auto& constant : spvReflect.GetSpecConstants())
+    {
+        /* Skip unused entries and constants without a SpecId decoration, since they cannot be specialized */
+        if (constant.id == 0 || !constant.hasSpecId)
+            continue;
+
+        SpecializationConstant specConstant;
+        if (SpvTypeToSpecializationConstantType(constant.type, specConstant.type))
+        {
+            specConstant.constantID = constant.constantID;
+            specConstant.u32        = constant.value;
+            reflection.specializationConstants.push_back(specConstant);
+        }
+    }
 }
 
 bool VKShader::ReflectLocalSize(Extent3D& localSize) const
@@ -480,6 +612,54 @@ void VKShader::BuildInputLayout(std::size_t numVertexAttribs, const VertexAttrib
     inputLayout_.bindingDescs.insert(inputLayout_.bindingDescs.end(), bindingDescSet.begin(), bindingDescSet.end());
 }
 
+void VKShader::BuildSpecializationInfo(const std::vector<SpecializationConstant>& specializationConstants)
+{
+    if (specializationConstants.empty())
+        return;
+
+    /*
+    Store all constants as 32-bit words, since VkBool32 is also 32 bits wide.
+    Constant IDs must be unique within VkSpecializationInfo, so duplicates are merged and the last value is used.
+    */
+    specialization_.mapEntries.reserve(specializationConstants.size());
+    specialization_.data.reserve(specializationConstants.size());
+
+    for (const auto& constant : specializationConstants)
+    {
+        auto it = std::find_if(
+            specialization_.mapEntries.begin(),
+            specialization_.mapEntries.end(),
+            [&constant](const VkSpecializationMapEntry& entry)
+            {
+                return (entry.constantID == constant.constantID);
+            }
+        );
+
+        if (it != specialization_.mapEntries.end())
+        {
+            specialization_.data[static_cast<std::size_t>(it - specialization_.mapEntries.begin())] = constant.u32;
+            continue;
+        }
+
+        VkSpecializationMapEntry mapEntry;
+        {
+            mapEntry.constantID = constant.constantID;
+            mapEntry.offset     = static_cast<std::uint32_t>(specialization_.data.size() * sizeof(std::uint32_t));
+            mapEntry.size       = sizeof(std::uint32_t);
+        }
+        specialization_.mapEntries.push_back(mapEntry);
+        specialization_.data.push_back(constant.u32);
+    }
+
+    auto& info = specialization_.info;
+    {
+        info.mapEntryCount  = static_cast<std::uint32_t>(specialization_.mapEntries.size());
+        info.pMapEntries    = specialization_.mapEntries.data();
+        info.dataSize       = specialization_.data.size() * sizeof(std::uint32_t);
+        info.pData          = specialization_.data.data();
+    }
+}
+
 bool VKShader::CompileSource(const ShaderDescriptor& shaderDesc)
 {
     return false; // dummy
@@ -488,16 +668,16 @@ bool VKShader::CompileSource(const ShaderDescriptor& shaderDesc)
 bool VKShader::LoadBinary(const ShaderDescriptor& shaderDesc)
 {
     /* Get shader binary */
-    std::vector<char>   fileContent;
-    const char*         binaryBuffer = nullptr;
-    std::size_t         binaryLength = 0;
+    std::unique_ptr<Blob>   fileContent;
+    const char*             binaryBuffer = nullptr;
+    std::size_t             binaryLength = 0;
 
     if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
     {
-        /* Load binary from file */
-        fileContent = ReadFileBuffer(shaderDesc.source);
-        binaryBuffer = fileContent.data();
-        binaryLength = fileContent.size();
+        /* Load binary from mapped file */
+        fileContent = MapFileBuffer(shaderDesc.source);
+        binaryBuffer = reinterpret_cast<const char*>(fileContent->GetData());
+        binaryLength = fileContent->GetSize();
     }
     else
     {
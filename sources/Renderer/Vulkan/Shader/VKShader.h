@@ -21,6 +21,7 @@ namespace LLGL
 
 struct ShaderReflection;
 struct Extent3D;
+class VKShaderReflectionCache;
 
 class VKShader final : public Shader
 {
@@ -33,7 +34,8 @@ class VKShader final : public Shader
 
     public:
 
-        VKShader(const VKPtr<VkDevice>& device, const ShaderDescriptor& desc);
+        VKShader(const VKPtr<VkDevice>& device, const ShaderDescriptor& desc, VKShaderReflectionCache* reflectionCache = nullptr);
+        ~VKShader();
 
         void FillShaderStageCreateInfo(VkPipelineShaderStageCreateInfo& createInfo) const;
         void FillVertexInputStateCreateInfo(VkPipelineVertexInputStateCreateInfo& createInfo) const;
@@ -62,10 +64,13 @@ class VKShader final : public Shader
 
         bool BuildShader(const ShaderDescriptor& shaderDesc);
         void BuildInputLayout(std::size_t numVertexAttribs, const VertexAttribute* vertexAttribs);
+        void BuildSpecializationInfo(const std::vector<SpecializationConstant>& specializationConstants);
 
         bool CompileSource(const ShaderDescriptor& shaderDesc);
         bool LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        void ReflectShaderModule(ShaderReflection& reflection) const;
+
     private:
 
         struct VertexInputLayout
@@ -74,16 +79,26 @@ class VKShader final : public Shader
             std::vector<VkVertexInputAttributeDescription>  attribDescs;
         };
 
-    private:
+        struct SpecializationInfo
+        {
+            std::vector<VkSpecializationMapEntry>           mapEntries;
+            std::vector<std::uint32_t>                      data;
+            VkSpecializationInfo                            info;
+        };
 
-        VkDevice                device_             = VK_NULL_HANDLE;
-        VKPtr<VkShaderModule>   shaderModule_;
-        std::vector<char>       shaderModuleData_;
-        LoadBinaryResult        loadBinaryResult_   = LoadBinaryResult::Undefined;
-        VertexInputLayout       inputLayout_;
+    private:
 
-        std::string             entryPoint_;
-        std::string             errorLog_;
+        VkDevice                    device_             = VK_NULL_HANDLE;
+        VKPtr<VkShaderModule>       shaderModule_;
+        std::vector<char>           shaderModuleData_;
+        LoadBinaryResult            loadBinaryResult_   = LoadBinaryResult::Undefined;
+        VertexInputLayout           inputLayout_;
+        SpecializationInfo          specialization_;
+        VKShaderReflectionCache*    reflectionCache_    = nullptr;  // Optional cache of module reflections, owned by the render system
+        std::uint64_t               reflectionKey_      = 0;        // Key of the shader module in the reflection cache
+
+        std::string                 entryPoint_;
+        std::string                 errorLog_;
 
 };
 
@@ -0,0 +1,72 @@
+/*
+ * VKShaderReflectionCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKShaderReflectionCache.h"
+
+
+namespace LLGL
+{
+
+
+void VKShaderReflectionCache::Register(std::uint64_t key)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    entries_[key].refCount++;
+}
+
+void VKShaderReflectionCache::Unregister(std::uint64_t key)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+        if (--(it->second.refCount) == 0)
+            entries_.erase(it);
+    }
+}
+
+bool VKShaderReflectionCache::Find(std::uint64_t key, const ShaderType type, const std::vector<char>& moduleData, ShaderReflection& reflection) const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+        /* Compare module on a hit, since different modules can have the same hash */
+        const auto& entry = it->second;
+        if (entry.reflected && entry.type == type && entry.moduleData == moduleData)
+        {
+            reflection = entry.reflection;
+            return true;
+        }
+    }
+    return false;
+}
+
+void VKShaderReflectionCache::Store(std::uint64_t key, const ShaderType type, const std::vector<char>& moduleData, const ShaderReflection& reflection)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = entries_.find(key);
+    if (it != entries_.end())
+    {
+        /* Only store reflection of registered keys; the first module that is reflected with a key keeps its entry */
+        auto& entry = it->second;
+        if (!entry.reflected)
+        {
+            entry.reflected     = true;
+            entry.type          = type;
+            entry.moduleData    = moduleData;
+            entry.reflection    = reflection;
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,78 @@
+/*
+ * VKShaderReflectionCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_SHADER_REFLECTION_CACHE_H
+#define LLGL_VK_SHADER_REFLECTION_CACHE_H
+
+
+#include <LLGL/ShaderProgramFlags.h>
+#include <LLGL/ShaderFlags.h>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Cache of SPIR-V shader module reflections that is keyed by a hash of the module and its shader type.
+Shaders with identical modules are only reflected once per render system. Each entry keeps a copy of its module,
+so a hash collision is never mistaken for a hit, and it is evicted when the last shader with its key has been unregistered.
+*/
+class VKShaderReflectionCache
+{
+
+    public:
+
+        VKShaderReflectionCache() = default;
+
+        VKShaderReflectionCache(const VKShaderReflectionCache&) = delete;
+        VKShaderReflectionCache& operator = (const VKShaderReflectionCache&) = delete;
+
+        // Registers a shader with the specified key. Each call must be matched by a call to Unregister with the same key.
+        void Register(std::uint64_t key);
+
+        // Unregisters a shader with the specified key and evicts the cached reflection if no other shader with this key is registered.
+        void Unregister(std::uint64_t key);
+
+        // Copies the cached reflection of the specified module into the output parameter. Returns false on a cache miss.
+        bool Find(std::uint64_t key, const ShaderType type, const std::vector<char>& moduleData, ShaderReflection& reflection) const;
+
+        // Stores the reflection of the specified module. This has no effect if the key is already used by another module.
+        void Store(std::uint64_t key, const ShaderType type, const std::vector<char>& moduleData, const ShaderReflection& reflection);
+
+    private:
+
+        struct Entry
+        {
+            std::size_t         refCount    = 0;
+            bool                reflected   = false;
+            ShaderType          type        = ShaderType::Undefined;
+            std::vector<char>   moduleData;
+            ShaderReflection    reflection;
+        };
+
+    private:
+
+        mutable std::mutex                          mutex_;
+        std::unordered_map<std::uint64_t, Entry>    entries_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -66,8 +66,9 @@ void VKDeviceImage::CreateVkImage(
     std::uint32_t           numMipLevels,
     std::uint32_t           numArrayLayers,
     VkImageCreateFlags      createFlags,
-    VkSampleCountFlagBits   sampleCountBits,
-    VkImageUsageFlags       usageFlags)
+    VkSampleCountFlagBits               sampleCountBits,
+    VkImageUsageFlags                   usageFlags,
+    const std::vector<std::uint32_t>&   sharedQueueFamilies)
 {
     /* Create image object */
     VkImageCreateInfo createInfo;
@@ -83,9 +84,18 @@ void VKDeviceImage::CreateVkImage(
         createInfo.samples                  = sampleCountBits;
         createInfo.tiling                   = VK_IMAGE_TILING_OPTIMAL;
         createInfo.usage                    = usageFlags;
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
+        if (sharedQueueFamilies.size() > 1)
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount    = static_cast<std::uint32_t>(sharedQueueFamilies.size());
+            createInfo.pQueueFamilyIndices      = sharedQueueFamilies.data();
+        }
+        else
+        {
+            createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE; // only used by graphics queue
+            createInfo.queueFamilyIndexCount    = 0;
+            createInfo.pQueueFamilyIndices      = nullptr;
+        }
         createInfo.initialLayout            = VK_IMAGE_LAYOUT_UNDEFINED;
     }
     VkResult result = vkCreateImage(device, &createInfo, nullptr, image_.ReleaseAndGetAddressOf());
@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -48,8 +49,9 @@ class VKDeviceImage
             std::uint32_t           numMipLevels,
             std::uint32_t           numArrayLayers,
             VkImageCreateFlags      createFlags,
-            VkSampleCountFlagBits   sampleCountBits,
-            VkImageUsageFlags       usageFlags
+            VkSampleCountFlagBits               sampleCountBits,
+            VkImageUsageFlags                   usageFlags,
+            const std::vector<std::uint32_t>&   sharedQueueFamilies = {}
         );
 
         void ReleaseVkImage();
@@ -17,9 +17,10 @@ namespace LLGL
 
 
 VKTexture::VKTexture(
-    const VKPtr<VkDevice>&      device,
-    VKDeviceMemoryManager&      deviceMemoryMngr,
-    const TextureDescriptor&    desc)
+    const VKPtr<VkDevice>&              device,
+    VKDeviceMemoryManager&              deviceMemoryMngr,
+    const TextureDescriptor&            desc,
+    const std::vector<std::uint32_t>&   sharedQueueFamilies)
 :
     Texture       { desc.type, desc.bindFlags  },
     imageWrapper_ { device                     },
@@ -27,7 +28,7 @@ VKTexture::VKTexture(
     format_       { VKTypes::Map(desc.format)  }
 {
     /* Create Vulkan image and allocate memory region */
-    CreateImage(device, desc);
+    CreateImage(device, desc, sharedQueueFamilies);
     imageWrapper_.AllocateMemoryRegion(deviceMemoryMngr);
 }
 
@@ -332,7 +333,13 @@ static VkImageUsageFlags GetVkImageUsageFlags(const TextureDescriptor& desc)
     return usageFlags;
 }
 
-void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
+// Returns true if the texture is used as attachment, which is only supported by the graphics queue
+static bool IsAttachmentTexture(const TextureDescriptor& desc)
+{
+    return ((desc.bindFlags & (BindFlags::ColorAttachment | BindFlags::DepthStencilAttachment)) != 0);
+}
+
+void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc, const std::vector<std::uint32_t>& sharedQueueFamilies)
 {
     /* Setup texture parameters */
     auto imageType  = GetVkImageType(desc.type);
@@ -351,7 +358,8 @@ void VKTexture::CreateImage(VkDevice device, const TextureDescriptor& desc)
         numArrayLayers_,
         GetVkImageCreateFlags(desc),
         GetVkImageSampleCountFlags(desc),
-        GetVkImageUsageFlags(desc)
+        GetVkImageUsageFlags(desc),
+        (IsAttachmentTexture(desc) ? std::vector<std::uint32_t>{} : sharedQueueFamilies)
     );
 }
 
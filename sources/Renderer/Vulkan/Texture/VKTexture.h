@@ -14,6 +14,7 @@
 #include <vulkan/vulkan.h>
 #include "../VKPtr.h"
 #include <cstdint>
+#include <vector>
 
 
 namespace LLGL
@@ -29,9 +30,10 @@ class VKTexture final : public Texture
     public:
 
         VKTexture(
-            const VKPtr<VkDevice>&      device,
-            VKDeviceMemoryManager&      deviceMemoryMngr,
-            const TextureDescriptor&    desc
+            const VKPtr<VkDevice>&              device,
+            VKDeviceMemoryManager&              deviceMemoryMngr,
+            const TextureDescriptor&            desc,
+            const std::vector<std::uint32_t>&   sharedQueueFamilies = {}
         );
 
         Extent3D GetMipExtent(std::uint32_t mipLevel) const override;
@@ -109,7 +111,7 @@ class VKTexture final : public Texture
 
     private:
 
-        void CreateImage(VkDevice device, const TextureDescriptor& desc);
+        void CreateImage(VkDevice device, const TextureDescriptor& desc, const std::vector<std::uint32_t>& sharedQueueFamilies);
 
     private:
 
@@ -25,6 +25,7 @@
 #include "../../Core/Exception.h"
 #include <LLGL/StaticLimits.h>
 #include <cstddef>
+#include <chrono>
 
 
 namespace LLGL
@@ -42,6 +43,48 @@ static std::uint32_t GetMaxDrawIndirectCount(const VKPhysicalDevice& physicalDev
         return 1u;
 }
 
+// Returns the pipeline stages that are supported by the queue family with the specified index
+static VkPipelineStageFlags GetSupportedPipelineStages(const VKPhysicalDevice& physicalDevice, std::uint32_t queueFamilyIndex)
+{
+    const auto queueFamilies = VKQueryQueueFamilyProperties(physicalDevice.GetVkPhysicalDevice());
+    const auto queueFlags = (queueFamilyIndex < queueFamilies.size() ? queueFamilies[queueFamilyIndex].queueFlags : 0u);
+
+    /* Transfer and host stages are supported by all queues */
+    VkPipelineStageFlags stageMask =
+    (
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT       |
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT    |
+        VK_PIPELINE_STAGE_TRANSFER_BIT          |
+        VK_PIPELINE_STAGE_HOST_BIT              |
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+    );
+
+    if ((queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0)
+        stageMask |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+
+    if ((queueFlags & VK_QUEUE_COMPUTE_BIT) != 0)
+        stageMask |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+    if ((queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0)
+    {
+        stageMask |=
+        (
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT                   |
+            VK_PIPELINE_STAGE_VERTEX_SHADER_BIT                  |
+            VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT    |
+            VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT |
+            VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT                |
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT                |
+            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT           |
+            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT            |
+            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT        |
+            VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT
+        );
+    }
+
+    return stageMask;
+}
+
 // Returns the number of native command buffers for the specified descriptor
 static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
 {
@@ -54,14 +97,15 @@ static std::uint32_t GetNumVkCommandBuffers(const CommandBufferDescriptor& desc)
 VKCommandBuffer::VKCommandBuffer(
     const VKPhysicalDevice&         physicalDevice,
     VKDevice&                       device,
-    VkQueue                         graphicsQueue,
+    VkQueue                         commandQueue,
+    std::uint32_t                   queueFamilyIndex,
     const QueueFamilyIndices&       queueFamilyIndices,
     const CommandBufferDescriptor&  desc)
 :
     device_               { device                                  },
-    commandPool_          { device, vkDestroyCommandPool            },
     queuePresentFamily_   { queueFamilyIndices.presentFamily        },
-    maxDrawIndirectCount_ { GetMaxDrawIndirectCount(physicalDevice) }
+    maxDrawIndirectCount_ { GetMaxDrawIndirectCount(physicalDevice) },
+    supportedStageMask_   { GetSupportedPipelineStages(physicalDevice, queueFamilyIndex) }
 {
     /* Translate creation flags */
     if ((desc.flags & CommandBufferFlags::DeferredSubmit) != 0)
@@ -76,9 +120,9 @@ VKCommandBuffer::VKCommandBuffer(
     const auto bufferCount = GetNumVkCommandBuffers(desc);
 
     /* Create native command buffer objects */
-    CreateCommandPool(queueFamilyIndices.graphicsFamily);
+    CreateCommandPools(queueFamilyIndex, bufferCount);
     CreateCommandBuffers(bufferCount);
-    CreateRecordingFences(graphicsQueue, bufferCount);
+    CreateRecordingFences(commandQueue, bufferCount);
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
@@ -86,12 +130,8 @@ VKCommandBuffer::VKCommandBuffer(
 
 VKCommandBuffer::~VKCommandBuffer()
 {
-    vkFreeCommandBuffers(
-        device_,
-        commandPool_,
-        static_cast<std::uint32_t>(commandBufferList_.size()),
-        commandBufferList_.data()
-    );
+    for (std::size_t i = 0; i < commandBufferList_.size(); ++i)
+        vkFreeCommandBuffers(device_, commandPoolList_[i], 1, &commandBufferList_[i]);
 }
 
 /* ----- Encoding ----- */
@@ -101,10 +141,22 @@ void VKCommandBuffer::Begin()
     /* Use next internal VkCommandBuffer object to reduce latency */
     AcquireNextBuffer();
 
-    /* Wait for fence before recording */
-    vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
+    /* Wait for fence before recording, and measure how long the CPU is blocked if the GPU has not finished this buffer yet */
+    if (vkGetFenceStatus(device_, recordingFence_) == VK_SUCCESS)
+        lastWaitTime_ = 0;
+    else
+    {
+        const auto waitStartTime = std::chrono::steady_clock::now();
+        vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
+        lastWaitTime_ = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStartTime).count()
+        );
+    }
     vkResetFences(device_, 1, &recordingFence_);
 
+    /* Reset the entire command pool of this frame at once, since its fence has been signaled; the pools of the other frames may still be in flight */
+    vkResetCommandPool(device_, commandPoolList_[commandBufferIndex_], 0);
+
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
     {
@@ -135,6 +187,22 @@ void VKCommandBuffer::End()
     recordState_ = RecordState::ReadyForSubmit;
 }
 
+bool VKCommandBuffer::TryBegin()
+{
+    /* Only begin encoding if the next native command buffer is no longer in use by the GPU */
+    const auto nextIndex = (commandBufferIndex_ + 1) % commandBufferList_.size();
+    if (vkGetFenceStatus(device_, recordingFenceList_[nextIndex]) != VK_SUCCESS)
+        return false;
+
+    Begin();
+    return true;
+}
+
+std::uint64_t VKCommandBuffer::GetLastWaitTime() const
+{
+    return lastWaitTime_;
+}
+
 void VKCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
 {
     auto& cmdBufferVK = LLGL_CAST(VKCommandBuffer&, deferredCommandBuffer);
@@ -1015,6 +1083,82 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 /* ----- Compute ----- */
 
+// Pipeline stages that can read from and write to resources in shaders; other shader stages are optional device features.
+static const VkPipelineStageFlags g_shaderStageMask =
+(
+    VK_PIPELINE_STAGE_VERTEX_SHADER_BIT     |
+    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT   |
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+);
+
+// Accumulates the access and pipeline stage masks for all kinds of access to a resource with the specified binding flags.
+static void AccumulateBarrierMasks(long bindFlags, VkAccessFlags& accessMask, VkPipelineStageFlags& stageMask)
+{
+    if ((bindFlags & BindFlags::VertexBuffer) != 0)
+    {
+        accessMask  |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        stageMask   |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if ((bindFlags & BindFlags::IndexBuffer) != 0)
+    {
+        accessMask  |= VK_ACCESS_INDEX_READ_BIT;
+        stageMask   |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if ((bindFlags & BindFlags::ConstantBuffer) != 0)
+    {
+        accessMask  |= VK_ACCESS_UNIFORM_READ_BIT;
+        stageMask   |= g_shaderStageMask;
+    }
+    if ((bindFlags & BindFlags::IndirectBuffer) != 0)
+    {
+        accessMask  |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        stageMask   |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    }
+    if ((bindFlags & BindFlags::Sampled) != 0)
+    {
+        accessMask  |= VK_ACCESS_SHADER_READ_BIT;
+        stageMask   |= g_shaderStageMask;
+    }
+    if ((bindFlags & BindFlags::Storage) != 0)
+    {
+        accessMask  |= (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        stageMask   |= g_shaderStageMask;
+    }
+    if ((bindFlags & BindFlags::ColorAttachment) != 0)
+    {
+        accessMask  |= (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        stageMask   |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+    if ((bindFlags & BindFlags::DepthStencilAttachment) != 0)
+    {
+        accessMask  |= (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        stageMask   |= (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT);
+    }
+
+    /* Copy commands are allowed for all resources */
+    accessMask  |= (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+    stageMask   |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+}
+
+// Returns the access types that are supported by the specified pipeline stages.
+static VkAccessFlags GetSupportedAccessMask(VkPipelineStageFlags stageMask)
+{
+    VkAccessFlags accessMask = (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_READ_BIT | VK_ACCESS_HOST_WRITE_BIT);
+
+    if ((stageMask & VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) != 0)
+        accessMask |= (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT);
+    if ((stageMask & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT) != 0)
+        accessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    if ((stageMask & g_shaderStageMask) != 0)
+        accessMask |= (VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+    if ((stageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) != 0)
+        accessMask |= (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    if ((stageMask & (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT)) != 0)
+        accessMask |= (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+
+    return accessMask;
+}
+
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
@@ -1026,6 +1170,65 @@ void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
 
+void VKCommandBuffer::ResourceBarrier(
+    std::uint32_t       numBuffers,
+    Buffer* const *     buffers,
+    std::uint32_t       numTextures,
+    Texture* const *    textures)
+{
+    /* Gather all kinds of access to the specified resources */
+    VkAccessFlags           accessMask  = 0;
+    VkPipelineStageFlags    stageMask   = 0;
+    bool                    hostRead    = false;
+
+    for (std::uint32_t i = 0; i < numBuffers; ++i)
+    {
+        AccumulateBarrierMasks(buffers[i]->GetBindFlags(), accessMask, stageMask);
+
+        /* Readback buffers are host visible and read by the CPU after the command buffer has completed */
+        auto bufferVK = LLGL_CAST(VKBuffer*, buffers[i]);
+        if (bufferVK->IsHostVisible())
+            hostRead = true;
+    }
+    for (std::uint32_t i = 0; i < numTextures; ++i)
+        AccumulateBarrierMasks(textures[i]->GetBindFlags(), accessMask, stageMask);
+
+    /* Remove the stages that are not supported by the queue family of this command buffer, e.g. graphics stages on a compute or transfer queue */
+    stageMask   &= supportedStageMask_;
+    accessMask  &= GetSupportedAccessMask(stageMask);
+
+    if (stageMask == 0)
+        return;
+
+    /*
+    Make all previous writes available and visible to all subsequent accesses of the same kinds.
+    Using the same stages on both sides also orders previous reads before subsequent writes, e.g. an indirect draw before the next copy into its argument buffer.
+    A global memory barrier is sufficient, since no image layout transitions are required.
+    */
+    VkMemoryBarrier memoryBarrier;
+    {
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.pNext         = nullptr;
+        memoryBarrier.srcAccessMask = (accessMask & (VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT));
+        memoryBarrier.dstAccessMask = accessMask;
+    }
+
+    /* Make copies into readback buffers visible to the host; the fence alone does not guarantee visibility of device writes to host reads */
+    VkMemoryBarrier hostBarrier;
+    {
+        hostBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.pNext           = nullptr;
+        hostBarrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+    }
+
+    /* Barriers must not be recorded inside a render pass, since that would require a subpass self-dependency */
+    vkCmdPipelineBarrier(commandBuffer_, stageMask, stageMask, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    if (hostRead)
+        vkCmdPipelineBarrier(commandBuffer_, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+}
+
 /* ----- Debugging ----- */
 
 void VKCommandBuffer::PushDebugGroup(const char* name)
@@ -1064,38 +1267,49 @@ void VKCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc, std::s
  * ======= Private: =======
  */
 
-void VKCommandBuffer::CreateCommandPool(std::uint32_t queueFamilyIndex)
+void VKCommandBuffer::CreateCommandPools(std::uint32_t queueFamilyIndex, std::uint32_t numPools)
 {
-    /* Create command pool */
+    /* Create one transient command pool per frame in flight, so each pool can be reset as a whole once the fence of its frame has been signaled */
     VkCommandPoolCreateInfo createInfo;
     {
         createInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         createInfo.pNext            = nullptr;
-        createInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        createInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
         createInfo.queueFamilyIndex = queueFamilyIndex;
     }
-    auto result = vkCreateCommandPool(device_, &createInfo, nullptr, commandPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan command pool");
+
+    commandPoolList_.reserve(numPools);
+
+    for (std::uint32_t i = 0; i < numPools; ++i)
+    {
+        VKPtr<VkCommandPool> commandPool{ device_, vkDestroyCommandPool };
+        auto result = vkCreateCommandPool(device_, &createInfo, nullptr, commandPool.ReleaseAndGetAddressOf());
+        VKThrowIfFailed(result, "failed to create Vulkan command pool");
+        commandPoolList_.emplace_back(std::move(commandPool));
+    }
 }
 
 void VKCommandBuffer::CreateCommandBuffers(std::uint32_t bufferCount)
 {
-    /* Allocate command buffers */
+    /* Allocate one command buffer per frame in flight, each from the command pool of its frame */
     commandBufferList_.resize(bufferCount);
 
-    VkCommandBufferAllocateInfo allocInfo;
+    for (std::uint32_t i = 0; i < bufferCount; ++i)
     {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.commandPool           = commandPool_;
-        allocInfo.level                 = bufferLevel_;
-        allocInfo.commandBufferCount    = bufferCount;
+        VkCommandBufferAllocateInfo allocInfo;
+        {
+            allocInfo.sType                 = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.pNext                 = nullptr;
+            allocInfo.commandPool           = commandPoolList_[i];
+            allocInfo.level                 = bufferLevel_;
+            allocInfo.commandBufferCount    = 1;
+        }
+        auto result = vkAllocateCommandBuffers(device_, &allocInfo, &commandBufferList_[i]);
+        VKThrowIfFailed(result, "failed to allocate Vulkan command buffers");
     }
-    auto result = vkAllocateCommandBuffers(device_, &allocInfo, commandBufferList_.data());
-    VKThrowIfFailed(result, "failed to allocate Vulkan command buffers");
 }
 
-void VKCommandBuffer::CreateRecordingFences(VkQueue graphicsQueue, std::uint32_t numFences)
+void VKCommandBuffer::CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences)
 {
     recordingFenceList_.reserve(numFences);
 
@@ -1115,7 +1329,8 @@ void VKCommandBuffer::CreateRecordingFences(VkQueue graphicsQueue, std::uint32_t
             VKThrowIfFailed(result, "failed to create Vulkan fence");
 
             /* Initial fence signal */
-            vkQueueSubmit(graphicsQueue, 0, nullptr, fence);
+            std::lock_guard<std::mutex> guard { device_.GetQueueMutex() };
+            vkQueueSubmit(commandQueue, 0, nullptr, fence);
         }
         recordingFenceList_.emplace_back(std::move(fence));
     }
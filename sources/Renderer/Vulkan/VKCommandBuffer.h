@@ -37,7 +37,8 @@ class VKCommandBuffer final : public CommandBuffer
         VKCommandBuffer(
             const VKPhysicalDevice&         physicalDevice,
             VKDevice&                       device,
-            VkQueue                         graphicsQueue,
+            VkQueue                         commandQueue,
+            std::uint32_t                   queueFamilyIndex,
             const QueueFamilyIndices&       queueFamilyIndices,
             const CommandBufferDescriptor&  desc
         );
@@ -48,6 +49,9 @@ class VKCommandBuffer final : public CommandBuffer
         void Begin() override;
         void End() override;
 
+        bool TryBegin() override;
+        std::uint64_t GetLastWaitTime() const override;
+
         void Execute(CommandBuffer& deferredCommandBuffer) override;
 
         /* ----- Blitting ----- */
@@ -219,6 +223,13 @@ class VKCommandBuffer final : public CommandBuffer
         void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ) override;
         void DispatchIndirect(Buffer& buffer, std::uint64_t offset) override;
 
+        void ResourceBarrier(
+            std::uint32_t       numBuffers,
+            Buffer* const *     buffers,
+            std::uint32_t       numTextures = 0,
+            Texture* const *    textures    = nullptr
+        ) override;
+
         /* ----- Debugging ----- */
 
         void PushDebugGroup(const char* name) override;
@@ -256,9 +267,9 @@ class VKCommandBuffer final : public CommandBuffer
 
     private:
 
-        void CreateCommandPool(std::uint32_t queueFamilyIndex);
+        void CreateCommandPools(std::uint32_t queueFamilyIndex, std::uint32_t numPools);
         void CreateCommandBuffers(std::uint32_t bufferCount);
-        void CreateRecordingFences(VkQueue graphicsQueue, std::uint32_t numFences);
+        void CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
@@ -287,41 +298,45 @@ class VKCommandBuffer final : public CommandBuffer
 
     private:
 
-        VKDevice&                       device_;
-        VKPtr<VkCommandPool>            commandPool_;
+        VKDevice&                           device_;
+
+        // Transient command pools, one for each native command buffer, i.e. one per frame in flight
+        std::vector<VKPtr<VkCommandPool>>   commandPoolList_;
 
-        std::vector<VkCommandBuffer>    commandBufferList_;
-        VkCommandBuffer                 commandBuffer_;
-        std::size_t                     commandBufferIndex_         = 0;
+        std::vector<VkCommandBuffer>        commandBufferList_;
+        VkCommandBuffer                     commandBuffer_;
+        std::size_t                         commandBufferIndex_         = 0;
 
-        std::vector<VKPtr<VkFence>>     recordingFenceList_;
-        VkFence                         recordingFence_;
+        std::vector<VKPtr<VkFence>>         recordingFenceList_;
+        VkFence                             recordingFence_;
+        std::uint64_t                       lastWaitTime_               = 0;
 
-        RecordState                     recordState_                = RecordState::Undefined;
+        RecordState                         recordState_                = RecordState::Undefined;
 
-        VkCommandBufferUsageFlags       usageFlags_                 = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        VkCommandBufferLevel            bufferLevel_                = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        VkCommandBufferUsageFlags           usageFlags_                 = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VkCommandBufferLevel                bufferLevel_                = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
-        VkClearColorValue               clearColor_                 = { { 0.0f, 0.0f, 0.0f, 0.0f } };
-        VkClearDepthStencilValue        clearDepthStencil_          = { 1.0f, 0 };
+        VkClearColorValue                   clearColor_                 = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+        VkClearDepthStencilValue            clearDepthStencil_          = { 1.0f, 0 };
 
-        VkRenderPass                    renderPass_                 = VK_NULL_HANDLE; // primary render pass
-        VkRenderPass                    secondaryRenderPass_        = VK_NULL_HANDLE; // to pause/resume render pass (load and store content)
-        VkFramebuffer                   framebuffer_                = VK_NULL_HANDLE; // active framebuffer handle
-        VkExtent2D                      framebufferExtent_          = { 0, 0 };
-        std::uint32_t                   numColorAttachments_        = 0;
-        bool                            hasDSVAttachment_           = false;
+        VkRenderPass                        renderPass_                 = VK_NULL_HANDLE; // primary render pass
+        VkRenderPass                        secondaryRenderPass_        = VK_NULL_HANDLE; // to pause/resume render pass (load and store content)
+        VkFramebuffer                       framebuffer_                = VK_NULL_HANDLE; // active framebuffer handle
+        VkExtent2D                          framebufferExtent_          = { 0, 0 };
+        std::uint32_t                       numColorAttachments_        = 0;
+        bool                                hasDSVAttachment_           = false;
 
-        std::uint32_t                   queuePresentFamily_         = 0;
+        std::uint32_t                       queuePresentFamily_         = 0;
 
-        bool                            scissorEnabled_             = false;
-        bool                            scissorRectInvalidated_     = true;
+        bool                                scissorEnabled_             = false;
+        bool                                scissorRectInvalidated_     = true;
 
-        std::uint32_t                   maxDrawIndirectCount_       = 0;
+        std::uint32_t                       maxDrawIndirectCount_       = 0;
+        VkPipelineStageFlags                supportedStageMask_         = 0; // Pipeline stages supported by the queue family of this command buffer
 
         #if 1//TODO: optimize usage of query pools
-        std::vector<VKQueryHeap*>       queryHeapsInFlight_;
-        std::size_t                     numQueryHeapsInFlight_      = 0;
+        std::vector<VKQueryHeap*>           queryHeapsInFlight_;
+        std::size_t                         numQueryHeapsInFlight_      = 0;
         #endif
 
 };
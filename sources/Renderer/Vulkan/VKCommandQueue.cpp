@@ -17,9 +17,11 @@ namespace LLGL
 {
 
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(const VKDevice& device, VkQueue queue, std::uint32_t queueFamilyIndex) :
+    device_           { device                  },
+    native_           { queue                   },
+    queueFamilyIndex_ { queueFamilyIndex        },
+    queueMutex_       { device.GetQueueMutex()  }
 {
 }
 
@@ -31,21 +33,9 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 
     VkCommandBuffer commandBuffers[] = { commandBufferVK.GetVkCommandBuffer() };
 
-    /* Submit command buffer to graphics queue */
-    VkSubmitInfo submitInfo;
-    {
-        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.pNext                = nullptr;
-        submitInfo.waitSemaphoreCount   = 0;
-        submitInfo.pWaitSemaphores      = nullptr;
-        submitInfo.pWaitDstStageMask    = 0;
-        submitInfo.commandBufferCount   = 1;
-        submitInfo.pCommandBuffers      = commandBuffers;
-        submitInfo.signalSemaphoreCount = 0;
-        submitInfo.pSignalSemaphores    = nullptr;
-    }
-    auto result = vkQueueSubmit(native_, 1, &submitInfo, commandBufferVK.GetQueueSubmitFence());
-    VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
+    /* Submit command buffer to queue */
+    auto result = SubmitWithPendingWaits(1, commandBuffers, commandBufferVK.GetQueueSubmitFence());
+    VKThrowIfFailed(result, "failed to submit command buffer to Vulkan queue");
 }
 
 /* ----- Queries ----- */
@@ -95,8 +85,16 @@ bool VKCommandBuffer::QueryPipelineStatisticsResult(QueryHeap& queryHeap, QueryP
 void VKCommandQueue::Submit(Fence& fence)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
-    fenceVK.Reset(device_);
-    vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
+    if (fenceVK.IsTimeline())
+    {
+        /* Signal timeline semaphore with the next value */
+        SubmitWithPendingWaits(0, nullptr, VK_NULL_HANDLE, fenceVK.GetVkSemaphore(), fenceVK.NextSignalValue());
+    }
+    else
+    {
+        fenceVK.Reset(device_);
+        SubmitWithPendingWaits(0, nullptr, fenceVK.GetVkFence());
+    }
 }
 
 bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
@@ -107,14 +105,106 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void VKCommandQueue::WaitIdle()
 {
+    std::lock_guard<std::mutex> guard { queueMutex_ };
     vkQueueWaitIdle(native_);
 }
 
+/* ----- Fence values ----- */
+
+void VKCommandQueue::Signal(Fence& fence, std::uint64_t value)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    if (fenceVK.IsTimeline())
+    {
+        /* Signal timeline semaphore with the explicit value, which shares its counter with Submit(Fence&) */
+        SubmitWithPendingWaits(0, nullptr, VK_NULL_HANDLE, fenceVK.GetVkSemaphore(), fenceVK.AdvanceSignalValue(value));
+    }
+    else
+        Submit(fence);
+}
+
+void VKCommandQueue::Wait(Fence& fence, std::uint64_t value)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    if (fenceVK.IsTimeline())
+    {
+        /* Let the next submission wait on the GPU for the timeline semaphore; pending waits are guarded by the same mutex as submissions */
+        std::lock_guard<std::mutex> guard { queueMutex_ };
+        waitSemaphores_.push_back(fenceVK.GetVkSemaphore());
+        waitValues_.push_back(value);
+        waitStages_.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    }
+    else
+    {
+        /* Binary fences can only be waited for on the CPU */
+        fenceVK.Wait(device_, UINT64_MAX);
+    }
+}
+
+bool VKCommandQueue::WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout)
+{
+    auto& fenceVK = LLGL_CAST(VKFence&, fence);
+    return fenceVK.WaitValue(device_, value, timeout);
+}
+
 
 /*
  * ======= Private: =======
  */
 
+VkResult VKCommandQueue::SubmitWithPendingWaits(
+    std::uint32_t           numCommandBuffers,
+    const VkCommandBuffer*  commandBuffers,
+    VkFence                 fence,
+    VkSemaphore             signalSemaphore,
+    std::uint64_t           signalValue)
+{
+    std::lock_guard<std::mutex> guard { queueMutex_ };
+
+    const auto numWaitSemaphores = static_cast<std::uint32_t>(waitSemaphores_.size());
+
+    /* Submit only the fence if there is nothing else to submit */
+    if (numCommandBuffers == 0 && numWaitSemaphores == 0 && signalSemaphore == VK_NULL_HANDLE)
+        return vkQueueSubmit(native_, 0, nullptr, fence);
+
+    VkSubmitInfo submitInfo;
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext                = nullptr;
+        submitInfo.waitSemaphoreCount   = numWaitSemaphores;
+        submitInfo.pWaitSemaphores      = (numWaitSemaphores > 0 ? waitSemaphores_.data() : nullptr);
+        submitInfo.pWaitDstStageMask    = (numWaitSemaphores > 0 ? waitStages_.data() : nullptr);
+        submitInfo.commandBufferCount   = numCommandBuffers;
+        submitInfo.pCommandBuffers      = commandBuffers;
+        submitInfo.signalSemaphoreCount = (signalSemaphore != VK_NULL_HANDLE ? 1 : 0);
+        submitInfo.pSignalSemaphores    = (signalSemaphore != VK_NULL_HANDLE ? &signalSemaphore : nullptr);
+    }
+
+    #ifdef VK_KHR_timeline_semaphore
+    /* Pass values for all timeline semaphores (only timeline semaphores are waited for and signaled here) */
+    VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo;
+    if (submitInfo.waitSemaphoreCount > 0 || submitInfo.signalSemaphoreCount > 0)
+    {
+        timelineSubmitInfo.sType                        = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+        timelineSubmitInfo.pNext                        = nullptr;
+        timelineSubmitInfo.waitSemaphoreValueCount      = submitInfo.waitSemaphoreCount;
+        timelineSubmitInfo.pWaitSemaphoreValues         = (numWaitSemaphores > 0 ? waitValues_.data() : nullptr);
+        timelineSubmitInfo.signalSemaphoreValueCount    = submitInfo.signalSemaphoreCount;
+        timelineSubmitInfo.pSignalSemaphoreValues       = (signalSemaphore != VK_NULL_HANDLE ? &signalValue : nullptr);
+        submitInfo.pNext = &timelineSubmitInfo;
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
+    auto result = vkQueueSubmit(native_, 1, &submitInfo, fence);
+
+    /* Pending wait operations are consumed by this submission */
+    waitSemaphores_.clear();
+    waitValues_.clear();
+    waitStages_.clear();
+
+    return result;
+}
+
 VkResult VKCommandQueue::GetQueryResults(
     VKQueryHeap&    queryHeapVK,
     std::uint32_t   firstQuery,
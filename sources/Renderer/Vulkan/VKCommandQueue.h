@@ -13,7 +13,10 @@
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "VKDevice.h"
 #include "RenderState/VKFence.h"
+#include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -29,7 +32,7 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue);
+        VKCommandQueue(const VKDevice& device, VkQueue queue, std::uint32_t queueFamilyIndex);
 
         /* ----- Command Buffers ----- */
 
@@ -46,8 +49,38 @@ class VKCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+        /* ----- Fence values ----- */
+
+        void Signal(Fence& fence, std::uint64_t value) override;
+        void Wait(Fence& fence, std::uint64_t value) override;
+
+        bool WaitFenceValue(Fence& fence, std::uint64_t value, std::uint64_t timeout) override;
+
+        /* ----- Handles ----- */
+
+        // Returns the native VkQueue handle.
+        inline VkQueue GetVkQueue() const
+        {
+            return native_;
+        }
+
+        // Returns the queue family index of this command queue.
+        inline std::uint32_t GetQueueFamilyIndex() const
+        {
+            return queueFamilyIndex_;
+        }
+
     private:
 
+        // Submits the command buffers with all pending wait operations and an optional timeline semaphore signal operation.
+        VkResult SubmitWithPendingWaits(
+            std::uint32_t           numCommandBuffers,
+            const VkCommandBuffer*  commandBuffers,
+            VkFence                 fence,
+            VkSemaphore             signalSemaphore = VK_NULL_HANDLE,
+            std::uint64_t           signalValue     = 0
+        );
+
         VkResult GetQueryResults(
             VKQueryHeap&    queryHeapVK,
             std::uint32_t   firstQuery,
@@ -76,8 +109,15 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        VkDevice                            device_;
+        VkQueue                             native_             = VK_NULL_HANDLE;
+        std::uint32_t                       queueFamilyIndex_   = 0;
+        std::mutex&                         queueMutex_;        // Shared with all device queues, see VKDevice::GetQueueMutex
+
+        // Timeline semaphores and values the next submission waits for; guarded by 'queueMutex_'.
+        std::vector<VkSemaphore>            waitSemaphores_;
+        std::vector<std::uint64_t>          waitValues_;
+        std::vector<VkPipelineStageFlags>   waitStages_;
 
 };
 
@@ -295,9 +295,28 @@ QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFla
         ++i;
     }
 
+    /* Get dedicated compute and transfer family indices, so their queues can run asynchronously to the graphics queue */
+    indices.computeFamily   = VKFindDedicatedQueueFamily(queueFamilies, VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT, indices.graphicsFamily);
+    indices.transferFamily  = VKFindDedicatedQueueFamily(queueFamilies, VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, indices.computeFamily);
+
     return indices;
 }
 
+std::uint32_t VKFindDedicatedQueueFamily(
+    const std::vector<VkQueueFamilyProperties>& queueFamilies,
+    const VkQueueFlags                          requiredFlags,
+    const VkQueueFlags                          excludedFlags,
+    std::uint32_t                               fallbackIndex)
+{
+    for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(queueFamilies.size()); ++i)
+    {
+        const auto& family = queueFamilies[i];
+        if (family.queueCount > 0 && (family.queueFlags & requiredFlags) == requiredFlags && (family.queueFlags & excludedFlags) == 0)
+            return i;
+    }
+    return fallbackIndex;
+}
+
 VkFormat VKFindSupportedImageFormat(VkPhysicalDevice device, const std::initializer_list<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features)
 {
     for (auto format : candidates)
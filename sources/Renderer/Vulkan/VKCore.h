@@ -28,18 +28,21 @@ struct QueueFamilyIndices
 
     QueueFamilyIndices() :
         graphicsFamily { invalidIndex },
-        presentFamily  { invalidIndex }
+        presentFamily  { invalidIndex },
+        computeFamily  { invalidIndex },
+        transferFamily { invalidIndex }
     {
     }
 
     union
     {
-        std::uint32_t indices[2];
+        std::uint32_t indices[4];
         struct
         {
             std::uint32_t graphicsFamily;
             std::uint32_t presentFamily;
-            //std::uint32_t transferFamily;
+            std::uint32_t computeFamily;    // Dedicated compute family, or graphics family if there is none
+            std::uint32_t transferFamily;   // Dedicated transfer family, or compute family if there is none
         };
     };
 
@@ -83,6 +86,15 @@ std::vector<VkQueueFamilyProperties> VKQueryQueueFamilyProperties(VkPhysicalDevi
 
 SurfaceSupportDetails VKQuerySurfaceSupport(VkPhysicalDevice device, VkSurfaceKHR surface);
 QueueFamilyIndices VKFindQueueFamilies(VkPhysicalDevice device, const VkQueueFlags flags, VkSurfaceKHR* surface = nullptr);
+
+// Returns the index of the first queue family with all required flags and none of the excluded flags, or the fallback index if there is none.
+std::uint32_t VKFindDedicatedQueueFamily(
+    const std::vector<VkQueueFamilyProperties>& queueFamilies,
+    const VkQueueFlags                          requiredFlags,
+    const VkQueueFlags                          excludedFlags,
+    std::uint32_t                               fallbackIndex
+);
+
 VkFormat VKFindSupportedImageFormat(VkPhysicalDevice device, const std::initializer_list<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
 
 // Returns the memory type index that supports the specified type bits and properties, or throws an std::runtime_error exception on failure.
@@ -24,30 +24,38 @@ namespace LLGL
 /* ----- Common ----- */
 
 VKDevice::VKDevice() :
-    device_      { vkDestroyDevice               },
-    commandPool_ { device_, vkDestroyCommandPool }
+    device_ { vkDestroyDevice }
 {
 }
 
+// Staging command pools and mutexes are not moved, since the device is only moved before any command pool is created.
 VKDevice::VKDevice(VKDevice&& device) :
-    device_             { std::move(device.device_)      },
-    queueFamilyIndices_ { device.queueFamilyIndices_     },
-    graphicsQueue_      { device.graphicsQueue_          },
-    commandPool_        { std::move(device.commandPool_) }
+    device_              { std::move(device.device_)              },
+    queueFamilyIndices_  { device.queueFamilyIndices_             },
+    graphicsQueue_       { device.graphicsQueue_                  },
+    computeQueue_        { device.computeQueue_                   },
+    transferQueue_       { device.transferQueue_                  },
+    sharedQueueFamilies_ { std::move(device.sharedQueueFamilies_) },
+    nonCoherentAtomSize_ { device.nonCoherentAtomSize_            }
 {
 }
 
 VKDevice& VKDevice::operator = (VKDevice&& device)
 {
-    device_             = std::move(device.device_);
-    queueFamilyIndices_ = device.queueFamilyIndices_;
-    graphicsQueue_      = device.graphicsQueue_;
-    commandPool_        = std::move(device.commandPool_);
+    device_                 = std::move(device.device_);
+    queueFamilyIndices_     = device.queueFamilyIndices_;
+    graphicsQueue_          = device.graphicsQueue_;
+    computeQueue_           = device.computeQueue_;
+    transferQueue_          = device.transferQueue_;
+    sharedQueueFamilies_    = std::move(device.sharedQueueFamilies_);
+    nonCoherentAtomSize_    = device.nonCoherentAtomSize_;
     return *this;
 }
 
 void VKDevice::WaitIdle()
 {
+    /* vkDeviceWaitIdle requires all device queues to be externally synchronized */
+    std::lock_guard<std::mutex> guard { queueMutex_ };
     vkDeviceWaitIdle(device_);
 }
 
@@ -63,7 +71,13 @@ void VKDevice::CreateLogicalDevice(
     queueFamilyIndices_ = VKFindQueueFamilies(physicalDevice, (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT));
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<std::uint32_t> uniqueQueueFamilies = { queueFamilyIndices_.graphicsFamily, queueFamilyIndices_.presentFamily };
+    std::set<std::uint32_t> uniqueQueueFamilies =
+    {
+        queueFamilyIndices_.graphicsFamily,
+        queueFamilyIndices_.presentFamily,
+        queueFamilyIndices_.computeFamily,
+        queueFamilyIndices_.transferFamily,
+    };
 
     float queuePriority = 1.0f;
     for (auto family : uniqueQueueFamilies)
@@ -80,11 +94,34 @@ void VKDevice::CreateLogicalDevice(
         queueCreateInfos.push_back(info);
     }
 
+    /* Enable timeline semaphores if the extension is enabled (the feature is mandatory for this extension) */
+    #ifdef VK_KHR_timeline_semaphore
+    const bool timelineSemaphores = std::any_of(
+        extensions,
+        extensions + numExtensions,
+        [](const char* extension)
+        {
+            return (::strcmp(extension, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) == 0);
+        }
+    );
+
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures;
+    {
+        timelineSemaphoreFeatures.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+        timelineSemaphoreFeatures.pNext             = nullptr;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+    }
+    #endif // /VK_KHR_timeline_semaphore
+
     /* Create logical device */
     VkDeviceCreateInfo createInfo;
     {
         createInfo.sType                    = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        #ifdef VK_KHR_timeline_semaphore
+        createInfo.pNext                    = (timelineSemaphores ? &timelineSemaphoreFeatures : nullptr);
+        #else
         createInfo.pNext                    = nullptr;
+        #endif
         createInfo.flags                    = 0;
         createInfo.queueCreateInfoCount     = static_cast<std::uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos        = queueCreateInfos.data();
@@ -97,11 +134,19 @@ void VKDevice::CreateLogicalDevice(
     auto result = vkCreateDevice(physicalDevice, &createInfo, nullptr, device_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan logical device");
 
-    /* Query device graphics queue */
+    /* Query device graphics, compute, and transfer queues (they share the same VkQueue if they have the same family) */
     vkGetDeviceQueue(device_, queueFamilyIndices_.graphicsFamily, 0, &graphicsQueue_);
+    vkGetDeviceQueue(device_, queueFamilyIndices_.computeFamily, 0, &computeQueue_);
+    vkGetDeviceQueue(device_, queueFamilyIndices_.transferFamily, 0, &transferQueue_);
+
+    /* Share resources between all queue families, so they can be used on all queues without ownership transfers */
+    if (uniqueQueueFamilies.size() > 1)
+        sharedQueueFamilies_ = std::vector<std::uint32_t>(uniqueQueueFamilies.begin(), uniqueQueueFamilies.end());
 
-    /* Create default command pool */
-    commandPool_ = CreateCommandPool();
+    /* Store alignment for flushing and invalidating memory ranges that are not host coherent */
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    nonCoherentAtomSize_ = properties.limits.nonCoherentAtomSize;
 }
 
 VKPtr<VkCommandPool> VKDevice::CreateCommandPool()
@@ -126,18 +171,25 @@ VkCommandBuffer VKDevice::AllocCommandBuffer(bool begin)
 {
     VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
 
-    /* Allocate new primary level command buffer via staging command pool */
+    /* Allocate new primary level command buffer via staging command pool that is borrowed by the calling thread */
     VkCommandBufferAllocateInfo allocInfo;
     {
         allocInfo.sType                = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
         allocInfo.pNext                = nullptr;
-        allocInfo.commandPool          = commandPool_;
+        allocInfo.commandPool          = AcquireStagingCommandPool();
         allocInfo.level                = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         allocInfo.commandBufferCount   = 1;
     }
     auto result = vkAllocateCommandBuffers(device_, &allocInfo, &cmdBuffer);
+    if (result != VK_SUCCESS)
+        ReturnStagingCommandPool(allocInfo.commandPool);
     VKThrowIfFailed(result, "failed to allocate Vulkan command buffer");
 
+    {
+        std::lock_guard<std::mutex> guard { stagingCommandPoolsMutex_ };
+        borrowedStagingCommandPools_[cmdBuffer] = allocInfo.commandPool;
+    }
+
     /* Begin command buffer recording (if enabled) */
     if (begin)
     {
@@ -172,15 +224,36 @@ void VKDevice::FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release)
             submitInfo.commandBufferCount   = 1;
             submitInfo.pCommandBuffers      = (&cmdBuffer);
         }
-        vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence.GetVkFence());
+        {
+            std::lock_guard<std::mutex> guard { queueMutex_ };
+            result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, fence.GetVkFence());
+        }
+        VKThrowIfFailed(result, "failed to submit Vulkan staging command buffer");
 
-        /* Wait for fence to be signaled */
+        /* Wait for fence to be signaled (outside of the queue lock, so other threads can submit in the meantime) */
         fence.Wait(device_, std::numeric_limits<std::uint64_t>::max());
     }
 
     /* Release command buffer (if enabled) */
     if (release)
-        vkFreeCommandBuffers(device_, commandPool_, 1, &cmdBuffer);
+        ReleaseCommandBuffer(cmdBuffer);
+}
+
+void VKDevice::ReleaseCommandBuffer(VkCommandBuffer cmdBuffer)
+{
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    {
+        std::lock_guard<std::mutex> guard { stagingCommandPoolsMutex_ };
+        auto it = borrowedStagingCommandPools_.find(cmdBuffer);
+        if (it == borrowedStagingCommandPools_.end())
+            return;
+        commandPool = it->second;
+        borrowedStagingCommandPools_.erase(it);
+    }
+
+    /* Free command buffer before the pool can be borrowed by another thread */
+    vkFreeCommandBuffers(device_, commandPool, 1, &cmdBuffer);
+    ReturnStagingCommandPool(commandPool);
 }
 
 // Returns the image aspect for the specified Vulkan format
@@ -537,6 +610,75 @@ void VKDevice::FlushMappedBuffer(VKDeviceBuffer& buffer, VkDeviceSize size, VkDe
     }
 }
 
+/*
+Returns the memory range of the buffer's region within its chunk, widened to multiples of VkPhysicalDeviceLimits::nonCoherentAtomSize.
+The range is clamped to the end of the chunk, since the size must either be a multiple of the atom size or reach the end of the allocation.
+*/
+static VkMappedMemoryRange GetAlignedMappedMemoryRange(VKDeviceBuffer& buffer, VkDeviceSize nonCoherentAtomSize)
+{
+    auto region         = buffer.GetMemoryRegion();
+    auto chunk          = region->GetParentChunk();
+    const auto atomSize = std::max<VkDeviceSize>(1, nonCoherentAtomSize);
+    const auto begin    = (region->GetOffset() / atomSize) * atomSize;
+    const auto end      = ((region->GetOffsetWithSize() + atomSize - 1) / atomSize) * atomSize;
+
+    VkMappedMemoryRange memoryRange;
+    {
+        memoryRange.sType   = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        memoryRange.pNext   = nullptr;
+        memoryRange.memory  = chunk->GetVkDeviceMemory();
+        memoryRange.offset  = begin;
+        memoryRange.size    = (end < chunk->GetSize() ? end - begin : VK_WHOLE_SIZE);
+    }
+    return memoryRange;
+}
+
+void VKDevice::InvalidateMappedMemory(VKDeviceBuffer& buffer)
+{
+    if (buffer.GetMemoryRegion() != nullptr)
+    {
+        const auto memoryRange = GetAlignedMappedMemoryRange(buffer, nonCoherentAtomSize_);
+        auto result = vkInvalidateMappedMemoryRanges(device_, 1, &memoryRange);
+        VKThrowIfFailed(result, "failed to invalidate mapped memory range");
+    }
+}
+
+void VKDevice::FlushMappedMemory(VKDeviceBuffer& buffer)
+{
+    if (buffer.GetMemoryRegion() != nullptr)
+    {
+        const auto memoryRange = GetAlignedMappedMemoryRange(buffer, nonCoherentAtomSize_);
+        auto result = vkFlushMappedMemoryRanges(device_, 1, &memoryRange);
+        VKThrowIfFailed(result, "failed to flush mapped memory range");
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VkCommandPool VKDevice::AcquireStagingCommandPool()
+{
+    std::lock_guard<std::mutex> guard { stagingCommandPoolsMutex_ };
+
+    if (!freeStagingCommandPools_.empty())
+    {
+        auto commandPool = freeStagingCommandPools_.back();
+        freeStagingCommandPools_.pop_back();
+        return commandPool;
+    }
+
+    stagingCommandPools_.emplace_back(CreateCommandPool());
+    return stagingCommandPools_.back();
+}
+
+void VKDevice::ReturnStagingCommandPool(VkCommandPool commandPool)
+{
+    std::lock_guard<std::mutex> guard { stagingCommandPoolsMutex_ };
+    freeStagingCommandPools_.push_back(commandPool);
+}
+
 
 } // /namespace LLGL
 
@@ -14,6 +14,9 @@
 #include "VKPtr.h"
 #include "VKCore.h"
 #include "Buffer/VKDeviceBuffer.h"
+#include <vector>
+#include <unordered_map>
+#include <mutex>
 
 
 namespace LLGL
@@ -51,9 +54,15 @@ class VKDevice
 
         /* ----- Queue ----- */
 
+        // Allocates a primary command buffer from a staging command pool that is borrowed by the calling thread until the command buffer is released.
         VkCommandBuffer AllocCommandBuffer(bool begin = true);
+
+        // Submits the command buffer to the graphics queue and waits for its completion. The command buffer must have been allocated by the calling thread.
         void FlushCommandBuffer(VkCommandBuffer cmdBuffer, bool release = true);
 
+        // Releases the staging command buffer and returns its command pool, so other threads can borrow it again.
+        void ReleaseCommandBuffer(VkCommandBuffer cmdBuffer);
+
         /* ----- Buffer/Image operatons ----- */
 
         void TransitionImageLayout(
@@ -136,6 +145,12 @@ class VKDevice
         void WriteBuffer(VKDeviceBuffer& buffer, const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
         void FlushMappedBuffer(VKDeviceBuffer& buffer, VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
 
+        // Invalidates the memory region of the mapped buffer, so device writes become visible on the host also for memory that is not host coherent.
+        void InvalidateMappedMemory(VKDeviceBuffer& buffer);
+
+        // Flushes the memory region of the mapped buffer, so host writes become visible on the device also for memory that is not host coherent.
+        void FlushMappedMemory(VKDeviceBuffer& buffer);
+
         /* ----- Handles ----- */
 
         // Returns the native VkDevice handle.
@@ -168,18 +183,61 @@ class VKDevice
             return graphicsQueue_;
         }
 
-        // Returns the native VkCommandPool handle.
-        inline const VKPtr<VkCommandPool>& GetVkCommandPool() const
+        // Returns the native VkQueue handle of the dedicated compute queue, or the graphics queue if there is none.
+        inline VkQueue GetComputeVkQueue() const
         {
-            return commandPool_;
+            return computeQueue_;
         }
 
+        // Returns the native VkQueue handle of the dedicated transfer queue, or the compute queue if there is none.
+        inline VkQueue GetTransferVkQueue() const
+        {
+            return transferQueue_;
+        }
+
+        // Returns the list of all distinct queue families resources are shared with, or an empty list if there is only a single queue family.
+        inline const std::vector<std::uint32_t>& GetSharedQueueFamilies() const
+        {
+            return sharedQueueFamilies_;
+        }
+
+        /*
+        Returns the mutex that must be locked while commands are submitted to, presented on, or waited for on any of the device queues.
+        VkQueue objects must be externally synchronized, and staging command buffers are submitted from the threads that create resources.
+        */
+        inline std::mutex& GetQueueMutex() const
+        {
+            return queueMutex_;
+        }
+
+    private:
+
+        // Borrows a staging command pool that is not used by any other thread, or creates a new one if all pools are in use.
+        VkCommandPool AcquireStagingCommandPool();
+
+        // Returns the borrowed staging command pool to the free list.
+        void ReturnStagingCommandPool(VkCommandPool commandPool);
+
     private:
 
-        VKPtr<VkDevice>         device_;
-        QueueFamilyIndices      queueFamilyIndices_;
-        VkQueue                 graphicsQueue_      = VK_NULL_HANDLE;
-        VKPtr<VkCommandPool>    commandPool_;
+        VKPtr<VkDevice>             device_;
+        QueueFamilyIndices          queueFamilyIndices_;
+        VkQueue                     graphicsQueue_          = VK_NULL_HANDLE;
+        VkQueue                     computeQueue_           = VK_NULL_HANDLE;
+        VkQueue                     transferQueue_          = VK_NULL_HANDLE;
+        std::vector<std::uint32_t>  sharedQueueFamilies_;
+        VkDeviceSize                nonCoherentAtomSize_    = 1;
+
+        /*
+        Command pools must be externally synchronized, so each staging command buffer borrows a pool that no other thread uses until it is released.
+        The number of pools is bounded by the number of staging command buffers that are recorded at the same time, not by the number of threads.
+        */
+        std::vector<VKPtr<VkCommandPool>>                   stagingCommandPools_;
+        std::vector<VkCommandPool>                          freeStagingCommandPools_;
+        std::unordered_map<VkCommandBuffer, VkCommandPool>  borrowedStagingCommandPools_;
+        std::mutex                                          stagingCommandPoolsMutex_;
+
+        mutable std::mutex          queueMutex_;
 
 };
 
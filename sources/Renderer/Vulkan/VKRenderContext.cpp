@@ -41,7 +41,7 @@ static VKPtr<VkFramebuffer> NullVkFramebuffer(const VKPtr<VkDevice>& device)
 VKRenderContext::VKRenderContext(
     const VKPtr<VkInstance>&        instance,
     VkPhysicalDevice                physicalDevice,
-    const VKPtr<VkDevice>&          device,
+    const VKDevice&                 device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
     RenderContextDescriptor         desc,
     const std::shared_ptr<Surface>& surface)
@@ -49,11 +49,12 @@ VKRenderContext::VKRenderContext(
     RenderContext            { desc.videoMode, desc.vsync      },
     instance_                { instance                        },
     physicalDevice_          { physicalDevice                  },
-    device_                  { device                          },
+    device_                  { device.GetVkDevice()            },
     deviceMemoryMngr_        { deviceMemoryMngr                },
+    queueMutex_              { device.GetQueueMutex()          },
     surface_                 { instance, vkDestroySurfaceKHR   },
-    swapChain_               { device, vkDestroySwapchainKHR   },
-    swapChainRenderPass_     { device                          },
+    swapChain_               { device_, vkDestroySwapchainKHR  },
+    swapChainRenderPass_     { device_                         },
     swapChainSamples_        { GetClampedSamples(desc.samples) },
     swapChainImageViews_     { NullVkImageView(device_),
                                NullVkImageView(device_),
@@ -61,11 +62,11 @@ VKRenderContext::VKRenderContext(
     swapChainFramebuffers_   { NullVkFramebuffer(device_),
                                NullVkFramebuffer(device_),
                                NullVkFramebuffer(device_)      },
-    secondaryRenderPass_     { device                          },
-    depthStencilBuffer_      { device                          },
-    colorBuffers_            { device, device, device          },
-    imageAvailableSemaphore_ { device, vkDestroySemaphore      },
-    renderFinishedSemaphore_ { device, vkDestroySemaphore      }
+    secondaryRenderPass_     { device_                         },
+    depthStencilBuffer_      { device_                         },
+    colorBuffers_            { device_, device_, device_       },
+    imageAvailableSemaphore_ { device_, vkDestroySemaphore     },
+    renderFinishedSemaphore_ { device_, vkDestroySemaphore     }
 {
     SetOrCreateSurface(surface, desc.videoMode, nullptr);
     desc.videoMode = GetVideoMode();
@@ -102,8 +103,6 @@ void VKRenderContext::Present()
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores    = signalSemaphores;
     }
-    auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
-    VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
 
     /* Present result on screen */
     VkSwapchainKHR swapChains[] = { swapChain_ };
@@ -119,8 +118,17 @@ void VKRenderContext::Present()
         presentInfo.pImageIndices       = &presentImageIndex_;
         presentInfo.pResults            = nullptr;
     }
-    result = vkQueuePresentKHR(presentQueue_, &presentInfo);
-    VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
+
+    /* Submit and present under the device queue lock, since worker threads may submit to the same queues */
+    {
+        std::lock_guard<std::mutex> guard { queueMutex_ };
+
+        auto result = vkQueueSubmit(graphicsQueue_, 1, &submitInfo, VK_NULL_HANDLE);
+        VKThrowIfFailed(result, "failed to submit semaphore to Vulkan graphics queue");
+
+        result = vkQueuePresentKHR(presentQueue_, &presentInfo);
+        VKThrowIfFailed(result, "failed to present Vulkan graphics queue");
+    }
 
     /* Get image index for next presentation */
     AcquireNextPresentImage();
@@ -168,7 +176,10 @@ bool VKRenderContext::OnSetVideoMode(const VideoModeDescriptor& videoModeDesc)
     const auto& prevVideoMode = GetVideoMode();
 
     /* Wait until graphics queue is idle before resources are destroyed and recreated */
-    vkQueueWaitIdle(graphicsQueue_);
+    {
+        std::lock_guard<std::mutex> guard { queueMutex_ };
+        vkQueueWaitIdle(graphicsQueue_);
+    }
 
     /* Recreate presenting semaphores and Vulkan surface */
     CreatePresentSemaphores();
@@ -13,11 +13,13 @@
 #include <LLGL/RenderContext.h>
 #include "VKCore.h"
 #include "VKPtr.h"
+#include "VKDevice.h"
 #include "RenderState/VKRenderPass.h"
 #include "Texture/VKDepthStencilBuffer.h"
 #include "Texture/VKColorBuffer.h"
 #include <memory>
 #include <vector>
+#include <mutex>
 
 
 namespace LLGL
@@ -35,7 +37,7 @@ class VKRenderContext final : public RenderContext
         VKRenderContext(
             const VKPtr<VkInstance>&        instance,
             VkPhysicalDevice                physicalDevice,
-            const VKPtr<VkDevice>&          device,
+            const VKDevice&                 device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
             RenderContextDescriptor         desc,
             const std::shared_ptr<Surface>& surface
@@ -120,6 +122,7 @@ class VKRenderContext final : public RenderContext
         const VKPtr<VkDevice>&  device_;
 
         VKDeviceMemoryManager&  deviceMemoryMngr_;
+        std::mutex&             queueMutex_;                                    // Guards the graphics and present queue
 
         VKPtr<VkSurfaceKHR>     surface_;
         SurfaceSupportDetails   surfaceSupportDetails_;
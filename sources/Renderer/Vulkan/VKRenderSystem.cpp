@@ -9,6 +9,7 @@
 #include "VKRenderSystem.h"
 #include "Ext/VKExtensionLoader.h"
 #include "Ext/VKExtensions.h"
+#include "Ext/VKExtensionRegistry.h"
 #include "Memory/VKDeviceMemory.h"
 #include "../RenderSystemUtils.h"
 #include "../TextureUtils.h"
@@ -22,6 +23,7 @@
 #include "RenderState/VKComputePSO.h"
 #include <LLGL/Log.h>
 #include <LLGL/ImageFlags.h>
+#include <string.h>
 
 
 namespace LLGL
@@ -48,12 +50,45 @@ static void DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCall
 
 static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 {
-    if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
+    /* Staging buffers for read access are the destination of a copy from the device buffer in <MapBuffer> */
+    if ((cpuAccessFlags & CPUAccessFlags::ReadWrite) != 0)
         return VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
     else
         return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 }
 
+// Returns the memory properties for readback buffers. Host cached memory is preferred, since CPU reads from uncached memory are very slow.
+static VkMemoryPropertyFlags GetReadbackVkMemoryProperties(const VkPhysicalDeviceMemoryProperties& memoryProperties, std::uint32_t memoryTypeBits)
+{
+    const VkMemoryPropertyFlags candidates[] =
+    {
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT),
+    };
+
+    for (auto properties : candidates)
+    {
+        for (std::uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+        {
+            if ((memoryTypeBits & (1u << i)) != 0 && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+                return properties;
+        }
+    }
+
+    return (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+}
+
+// Writes the data into the mapped memory of a host visible buffer, and flushes it in case the memory is not host coherent.
+static void WriteHostVisibleBuffer(VKDevice& device, VKBuffer& bufferVK, const void* data, VkDeviceSize size, VkDeviceSize offset)
+{
+    if (auto mappedData = bufferVK.Map(device, CPUAccess::WriteOnly))
+    {
+        ::memcpy(reinterpret_cast<char*>(mappedData) + offset, data, static_cast<std::size_t>(size));
+        device.FlushMappedMemory(bufferVK.GetDeviceBuffer());
+        bufferVK.Unmap(device);
+    }
+}
+
 
 /* ----- Common ----- */
 
@@ -113,13 +148,43 @@ CommandQueue* VKRenderSystem::GetCommandQueue()
     return commandQueue_.get();
 }
 
+CommandQueue* VKRenderSystem::GetCommandQueueOfType(const CommandQueueType type)
+{
+    /* Fall back to the next more general queue if there is no dedicated queue family */
+    switch (type)
+    {
+        case CommandQueueType::Graphics:
+            break;
+        case CommandQueueType::Compute:
+            if (computeQueue_)
+                return computeQueue_.get();
+            break;
+        case CommandQueueType::Transfer:
+            if (transferQueue_)
+                return transferQueue_.get();
+            if (computeQueue_)
+                return computeQueue_.get();
+            break;
+    }
+    return commandQueue_.get();
+}
+
 /* ----- Command buffers ----- */
 
 CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
+    /* Allocate command buffer for the queue family it will be submitted to */
+    auto commandQueueVK = LLGL_CAST(VKCommandQueue*, GetCommandQueueOfType(desc.queueType));
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), desc)
+        MakeUnique<VKCommandBuffer>(
+            physicalDevice_,
+            device_,
+            commandQueueVK->GetVkQueue(),
+            commandQueueVK->GetQueueFamilyIndex(),
+            device_.GetQueueFamilyIndices(),
+            desc
+        )
     );
 }
 
@@ -134,6 +199,25 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 {
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
+    /* Create primary buffer object */
+    auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, desc, device_.GetSharedQueueFamilies()));
+
+    if (buffer->IsHostVisible())
+    {
+        /* Allocate readback buffers in host visible (and preferably host cached) memory, so copy commands write directly into CPU readable memory */
+        const auto& requirements = buffer->GetDeviceBuffer().GetRequirements();
+        auto memoryRegion = deviceMemoryMngr_->Allocate(
+            requirements,
+            GetReadbackVkMemoryProperties(physicalDevice_.GetMemoryProperties(), requirements.memoryTypeBits)
+        );
+        buffer->BindMemoryRegion(device_, memoryRegion);
+
+        if (initialData != nullptr)
+            WriteHostVisibleBuffer(device_, *buffer, initialData, static_cast<VkDeviceSize>(desc.size), 0);
+
+        return buffer;
+    }
+
     /* Create staging buffer */
     VkBufferCreateInfo stagingCreateInfo;
     BuildVkBufferCreateInfo(
@@ -144,9 +228,6 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 
     auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
 
-    /* Create primary buffer object */
-    auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, desc));
-
     /* Allocate device memory */
     auto memoryRegion = deviceMemoryMngr_->Allocate(
         buffer->GetDeviceBuffer().GetRequirements(),
@@ -196,7 +277,12 @@ void VKRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, con
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
+    if (bufferVK.IsHostVisible())
+    {
+        /* Copy data directly to host visible buffer memory */
+        WriteHostVisibleBuffer(device_, bufferVK, data, dataSize, dstOffset);
+    }
+    else if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
         /* Copy data to staging buffer memory */
         device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, dstOffset);
@@ -228,6 +314,15 @@ void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    if (bufferVK.IsHostVisible())
+    {
+        /* Map host visible buffer directly; the client synchronizes with the GPU, e.g. by waiting for a fence */
+        auto mappedData = bufferVK.Map(device_, access);
+        if (mappedData != nullptr && access != CPUAccess::WriteOnly && access != CPUAccess::WriteDiscard)
+            device_.InvalidateMappedMemory(bufferVK.GetDeviceBuffer());
+        return mappedData;
+    }
+
     if (auto stagingBuffer = bufferVK.GetStagingVkBuffer())
     {
         /* Copy GPU local buffer into staging buffer for read accces */
@@ -245,6 +340,13 @@ void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    if (bufferVK.IsHostVisible())
+    {
+        /* Unmap host visible buffer */
+        bufferVK.Unmap(device_);
+        return;
+    }
+
     if (auto stagingBuffer = bufferVK.GetStagingVkBuffer())
     {
         /* Unmap staging buffer */
@@ -326,7 +428,7 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
     auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, initialDataSize);
 
     /* Create device texture */
-    auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
+    auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc, device_.GetSharedQueueFamilies());
 
     /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
     auto cmdBuffer = device_.AllocCommandBuffer();
@@ -558,12 +660,26 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
 
 Sampler* VKRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, desc));
+    auto createSampler = [this, &desc]() -> Sampler*
+    {
+        return TakeOwnership(samplers_, MakeUnique<VKSampler>(device_, desc));
+    };
+
+    if (GetConfiguration().samplerCache)
+        return samplerCache_.Acquire(desc, createSampler);
+    else
+        return createSampler();
 }
 
 void VKRenderSystem::Release(Sampler& sampler)
 {
-    RemoveFromUniqueSet(samplers_, &sampler);
+    if (samplerCache_.Release(sampler))
+        RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+SamplerCacheStatistics VKRenderSystem::GetSamplerCacheStatistics() const
+{
+    return samplerCache_.GetStatistics();
 }
 
 /* ----- Resource Heaps ----- */
@@ -611,7 +727,7 @@ void VKRenderSystem::Release(RenderTarget& renderTarget)
 Shader* VKRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
     AssertCreateShader(desc);
-    return TakeOwnership(shaders_, MakeUnique<VKShader>(device_, desc));
+    return TakeOwnership(shaders_, MakeUnique<VKShader>(device_, desc, &shaderReflectionCache_));
 }
 
 ShaderProgram* VKRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
@@ -692,7 +808,8 @@ void VKRenderSystem::Release(QueryHeap& queryHeap)
 
 Fence* VKRenderSystem::CreateFence()
 {
-    return TakeOwnership(fences_, MakeUnique<VKFence>(device_));
+    /* Use timeline semaphores if supported, so fences can be signaled with 64-bit values and waited for across queues */
+    return TakeOwnership(fences_, MakeUnique<VKFence>(device_, HasExtension(VKExt::KHR_timeline_semaphore)));
 }
 
 void VKRenderSystem::Release(Fence& fence)
@@ -814,7 +931,7 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL VKDebugCallback(
     void*                       userData)
 {
     //auto renderSystemVK = reinterpret_cast<VKRenderSystem*>(userData);
-    Log::PostReport(ToReportType(flags), message, "vkDebugReportCallback");
+    Log::PostReportFormat(ToReportType(flags), "%s", { message }, "vkDebugReportCallback");
     return VK_FALSE;
 }
 
@@ -867,8 +984,19 @@ void VKRenderSystem::CreateLogicalDevice()
     /* Create logical device with all supported physical device feature */
     device_ = physicalDevice_.CreateLogicalDevice();
 
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
+    /* Create command queue interfaces, and additional ones for dedicated compute and transfer queue families */
+    const auto& queueFamilyIndices = device_.GetQueueFamilyIndices();
+
+    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue(), queueFamilyIndices.graphicsFamily);
+
+    if (queueFamilyIndices.computeFamily != queueFamilyIndices.graphicsFamily)
+        computeQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetComputeVkQueue(), queueFamilyIndices.computeFamily);
+
+    if (queueFamilyIndices.transferFamily != queueFamilyIndices.graphicsFamily &&
+        queueFamilyIndices.transferFamily != queueFamilyIndices.computeFamily)
+    {
+        transferQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetTransferVkQueue(), queueFamilyIndices.transferFamily);
+    }
 
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
@@ -13,6 +13,7 @@
 #include "VKPhysicalDevice.h"
 #include "VKDevice.h"
 #include "../ContainerTypes.h"
+#include "../SamplerCache.h"
 #include "Memory/VKDeviceMemoryManager.h"
 
 #include "VKCommandQueue.h"
@@ -24,6 +25,7 @@
 
 #include "Shader/VKShader.h"
 #include "Shader/VKShaderProgram.h"
+#include "Shader/VKShaderReflectionCache.h"
 
 #include "Texture/VKTexture.h"
 #include "Texture/VKSampler.h"
@@ -47,6 +49,13 @@ namespace LLGL
 {
 
 
+/*
+Vulkan render system.
+Resources (buffers, textures, samplers, shaders, pipeline states etc.) can be created and released from multiple worker threads concurrently:
+the hardware object containers are thread-safe, the device memory manager is lock-striped by memory type,
+each staging command buffer borrows a command pool that no other thread uses at the same time, and all queue submissions are serialized by the device queue lock.
+Recording and submitting command buffers and presenting render contexts still requires external synchronization by the client.
+*/
 class VKRenderSystem final : public RenderSystem
 {
 
@@ -66,6 +75,7 @@ class VKRenderSystem final : public RenderSystem
         /* ----- Command queues ----- */
 
         CommandQueue* GetCommandQueue() override;
+        CommandQueue* GetCommandQueueOfType(const CommandQueueType type) override;
 
         /* ----- Command buffers ----- */
 
@@ -101,6 +111,8 @@ class VKRenderSystem final : public RenderSystem
 
         void Release(Sampler& sampler) override;
 
+        SamplerCacheStatistics GetSamplerCacheStatistics() const override;
+
         /* ----- Resource Heaps ----- */
 
         ResourceHeap* CreateResourceHeap(const ResourceHeapDescriptor& desc) override;
@@ -190,24 +202,30 @@ class VKRenderSystem final : public RenderSystem
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
+        VKShaderReflectionCache                 shaderReflectionCache_; // Must outlive all shaders, which unregister their modules on destruction
+
         /* ----- Hardware object containers ----- */
 
-        HWObjectContainer<VKRenderContext>      renderContexts_;
-        HWObjectInstance<VKCommandQueue>        commandQueue_;
-        HWObjectContainer<VKCommandBuffer>      commandBuffers_;
-        HWObjectContainer<VKBuffer>             buffers_;
-        HWObjectContainer<VKBufferArray>        bufferArrays_;
-        HWObjectContainer<VKTexture>            textures_;
-        HWObjectContainer<VKSampler>            samplers_;
-        HWObjectContainer<VKRenderPass>         renderPasses_;
-        HWObjectContainer<VKRenderTarget>       renderTargets_;
-        HWObjectContainer<VKShader>             shaders_;
-        HWObjectContainer<VKShaderProgram>      shaderPrograms_;
-        HWObjectContainer<VKPipelineLayout>     pipelineLayouts_;
-        HWObjectContainer<VKPipelineState>      pipelineStates_;
-        HWObjectContainer<VKResourceHeap>       resourceHeaps_;
-        HWObjectContainer<VKQueryHeap>          queryHeaps_;
-        HWObjectContainer<VKFence>              fences_;
+        HWObjectContainer<VKRenderContext, true>     renderContexts_;
+        HWObjectInstance<VKCommandQueue>             commandQueue_;
+        HWObjectInstance<VKCommandQueue>             computeQueue_;    // Only created for a dedicated compute queue family
+        HWObjectInstance<VKCommandQueue>             transferQueue_;   // Only created for a dedicated transfer queue family
+        HWObjectContainer<VKCommandBuffer, true>     commandBuffers_;
+        HWObjectContainer<VKBuffer, true>            buffers_;
+        HWObjectContainer<VKBufferArray, true>       bufferArrays_;
+        HWObjectContainer<VKTexture, true>           textures_;
+        HWObjectContainer<VKSampler, true>           samplers_;
+        HWObjectContainer<VKRenderPass, true>        renderPasses_;
+        HWObjectContainer<VKRenderTarget, true>      renderTargets_;
+        HWObjectContainer<VKShader, true>            shaders_;
+        HWObjectContainer<VKShaderProgram, true>     shaderPrograms_;
+        HWObjectContainer<VKPipelineLayout, true>    pipelineLayouts_;
+        HWObjectContainer<VKPipelineState, true>     pipelineStates_;
+        HWObjectContainer<VKResourceHeap, true>      resourceHeaps_;
+        HWObjectContainer<VKQueryHeap, true>         queryHeaps_;
+        HWObjectContainer<VKFence, true>             fences_;
+
+        SamplerCache                            samplerCache_;
 
 };
 
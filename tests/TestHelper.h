@@ -0,0 +1,48 @@
+/*
+ * TestHelper.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TEST_HELPER_H
+#define LLGL_TEST_HELPER_H
+
+
+#include <iostream>
+#include <string>
+
+
+// Returns the number of failed checks of the current test.
+inline int& GetNumFailedChecks()
+{
+    static int numFailedChecks = 0;
+    return numFailedChecks;
+}
+
+// Prints whether the check with the specified name has passed and counts the failed checks.
+inline void Check(bool condition, const std::string& name)
+{
+    std::cout << (condition ? "passed: " : "FAILED: ") << name << std::endl;
+    if (!condition)
+        ++GetNumFailedChecks();
+}
+
+// Prints the number of failed checks (if any) and returns the exit code of the test, i.e. 1 if any check has failed.
+inline int ReportChecks()
+{
+    const int numFailedChecks = GetNumFailedChecks();
+    if (numFailedChecks > 0)
+    {
+        std::cerr << numFailedChecks << " test(s) failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+
+#endif
+
+
+
+// ================================================================================
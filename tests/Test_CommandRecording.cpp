@@ -0,0 +1,477 @@
+/*
+ * Test_CommandRecording.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_CommandRecording [RENDERER] [-debug] [-frames N] [-draws N]
+ *
+ * Measures the CPU overhead of recording synthetic frames into command buffers and prints the results as CSV to the standard output.
+ * Each row reports the average time per recorded command, the time per frame, and the number/size of heap allocations per frame.
+ * The GPU work is submitted after each frame, but only the encoding (Begin to End) is measured.
+ * On OpenGL, the multi-submit command buffers are JIT compiled if LLGL was built with LLGL_ENABLE_JIT_COMPILER; to compare them against
+ * the interpreted command buffers, run this test with a build without the JIT compiler. The uniforms pattern is skipped if the shader has no "tint" uniform (e.g. with SPIR-V).
+ */
+
+
+// Allocation counters that are only active while a frame is being recorded
+static std::atomic<bool>            g_countAllocs   { false };
+static std::atomic<std::uint64_t>   g_numAllocs     { 0 };
+static std::atomic<std::uint64_t>   g_allocBytes    { 0 };
+
+void* operator new (std::size_t size)
+{
+    if (g_countAllocs.load(std::memory_order_relaxed))
+    {
+        g_numAllocs.fetch_add(1, std::memory_order_relaxed);
+        g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (auto ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct TestConfig
+{
+    std::string     rendererModule  = "OpenGL";
+    bool            debugLayer      = false;
+    std::uint32_t   numFrames       = 200;
+    std::uint32_t   numDraws        = 1000;
+};
+
+// State change patterns that are applied between two draw calls.
+enum class StatePattern
+{
+    None,
+    Pipeline,
+    ResourceHeap,
+    VertexBuffer,
+    Viewport,
+    Uniforms,
+};
+
+static const char* ToString(const StatePattern pattern)
+{
+    switch (pattern)
+    {
+        case StatePattern::None:            return "draws";
+        case StatePattern::Pipeline:        return "pipeline";
+        case StatePattern::ResourceHeap:    return "resource_heap";
+        case StatePattern::VertexBuffer:    return "vertex_buffer";
+        case StatePattern::Viewport:        return "viewport";
+        case StatePattern::Uniforms:        return "uniforms";
+    }
+    return "";
+}
+
+static const char* g_vertexShaderGLSL =
+    "#version 420\n"
+    "layout(location = 0) in vec2 coord;\n"
+    "layout(location = 1) in vec2 texCoord;\n"
+    "layout(location = 2) in vec3 color;\n"
+    "layout(std140, binding = 2) uniform Matrices { mat4 projection; mat4 modelView; };\n"
+    "uniform vec4 tint;\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_Position = projection * modelView * vec4(coord, 0, 1);\n"
+    "    vColor = vec4(color, 1) * tint + vec4(texCoord, 0, 0);\n"
+    "}\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 420\n"
+    "in vec4 vColor;\n"
+    "layout(std140, binding = 5) uniform Colors { vec4 diffuse; };\n"
+    "out vec4 fColor;\n"
+    "void main() {\n"
+    "    fColor = diffuse * vColor;\n"
+    "}\n";
+
+class CommandRecordingTest
+{
+
+    private:
+
+        LLGL::RenderingProfiler             profiler;
+        LLGL::RenderingDebugger             debugger;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::RenderContext*                context         = nullptr;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                primaryCommands = nullptr;
+
+        LLGL::Buffer*                       vertexBuffers[2]    = {};
+        LLGL::Buffer*                       constantBuffers[2]  = {};
+        LLGL::PipelineLayout*               pipelineLayout      = nullptr;
+        LLGL::ResourceHeap*                 resourceHeaps[2]    = {};
+        LLGL::ShaderProgram*                shaderProgram       = nullptr;
+        LLGL::PipelineState*                pipelines[2]        = {};
+        LLGL::UniformLocation               tintLocation        = -1;
+
+        TestConfig                          config;
+
+    private:
+
+        void CreateResources()
+        {
+            // Create vertex buffers
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "coord",    LLGL::Format::RG32Float  });
+            vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float  });
+            vertexFormat.AppendAttribute({ "color",    LLGL::Format::RGB32Float });
+
+            const float vertices[] =
+            {
+                -1.0f,  1.0f,   0.0f, 1.0f,   1.0f, 1.0f, 1.0f,
+                -1.0f, -1.0f,   0.0f, 0.0f,   1.0f, 1.0f, 1.0f,
+                 1.0f,  1.0f,   1.0f, 1.0f,   1.0f, 1.0f, 1.0f,
+                 1.0f, -1.0f,   1.0f, 0.0f,   1.0f, 1.0f, 1.0f,
+            };
+
+            for (auto& buffer : vertexBuffers)
+                buffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            // Create constant buffers
+            const float matrices[32] =
+            {
+                1.0f, 0.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f, 0.0f,   0.0f, 0.0f, 0.0f, 1.0f,
+                1.0f, 0.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f, 0.0f,   0.0f, 0.0f, 0.0f, 1.0f,
+            };
+            const LLGL::ColorRGBAf diffuse { 1.0f, 1.0f, 1.0f, 1.0f };
+
+            constantBuffers[0] = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(matrices)), matrices);
+            constantBuffers[1] = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(diffuse)), &diffuse);
+
+            // Create sampler and 1x1 texture, which are only used by the SPIR-V shaders
+            const std::uint32_t texel = 0xFFFFFFFF;
+
+            LLGL::SrcImageDescriptor imageDesc;
+            {
+                imageDesc.data      = &texel;
+                imageDesc.dataSize  = sizeof(texel);
+            }
+            auto texture = renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, 1, 1), &imageDesc);
+            auto sampler = renderer->CreateSampler({});
+
+            // Create pipeline layout and two resource heaps with the same layout
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            layoutDesc.bindings =
+            {
+                LLGL::BindingDescriptor { LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::VertexStage  , 2 },
+                LLGL::BindingDescriptor { LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::FragmentStage, 5 },
+                LLGL::BindingDescriptor { LLGL::ResourceType::Sampler, 0,                               LLGL::StageFlags::FragmentStage, 3 },
+                LLGL::BindingDescriptor { LLGL::ResourceType::Texture, 0,                               LLGL::StageFlags::FragmentStage, 4 },
+            };
+            pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+            for (auto& heap : resourceHeaps)
+            {
+                LLGL::ResourceHeapDescriptor heapDesc;
+                {
+                    heapDesc.pipelineLayout = pipelineLayout;
+                    heapDesc.resourceViews  = { constantBuffers[0], constantBuffers[1], sampler, texture };
+                }
+                heap = renderer->CreateResourceHeap(heapDesc);
+            }
+
+            // Create shader program
+            LLGL::ShaderDescriptor vertShaderDesc, fragShaderDesc;
+
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            if (std::find(languages.begin(), languages.end(), LLGL::ShadingLanguage::SPIRV) != languages.end())
+            {
+                vertShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Vertex,   "Shaders/Triangle.vert.spv");
+                fragShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Fragment, "Shaders/Triangle.frag.spv");
+            }
+            else
+            {
+                vertShaderDesc = { LLGL::ShaderType::Vertex,   g_vertexShaderGLSL   };
+                fragShaderDesc = { LLGL::ShaderType::Fragment, g_fragmentShaderGLSL };
+                vertShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+                fragShaderDesc.sourceType = LLGL::ShaderSourceType::CodeString;
+            }
+
+            vertShaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader      = renderer->CreateShader(vertShaderDesc);
+                shaderProgramDesc.fragmentShader    = renderer->CreateShader(fragShaderDesc);
+            }
+            shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            tintLocation = shaderProgram->FindUniformLocation("tint");
+
+            // Create two pipelines that only differ in their primitive topology
+            for (int i = 0; i < 2; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.shaderProgram      = shaderProgram;
+                    pipelineDesc.renderPass         = context->GetRenderPass();
+                    pipelineDesc.pipelineLayout     = pipelineLayout;
+                    pipelineDesc.primitiveTopology  = (i == 0 ? LLGL::PrimitiveTopology::TriangleStrip : LLGL::PrimitiveTopology::TriangleList);
+                }
+                pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+            }
+        }
+
+        // Records one synthetic frame and returns the number of recorded commands.
+        std::uint64_t RecordFrame(LLGL::CommandBuffer& commands, const StatePattern pattern)
+        {
+            const auto resolution = context->GetResolution();
+            const LLGL::Viewport viewports[2] =
+            {
+                LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(resolution.width), static_cast<float>(resolution.height) },
+                LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(resolution.width / 2), static_cast<float>(resolution.height / 2) },
+            };
+            const LLGL::ColorRGBAf tints[2] = { { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.5f, 0.5f, 0.5f, 1.0f } };
+
+            std::uint64_t numCommands = 0;
+
+            commands.Begin();
+            {
+                commands.SetVertexBuffer(*vertexBuffers[0]);
+                commands.BeginRenderPass(*context);
+                {
+                    commands.SetViewport(viewports[0]);
+                    commands.SetPipelineState(*pipelines[0]);
+                    commands.SetResourceHeap(*resourceHeaps[0]);
+                    numCommands += 6;
+
+                    for (std::uint32_t i = 0; i < config.numDraws; ++i)
+                    {
+                        const auto index = (i & 1);
+                        switch (pattern)
+                        {
+                            case StatePattern::None:
+                                break;
+                            case StatePattern::Pipeline:
+                                commands.SetPipelineState(*pipelines[index]);
+                                commands.SetResourceHeap(*resourceHeaps[0]);
+                                numCommands += 2;
+                                break;
+                            case StatePattern::ResourceHeap:
+                                commands.SetResourceHeap(*resourceHeaps[index]);
+                                numCommands += 1;
+                                break;
+                            case StatePattern::VertexBuffer:
+                                commands.SetVertexBuffer(*vertexBuffers[index]);
+                                numCommands += 1;
+                                break;
+                            case StatePattern::Viewport:
+                                commands.SetViewport(viewports[index]);
+                                numCommands += 1;
+                                break;
+                            case StatePattern::Uniforms:
+                                commands.SetUniform(tintLocation, &tints[index], sizeof(tints[index]));
+                                numCommands += 1;
+                                break;
+                        }
+                        commands.Draw(4, 0);
+                        numCommands += 1;
+                    }
+                }
+                commands.EndRenderPass();
+                numCommands += 1;
+            }
+            commands.End();
+            numCommands += 1;
+
+            return numCommands;
+        }
+
+        void MeasureRecording(const char* commandBufferName, long commandBufferFlags, const StatePattern pattern)
+        {
+            LLGL::CommandBufferDescriptor cmdBufferDesc;
+            {
+                cmdBufferDesc.flags = commandBufferFlags;
+            }
+            auto commands = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+            std::uint64_t numCommands = 0, elapsedTime = 0, numAllocs = 0, allocBytes = 0;
+
+            for (std::uint32_t frame = 0; frame < config.numFrames; ++frame)
+            {
+                // Measure encoding of the current frame only
+                g_numAllocs     = 0;
+                g_allocBytes    = 0;
+                g_countAllocs   = true;
+
+                const auto startTime = std::chrono::steady_clock::now();
+                numCommands += RecordFrame(*commands, pattern);
+                const auto endTime = std::chrono::steady_clock::now();
+
+                g_countAllocs   = false;
+
+                elapsedTime += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+                numAllocs   += g_numAllocs;
+                allocBytes  += g_allocBytes;
+
+                // Submit frame; secondary command buffers must be executed by a primary command buffer
+                if ((commandBufferFlags & LLGL::CommandBufferFlags::DeferredSubmit) != 0)
+                {
+                    primaryCommands->Begin();
+                    primaryCommands->Execute(*commands);
+                    primaryCommands->End();
+                    commandQueue->Submit(*primaryCommands);
+                }
+                else
+                    commandQueue->Submit(*commands);
+
+                context->Present();
+            }
+
+            commandQueue->WaitIdle();
+            renderer->Release(*commands);
+
+            // Print results as CSV row
+            const double numFrames = static_cast<double>(config.numFrames);
+            std::cout << config.rendererModule << ',' << (config.debugLayer ? 1 : 0) << ',' << commandBufferName << ',' << ToString(pattern) << ',';
+            std::cout << config.numDraws << ',' << config.numFrames << ',' << (static_cast<double>(numCommands) / numFrames) << ',';
+            std::cout << (static_cast<double>(elapsedTime) / static_cast<double>(numCommands)) << ',';
+            std::cout << (static_cast<double>(elapsedTime) / numFrames) << ',';
+            std::cout << (static_cast<double>(numAllocs) / numFrames) << ',';
+            std::cout << (static_cast<double>(allocBytes) / numFrames) << std::endl;
+        }
+
+        // Loads the renderer and creates all resources.
+        void LoadRenderer()
+        {
+            // Load renderer (with debug layer if enabled)
+            if (config.debugLayer)
+                renderer = LLGL::RenderSystem::Load(config.rendererModule, &profiler, &debugger);
+            else
+                renderer = LLGL::RenderSystem::Load(config.rendererModule);
+
+            // Create render context without vsync, so presenting does not throttle the measurement
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution    = { 640, 480 };
+                contextDesc.vsync.enabled           = false;
+            }
+            context = renderer->CreateRenderContext(contextDesc);
+
+            // Get command queue and create primary command buffer to execute secondary command buffers
+            commandQueue    = renderer->GetCommandQueue();
+            primaryCommands = renderer->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void MeasureAllPatterns(const char* commandBufferName, long commandBufferFlags)
+        {
+            const StatePattern patterns[] =
+            {
+                StatePattern::None,
+                StatePattern::Pipeline,
+                StatePattern::ResourceHeap,
+                StatePattern::VertexBuffer,
+                StatePattern::Viewport,
+                StatePattern::Uniforms,
+            };
+
+            for (auto pattern : patterns)
+            {
+                // Uniforms can only be set if the shader has a uniform that is not part of a constant buffer (not the case for SPIR-V)
+                if (pattern == StatePattern::Uniforms && tintLocation < 0)
+                    continue;
+                MeasureRecording(commandBufferName, commandBufferFlags, pattern);
+            }
+        }
+
+    public:
+
+        void Load(const TestConfig& testConfig)
+        {
+            // Store test configuration
+            config = testConfig;
+            LoadRenderer();
+        }
+
+        void Run()
+        {
+            struct CommandBufferConfig
+            {
+                const char* name;
+                long        flags;
+            };
+
+            std::vector<CommandBufferConfig> cmdBufferConfigs =
+            {
+                /* GLImmediateCommandBuffer on OpenGL, primary command buffer on other backends */
+                { "primary",      0                                     },
+                /* GLDeferredCommandBuffer with JIT compilation on OpenGL (if LLGL_ENABLE_JIT_COMPILER is enabled) */
+                { "multi_submit", LLGL::CommandBufferFlags::MultiSubmit },
+            };
+
+            /* GLDeferredCommandBuffer without JIT compilation; other backends cannot begin a render pass inside a secondary command buffer */
+            if (renderer->GetRendererID() == LLGL::RendererID::OpenGL)
+                cmdBufferConfigs.push_back({ "secondary", LLGL::CommandBufferFlags::DeferredSubmit });
+
+            std::cout << "renderer,debug_layer,command_buffer,pattern,draws,frames,commands_per_frame,ns_per_command,ns_per_frame,allocs_per_frame,alloc_bytes_per_frame" << std::endl;
+
+            for (const auto& cmdBufferConfig : cmdBufferConfigs)
+                MeasureAllPatterns(cmdBufferConfig.name, cmdBufferConfig.flags);
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    TestConfig testConfig;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-debug") == 0)
+            testConfig.debugLayer = true;
+        else if (std::strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+            testConfig.numFrames = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "-draws") == 0 && i + 1 < argc)
+            testConfig.numDraws = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else
+            testConfig.rendererModule = argv[i];
+    }
+
+    try
+    {
+        CommandRecordingTest test;
+        test.Load(testConfig);
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
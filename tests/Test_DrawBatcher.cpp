@@ -0,0 +1,386 @@
+/*
+ * Test_DrawBatcher.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <LLGL/DrawBatcher.h>
+#include "TestHelper.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_DrawBatcher
+ *
+ * Adds draw packets with two pipeline states and two resource heaps in an interleaved order from two threads to a DrawBatcher
+ * and renders them on the OpenGL backend three times into an offscreen render target:
+ * with the sorted multi-draw-indirect commands (DrawBatcher::Execute), with the sorted plain draw commands (DrawBatcher::ExecuteDirect),
+ * and with one plain draw command per packet in the order the packets were added, as reference.
+ * All three images must be equal. Each instance covers its own cell of the render target, so the draw order does not affect the result.
+ */
+
+
+static const char* g_vertexShaderGLSL =
+    "#version 420\n"
+    "in vec2 position;\n"
+    "in vec2 offset;\n"
+    "in vec4 color;\n"
+    "layout(std140, binding = 1) uniform Settings { vec4 tint; };\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position + offset, 0, 1);\n"
+    "    vColor = color * tint;\n"
+    "}\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 420\n"
+    "in vec4 vColor;\n"
+    "out vec4 fColor;\n"
+    "void main() {\n"
+    "    fColor = vColor;\n"
+    "}\n";
+
+class DrawBatcherTest
+{
+
+    private:
+
+        // Per-instance data: offset of the grid cell in NDC and color.
+        struct Instance
+        {
+            float offset[2];
+            float color[4];
+        };
+
+        // Draw packet in the order it was added, with the offset to its instance data.
+        struct ReferenceDraw
+        {
+            LLGL::DrawPacket    packet;
+            std::uint32_t       firstInstance;
+        };
+
+        static const std::uint32_t          gridSize        = 8;
+        static const std::uint32_t          resolution      = 64;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                commands        = nullptr;
+
+        LLGL::VertexFormat                  vertexFormat;
+        LLGL::VertexFormat                  instanceFormat;
+        LLGL::Buffer*                       vertexBuffer    = nullptr;
+        LLGL::Buffer*                       indexBuffer     = nullptr;
+        LLGL::PipelineLayout*               pipelineLayout  = nullptr;
+        LLGL::ResourceHeap*                 resourceHeaps[2]    = {};
+        LLGL::PipelineState*                pipelines[2]        = {};
+        LLGL::Texture*                      targetTexture   = nullptr;
+        LLGL::RenderTarget*                 renderTarget    = nullptr;
+
+        std::vector<Instance>               referenceInstances;
+        std::vector<ReferenceDraw>          referenceDraws;
+
+    private:
+
+        void CreateResources()
+        {
+            // Create vertex buffer with a quad that covers one grid cell and a triangle that covers half of it
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float, 0 });
+            vertexFormat.SetSlot(0);
+
+            instanceFormat.AppendAttribute({ "offset", LLGL::Format::RG32Float,   1, 1 });
+            instanceFormat.AppendAttribute({ "color",  LLGL::Format::RGBA32Float, 2, 1 });
+            instanceFormat.SetSlot(1);
+
+            const float cellSize = 2.0f / static_cast<float>(gridSize);
+            const float vertices[] =
+            {
+                0.0f, 0.0f,   0.0f, cellSize,   cellSize, 0.0f,   cellSize, cellSize,
+                0.0f, 0.0f,   0.0f, cellSize,   cellSize, 0.0f,
+            };
+            vertexBuffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            // Create index buffer: quad at first index 0, triangle at first index 6 (with vertex offset 4)
+            const std::uint32_t indices[] = { 0, 1, 2, 2, 1, 3,   0, 1, 2 };
+            indexBuffer = renderer->CreateBuffer(LLGL::IndexBufferDesc(sizeof(indices), LLGL::Format::R32UInt), indices);
+
+            // Create two resource heaps with different tint colors
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings =
+                {
+                    LLGL::BindingDescriptor{ LLGL::ResourceType::Buffer, LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::VertexStage, 1 },
+                };
+            }
+            pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+            const LLGL::ColorRGBAf tints[2] = { { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.5f, 1.0f, 0.25f, 1.0f } };
+
+            for (int i = 0; i < 2; ++i)
+            {
+                auto constantBuffer = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(tints[i])), &tints[i]);
+
+                LLGL::ResourceHeapDescriptor heapDesc;
+                {
+                    heapDesc.pipelineLayout = pipelineLayout;
+                    heapDesc.resourceViews  = { constantBuffer };
+                }
+                resourceHeaps[i] = renderer->CreateResourceHeap(heapDesc);
+            }
+
+            // Create offscreen render target
+            targetTexture = renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, resolution, resolution));
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution     = { resolution, resolution };
+                renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, targetTexture } };
+            }
+            renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+            // Create shader program
+            LLGL::ShaderDescriptor vertShaderDesc { LLGL::ShaderType::Vertex,   g_vertexShaderGLSL   };
+            LLGL::ShaderDescriptor fragShaderDesc { LLGL::ShaderType::Fragment, g_fragmentShaderGLSL };
+            {
+                vertShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+                fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+                vertShaderDesc.vertex.inputAttribs.insert(
+                    vertShaderDesc.vertex.inputAttribs.end(), instanceFormat.attributes.begin(), instanceFormat.attributes.end()
+                );
+            }
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader      = renderer->CreateShader(vertShaderDesc);
+                shaderProgramDesc.fragmentShader    = renderer->CreateShader(fragShaderDesc);
+            }
+            auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            // Create two pipelines; the second one does not write the green channel, so binding the wrong pipeline changes the image
+            for (int i = 0; i < 2; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.shaderProgram                  = shaderProgram;
+                    pipelineDesc.renderPass                     = renderTarget->GetRenderPass();
+                    pipelineDesc.pipelineLayout                 = pipelineLayout;
+                    pipelineDesc.blend.targets[0].colorMask     = { true, (i == 0), true, true };
+                }
+                pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+            }
+        }
+
+        // Adds the draw packets to the batcher and stores them in the same order for the reference pass.
+        void AddDrawPackets(LLGL::DrawBatcher& batcher)
+        {
+            const float cellSize = 2.0f / static_cast<float>(gridSize);
+
+            std::uint32_t cell = 0;
+
+            for (std::uint32_t i = 0; cell < gridSize * gridSize; ++i)
+            {
+                // Interleave pipeline states and resource heaps, and vary the mesh and number of instances
+                LLGL::DrawPacket packet;
+                {
+                    packet.pipelineState    = pipelines[i % 2];
+                    packet.resourceHeap     = resourceHeaps[(i / 2) % 2];
+                    packet.numInstances     = std::min(1 + i % 3, gridSize * gridSize - cell);
+                    if (i % 5 == 0)
+                    {
+                        packet.numIndices   = 3;
+                        packet.firstIndex   = 6;
+                        packet.vertexOffset = 4;
+                    }
+                    else
+                        packet.numIndices   = 6;
+                }
+
+                ReferenceDraw draw;
+                {
+                    draw.packet         = packet;
+                    draw.firstInstance  = static_cast<std::uint32_t>(referenceInstances.size());
+                }
+                referenceDraws.push_back(draw);
+
+                // Give each instance its own grid cell and a unique color
+                std::vector<Instance> instances(packet.numInstances);
+                for (auto& instance : instances)
+                {
+                    instance.offset[0]  = -1.0f + cellSize * static_cast<float>(cell % gridSize);
+                    instance.offset[1]  = -1.0f + cellSize * static_cast<float>(cell / gridSize);
+                    instance.color[0]   = static_cast<float>(cell % 4) / 3.0f;
+                    instance.color[1]   = static_cast<float>((cell / 4) % 4) / 3.0f;
+                    instance.color[2]   = static_cast<float>((cell / 16) % 4) / 3.0f;
+                    instance.color[3]   = 1.0f;
+                    referenceInstances.push_back(instance);
+                    ++cell;
+                }
+
+                // Alternate between both thread indices
+                batcher.AddDraw(i % 2, packet, instances.data());
+            }
+        }
+
+        // Records the specified draw commands into the offscreen render target and returns the image.
+        std::vector<std::uint8_t> Render(LLGL::BufferArray& vertexBufferArray, const std::function<void(LLGL::CommandBuffer&)>& drawCommands)
+        {
+            commands->Begin();
+            {
+                commands->SetVertexBufferArray(vertexBufferArray);
+                commands->SetIndexBuffer(*indexBuffer);
+                commands->BeginRenderPass(*renderTarget);
+                {
+                    commands->SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+                    commands->Clear(LLGL::ClearFlags::Color);
+                    commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(resolution), static_cast<float>(resolution) });
+                    drawCommands(*commands);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+            commandQueue->WaitIdle();
+
+            std::vector<std::uint8_t> image(resolution * resolution * 4);
+
+            LLGL::DstImageDescriptor imageDesc { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), image.size() };
+            renderer->ReadTexture(*targetTexture, LLGL::TextureRegion{ LLGL::Offset3D{}, LLGL::Extent3D{ resolution, resolution, 1 } }, imageDesc);
+
+            return image;
+        }
+
+        // Returns the number of pixels that are not cleared.
+        static std::size_t CountCoveredPixels(const std::vector<std::uint8_t>& image)
+        {
+            std::size_t n = 0;
+            for (std::size_t i = 3; i < image.size(); i += 4)
+            {
+                if (image[i] != 0)
+                    ++n;
+            }
+            return n;
+        }
+
+    public:
+
+        void Load()
+        {
+            renderer = LLGL::RenderSystem::Load("OpenGL");
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 64, 64 };
+            }
+            renderer->CreateRenderContext(contextDesc);
+
+            const auto& features = renderer->GetRenderingCaps().features;
+            if (!features.hasIndirectDrawing || !features.hasOffsetInstancing)
+                throw std::runtime_error("indirect drawing with instance offsets is not supported by renderer");
+
+            commandQueue    = renderer->GetCommandQueue();
+            commands        = renderer->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            // Create draw batcher for two threads with an instance buffer
+            LLGL::DrawBatcherDescriptor batcherDesc;
+            {
+                batcherDesc.numThreads                      = 2;
+                batcherDesc.maxNumDraws                     = gridSize * gridSize;
+                batcherDesc.instanceDataSize                = sizeof(Instance);
+                batcherDesc.maxNumInstances                 = gridSize * gridSize;
+                batcherDesc.instanceBufferDesc.bindFlags    = LLGL::BindFlags::VertexBuffer;
+                batcherDesc.instanceBufferDesc.vertexAttribs = instanceFormat.attributes;
+            }
+            LLGL::DrawBatcher batcher(*renderer, batcherDesc);
+
+            AddDrawPackets(batcher);
+            batcher.Build();
+
+            Check(batcher.GetNumDraws() == referenceDraws.size(), "number of draw packets");
+            Check(batcher.GetNumBatches() == 4, "one batch per combination of pipeline state and resource heap");
+
+            // Render with the batched and the direct draw path of the batcher
+            LLGL::Buffer* batchedBuffers[] = { vertexBuffer, batcher.GetInstanceBuffer() };
+            auto batchedBufferArray = renderer->CreateBufferArray(2, batchedBuffers);
+
+            auto batchedImage = Render(
+                *batchedBufferArray,
+                [&batcher](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    batcher.Execute(cmdBuffer);
+                }
+            );
+
+            auto directImage = Render(
+                *batchedBufferArray,
+                [&batcher](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    batcher.ExecuteDirect(cmdBuffer);
+                }
+            );
+
+            // Render reference with one draw command per packet in the order they were added
+            LLGL::BufferDescriptor referenceBufferDesc;
+            {
+                referenceBufferDesc.size            = sizeof(Instance) * referenceInstances.size();
+                referenceBufferDesc.bindFlags       = LLGL::BindFlags::VertexBuffer;
+                referenceBufferDesc.vertexAttribs   = instanceFormat.attributes;
+            }
+            auto referenceInstanceBuffer = renderer->CreateBuffer(referenceBufferDesc, referenceInstances.data());
+
+            LLGL::Buffer* referenceBuffers[] = { vertexBuffer, referenceInstanceBuffer };
+            auto referenceBufferArray = renderer->CreateBufferArray(2, referenceBuffers);
+
+            auto referenceImage = Render(
+                *referenceBufferArray,
+                [this](LLGL::CommandBuffer& cmdBuffer)
+                {
+                    for (const auto& draw : referenceDraws)
+                    {
+                        const auto& packet = draw.packet;
+                        cmdBuffer.SetPipelineState(*packet.pipelineState);
+                        cmdBuffer.SetResourceHeap(*packet.resourceHeap);
+                        cmdBuffer.DrawIndexedInstanced(packet.numIndices, packet.numInstances, packet.firstIndex, packet.vertexOffset, draw.firstInstance);
+                    }
+                }
+            );
+
+            // Compare images
+            Check(CountCoveredPixels(referenceImage) > resolution * resolution / 2, "reference image covers the render target");
+            Check(batchedImage == referenceImage, "batched draws (Execute) match reference draws");
+            Check(directImage == referenceImage, "direct draws (ExecuteDirect) match reference draws");
+        }
+
+};
+
+int main()
+{
+    try
+    {
+        DrawBatcherTest test;
+        test.Load();
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return ReportChecks();
+}
@@ -0,0 +1,271 @@
+/*
+ * Test_GLThreadedSubmission.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Usage: Test_GLThreadedSubmission [-frames N] [-draws N] [-threads N]
+ *
+ * Compares the OpenGL backend with and without threaded submission (see RendererConfigurationOpenGL::threadedSubmission)
+ * and prints the results as CSV to the standard output.
+ * The single-threaded path records all draw calls into an immediate command buffer on the main thread.
+ * The threaded path records the same draw calls into deferred command buffers on several threads, which also submit them,
+ * while the GL submission thread executes them. Each row reports the average CPU time per frame on the main thread.
+ */
+
+
+struct TestConfig
+{
+    std::uint32_t   numFrames   = 200;
+    std::uint32_t   numDraws    = 4000;
+    std::uint32_t   numThreads  = 4;
+};
+
+static const char* g_vertexShaderGLSL =
+    "#version 330\n"
+    "layout(location = 0) in vec2 position;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "}\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 330\n"
+    "out vec4 fColor;\n"
+    "void main() {\n"
+    "    fColor = vec4(1);\n"
+    "}\n";
+
+class GLThreadedSubmissionTest
+{
+
+    private:
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::RenderContext*                context         = nullptr;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::Buffer*                       vertexBuffer    = nullptr;
+        LLGL::PipelineState*                pipeline        = nullptr;
+
+        TestConfig                          config;
+
+    private:
+
+        void LoadRenderer(bool threadedSubmission)
+        {
+            // Load OpenGL renderer with or without threaded submission
+            LLGL::RendererConfigurationOpenGL rendererConfig;
+            {
+                rendererConfig.contextProfile       = LLGL::OpenGLContextProfile::CoreProfile;
+                rendererConfig.threadedSubmission   = threadedSubmission;
+            }
+            LLGL::RenderSystemDescriptor rendererDesc;
+            {
+                rendererDesc.moduleName         = "OpenGL";
+                rendererDesc.rendererConfig     = &rendererConfig;
+                rendererDesc.rendererConfigSize = sizeof(rendererConfig);
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            // Create render context without vsync, so presenting does not throttle the measurement
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution    = { 640, 480 };
+                contextDesc.vsync.enabled           = false;
+            }
+            context = renderer->CreateRenderContext(contextDesc);
+            commandQueue = renderer->GetCommandQueue();
+
+            // Create vertex buffer with a small triangle
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            const float vertices[] = { 0.0f, 0.01f,   0.01f, -0.01f,   -0.01f, -0.01f };
+            vertexBuffer = renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices);
+
+            // Create shader program and graphics pipeline
+            LLGL::ShaderDescriptor vertShaderDesc { LLGL::ShaderType::Vertex,   g_vertexShaderGLSL   };
+            LLGL::ShaderDescriptor fragShaderDesc { LLGL::ShaderType::Fragment, g_fragmentShaderGLSL };
+            {
+                vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+                fragShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            }
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader      = renderer->CreateShader(vertShaderDesc);
+                shaderProgramDesc.fragmentShader    = renderer->CreateShader(fragShaderDesc);
+            }
+            auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram = shaderProgram;
+            }
+            pipeline = renderer->CreatePipelineState(pipelineDesc);
+        }
+
+        void UnloadRenderer()
+        {
+            LLGL::RenderSystem::Unload(std::move(renderer));
+            context         = nullptr;
+            commandQueue    = nullptr;
+            vertexBuffer    = nullptr;
+            pipeline        = nullptr;
+        }
+
+        void RecordDraws(LLGL::CommandBuffer& commands, std::uint32_t numDraws)
+        {
+            commands.Begin();
+            {
+                commands.SetVertexBuffer(*vertexBuffer);
+                commands.BeginRenderPass(*context);
+                {
+                    commands.SetViewport(context->GetResolution());
+                    commands.SetPipelineState(*pipeline);
+                    for (std::uint32_t i = 0; i < numDraws; ++i)
+                        commands.Draw(3, 0);
+                }
+                commands.EndRenderPass();
+            }
+            commands.End();
+        }
+
+        void PrintResult(const char* mode, std::uint32_t numThreads, std::uint64_t elapsedTime)
+        {
+            std::cout << mode << ',' << numThreads << ',' << config.numDraws << ',' << config.numFrames << ',';
+            std::cout << (static_cast<double>(elapsedTime) / static_cast<double>(config.numFrames) / 1000000.0) << std::endl;
+        }
+
+        void MeasureSingleThreaded()
+        {
+            LoadRenderer(false);
+
+            auto commands = renderer->CreateCommandBuffer();
+
+            std::uint64_t elapsedTime = 0;
+
+            for (std::uint32_t frame = 0; frame < config.numFrames; ++frame)
+            {
+                const auto startTime = std::chrono::steady_clock::now();
+                {
+                    RecordDraws(*commands, config.numDraws);
+                    commandQueue->Submit(*commands);
+                    context->Present();
+                }
+                const auto endTime = std::chrono::steady_clock::now();
+                elapsedTime += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+            }
+
+            commandQueue->WaitIdle();
+            PrintResult("single_threaded", 1, elapsedTime);
+
+            UnloadRenderer();
+        }
+
+        void MeasureThreaded(std::uint32_t numThreads)
+        {
+            LoadRenderer(true);
+
+            // Create one command buffer per recording thread
+            std::vector<LLGL::CommandBuffer*> commandBuffers(numThreads);
+            for (auto& commands : commandBuffers)
+                commands = renderer->CreateCommandBuffer();
+
+            std::uint64_t elapsedTime = 0;
+
+            for (std::uint32_t frame = 0; frame < config.numFrames; ++frame)
+            {
+                const auto startTime = std::chrono::steady_clock::now();
+                {
+                    // Record and submit the draw calls of this frame on all recording threads
+                    std::vector<std::thread> workers;
+                    workers.reserve(numThreads);
+
+                    for (std::uint32_t i = 0; i < numThreads; ++i)
+                    {
+                        const auto numDraws = config.numDraws / numThreads + (i < config.numDraws % numThreads ? 1 : 0);
+                        workers.emplace_back(
+                            [this, &commandBuffers, i, numDraws]()
+                            {
+                                RecordDraws(*commandBuffers[i], numDraws);
+                                commandQueue->Submit(*commandBuffers[i]);
+                            }
+                        );
+                    }
+
+                    for (auto& worker : workers)
+                        worker.join();
+
+                    context->Present();
+                }
+                const auto endTime = std::chrono::steady_clock::now();
+                elapsedTime += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+            }
+
+            commandQueue->WaitIdle();
+            PrintResult("threaded", numThreads, elapsedTime);
+
+            UnloadRenderer();
+        }
+
+    public:
+
+        void Run(const TestConfig& testConfig)
+        {
+            config = testConfig;
+
+            std::cout << "mode,recording_threads,draws,frames,ms_per_frame" << std::endl;
+
+            MeasureSingleThreaded();
+            MeasureThreaded(1);
+            if (config.numThreads > 1)
+                MeasureThreaded(config.numThreads);
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    TestConfig testConfig;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-frames") == 0 && i + 1 < argc)
+            testConfig.numFrames = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "-draws") == 0 && i + 1 < argc)
+            testConfig.numDraws = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+            testConfig.numThreads = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+    }
+
+    try
+    {
+        GLThreadedSubmissionTest test;
+        test.Run(testConfig);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * Test_GLVertexBinding.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include "TestHelper.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_GLVertexBinding
+ *
+ * Renders a full-screen triangle on the OpenGL backend from vertex buffers with planar layouts, i.e. all positions followed by all colors.
+ * The colors are stored at offsets of 4096 and 8192 bytes, which exceed the minimum of GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET (2047),
+ * and with another stride than the positions. Both planar buffers share the same VAO, since only their buffer offsets differ.
+ * An interleaved vertex buffer is rendered as reference. The center pixel of each image must have the color of the respective buffer.
+ */
+
+
+static const char* g_vertexShaderGLSL =
+    "#version 330\n"
+    "in vec2 position;\n"
+    "in vec4 color;\n"
+    "out vec4 vColor;\n"
+    "void main() {\n"
+    "    gl_Position = vec4(position, 0, 1);\n"
+    "    vColor = color;\n"
+    "}\n";
+
+static const char* g_fragmentShaderGLSL =
+    "#version 330\n"
+    "in vec4 vColor;\n"
+    "out vec4 fColor;\n"
+    "void main() {\n"
+    "    fColor = vColor;\n"
+    "}\n";
+
+class GLVertexBindingTest
+{
+
+    private:
+
+        static const std::uint32_t          resolution      = 16;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                commands        = nullptr;
+        LLGL::Texture*                      targetTexture   = nullptr;
+        LLGL::RenderTarget*                 renderTarget    = nullptr;
+        LLGL::PipelineState*                pipeline        = nullptr;
+
+    private:
+
+        // Returns the vertex attributes for positions at offset 0 and colors at the specified offset.
+        static std::vector<LLGL::VertexAttribute> GetVertexAttribs(std::uint32_t colorOffset, std::uint32_t colorStride, std::uint32_t positionStride)
+        {
+            return
+            {
+                LLGL::VertexAttribute{ "position", LLGL::Format::RG32Float,   0, 0,           positionStride },
+                LLGL::VertexAttribute{ "color",    LLGL::Format::RGBA32Float, 1, colorOffset, colorStride    },
+            };
+        }
+
+        // Creates a vertex buffer with the full-screen triangle in a planar layout and the colors at the specified offset.
+        LLGL::Buffer* CreatePlanarVertexBuffer(std::uint32_t colorOffset, const LLGL::ColorRGBAf& color)
+        {
+            const float positions[] = { -1.0f, -1.0f,   3.0f, -1.0f,   -1.0f, 3.0f };
+
+            std::vector<char> data(colorOffset + 3 * sizeof(color), 0);
+            std::memcpy(data.data(), positions, sizeof(positions));
+            for (std::uint32_t i = 0; i < 3; ++i)
+                std::memcpy(&data[colorOffset + i * sizeof(color)], &color, sizeof(color));
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = data.size();
+                bufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer;
+                bufferDesc.vertexAttribs    = GetVertexAttribs(colorOffset, sizeof(color), sizeof(float) * 2);
+            }
+            return renderer->CreateBuffer(bufferDesc, data.data());
+        }
+
+        // Creates a vertex buffer with the full-screen triangle in an interleaved layout.
+        LLGL::Buffer* CreateInterleavedVertexBuffer(const LLGL::ColorRGBAf& color)
+        {
+            const float vertices[] =
+            {
+                -1.0f, -1.0f,   color.r, color.g, color.b, color.a,
+                 3.0f, -1.0f,   color.r, color.g, color.b, color.a,
+                -1.0f,  3.0f,   color.r, color.g, color.b, color.a,
+            };
+
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = sizeof(vertices);
+                bufferDesc.bindFlags        = LLGL::BindFlags::VertexBuffer;
+                bufferDesc.vertexAttribs    = GetVertexAttribs(sizeof(float) * 2, sizeof(float) * 6, sizeof(float) * 6);
+            }
+            return renderer->CreateBuffer(bufferDesc, vertices);
+        }
+
+        void CreateResources()
+        {
+            // Create offscreen render target
+            targetTexture = renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, resolution, resolution));
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution     = { resolution, resolution };
+                renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, targetTexture } };
+            }
+            renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+            // Create shader program
+            LLGL::ShaderDescriptor vertShaderDesc { LLGL::ShaderType::Vertex,   g_vertexShaderGLSL   };
+            LLGL::ShaderDescriptor fragShaderDesc { LLGL::ShaderType::Fragment, g_fragmentShaderGLSL };
+            {
+                vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+                fragShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.vertex.inputAttribs  = GetVertexAttribs(0, 0, 0);
+            }
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader      = renderer->CreateShader(vertShaderDesc);
+                shaderProgramDesc.fragmentShader    = renderer->CreateShader(fragShaderDesc);
+            }
+            auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram  = shaderProgram;
+                pipelineDesc.renderPass     = renderTarget->GetRenderPass();
+            }
+            pipeline = renderer->CreatePipelineState(pipelineDesc);
+        }
+
+        // Renders the full-screen triangle from the specified vertex buffer and returns the color of the center pixel.
+        std::uint32_t Render(LLGL::Buffer& vertexBuffer)
+        {
+            commands->Begin();
+            {
+                commands->SetVertexBuffer(vertexBuffer);
+                commands->BeginRenderPass(*renderTarget);
+                {
+                    commands->SetClearColor({ 0.0f, 0.0f, 0.0f, 0.0f });
+                    commands->Clear(LLGL::ClearFlags::Color);
+                    commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, static_cast<float>(resolution), static_cast<float>(resolution) });
+                    commands->SetPipelineState(*pipeline);
+                    commands->Draw(3, 0);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+            commandQueue->WaitIdle();
+
+            std::uint32_t color = 0;
+
+            LLGL::DstImageDescriptor imageDesc { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, &color, sizeof(color) };
+            renderer->ReadTexture(*targetTexture, LLGL::TextureRegion{ LLGL::Offset3D{ resolution / 2, resolution / 2, 0 }, LLGL::Extent3D{ 1, 1, 1 } }, imageDesc);
+
+            return color;
+        }
+
+        // Returns the specified color as packed RGBA8 value, as it is read back from the render target.
+        static std::uint32_t PackColor(const LLGL::ColorRGBAf& color)
+        {
+            const std::uint8_t components[4] =
+            {
+                static_cast<std::uint8_t>(color.r * 255.0f),
+                static_cast<std::uint8_t>(color.g * 255.0f),
+                static_cast<std::uint8_t>(color.b * 255.0f),
+                static_cast<std::uint8_t>(color.a * 255.0f),
+            };
+            std::uint32_t packed = 0;
+            std::memcpy(&packed, components, sizeof(packed));
+            return packed;
+        }
+
+    public:
+
+        void Load()
+        {
+            renderer = LLGL::RenderSystem::Load("OpenGL");
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 64, 64 };
+            }
+            renderer->CreateRenderContext(contextDesc);
+
+            commandQueue    = renderer->GetCommandQueue();
+            commands        = renderer->CreateCommandBuffer();
+
+            CreateResources();
+        }
+
+        void Run()
+        {
+            const LLGL::ColorRGBAf green    { 0.0f, 1.0f, 0.0f, 1.0f };
+            const LLGL::ColorRGBAf red      { 1.0f, 0.0f, 0.0f, 1.0f };
+            const LLGL::ColorRGBAf blue     { 0.0f, 0.0f, 1.0f, 1.0f };
+
+            auto planarBuffer4K = CreatePlanarVertexBuffer(4096, green);
+            auto planarBuffer8K = CreatePlanarVertexBuffer(8192, red);
+            auto interleavedBuffer = CreateInterleavedVertexBuffer(blue);
+
+            Check(Render(*interleavedBuffer) == PackColor(blue), "interleaved layout");
+            Check(Render(*planarBuffer4K) == PackColor(green), "planar layout with colors at offset 4096");
+            Check(Render(*planarBuffer8K) == PackColor(red), "planar layout with colors at offset 8192");
+            Check(Render(*planarBuffer4K) == PackColor(green), "planar layout with colors at offset 4096 after switching buffers");
+        }
+
+};
+
+int main()
+{
+    try
+    {
+        GLVertexBindingTest test;
+        test.Load();
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return ReportChecks();
+}
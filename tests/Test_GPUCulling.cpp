@@ -0,0 +1,308 @@
+/*
+ * Test_GPUCulling.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <LLGL/GPUCulling.h>
+#include "TestHelper.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_GPUCulling
+ *
+ * Runs the GPU culling pass with the built-in GLSL compute shader on the OpenGL backend and compares its output
+ * with the CPU reference implementation CullInstancesCPU, once with frustum culling only and once with a hierarchical-Z pyramid.
+ * The indirect arguments must be equal, and the visible instances must be equal within the range of each mesh (order ignored).
+ * All instances are placed with a safe distance to the frustum planes and the occluder edges, so rounding cannot change the result.
+ */
+
+
+class GPUCullingTest
+{
+
+    private:
+
+        static const std::uint32_t          hiZSize     = 16;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                commands        = nullptr;
+
+        std::vector<LLGL::GPUCullingMesh>   meshes;
+        std::vector<LLGL::GPUCullingInstance> instances;
+        LLGL::GPUCullingView                view;
+
+    private:
+
+        // Generates instances on a grid whose centers have a distance of at least 0.075 to the frustum planes and the occluder edge.
+        void GenerateInstances()
+        {
+            meshes.resize(3);
+            for (std::size_t i = 0; i < meshes.size(); ++i)
+            {
+                meshes[i].numIndices    = static_cast<std::uint32_t>(3 * (i + 1));
+                meshes[i].firstIndex    = static_cast<std::uint32_t>(10 * i);
+                meshes[i].vertexOffset  = static_cast<std::int32_t>(i);
+            }
+
+            const float depths[] = { -0.6f, 0.2f, 0.7f, 1.6f };
+
+            for (int y = 0; y < 12; ++y)
+            {
+                for (int x = 0; x < 12; ++x)
+                {
+                    for (float z : depths)
+                    {
+                        LLGL::GPUCullingInstance instance;
+                        {
+                            instance.center[0]  = -1.375f + 0.25f * static_cast<float>(x);
+                            instance.center[1]  = -1.375f + 0.25f * static_cast<float>(y);
+                            instance.center[2]  = z;
+                            instance.radius     = 0.05f;
+                            instance.meshIndex  = static_cast<std::uint32_t>((x + y * 5) % meshes.size());
+                        }
+                        instances.push_back(instance);
+                    }
+                }
+            }
+        }
+
+        // Initializes an orthographic view that maps the world coordinate Z into the depth range [0, 1] via 0.5*Z + 0.5 for both clipping ranges.
+        void InitializeView()
+        {
+            const auto& caps = renderer->GetRenderingCaps();
+
+            view.clippingRange  = caps.clippingRange;
+            view.hiZOrigin      = caps.screenOrigin;
+
+            if (view.clippingRange == LLGL::ClippingRange::ZeroToOne)
+            {
+                view.viewProjection[10] = 0.5f;
+                view.viewProjection[14] = 0.5f;
+            }
+        }
+
+        // Builds a depth buffer whose left half is occluded at depth 0.5 and whose right half is empty.
+        void BuildDepthBuffer(std::vector<float>& depthData)
+        {
+            depthData.resize(hiZSize * hiZSize);
+            for (std::uint32_t y = 0; y < hiZSize; ++y)
+            {
+                for (std::uint32_t x = 0; x < hiZSize; ++x)
+                    depthData[y * hiZSize + x] = (x < hiZSize / 2 ? 0.5f : 1.0f);
+            }
+        }
+
+        LLGL::Texture* CreateHiZTexture(const LLGL::HiZPyramid& pyramid)
+        {
+            auto textureDesc = LLGL::Texture2DDesc(LLGL::Format::R32Float, hiZSize, hiZSize, LLGL::BindFlags::Sampled);
+            textureDesc.mipLevels = static_cast<std::uint32_t>(pyramid.levels.size());
+
+            auto texture = renderer->CreateTexture(textureDesc);
+
+            for (std::size_t i = 0; i < pyramid.levels.size(); ++i)
+            {
+                const auto& extent = pyramid.extents[i];
+                const auto& level = pyramid.levels[i];
+
+                LLGL::SrcImageDescriptor imageDesc
+                {
+                    LLGL::ImageFormat::R,
+                    LLGL::DataType::Float32,
+                    level.data(),
+                    level.size() * sizeof(float)
+                };
+
+                const LLGL::TextureRegion region
+                {
+                    LLGL::TextureSubresource{ 0, static_cast<std::uint32_t>(i) },
+                    LLGL::Offset3D{ 0, 0, 0 },
+                    LLGL::Extent3D{ extent.width, extent.height, 1 }
+                };
+
+                renderer->WriteTexture(*texture, region, imageDesc);
+            }
+
+            return texture;
+        }
+
+        LLGL::Buffer* CreateReadbackBuffer(std::uint64_t size)
+        {
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = size;
+                bufferDesc.bindFlags        = LLGL::BindFlags::CopyDst;
+                bufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read;
+            }
+            return renderer->CreateBuffer(bufferDesc);
+        }
+
+        template <typename T>
+        void ReadBuffer(LLGL::Buffer& buffer, std::vector<T>& data)
+        {
+            if (auto mappedData = renderer->MapBuffer(buffer, LLGL::CPUAccess::ReadOnly))
+            {
+                ::memcpy(data.data(), mappedData, data.size() * sizeof(T));
+                renderer->UnmapBuffer(buffer);
+            }
+        }
+
+        void CompareWithCPU(const std::string& name, LLGL::Texture* hiZTexture, const LLGL::HiZPyramid* hiZPyramid)
+        {
+            /* Run culling pass on the GPU */
+            LLGL::GPUCullingDescriptor cullingDesc;
+            {
+                cullingDesc.meshes                              = meshes;
+                cullingDesc.maxNumInstances                     = static_cast<std::uint32_t>(instances.size());
+                cullingDesc.hiZTexture                          = hiZTexture;
+                cullingDesc.visibleInstanceBufferDesc.bindFlags = LLGL::BindFlags::VertexBuffer | LLGL::BindFlags::CopySrc;
+            }
+            LLGL::GPUCulling culling(*renderer, cullingDesc);
+            culling.SetInstances(instances.data(), static_cast<std::uint32_t>(instances.size()));
+
+            const auto drawArgsSize         = sizeof(LLGL::DrawIndexedIndirectArguments) * meshes.size();
+            const auto visibleInstancesSize = sizeof(std::uint32_t) * instances.size();
+
+            auto drawArgsReadback           = CreateReadbackBuffer(drawArgsSize);
+            auto visibleInstancesReadback   = CreateReadbackBuffer(visibleInstancesSize);
+
+            commands->Begin();
+            {
+                culling.Dispatch(*commands, view);
+                commands->CopyBuffer(*drawArgsReadback, 0, *culling.GetDrawArgsBuffer(), 0, drawArgsSize);
+                commands->CopyBuffer(*visibleInstancesReadback, 0, *culling.GetVisibleInstanceBuffer(), 0, visibleInstancesSize);
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+            commandQueue->WaitIdle();
+
+            std::vector<LLGL::DrawIndexedIndirectArguments> gpuDrawArgs(meshes.size());
+            std::vector<std::uint32_t> gpuVisibleInstances(instances.size());
+
+            ReadBuffer(*drawArgsReadback, gpuDrawArgs);
+            ReadBuffer(*visibleInstancesReadback, gpuVisibleInstances);
+
+            renderer->Release(*drawArgsReadback);
+            renderer->Release(*visibleInstancesReadback);
+
+            /* Run culling pass on the CPU */
+            std::vector<LLGL::DrawIndexedIndirectArguments> cpuDrawArgs;
+            std::vector<std::uint32_t> cpuVisibleInstances;
+
+            LLGL::CullInstancesCPU(
+                view, meshes, instances.data(), static_cast<std::uint32_t>(instances.size()), hiZPyramid, cpuDrawArgs, cpuVisibleInstances
+            );
+
+            /* Compare indirect arguments */
+            bool drawArgsEqual = (cpuDrawArgs.size() == gpuDrawArgs.size());
+            for (std::size_t i = 0; drawArgsEqual && i < cpuDrawArgs.size(); ++i)
+            {
+                const auto& lhs = cpuDrawArgs[i];
+                const auto& rhs = gpuDrawArgs[i];
+                drawArgsEqual =
+                (
+                    lhs.numIndices      == rhs.numIndices       &&
+                    lhs.numInstances    == rhs.numInstances     &&
+                    lhs.firstIndex      == rhs.firstIndex       &&
+                    lhs.vertexOffset    == rhs.vertexOffset     &&
+                    lhs.firstInstance   == rhs.firstInstance
+                );
+            }
+            Check(drawArgsEqual, name + ": indirect arguments");
+
+            /* Compare visible instances within the range of each mesh, since the GPU does not preserve their order */
+            bool visibleInstancesEqual = drawArgsEqual;
+            for (std::size_t i = 0; visibleInstancesEqual && i < cpuDrawArgs.size(); ++i)
+            {
+                const auto first    = cpuDrawArgs[i].firstInstance;
+                const auto count    = cpuDrawArgs[i].numInstances;
+
+                if (first + count > cpuVisibleInstances.size())
+                {
+                    visibleInstancesEqual = false;
+                    break;
+                }
+
+                std::vector<std::uint32_t> lhs(cpuVisibleInstances.begin() + first, cpuVisibleInstances.begin() + first + count);
+                std::vector<std::uint32_t> rhs(gpuVisibleInstances.begin() + first, gpuVisibleInstances.begin() + first + count);
+
+                std::sort(lhs.begin(), lhs.end());
+                std::sort(rhs.begin(), rhs.end());
+
+                visibleInstancesEqual = (lhs == rhs);
+            }
+            Check(visibleInstancesEqual, name + ": visible instances");
+
+            /* Make sure the test actually culls some instances but not all of them */
+            std::uint32_t numVisible = 0;
+            for (const auto& args : cpuDrawArgs)
+                numVisible += args.numInstances;
+            Check(numVisible > 0 && numVisible < instances.size(), name + ": partial visibility");
+        }
+
+    public:
+
+        void Load()
+        {
+            renderer = LLGL::RenderSystem::Load("OpenGL");
+
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 64, 64 };
+            }
+            renderer->CreateRenderContext(contextDesc);
+
+            if (!renderer->GetRenderingCaps().features.hasComputeShaders)
+                throw std::runtime_error("compute shaders are not supported by renderer");
+
+            commandQueue    = renderer->GetCommandQueue();
+            commands        = renderer->CreateCommandBuffer();
+
+            GenerateInstances();
+            InitializeView();
+        }
+
+        void Run()
+        {
+            /* Frustum culling only */
+            CompareWithCPU("frustum culling", nullptr, nullptr);
+
+            /* Frustum and occlusion culling */
+            std::vector<float> depthData;
+            BuildDepthBuffer(depthData);
+
+            LLGL::HiZPyramid pyramid;
+            LLGL::BuildHiZPyramid(depthData.data(), LLGL::Extent2D{ hiZSize, hiZSize }, pyramid);
+
+            auto hiZTexture = CreateHiZTexture(pyramid);
+            CompareWithCPU("occlusion culling", hiZTexture, &pyramid);
+            renderer->Release(*hiZTexture);
+        }
+
+};
+
+int main()
+{
+    try
+    {
+        GPUCullingTest test;
+        test.Load();
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return ReportChecks();
+}
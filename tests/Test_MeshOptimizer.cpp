@@ -0,0 +1,279 @@
+/*
+ * Test_MeshOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/MeshOptimizer.h>
+#include "TestHelper.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_MeshOptimizer
+ *
+ * Runs the mesh optimization functions on a grid mesh whose triangles are shuffled, so the original vertex cache efficiency is poor.
+ * The reordered index buffers must contain the same triangles with the same winding, and the vertex cache optimization must not increase the ACMR.
+ * The vertex fetch optimization must reproduce the same vertex for every index, and the meshlets must respect their limits and reproduce all triangles.
+ */
+
+
+// Vertex with a position and a unique ID to identify the vertex after it has been reordered.
+struct Vertex
+{
+    float position[3];
+    float id;
+};
+
+struct Mesh
+{
+    LLGL::VertexFormat          format;
+    std::vector<Vertex>         vertices;
+    std::vector<std::uint32_t>  indices;
+
+    LLGL::SrcVertexDescriptor GetSrcDesc() const
+    {
+        LLGL::SrcVertexDescriptor desc;
+        {
+            desc.format     = &format;
+            desc.data       = vertices.data();
+            desc.dataSize   = vertices.size() * sizeof(Vertex);
+        }
+        return desc;
+    }
+};
+
+// Generates a curved grid of NxN quads with shuffled triangles and a few unreferenced vertices at the end.
+static Mesh GenerateShuffledGrid(std::uint32_t size)
+{
+    Mesh mesh;
+
+    mesh.format.AppendAttribute({ "position", LLGL::Format::RGB32Float });
+    mesh.format.AppendAttribute({ "id",       LLGL::Format::R32Float   });
+
+    const std::uint32_t numVerticesPerRow = size + 1;
+
+    for (std::uint32_t y = 0; y < numVerticesPerRow; ++y)
+    {
+        for (std::uint32_t x = 0; x < numVerticesPerRow; ++x)
+        {
+            const float fx = static_cast<float>(x) / static_cast<float>(size);
+            const float fy = static_cast<float>(y) / static_cast<float>(size);
+            mesh.vertices.push_back({ { fx, fy, std::sin(fx * 3.0f) * std::cos(fy * 3.0f) }, static_cast<float>(mesh.vertices.size()) });
+        }
+    }
+
+    for (int i = 0; i < 5; ++i)
+        mesh.vertices.push_back({ { 10.0f, 10.0f, 10.0f }, static_cast<float>(mesh.vertices.size()) });
+
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+
+    for (std::uint32_t y = 0; y < size; ++y)
+    {
+        for (std::uint32_t x = 0; x < size; ++x)
+        {
+            const std::uint32_t i0 = y * numVerticesPerRow + x;
+            const std::uint32_t i1 = i0 + 1;
+            const std::uint32_t i2 = i0 + numVerticesPerRow;
+            const std::uint32_t i3 = i2 + 1;
+            triangles.push_back({ { i0, i1, i2 } });
+            triangles.push_back({ { i2, i1, i3 } });
+        }
+    }
+
+    // Shuffle triangles with a fixed linear congruential generator, so the result is reproducible
+    std::uint32_t seed = 12345;
+    for (std::size_t i = triangles.size(); i > 1; --i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(triangles[i - 1], triangles[(seed >> 8) % i]);
+    }
+
+    for (const auto& tri : triangles)
+        mesh.indices.insert(mesh.indices.end(), tri.begin(), tri.end());
+
+    return mesh;
+}
+
+// Returns the sorted list of triangles, each rotated so its smallest index comes first (which preserves the winding).
+static std::vector<std::array<std::uint32_t, 3>> GetCanonicalTriangles(const std::vector<std::uint32_t>& indices)
+{
+    std::vector<std::array<std::uint32_t, 3>> triangles;
+
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        std::array<std::uint32_t, 3> tri = { { indices[i], indices[i + 1], indices[i + 2] } };
+        while (tri[0] > tri[1] || tri[0] > tri[2])
+            std::rotate(tri.begin(), tri.begin() + 1, tri.end());
+        triangles.push_back(tri);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+static void TestVertexCache()
+{
+    auto mesh = GenerateShuffledGrid(32);
+    const auto originalIndices = mesh.indices;
+    const auto numVertices = static_cast<std::uint32_t>(mesh.vertices.size());
+
+    /* Vertex cache optimization */
+    const auto report = LLGL::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), numVertices);
+
+    Check(GetCanonicalTriangles(mesh.indices) == GetCanonicalTriangles(originalIndices), "vertex cache: triangles preserved");
+    Check(report.after.acmr <= report.before.acmr, "vertex cache: ACMR does not increase");
+    Check(report.after.acmr < report.before.acmr * 0.75f, "vertex cache: ACMR of shuffled mesh is reduced");
+
+    const auto stats = LLGL::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), numVertices);
+    Check(stats.numTransformedVertices == report.after.numTransformedVertices, "vertex cache: report matches analysis");
+
+    /* Overdraw optimization only reorders clusters of the optimized triangles, so it must retain most of the vertex cache efficiency */
+    const auto optimizedIndices = mesh.indices;
+    const auto overdrawReport = LLGL::OptimizeOverdraw(mesh.indices.data(), mesh.indices.size(), mesh.GetSrcDesc());
+
+    Check(GetCanonicalTriangles(mesh.indices) == GetCanonicalTriangles(optimizedIndices), "overdraw: triangles preserved");
+    Check(overdrawReport.before.acmr == report.after.acmr, "overdraw: report starts with optimized ACMR");
+    Check(overdrawReport.after.acmr <= report.before.acmr, "overdraw: ACMR does not exceed ACMR of original mesh");
+}
+
+static void TestVertexFetch()
+{
+    auto mesh = GenerateShuffledGrid(16);
+    LLGL::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), static_cast<std::uint32_t>(mesh.vertices.size()));
+
+    const auto originalVertices = mesh.vertices;
+    const auto originalIndices  = mesh.indices;
+    const auto numReferenced    = (16 + 1) * (16 + 1);
+
+    const auto numVertices = LLGL::OptimizeVertexFetch(
+        mesh.format, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex), mesh.indices.data(), mesh.indices.size()
+    );
+
+    Check(numVertices == static_cast<std::uint32_t>(numReferenced), "vertex fetch: number of referenced vertices");
+
+    /* Every index must still refer to the same vertex */
+    bool sameVertices = true;
+    for (std::size_t i = 0; i < mesh.indices.size(); ++i)
+    {
+        if (std::memcmp(&mesh.vertices[mesh.indices[i]], &originalVertices[originalIndices[i]], sizeof(Vertex)) != 0)
+        {
+            sameVertices = false;
+            break;
+        }
+    }
+    Check(sameVertices, "vertex fetch: indices refer to the same vertex data");
+
+    /* Vertices must be in the order of first reference, and the vertex buffer must be a permutation of the original */
+    bool firstReferenceOrder = true;
+    std::uint32_t nextVertex = 0;
+    for (auto index : mesh.indices)
+    {
+        if (index > nextVertex)
+        {
+            firstReferenceOrder = false;
+            break;
+        }
+        if (index == nextVertex)
+            ++nextVertex;
+    }
+    Check(firstReferenceOrder, "vertex fetch: vertices in order of first reference");
+
+    std::vector<float> ids, originalIds;
+    for (const auto& v : mesh.vertices)
+        ids.push_back(v.id);
+    for (const auto& v : originalVertices)
+        originalIds.push_back(v.id);
+    std::sort(ids.begin(), ids.end());
+    Check(ids == originalIds, "vertex fetch: vertex buffer is a permutation");
+
+    bool unreferencedAtEnd = true;
+    for (std::size_t i = numVertices; i < mesh.vertices.size(); ++i)
+        unreferencedAtEnd = unreferencedAtEnd && (mesh.vertices[i].position[0] == 10.0f);
+    Check(unreferencedAtEnd, "vertex fetch: unreferenced vertices moved to the end");
+}
+
+static void TestMeshlets(std::uint32_t maxVertices, std::uint32_t maxTriangles)
+{
+    const std::string name = "meshlets (" + std::to_string(maxVertices) + ", " + std::to_string(maxTriangles) + "): ";
+
+    auto mesh = GenerateShuffledGrid(24);
+    LLGL::OptimizeVertexCache(mesh.indices.data(), mesh.indices.size(), static_cast<std::uint32_t>(mesh.vertices.size()));
+
+    LLGL::MeshletBuffer buffer;
+    try
+    {
+        buffer = LLGL::GenerateMeshlets(mesh.indices.data(), mesh.indices.size(), mesh.GetSrcDesc(), maxVertices, maxTriangles);
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, name + e.what());
+        return;
+    }
+
+    bool withinLimits = true, validLocalIndices = true, validBounds = true;
+    std::vector<std::uint32_t> reconstructedIndices;
+
+    for (std::size_t m = 0; m < buffer.meshlets.size(); ++m)
+    {
+        const auto& meshlet = buffer.meshlets[m];
+        const auto& bounds  = buffer.bounds[m];
+
+        if (meshlet.numVertices > maxVertices || meshlet.numTriangles > maxTriangles || meshlet.numTriangles == 0)
+            withinLimits = false;
+
+        for (std::uint32_t i = 0; i < meshlet.numTriangles * 3; ++i)
+        {
+            const auto localIndex = buffer.triangles[meshlet.firstTriangle + i];
+            if (localIndex >= meshlet.numVertices)
+            {
+                validLocalIndices = false;
+                continue;
+            }
+            reconstructedIndices.push_back(buffer.vertices[meshlet.firstVertex + localIndex]);
+        }
+
+        /* All vertices must be inside the bounding sphere */
+        for (std::uint32_t i = 0; i < meshlet.numVertices; ++i)
+        {
+            const auto& pos = mesh.vertices[buffer.vertices[meshlet.firstVertex + i]].position;
+            const float d[3] = { pos[0] - bounds.center[0], pos[1] - bounds.center[1], pos[2] - bounds.center[2] };
+            if (std::sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]) > bounds.radius * 1.0001f + 1.0e-6f)
+                validBounds = false;
+        }
+    }
+
+    Check(!buffer.meshlets.empty() && buffer.bounds.size() == buffer.meshlets.size(), name + "meshlets generated");
+    Check(withinLimits, name + "vertex and triangle limits respected");
+    Check(validLocalIndices, name + "local indices in range");
+    Check(reconstructedIndices == mesh.indices, name + "triangles reproduced in order");
+    Check(validBounds, name + "bounding spheres contain all vertices");
+}
+
+int main()
+{
+    try
+    {
+        TestVertexCache();
+        TestVertexFetch();
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("mesh optimization: ") + e.what());
+    }
+
+    TestMeshlets(64, 124);
+    TestMeshlets(3, 1);
+    TestMeshlets(256, 0x40000000u);
+
+    return ReportChecks();
+}
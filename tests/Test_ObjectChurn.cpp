@@ -0,0 +1,169 @@
+/*
+ * Test_ObjectChurn.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_ObjectChurn [RENDERER] [-debug] [-iterations N]
+ *
+ * Measures the CPU time of releasing and creating render system objects while a number of other objects of the same type are alive,
+ * which is the churn a resource streamer produces. The results are printed as CSV to the standard output.
+ * Each row reports the average time of one release followed by one create, so the storage of the render system objects
+ * must scale with the number of live objects to keep this time constant.
+ */
+
+
+struct TestConfig
+{
+    std::string     rendererModule  = "OpenGL";
+    bool            debugLayer      = false;
+    std::uint32_t   numIterations   = 10000;
+};
+
+class ObjectChurnTest
+{
+
+    private:
+
+        LLGL::RenderingProfiler             profiler;
+        LLGL::RenderingDebugger             debugger;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+
+        TestConfig                          config;
+
+    private:
+
+        template <typename T>
+        void MeasureChurn(
+            const char*                                 objectType,
+            std::uint32_t                               numLiveObjects,
+            const std::function<T*()>&                  createObject)
+        {
+            // Create objects that stay alive during the measurement
+            std::vector<T*> objects(numLiveObjects + 1);
+            for (auto& obj : objects)
+                obj = createObject();
+
+            // Release a random object and create a new one in each iteration
+            std::mt19937 rng { 1234 };
+            std::uniform_int_distribution<std::size_t> dist { 0, objects.size() - 1 };
+
+            const auto startTime = std::chrono::steady_clock::now();
+
+            for (std::uint32_t i = 0; i < config.numIterations; ++i)
+            {
+                auto& obj = objects[dist(rng)];
+                renderer->Release(*obj);
+                obj = createObject();
+            }
+
+            const auto endTime = std::chrono::steady_clock::now();
+            const auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+            for (auto obj : objects)
+                renderer->Release(*obj);
+
+            // Print results as CSV row
+            std::cout << config.rendererModule << ',' << (config.debugLayer ? 1 : 0) << ',' << objectType << ',';
+            std::cout << numLiveObjects << ',' << config.numIterations << ',';
+            std::cout << (static_cast<double>(elapsedTime) / static_cast<double>(config.numIterations)) << std::endl;
+        }
+
+    public:
+
+        void Load(const TestConfig& testConfig)
+        {
+            // Store test configuration
+            config = testConfig;
+
+            // Load renderer (with debug layer if enabled)
+            if (config.debugLayer)
+                renderer = LLGL::RenderSystem::Load(config.rendererModule, &profiler, &debugger);
+            else
+                renderer = LLGL::RenderSystem::Load(config.rendererModule);
+
+            // Create render context, since some renderers can only create objects with an active context
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 320, 240 };
+            }
+            renderer->CreateRenderContext(contextDesc);
+        }
+
+        void Run()
+        {
+            const std::uint32_t liveObjectCounts[] = { 0, 100, 1000, 10000 };
+
+            const std::uint32_t texel = 0xFFFFFFFF;
+
+            LLGL::SrcImageDescriptor imageDesc;
+            {
+                imageDesc.data      = &texel;
+                imageDesc.dataSize  = sizeof(texel);
+            }
+
+            std::cout << "renderer,debug_layer,object_type,live_objects,iterations,ns_per_release_and_create" << std::endl;
+
+            for (auto numLiveObjects : liveObjectCounts)
+            {
+                MeasureChurn<LLGL::Buffer>(
+                    "buffer", numLiveObjects,
+                    [&]() { return renderer->CreateBuffer(LLGL::ConstantBufferDesc(256)); }
+                );
+                MeasureChurn<LLGL::Texture>(
+                    "texture", numLiveObjects,
+                    [&]() { return renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, 1, 1), &imageDesc); }
+                );
+                MeasureChurn<LLGL::Sampler>(
+                    "sampler", numLiveObjects,
+                    [&]() { return renderer->CreateSampler({}); }
+                );
+            }
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    TestConfig testConfig;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-debug") == 0)
+            testConfig.debugLayer = true;
+        else if (std::strcmp(argv[i], "-iterations") == 0 && i + 1 < argc)
+            testConfig.numIterations = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else
+            testConfig.rendererModule = argv[i];
+    }
+
+    try
+    {
+        ObjectChurnTest test;
+        test.Load(testConfig);
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * Test_RenderGraph.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/RenderGraph.h>
+#include <LLGL/TextureFlags.h>
+#include "TestHelper.h"
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_RenderGraph
+ *
+ * Compiles render graphs without a render system (dry run) and checks the scheduling decisions:
+ * passes must be ordered by their resource dependencies regardless of the order they were added, unused passes must be culled,
+ * and transient textures may only share a physical texture if they have the same descriptor and disjoint lifetimes.
+ * The physical texture of each resource is read from the printed schedule.
+ */
+
+
+static LLGL::TextureDescriptor MakeTextureDesc(LLGL::Format format, std::uint32_t size, long bindFlags)
+{
+    LLGL::TextureDescriptor textureDesc;
+    {
+        textureDesc.format      = format;
+        textureDesc.extent      = { size, size, 1 };
+        textureDesc.bindFlags   = bindFlags;
+        textureDesc.miscFlags   = 0;
+        textureDesc.mipLevels   = 1;
+    }
+    return textureDesc;
+}
+
+static std::string PrintSchedule(const LLGL::RenderGraph& renderGraph)
+{
+    std::stringstream stream;
+    renderGraph.PrintSchedule(stream);
+    return stream.str();
+}
+
+// Returns the index of the physical texture of the specified resource from the printed schedule, or -1 if the resource has none.
+static int GetPhysicalTexture(const LLGL::RenderGraph& renderGraph, const std::string& name)
+{
+    std::stringstream stream(PrintSchedule(renderGraph));
+    const std::string prefix = "  " + name + ": ";
+
+    for (std::string line; std::getline(stream, line);)
+    {
+        if (line.compare(0, prefix.size(), prefix) == 0)
+        {
+            const auto pos = line.find("physical texture #");
+            if (pos != std::string::npos)
+                return std::stoi(line.substr(pos + 18));
+            return -1;
+        }
+    }
+
+    return -1;
+}
+
+static bool HasTransition(const LLGL::RenderGraph& renderGraph, const std::string& transition)
+{
+    return (PrintSchedule(renderGraph).find("        " + transition + "\n") != std::string::npos);
+}
+
+// Builds a deferred frame whose passes are added in a different order than they must be executed.
+static void BuildDeferredFrame(LLGL::RenderGraph& renderGraph, std::vector<std::string>& executed)
+{
+    const long colorFlags = (LLGL::BindFlags::Sampled | LLGL::BindFlags::ColorAttachment);
+    const long depthFlags = (LLGL::BindFlags::Sampled | LLGL::BindFlags::DepthStencilAttachment);
+
+    auto gBuffer    = renderGraph.CreateTexture("gBuffer", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 256, colorFlags));
+    auto depth      = renderGraph.CreateTexture("depth",   MakeTextureDesc(LLGL::Format::D16UNorm,   256, depthFlags));
+    auto hdr        = renderGraph.CreateTexture("hdr",     MakeTextureDesc(LLGL::Format::RGBA8UNorm, 256, colorFlags));
+    auto bloom      = renderGraph.CreateTexture("bloom",   MakeTextureDesc(LLGL::Format::RGBA8UNorm, 256, colorFlags));
+    auto debug      = renderGraph.CreateTexture("debug",   MakeTextureDesc(LLGL::Format::RGBA8UNorm, 256, colorFlags));
+
+    auto MakePass = [&executed](const std::string& name) -> LLGL::RenderGraphPassDescriptor
+    {
+        LLGL::RenderGraphPassDescriptor passDesc;
+        {
+            passDesc.name       = name;
+            passDesc.execute    = [&executed, name](LLGL::CommandBuffer&, const LLGL::RenderGraph&) { executed.push_back(name); };
+        }
+        return passDesc;
+    };
+
+    /* Final pass is added first and reads resources that are written by passes added later */
+    auto finalPass = MakePass("Final");
+    {
+        finalPass.reads             = { hdr, bloom };
+        finalPass.hasSideEffects    = true;
+    }
+    renderGraph.AddPass(finalPass);
+
+    auto geometryPass = MakePass("Geometry");
+    {
+        geometryPass.colorAttachments       = { gBuffer };
+        geometryPass.depthStencilAttachment = depth;
+    }
+    renderGraph.AddPass(geometryPass);
+
+    auto lightingPass = MakePass("Lighting");
+    {
+        lightingPass.reads              = { gBuffer, depth };
+        lightingPass.colorAttachments   = { hdr };
+    }
+    renderGraph.AddPass(lightingPass);
+
+    /* Debug pass writes a resource that is never read, so it must be culled */
+    auto debugPass = MakePass("Debug");
+    {
+        debugPass.reads             = { gBuffer };
+        debugPass.colorAttachments  = { debug };
+    }
+    renderGraph.AddPass(debugPass);
+
+    auto bloomPass = MakePass("Bloom");
+    {
+        bloomPass.reads             = { hdr };
+        bloomPass.colorAttachments  = { bloom };
+    }
+    renderGraph.AddPass(bloomPass);
+}
+
+static void TestDeferredFrame()
+{
+    LLGL::RenderGraph renderGraph;
+    std::vector<std::string> executed;
+
+    BuildDeferredFrame(renderGraph, executed);
+    renderGraph.Compile();
+
+    /* Passes in order of addition: Final (0), Geometry (1), Lighting (2), Debug (3), Bloom (4) */
+    Check(renderGraph.GetSchedule() == std::vector<std::uint32_t>{ 1, 2, 4, 0 }, "deferred frame: passes sorted by dependencies");
+    Check(PrintSchedule(renderGraph).find("  culled: Debug\n") != std::string::npos, "deferred frame: unused pass culled");
+    Check(PrintSchedule(renderGraph).find("  debug: unused\n") != std::string::npos, "deferred frame: resource of culled pass unused");
+
+    /* Transitions of the G-buffer from its first write to its read in the lighting pass */
+    Check(HasTransition(renderGraph, "gBuffer: Undefined -> ColorAttachment"), "deferred frame: G-buffer written as color attachment");
+    Check(HasTransition(renderGraph, "depth: Undefined -> DepthStencilAttachment"), "deferred frame: depth written as depth-stencil attachment");
+    Check(HasTransition(renderGraph, "gBuffer: ColorAttachment -> ShaderResource"), "deferred frame: G-buffer read by shaders");
+
+    /* Lifetimes: gBuffer [0, 1], depth [0, 1], hdr [1, 3], bloom [2, 3] */
+    const int gBufferTexture    = GetPhysicalTexture(renderGraph, "gBuffer");
+    const int depthTexture      = GetPhysicalTexture(renderGraph, "depth");
+    const int hdrTexture        = GetPhysicalTexture(renderGraph, "hdr");
+    const int bloomTexture      = GetPhysicalTexture(renderGraph, "bloom");
+
+    Check(gBufferTexture >= 0 && depthTexture >= 0 && hdrTexture >= 0 && bloomTexture >= 0, "deferred frame: physical textures assigned");
+    Check(bloomTexture == gBufferTexture, "deferred frame: bloom aliases G-buffer after its last use");
+    Check(hdrTexture != gBufferTexture, "deferred frame: HDR does not alias G-buffer with overlapping lifetime");
+    Check(depthTexture != gBufferTexture && depthTexture != hdrTexture, "deferred frame: depth does not alias textures with other descriptor");
+    Check(GetPhysicalTexture(renderGraph, "debug") == -1, "deferred frame: no physical texture for unused resource");
+
+    const std::uint64_t colorSize = 256 * 256 * 4;
+    const std::uint64_t depthSize = 256 * 256 * 2;
+
+    Check(renderGraph.GetTransientMemory() == 3 * colorSize + depthSize, "deferred frame: transient memory");
+    Check(renderGraph.GetAliasedMemory() == 2 * colorSize + depthSize, "deferred frame: aliased memory");
+
+    /* Dry run does not create any physical textures */
+    Check(renderGraph.GetTexture(1) == nullptr, "deferred frame: no textures in dry run");
+
+    /* Recompiling and rebuilding the same graph must produce the same decisions */
+    const auto schedule = renderGraph.GetSchedule();
+    renderGraph.Compile();
+    Check(renderGraph.GetSchedule() == schedule && renderGraph.GetAliasedMemory() == 2 * colorSize + depthSize, "deferred frame: recompilation");
+
+    renderGraph.Reset();
+    Check(renderGraph.GetSchedule().empty() && renderGraph.GetTransientMemory() == 0, "deferred frame: reset");
+
+    BuildDeferredFrame(renderGraph, executed);
+    renderGraph.Compile();
+    Check(renderGraph.GetSchedule() == schedule && GetPhysicalTexture(renderGraph, "bloom") == GetPhysicalTexture(renderGraph, "gBuffer"), "deferred frame: rebuild after reset");
+
+    Check(executed.empty(), "deferred frame: no pass executed in dry run");
+}
+
+// Builds a chain of passes that each read the output of the previous pass.
+static void TestChain()
+{
+    const long colorFlags = (LLGL::BindFlags::Sampled | LLGL::BindFlags::ColorAttachment);
+
+    LLGL::RenderGraph renderGraph;
+
+    auto full0  = renderGraph.CreateTexture("full0", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 64, colorFlags));
+    auto half0  = renderGraph.CreateTexture("half0", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 32, colorFlags));
+    auto full1  = renderGraph.CreateTexture("full1", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 64, colorFlags));
+    auto full2  = renderGraph.CreateTexture("full2", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 64, colorFlags));
+
+    const LLGL::RenderGraphResource outputs[]   = { full0, half0, full1, full2 };
+    const char*                     names[]     = { "A", "B", "C", "D" };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        LLGL::RenderGraphPassDescriptor passDesc;
+        {
+            passDesc.name               = names[i];
+            passDesc.colorAttachments   = { outputs[i] };
+            passDesc.hasSideEffects     = (i == 3);
+            if (i > 0)
+                passDesc.reads = { outputs[i - 1] };
+        }
+        renderGraph.AddPass(passDesc);
+    }
+
+    renderGraph.Compile();
+
+    /* Lifetimes: full0 [0, 1], half0 [1, 2], full1 [2, 3], full2 [3, 3] */
+    Check(renderGraph.GetSchedule() == std::vector<std::uint32_t>{ 0, 1, 2, 3 }, "chain: passes in order");
+    Check(GetPhysicalTexture(renderGraph, "full1") == GetPhysicalTexture(renderGraph, "full0"), "chain: full1 aliases full0");
+    Check(GetPhysicalTexture(renderGraph, "half0") != GetPhysicalTexture(renderGraph, "full0"), "chain: half0 does not alias other extent");
+    Check(GetPhysicalTexture(renderGraph, "full2") != GetPhysicalTexture(renderGraph, "full1"), "chain: full2 does not alias its input");
+    Check(GetPhysicalTexture(renderGraph, "full2") != GetPhysicalTexture(renderGraph, "half0"), "chain: full2 does not alias other extent");
+    Check(renderGraph.GetAliasedMemory() == 2 * 64 * 64 * 4 + 32 * 32 * 4, "chain: aliased memory");
+}
+
+static void TestErrors()
+{
+    const long colorFlags = (LLGL::BindFlags::Sampled | LLGL::BindFlags::ColorAttachment);
+
+    /* Invalid resource handles */
+    {
+        LLGL::RenderGraph renderGraph;
+        renderGraph.CreateTexture("texture", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 16, colorFlags));
+
+        LLGL::RenderGraphPassDescriptor passDesc;
+        passDesc.reads = { 2 };
+
+        bool rejected = false;
+        try
+        {
+            renderGraph.AddPass(passDesc);
+        }
+        catch (const std::out_of_range&)
+        {
+            rejected = true;
+        }
+        Check(rejected, "errors: invalid resource rejected");
+    }
+
+    /* Two passes that read each other's output before it is written */
+    {
+        LLGL::RenderGraph renderGraph;
+        auto a = renderGraph.CreateTexture("a", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 16, colorFlags));
+        auto b = renderGraph.CreateTexture("b", MakeTextureDesc(LLGL::Format::RGBA8UNorm, 16, colorFlags));
+
+        LLGL::RenderGraphPassDescriptor passX, passY;
+        {
+            passX.reads             = { a };
+            passX.colorAttachments  = { b };
+            passX.hasSideEffects    = true;
+            passY.reads             = { b };
+            passY.colorAttachments  = { a };
+            passY.hasSideEffects    = true;
+        }
+        renderGraph.AddPass(passX);
+        renderGraph.AddPass(passY);
+
+        bool rejected = false;
+        try
+        {
+            renderGraph.Compile();
+        }
+        catch (const std::runtime_error&)
+        {
+            rejected = true;
+        }
+        Check(rejected, "errors: cyclic dependencies rejected");
+    }
+}
+
+int main()
+{
+    try
+    {
+        TestDeferredFrame();
+        TestChain();
+        TestErrors();
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("render graph: ") + e.what());
+    }
+
+    return ReportChecks();
+}
@@ -0,0 +1,162 @@
+/*
+ * Test_SPIRVReflect.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_SPIRVReflect [-iterations N]
+ *
+ * Measures the CPU time of reflecting the SPIR-V test shaders with the Vulkan renderer. The results are printed as CSV to the standard output.
+ * Each iteration creates new shaders from the same modules, so only the first reflection of each module parses the SPIR-V code
+ * and all following reflections are served by the reflection cache of the render system.
+ */
+
+
+struct TestConfig
+{
+    std::uint32_t numIterations = 1000;
+};
+
+struct TestProgram
+{
+    const char*                         name;
+    std::vector<LLGL::ShaderDescriptor> shaderDescs;
+};
+
+class SPIRVReflectTest
+{
+
+    private:
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+
+        TestConfig                          config;
+
+    private:
+
+        // Creates the shaders and the shader program, and returns the time (in nanoseconds) it takes to reflect the shader program.
+        std::int64_t MeasureReflect(const TestProgram& program)
+        {
+            std::vector<LLGL::Shader*> shaders;
+            for (const auto& shaderDesc : program.shaderDescs)
+            {
+                auto shader = renderer->CreateShader(shaderDesc);
+                if (shader->HasErrors())
+                    throw std::runtime_error(shader->GetReport());
+                shaders.push_back(shader);
+            }
+
+            auto shaderProgram = renderer->CreateShaderProgram(LLGL::ShaderProgramDesc(shaders));
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            const auto startTime = std::chrono::steady_clock::now();
+
+            LLGL::ShaderReflection reflection;
+            if (!shaderProgram->Reflect(reflection))
+                throw std::runtime_error(std::string("failed to reflect shader program: ") + program.name);
+
+            const auto endTime = std::chrono::steady_clock::now();
+
+            renderer->Release(*shaderProgram);
+            for (auto shader : shaders)
+                renderer->Release(*shader);
+
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+        }
+
+    public:
+
+        void Load(const TestConfig& testConfig)
+        {
+            // Store test configuration
+            config = testConfig;
+
+            // Load Vulkan renderer, since it is the only renderer that reflects SPIR-V modules
+            renderer = LLGL::RenderSystem::Load("Vulkan");
+
+            // Create render context, since some renderers can only create objects with an active context
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 320, 240 };
+            }
+            renderer->CreateRenderContext(contextDesc);
+        }
+
+        void Run()
+        {
+            const TestProgram programs[] =
+            {
+                {
+                    "Triangle",
+                    {
+                        LLGL::ShaderDescFromFile(LLGL::ShaderType::Vertex,   "Shaders/Triangle.vert.spv"),
+                        LLGL::ShaderDescFromFile(LLGL::ShaderType::Fragment, "Shaders/Triangle.frag.spv"),
+                    }
+                },
+                {
+                    "SpirvReflectTest",
+                    {
+                        LLGL::ShaderDescFromFile(LLGL::ShaderType::Compute,  "Shaders/SpirvReflectTest.comp.spv"),
+                    }
+                },
+            };
+
+            std::cout << "program,iterations,ns_first_reflect,ns_per_cached_reflect" << std::endl;
+
+            for (const auto& program : programs)
+            {
+                // First reflection parses the SPIR-V modules
+                const auto firstTime = MeasureReflect(program);
+
+                // All further reflections of the same modules are served by the cache
+                std::int64_t cachedTime = 0;
+                for (std::uint32_t i = 0; i < config.numIterations; ++i)
+                    cachedTime += MeasureReflect(program);
+
+                // Print results as CSV row
+                std::cout << program.name << ',' << config.numIterations << ',' << firstTime << ',';
+                std::cout << (static_cast<double>(cachedTime) / static_cast<double>(config.numIterations)) << std::endl;
+            }
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    TestConfig testConfig;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-iterations") == 0 && i + 1 < argc)
+            testConfig.numIterations = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+    }
+
+    try
+    {
+        SPIRVReflectTest test;
+        test.Load(testConfig);
+        test.Run();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
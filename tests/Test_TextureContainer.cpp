@@ -0,0 +1,250 @@
+/*
+ * Test_TextureContainer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/TextureContainer.h>
+#include <LLGL/Blob.h>
+#include "TestHelper.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_TextureContainer
+ *
+ * Parses DDS and KTX2 files that are generated in memory. Well-formed files must be parsed into the expected
+ * texture descriptor and subresource sizes, and malformed headers (e.g. overflowing MIP-map or array layer counts)
+ * must be rejected with an exception instead of reading or writing out of bounds.
+ */
+
+
+static void Append(std::vector<std::int8_t>& data, std::uint32_t value)
+{
+    const auto bytes = reinterpret_cast<const std::int8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+static void Append(std::vector<std::int8_t>& data, std::uint64_t value)
+{
+    const auto bytes = reinterpret_cast<const std::int8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+static std::unique_ptr<LLGL::TextureContainer> Parse(std::vector<std::int8_t> data)
+{
+    return std::unique_ptr<LLGL::TextureContainer>(new LLGL::TextureContainer(LLGL::Blob::CreateStrongRef(std::move(data))));
+}
+
+// Returns true if parsing the specified data throws an exception.
+static bool IsRejected(const std::vector<std::int8_t>& data)
+{
+    try
+    {
+        Parse(data);
+        return false;
+    }
+    catch (const std::exception&)
+    {
+        return true;
+    }
+}
+
+// Generates a DDS file with RGBA8 pixels and an optional DX10 header extension.
+static std::vector<std::int8_t> MakeDDS(
+    std::uint32_t   width,
+    std::uint32_t   height,
+    std::uint32_t   mipMapCount,
+    bool            dx10            = false,
+    std::uint32_t   arraySize       = 1,
+    bool            cube            = false,
+    std::size_t     dataSize        = 0)
+{
+    std::vector<std::int8_t> data;
+
+    Append(data, 0x20534444u);                              // "DDS "
+    Append(data, 124u);                                     // size
+    Append(data, 0x0002100Fu);                              // flags
+    Append(data, height);
+    Append(data, width);
+    Append(data, width * 4u);                               // pitchOrLinearSize
+    Append(data, 0u);                                       // depth
+    Append(data, mipMapCount);
+    for (int i = 0; i < 11; ++i)
+        Append(data, 0u);                                   // reserved1
+
+    Append(data, 32u);                                      // pixelFormat.size
+    if (dx10)
+    {
+        Append(data, 0x00000004u);                          // pixelFormat.flags = DDPF_FOURCC
+        Append(data, 0x30315844u);                          // pixelFormat.fourCC = "DX10"
+        for (int i = 0; i < 5; ++i)
+            Append(data, 0u);
+    }
+    else
+    {
+        Append(data, 0x00000041u);                          // pixelFormat.flags = DDPF_RGB | DDPF_ALPHAPIXELS
+        Append(data, 0u);                                   // pixelFormat.fourCC
+        Append(data, 32u);                                  // pixelFormat.rgbBitCount
+        Append(data, 0x000000FFu);
+        Append(data, 0x0000FF00u);
+        Append(data, 0x00FF0000u);
+        Append(data, 0xFF000000u);
+    }
+
+    Append(data, 0x00001000u);                              // caps
+    Append(data, 0u);                                       // caps2
+    Append(data, 0u);                                       // caps3
+    Append(data, 0u);                                       // caps4
+    Append(data, 0u);                                       // reserved2
+
+    if (dx10)
+    {
+        Append(data, 28u);                                  // dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM
+        Append(data, 3u);                                   // resourceDimension = DDS_DIMENSION_TEXTURE2D
+        Append(data, (cube ? 0x00000004u : 0u));            // miscFlag
+        Append(data, arraySize);
+        Append(data, 0u);                                   // miscFlags2
+    }
+
+    data.resize(data.size() + dataSize, 0);
+    return data;
+}
+
+// Generates a KTX2 file with RGBA8 pixels and a consistent level index for all levels.
+static std::vector<std::int8_t> MakeKTX2(
+    std::uint32_t   width,
+    std::uint32_t   height,
+    std::uint32_t   levelCount,
+    std::uint32_t   layerCount  = 0,
+    std::uint32_t   faceCount   = 1,
+    std::uint32_t   depth       = 0)
+{
+    static const std::uint8_t identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+    std::vector<std::int8_t> data(identifier, identifier + sizeof(identifier));
+
+    Append(data, 37u);                                      // vkFormat = VK_FORMAT_R8G8B8A8_UNORM
+    Append(data, 1u);                                       // typeSize
+    Append(data, width);
+    Append(data, height);
+    Append(data, depth);
+    Append(data, layerCount);
+    Append(data, faceCount);
+    Append(data, levelCount);
+    for (int i = 0; i < 5; ++i)
+        Append(data, 0u);                                   // supercompressionScheme, dfd*, kvd*
+    Append(data, std::uint64_t(0));                         // sgdByteOffset
+    Append(data, std::uint64_t(0));                         // sgdByteLength
+
+    /* Write level index for a reasonable number of levels, followed by the level data */
+    const std::uint32_t numLevelIndices = std::min(levelCount, 16u);
+    const std::uint32_t numLayers       = std::max(1u, layerCount) * faceCount;
+
+    std::uint64_t offset = data.size() + numLevelIndices * 24;
+    for (std::uint32_t level = 0; level < numLevelIndices; ++level)
+    {
+        const std::uint64_t levelSize = std::uint64_t(std::max(1u, width >> level)) * std::max(1u, height >> level) * 4 * numLayers;
+        Append(data, offset);
+        Append(data, levelSize);
+        Append(data, levelSize);
+        offset += levelSize;
+    }
+
+    if (offset < (1u << 20))
+        data.resize(static_cast<std::size_t>(offset), 0);
+
+    return data;
+}
+
+static void TestWellFormed()
+{
+    /* DDS with 4x4 RGBA8 texture and three MIP-map levels */
+    try
+    {
+        auto container = Parse(MakeDDS(4, 4, 3, false, 1, false, (16 + 4 + 1) * 4));
+        const auto& desc = container->GetDesc();
+        Check(
+            desc.type == LLGL::TextureType::Texture2D && desc.extent.width == 4 && desc.mipLevels == 3 && desc.arrayLayers == 1,
+            "DDS texture descriptor"
+        );
+        Check(
+            container->GetSubresourceImage(0).dataSize == 64 && container->GetSubresourceImage(2).dataSize == 4,
+            "DDS subresource sizes"
+        );
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("DDS well-formed: ") + e.what());
+    }
+
+    /* DDS with DX10 header and cube map array of two cubes */
+    try
+    {
+        auto container = Parse(MakeDDS(2, 2, 1, true, 2, true, 2 * 6 * 16));
+        const auto& desc = container->GetDesc();
+        Check(desc.type == LLGL::TextureType::TextureCubeArray && desc.arrayLayers == 12, "DDS cube map array");
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("DDS cube map array: ") + e.what());
+    }
+
+    /* KTX2 with 8x8 RGBA8 texture array and full MIP-map chain */
+    try
+    {
+        auto container = Parse(MakeKTX2(8, 8, 4, 3));
+        const auto& desc = container->GetDesc();
+        Check(
+            desc.type == LLGL::TextureType::Texture2DArray && desc.mipLevels == 4 && desc.arrayLayers == 3,
+            "KTX2 texture descriptor"
+        );
+        Check(
+            container->GetSubresourceImage(1, 2).dataSize == 64 && container->GetSubresourceImage(3, 0).dataSize == 4,
+            "KTX2 subresource sizes"
+        );
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("KTX2 well-formed: ") + e.what());
+    }
+}
+
+static void TestMalformed()
+{
+    /* Truncated files */
+    Check(IsRejected(MakeDDS(4, 4, 1)), "DDS without texture data is rejected");
+    Check(IsRejected(std::vector<std::int8_t>(16, 0)), "truncated header is rejected");
+
+    /* MIP-map and array layer counts whose product wraps around 32 bits */
+    Check(IsRejected(MakeDDS(4, 4, 65536, true, 65537, false, 4096)), "DDS with overflowing MIP-map and layer counts is rejected");
+    Check(IsRejected(MakeDDS(4, 4, 1, true, 0x40000000u, true, 4096)), "DDS with overflowing cube map count is rejected");
+
+    /* More MIP-map levels than the texture extent allows, which would shift by 32 bits or more */
+    Check(IsRejected(MakeDDS(4, 4, 4, false, 1, false, 4096)), "DDS with too many MIP-map levels is rejected");
+    Check(IsRejected(MakeDDS(1u << 31, 1, 40, false, 1, false, 4096)), "DDS with more than 32 MIP-map levels is rejected");
+    Check(IsRejected(MakeKTX2(4, 4, 64)), "KTX2 with too many MIP-map levels is rejected");
+
+    /* Absurd layer counts */
+    Check(IsRejected(MakeKTX2(4, 4, 1, 0xFFFFFFFFu, 6)), "KTX2 with overflowing layer count is rejected");
+    Check(IsRejected(MakeDDS(1, 1, 1, true, 1000000, false, 4096)), "DDS with more layers than data is rejected");
+
+    /* Extent whose layer size overflows */
+    Check(IsRejected(MakeKTX2(0xFFFFFFFFu, 0xFFFFFFFFu, 1, 0, 1, 0xFFFFFFFFu)), "KTX2 with overflowing layer size is rejected");
+}
+
+int main()
+{
+    TestWellFormed();
+    TestMalformed();
+
+    return ReportChecks();
+}
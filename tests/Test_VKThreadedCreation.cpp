@@ -0,0 +1,242 @@
+/*
+ * Test_VKThreadedCreation.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Usage: Test_VKThreadedCreation [-iterations N] [-threads N]
+ *
+ * Creates and releases buffers, textures, and samplers on several worker threads concurrently with the Vulkan backend
+ * and prints the results as CSV to the standard output.
+ * Each worker thread creates all objects with initial data (which goes through a staging command pool borrowed by that thread),
+ * releases every other object right away, and keeps the rest alive. Afterwards, the main thread reads back the retained buffers
+ * to verify that no upload got lost or mixed up between threads. Each row reports the number of objects created per second.
+ */
+
+
+struct TestConfig
+{
+    std::uint32_t   numIterations   = 500;
+    std::uint32_t   maxThreads      = 8;
+};
+
+class VKThreadedCreationTest
+{
+
+    private:
+
+        // Objects a worker thread has kept alive, and the value its buffers have been filled with.
+        struct WorkerObjects
+        {
+            std::uint32_t                   pattern = 0;
+            std::vector<LLGL::Buffer*>      buffers;
+            std::vector<LLGL::Texture*>     textures;
+            std::vector<LLGL::Sampler*>     samplers;
+        };
+
+        static const std::uint32_t          bufferSize  = 4096;
+
+        std::unique_ptr<LLGL::RenderSystem> renderer;
+
+        TestConfig                          config;
+
+    private:
+
+        void RunWorker(WorkerObjects& objects, std::atomic<bool>& failed)
+        {
+            try
+            {
+                const std::vector<std::uint32_t> bufferData(bufferSize / sizeof(std::uint32_t), objects.pattern);
+
+                const std::uint32_t texels[4] = { objects.pattern, objects.pattern, objects.pattern, objects.pattern };
+
+                LLGL::SrcImageDescriptor imageDesc;
+                {
+                    imageDesc.data      = texels;
+                    imageDesc.dataSize  = sizeof(texels);
+                }
+
+                LLGL::SamplerDescriptor samplerDesc;
+                {
+                    samplerDesc.maxAnisotropy = 1 + objects.pattern % 16;
+                }
+
+                for (std::uint32_t i = 0; i < config.numIterations; ++i)
+                {
+                    auto buffer     = renderer->CreateBuffer(LLGL::ConstantBufferDesc(bufferSize, LLGL::CPUAccessFlags::Read), bufferData.data());
+                    auto texture    = renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, 2, 2), &imageDesc);
+                    auto sampler    = renderer->CreateSampler(samplerDesc);
+
+                    // Release every other object right away to interleave releases with the creation on other threads
+                    if (i % 2 == 0)
+                    {
+                        renderer->Release(*buffer);
+                        renderer->Release(*texture);
+                        renderer->Release(*sampler);
+                    }
+                    else
+                    {
+                        objects.buffers.push_back(buffer);
+                        objects.textures.push_back(texture);
+                        objects.samplers.push_back(sampler);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << e.what() << std::endl;
+                failed = true;
+            }
+        }
+
+        // Reads back all retained buffers and returns true if they all contain the pattern of their worker thread.
+        bool VerifyBuffers(const WorkerObjects& objects)
+        {
+            bool verified = true;
+
+            for (auto buffer : objects.buffers)
+            {
+                if (auto data = reinterpret_cast<const std::uint32_t*>(renderer->MapBuffer(*buffer, LLGL::CPUAccess::ReadOnly)))
+                {
+                    for (std::uint32_t i = 0; i < bufferSize / sizeof(std::uint32_t); ++i)
+                    {
+                        if (data[i] != objects.pattern)
+                        {
+                            verified = false;
+                            break;
+                        }
+                    }
+                    renderer->UnmapBuffer(*buffer);
+                }
+                else
+                    verified = false;
+            }
+
+            return verified;
+        }
+
+        void ReleaseObjects(const WorkerObjects& objects)
+        {
+            for (auto buffer : objects.buffers)
+                renderer->Release(*buffer);
+            for (auto texture : objects.textures)
+                renderer->Release(*texture);
+            for (auto sampler : objects.samplers)
+                renderer->Release(*sampler);
+        }
+
+        bool MeasureCreation(std::uint32_t numThreads)
+        {
+            std::vector<WorkerObjects> workerObjects(numThreads);
+            for (std::uint32_t i = 0; i < numThreads; ++i)
+                workerObjects[i].pattern = 0x01010101u * (i + 1);
+
+            std::atomic<bool> failed { false };
+
+            const auto startTime = std::chrono::steady_clock::now();
+
+            // Create and release objects on all worker threads concurrently
+            std::vector<std::thread> workers;
+            for (auto& objects : workerObjects)
+                workers.emplace_back(&VKThreadedCreationTest::RunWorker, this, std::ref(objects), std::ref(failed));
+
+            for (auto& worker : workers)
+                worker.join();
+
+            const auto endTime = std::chrono::steady_clock::now();
+            const auto elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+            // Verify and release retained objects on the main thread
+            bool verified = !failed;
+
+            for (const auto& objects : workerObjects)
+            {
+                if (verified)
+                    verified = VerifyBuffers(objects);
+                ReleaseObjects(objects);
+            }
+
+            // Print results as CSV row
+            const auto numObjects = static_cast<double>(numThreads) * config.numIterations * 3;
+
+            std::cout << numThreads << ',' << config.numIterations << ',';
+            std::cout << (static_cast<double>(elapsedTime) / 1000.0) << ',';
+            std::cout << (numObjects * 1000000.0 / static_cast<double>(std::max<std::int64_t>(1, elapsedTime))) << ',';
+            std::cout << (verified ? 1 : 0) << std::endl;
+
+            return verified;
+        }
+
+    public:
+
+        void Load(const TestConfig& testConfig)
+        {
+            // Store test configuration
+            config = testConfig;
+
+            // Load Vulkan renderer without debug layer, since the debug layer wrapper is not thread-safe
+            renderer = LLGL::RenderSystem::Load("Vulkan");
+        }
+
+        bool Run()
+        {
+            bool verified = true;
+
+            std::cout << "threads,iterations_per_thread,ms_total,objects_per_second,verified" << std::endl;
+
+            for (std::uint32_t numThreads = 1; numThreads <= config.maxThreads; numThreads *= 2)
+            {
+                if (!MeasureCreation(numThreads))
+                    verified = false;
+            }
+
+            return verified;
+        }
+
+};
+
+int main(int argc, char* argv[])
+{
+    TestConfig testConfig;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-iterations") == 0 && i + 1 < argc)
+            testConfig.numIterations = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (std::strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+            testConfig.maxThreads = static_cast<std::uint32_t>(std::max(1, std::atoi(argv[++i])));
+    }
+
+    try
+    {
+        VKThreadedCreationTest test;
+        test.Load(testConfig);
+        if (!test.Run())
+        {
+            std::cerr << "verification of concurrently created buffers failed" << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,321 @@
+/*
+ * Test_VertexConversion.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/VertexConversion.h>
+#include "TestHelper.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+/*
+ * Usage: Test_VertexConversion
+ *
+ * Converts vertex buffers with 32-bit floating-point attributes into half floats, 16-bit signed normalized formats with bounds encoding,
+ * octahedral encoded normals, and Format::RGB10A2UNorm. Each destination buffer is decoded again in this test,
+ * and the decoding error must stay within the quantization step of the format and match the maximum error reported by ConvertVertexBuffer.
+ * Out-of-range and NaN components must be clamped to the range of normalized formats.
+ */
+
+
+// Generates reproducible pseudo-random values in the range [minValue, maxValue] with a fixed linear congruential generator.
+class RandomGenerator
+{
+
+    public:
+
+        float Next(float minValue, float maxValue)
+        {
+            seed_ = seed_ * 1664525u + 1013904223u;
+            return minValue + (maxValue - minValue) * static_cast<float>(seed_ >> 8) / static_cast<float>(0x00FFFFFFu);
+        }
+
+    private:
+
+        std::uint32_t seed_ = 12345;
+
+};
+
+// Decodes an IEEE 754 half-precision float.
+static float DecodeFloat16(std::uint16_t value)
+{
+    const int   exponent    = (value >> 10) & 0x1F;
+    const int   mantissa    = value & 0x03FF;
+    const float sign        = ((value & 0x8000) != 0 ? -1.0f : 1.0f);
+
+    if (exponent == 0)
+        return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    if (exponent == 31)
+        return (mantissa == 0 ? sign * std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN());
+
+    return sign * std::ldexp(static_cast<float>(mantissa | 0x0400), exponent - 25);
+}
+
+static float DecodeSNorm16(const char* data)
+{
+    std::int16_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return std::max(-1.0f, static_cast<float>(value) / 32767.0f);
+}
+
+// Decodes the octahedral 2D vector into a normalized 3D vector.
+static void DecodeOctahedral(const float* oct, float* v)
+{
+    v[0] = oct[0];
+    v[1] = oct[1];
+    v[2] = 1.0f - std::abs(oct[0]) - std::abs(oct[1]);
+    if (v[2] < 0.0f)
+    {
+        v[0] = (1.0f - std::abs(oct[1])) * (oct[0] >= 0.0f ? 1.0f : -1.0f);
+        v[1] = (1.0f - std::abs(oct[0])) * (oct[1] >= 0.0f ? 1.0f : -1.0f);
+    }
+    const float len = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+    v[0] /= len;
+    v[1] /= len;
+    v[2] /= len;
+}
+
+static void DecodeRGB10A2(const char* data, float* v)
+{
+    std::uint32_t packed;
+    std::memcpy(&packed, data, sizeof(packed));
+    v[0] = static_cast<float>((packed      ) & 0x3FF) / 1023.0f;
+    v[1] = static_cast<float>((packed >> 10) & 0x3FF) / 1023.0f;
+    v[2] = static_cast<float>((packed >> 20) & 0x3FF) / 1023.0f;
+    v[3] = static_cast<float>((packed >> 30) & 0x003) / 3.0f;
+}
+
+// Returns true if the reported error matches the error measured by the test.
+static bool MatchesReportedError(float reportedError, float measuredError)
+{
+    return (std::abs(reportedError - measuredError) <= 1.0e-6f);
+}
+
+static void TestHalfFloat()
+{
+    LLGL::VertexFormat srcFormat, dstFormat;
+    srcFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float });
+    dstFormat.AppendAttribute({ "texCoord", LLGL::Format::RG16Float });
+
+    RandomGenerator rng;
+    std::vector<float> src;
+    for (int i = 0; i < 1000; ++i)
+        src.push_back(rng.Next(-4.0f, 4.0f));
+
+    std::vector<std::uint16_t> dst(src.size());
+    auto report = LLGL::ConvertVertexBuffer(srcFormat, src.data(), src.size() * sizeof(float), dstFormat, dst.data(), dst.size() * sizeof(std::uint16_t));
+
+    float measuredError = 0.0f, relativeError = 0.0f;
+    for (std::size_t i = 0; i < src.size(); ++i)
+    {
+        const float error = std::abs(DecodeFloat16(dst[i]) - src[i]);
+        measuredError = std::max(measuredError, error);
+        if (std::abs(src[i]) >= 1.0e-4f)
+            relativeError = std::max(relativeError, error / std::abs(src[i]));
+    }
+
+    Check(report.numVertices == 500 && report.attributes.size() == 1, "half float: report size");
+    /* The half-float compressor truncates the mantissa, so the relative error is bounded by one unit in the last place */
+    Check(relativeError <= std::ldexp(1.0f, -10), "half float: round-trip within half-precision");
+    Check(MatchesReportedError(report.attributes[0].maxError, measuredError), "half float: reported max error");
+}
+
+static void TestSNorm16Bounds()
+{
+    LLGL::VertexFormat srcFormat, dstFormat;
+    srcFormat.AppendAttribute({ "position", LLGL::Format::RGB32Float  });
+    dstFormat.AppendAttribute({ "position", LLGL::Format::RGBA16SNorm });
+
+    /* Positions in the box [-3, 5] x [10, 12] x [7, 7], where the last component is constant */
+    RandomGenerator rng;
+    std::vector<float> src;
+    for (int i = 0; i < 1000; ++i)
+    {
+        src.push_back(rng.Next(-3.0f, 5.0f));
+        src.push_back(rng.Next(10.0f, 12.0f));
+        src.push_back(7.0f);
+    }
+    src[0] = -3.0f;
+    src[1] = 10.0f;
+    src[3] = 5.0f;
+    src[4] = 12.0f;
+
+    const std::size_t dstStride = dstFormat.GetStride();
+    std::vector<char> dst(1000 * dstStride);
+
+    auto report = LLGL::ConvertVertexBuffer(
+        srcFormat, src.data(), src.size() * sizeof(float), dstFormat, dst.data(), dst.size(), { LLGL::VertexAttributeEncoding::Bounds }
+    );
+    const auto& q = report.attributes[0];
+
+    Check(
+        std::abs(q.scale[0] - 4.0f) <= 1.0e-5f && std::abs(q.offset[0] - 1.0f) <= 1.0e-5f &&
+        std::abs(q.scale[1] - 1.0f) <= 1.0e-5f && std::abs(q.offset[1] - 11.0f) <= 1.0e-5f &&
+        q.scale[2] == 0.0f && q.offset[2] == 7.0f,
+        "SNorm16 bounds: scale and offset"
+    );
+
+    float measuredError = 0.0f;
+    bool withinStep = true;
+    for (std::size_t vertex = 0; vertex < 1000; ++vertex)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const float decoded = DecodeSNorm16(&dst[vertex * dstStride + i * 2]) * q.scale[i] + q.offset[i];
+            const float error   = std::abs(decoded - src[vertex * 3 + i]);
+            measuredError = std::max(measuredError, error);
+
+            /* Half a quantization step plus the floating-point error of the decoding */
+            if (error > 0.5f * q.scale[i] / 32767.0f + 1.0e-5f)
+                withinStep = false;
+        }
+    }
+
+    Check(withinStep, "SNorm16 bounds: round-trip within half a quantization step");
+    Check(MatchesReportedError(q.maxError, measuredError), "SNorm16 bounds: reported max error");
+    Check(q.maxError > 0.0f && q.maxError <= 0.5f * 4.0f / 32767.0f + 1.0e-5f, "SNorm16 bounds: reported max error within bounds");
+}
+
+static void TestOctahedral()
+{
+    LLGL::VertexFormat srcFormat, dstFormat;
+    srcFormat.AppendAttribute({ "normal", LLGL::Format::RGB32Float });
+    dstFormat.AppendAttribute({ "normal", LLGL::Format::RG16SNorm  });
+
+    /* Random directions with unnormalized length, plus the axis directions that lie on the octahedron edges */
+    RandomGenerator rng;
+    std::vector<float> src = { 1, 0, 0,  -1, 0, 0,  0, 1, 0,  0, -1, 0,  0, 0, 1,  0, 0, -1 };
+    for (int i = 0; i < 2000; ++i)
+    {
+        float v[3] = { rng.Next(-1.0f, 1.0f), rng.Next(-1.0f, 1.0f), rng.Next(-1.0f, 1.0f) };
+        if (v[0]*v[0] + v[1]*v[1] + v[2]*v[2] < 0.01f)
+            continue;
+        const float scale = rng.Next(0.5f, 2.0f);
+        src.insert(src.end(), { v[0] * scale, v[1] * scale, v[2] * scale });
+    }
+
+    const std::size_t numVertices = src.size() / 3;
+    std::vector<char> dst(numVertices * dstFormat.GetStride());
+
+    auto report = LLGL::ConvertVertexBuffer(
+        srcFormat, src.data(), src.size() * sizeof(float), dstFormat, dst.data(), dst.size(), { LLGL::VertexAttributeEncoding::Octahedral }
+    );
+    const auto& q = report.attributes[0];
+
+    float measuredError = 0.0f;
+    for (std::size_t vertex = 0; vertex < numVertices; ++vertex)
+    {
+        const float* v = &src[vertex * 3];
+        const float len = std::sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+
+        float oct[2], decoded[3];
+        oct[0] = DecodeSNorm16(&dst[vertex * 4    ]) * q.scale[0] + q.offset[0];
+        oct[1] = DecodeSNorm16(&dst[vertex * 4 + 2]) * q.scale[1] + q.offset[1];
+        DecodeOctahedral(oct, decoded);
+
+        for (std::size_t i = 0; i < 3; ++i)
+            measuredError = std::max(measuredError, std::abs(decoded[i] - v[i] / len));
+    }
+
+    Check(measuredError <= 1.0e-4f, "octahedral: round-trip of normalized directions");
+    Check(MatchesReportedError(q.maxError, measuredError), "octahedral: reported max error");
+}
+
+static void TestRGB10A2()
+{
+    LLGL::VertexFormat srcFormat, dstFormat;
+    srcFormat.AppendAttribute({ "color", LLGL::Format::RGBA32Float  });
+    dstFormat.AppendAttribute({ "color", LLGL::Format::RGB10A2UNorm });
+
+    /* Colors with alpha values on the 2-bit quantization grid, so the error is dominated by the 10-bit components */
+    RandomGenerator rng;
+    std::vector<float> src;
+    for (int i = 0; i < 1000; ++i)
+    {
+        src.push_back(rng.Next(0.0f, 1.0f));
+        src.push_back(rng.Next(0.0f, 1.0f));
+        src.push_back(rng.Next(0.0f, 1.0f));
+        src.push_back(static_cast<float>(i % 4) / 3.0f);
+    }
+
+    std::vector<std::uint32_t> dst(1000);
+    auto report = LLGL::ConvertVertexBuffer(srcFormat, src.data(), src.size() * sizeof(float), dstFormat, dst.data(), dst.size() * sizeof(std::uint32_t));
+
+    float measuredError = 0.0f;
+    for (std::size_t vertex = 0; vertex < dst.size(); ++vertex)
+    {
+        float decoded[4];
+        DecodeRGB10A2(reinterpret_cast<const char*>(&dst[vertex]), decoded);
+        for (std::size_t i = 0; i < 4; ++i)
+            measuredError = std::max(measuredError, std::abs(decoded[i] - src[vertex * 4 + i]));
+    }
+
+    Check(measuredError <= 0.5f / 1023.0f + 1.0e-6f, "RGB10A2: round-trip within half a quantization step");
+    Check(MatchesReportedError(report.attributes[0].maxError, measuredError), "RGB10A2: reported max error");
+}
+
+static void TestClamping()
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    /* Out-of-range and NaN components must be clamped before they are cast to integers */
+    {
+        LLGL::VertexFormat srcFormat, dstFormat;
+        srcFormat.AppendAttribute({ "color", LLGL::Format::RGBA32Float  });
+        dstFormat.AppendAttribute({ "color", LLGL::Format::RGB10A2UNorm });
+
+        const float src[] = { 2.0f, -1.0f, nan, 1.0e20f,  inf, -inf, 0.5f, -1.0e20f };
+        std::uint32_t dst[2] = {};
+
+        LLGL::ConvertVertexBuffer(srcFormat, src, sizeof(src), dstFormat, dst, sizeof(dst));
+
+        float v0[4], v1[4];
+        DecodeRGB10A2(reinterpret_cast<const char*>(&dst[0]), v0);
+        DecodeRGB10A2(reinterpret_cast<const char*>(&dst[1]), v1);
+
+        Check(v0[0] == 1.0f && v0[1] == 0.0f && v0[2] == 0.0f && v0[3] == 1.0f, "RGB10A2: out-of-range and NaN components clamped");
+        Check(v1[0] == 1.0f && v1[1] == 0.0f && v1[2] == 512.0f / 1023.0f && v1[3] == 0.0f, "RGB10A2: infinite components clamped");
+    }
+
+    {
+        LLGL::VertexFormat srcFormat, dstFormat;
+        srcFormat.AppendAttribute({ "normal", LLGL::Format::RGBA32Float  });
+        dstFormat.AppendAttribute({ "normal", LLGL::Format::RGBA16SNorm });
+
+        const float src[] = { 3.0f, -3.0f, nan, -inf };
+        std::int16_t dst[4] = {};
+
+        LLGL::ConvertVertexBuffer(srcFormat, src, sizeof(src), dstFormat, dst, sizeof(dst));
+
+        Check(dst[0] == 32767 && dst[1] == -32767 && dst[2] == 0 && dst[3] == -32767, "SNorm16: out-of-range and NaN components clamped");
+    }
+}
+
+int main()
+{
+    try
+    {
+        TestHalfFloat();
+        TestSNorm16Bounds();
+        TestOctahedral();
+        TestRGB10A2();
+        TestClamping();
+    }
+    catch (const std::exception& e)
+    {
+        Check(false, std::string("vertex conversion: ") + e.what());
+    }
+
+    return ReportChecks();
+}